@@ -0,0 +1,16 @@
+if (HSMBUILD_DISPATCHER_EPOLL)
+    if (NOT CMAKE_SYSTEM_NAME STREQUAL "Linux")
+        message(FATAL_ERROR "HSMBUILD_DISPATCHER_EPOLL is supported only on Linux")
+    endif()
+
+    set(HSM_DEFINITIONS_EPOLL ${HSM_DEFINITIONS_BASE} -DHSM_BUILD_HSMBUILD_DISPATCHER_EPOLL CACHE STRING "" FORCE)
+    add_definitions(-DHSM_BUILD_HSMBUILD_DISPATCHER_EPOLL)
+    add_library(${HSM_LIBRARY_NAME}_epoll STATIC ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmEventDispatcherEpoll.cpp
+                                                 ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmTimerQueue.cpp)
+    target_compile_options(${HSM_LIBRARY_NAME}_epoll PUBLIC "-fPIC")
+
+    # Export variables
+    set(HSMCPP_EPOLL_CXX_FLAGS ${HSMCPP_CXX_FLAGS} -pthread CACHE STRING "" FORCE)
+    set(HSMCPP_EPOLL_LIB ${HSM_LIBRARY_NAME}_epoll ${HSMCPP_LIB} ${CMAKE_THREAD_LIBS_INIT} CACHE STRING "" FORCE)
+    set(HSMCPP_EPOLL_INCLUDE ${HSMCPP_INCLUDE} CACHE STRING "" FORCE)
+endif()
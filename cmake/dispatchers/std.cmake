@@ -1,7 +1,12 @@
 if (HSMBUILD_DISPATCHER_STD)
     set(HSM_DEFINITIONS_STD ${HSM_DEFINITIONS_BASE} -DHSM_BUILD_HSMBUILD_DISPATCHER_STD CACHE STRING "" FORCE)
     add_definitions(-DHSM_BUILD_HSMBUILD_DISPATCHER_STD)
-    add_library(${HSM_LIBRARY_NAME}_std STATIC ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmEventDispatcherSTD.cpp)
+    add_library(${HSM_LIBRARY_NAME}_std STATIC ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmEventDispatcherSTD.cpp
+                                               ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmEventDispatcherPool.cpp
+                                               ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmEventDispatcherBusyPoll.cpp
+                                               ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmEventDispatcherManual.cpp
+                                               ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmTimerQueue.cpp
+                                               ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmTimerService.cpp)
 
     if (NOT WIN32)
         target_compile_options(${HSM_LIBRARY_NAME}_std PUBLIC "-fPIC")
@@ -1,4 +1,5 @@
 include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/install/glib.cmake)
 include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/install/glibmm.cmake)
 include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/install/std.cmake)
+include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/install/epoll.cmake)
 include(${CMAKE_CURRENT_SOURCE_DIR}/cmake/install/qt.cmake)
\ No newline at end of file
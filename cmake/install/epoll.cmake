@@ -0,0 +1,10 @@
+if (HSMBUILD_DISPATCHER_EPOLL)
+    configure_file(./pkgconfig/hsmcpp_epoll.pc.in hsmcpp_epoll.pc @ONLY)
+    install(FILES "${PROJECT_BINARY_DIR}/hsmcpp_epoll.pc" DESTINATION ${CMAKE_INSTALL_LIBDIR}/pkgconfig)
+    install(TARGETS ${HSM_LIBRARY_NAME}_epoll DESTINATION ${CMAKE_INSTALL_LIBDIR})
+    install(FILES ${HSM_INCLUDES_ROOT}/HsmEventDispatcherEpoll.hpp
+                  ${HSM_INCLUDES_ROOT}/HsmTimerQueue.hpp
+            DESTINATION ${CMAKE_INSTALL_INCLUDEDIR})
+    install(FILES ${CMAKE_CURRENT_SOURCE_DIR}/pkgconfig/cmake/hsmcpp-epoll.cmake
+            DESTINATION ${CMAKE_INSTALL_LIBDIR}/cmake/${HSM_LIBRARY_NAME}/)
+endif()
@@ -3,6 +3,11 @@ if (HSMBUILD_DISPATCHER_STD)
     install(FILES "${PROJECT_BINARY_DIR}/hsmcpp_std.pc" DESTINATION ${CMAKE_INSTALL_LIBDIR}/pkgconfig)
     install(TARGETS ${HSM_LIBRARY_NAME}_std DESTINATION ${CMAKE_INSTALL_LIBDIR})
     install(FILES ${HSM_INCLUDES_ROOT}/HsmEventDispatcherSTD.hpp
+                  ${HSM_INCLUDES_ROOT}/HsmEventDispatcherPool.hpp
+                  ${HSM_INCLUDES_ROOT}/HsmEventDispatcherBusyPoll.hpp
+                  ${HSM_INCLUDES_ROOT}/HsmEventDispatcherManual.hpp
+                  ${HSM_INCLUDES_ROOT}/HsmTimerQueue.hpp
+                  ${HSM_INCLUDES_ROOT}/HsmTimerService.hpp
             DESTINATION ${CMAKE_INSTALL_INCLUDEDIR})
     install(FILES ${CMAKE_CURRENT_SOURCE_DIR}/pkgconfig/cmake/hsmcpp-std.cmake
             DESTINATION ${CMAKE_INSTALL_LIBDIR}/cmake/${HSM_LIBRARY_NAME}/)
@@ -3,6 +3,7 @@ message("Deploy Target: PlatformIO")
 set (DEPLOY_DIR ${DEPLOY_DIR_ROOT}/platformio)
 set (DEPLOY_FILES ${LIBRARY_SRC}
                   ${LIBRARY_HEADERS}
+                  ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmDefinition.hpp
                   ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmImpl.hpp
                   ${CMAKE_CURRENT_SOURCE_DIR}/src/HsmImplTypes.hpp
                   ${FILES_SCXML2GEN}
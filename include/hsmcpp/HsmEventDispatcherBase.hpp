@@ -7,8 +7,11 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
+#include "HsmHandlerRegistry.hpp"
+#include "HsmMpscQueue.hpp"
 #include "IHsmEventDispatcher.hpp"
 #include "os/Mutex.hpp"
 
@@ -17,6 +20,12 @@
  */
 #define DISPATCHER_DEFAULT_EVENTS_CACHESIZE (10)
 
+/**
+ * @details Default number of event handlers which can be queued by emitEvent() without locks. Handlers which don't fit
+ * into this queue are added using a mutex.
+ */
+#define DISPATCHER_DEFAULT_READY_QUEUE_SIZE (64)
+
 namespace hsmcpp {
 
 /**
@@ -29,7 +38,9 @@ class HsmEventDispatcherBase : public IHsmEventDispatcher {
 protected:
     struct TimerInfo {
         HandlerID_t handlerID = INVALID_HSM_DISPATCHER_HANDLER_ID;
-        unsigned int intervalMs = 0;
+        TimerID_t timerID = INVALID_HSM_TIMER_ID;  ///< timer ID provided by handler to startTimer()
+        uint64_t intervalUs = 0;
+        unsigned int slackMs = 0;
         bool isSingleShot = false;
     };
 
@@ -40,6 +51,12 @@ protected:
         EnqueuedEventInfo(const HandlerID_t newHandlerID, const EventID_t newEventID);
     };
 
+    struct FdWatchInfo {
+        int fd = -1;
+        FdEvents_t events = 0;
+        FdWatchHandlerFunc_t handler;
+    };
+
 public:
     /**
      * @brief See IHsmEventDispatcher::stop()
@@ -110,31 +127,110 @@ public:
                     const unsigned int intervalMs,
                     const bool isSingleShot) override;
 
+    /**
+     * @brief See IHsmEventDispatcher::startTimerUs()
+     * @details Interval is stored with microseconds resolution and can be accessed by platform specific implementation
+     * using getTimerIntervalUs(). startTimerImpl() receives interval rounded up to milliseconds.
+     * @threadsafe{ }
+     */
+    void startTimerUs(const HandlerID_t handlerID,
+                      const TimerID_t timerID,
+                      const uint64_t intervalUs,
+                      const bool isSingleShot) override;
+
+    // std::chrono overload of startTimer() from IHsmEventDispatcher
+    using IHsmEventDispatcher::startTimer;
+
+    /**
+     * @brief See IHsmEventDispatcher::startTimerWithSlack()
+     * @details Slack is stored together with other timer settings and can be accessed by platform specific
+     * implementation using getTimerSlack(). Dispatchers which don't support coarse timers will ignore it.
+     * @threadsafe{ }
+     */
+    void startTimerWithSlack(const HandlerID_t handlerID,
+                             const TimerID_t timerID,
+                             const unsigned int intervalMs,
+                             const unsigned int slackMs,
+                             const bool isSingleShot) override;
+
+    /**
+     * @brief Set how repeating timers should handle expirations which were missed because dispatcher was busy.
+     * @details Applies to all repeating timers of the dispatcher. Is supported only by dispatchers which manage timers
+     * on their own (STD, epoll and pool dispatchers). Default policy is MissedTicksPolicy::SKIP.
+     *
+     * @param policy missed ticks policy
+     *
+     * @notthreadsafe{Should be called before starting timers.}
+     */
+    void setMissedTicksPolicy(const MissedTicksPolicy policy);
+
+    /**
+     * @brief Returns current missed ticks policy. See setMissedTicksPolicy().
+     */
+    MissedTicksPolicy getMissedTicksPolicy() const;
+
     /**
      * @brief See IHsmEventDispatcher::restartTimer()
+     * @details Platform specific logic is implemented in restartTimerImpl().
      * @threadsafe{ }
      */
     void restartTimer(const TimerID_t timerID) override;
 
+    /**
+     * @brief See IHsmEventDispatcher::restartTimer(const HandlerID_t, const TimerID_t)
+     * @details Platform specific logic is implemented in restartTimerImpl().
+     * @threadsafe{ }
+     */
+    void restartTimer(const HandlerID_t handlerID, const TimerID_t timerID) override;
+
     /**
      * @brief See IHsmEventDispatcher::stopTimer()
      * @threadsafe{ }
      */
     void stopTimer(const TimerID_t timerID) override;
 
+    /**
+     * @brief See IHsmEventDispatcher::stopTimer(const HandlerID_t, const TimerID_t)
+     * @threadsafe{ }
+     */
+    void stopTimer(const HandlerID_t handlerID, const TimerID_t timerID) override;
+
     /**
      * @brief See IHsmEventDispatcher::isTimerRunning()
      * @threadsafe{ }
      */
     bool isTimerRunning(const TimerID_t timerID) override;
 
+    /**
+     * @brief See IHsmEventDispatcher::isTimerRunning(const HandlerID_t, const TimerID_t)
+     * @threadsafe{ }
+     */
+    bool isTimerRunning(const HandlerID_t handlerID, const TimerID_t timerID) override;
+
+    /**
+     * @brief See IHsmEventDispatcher::watchFd()
+     * @details Platform specific logic is implemented in watchFdImpl(). Default implementation doesn't support file
+     * descriptors watching.
+     *
+     * @threadsafe{ }
+     */
+    HandlerID_t watchFd(const int fd, const FdEvents_t events, const FdWatchHandlerFunc_t& handler) override;
+
+    /**
+     * @brief See IHsmEventDispatcher::unwatchFd()
+     * @threadsafe{ }
+     */
+    void unwatchFd(const HandlerID_t watchID) override;
+
 protected:
     /**
      * @brief Default constructor.
      * @param eventsCacheSize size of the queue preallocated for delayed events
+     * @param readyQueueSize number of event handlers which can be queued by emitEvent() without locks
      */
     // cppcheck-suppress misra-c2012-17.8 ; false positive. setting default parameter value is not parameter modification
-    explicit HsmEventDispatcherBase(const size_t eventsCacheSize = DISPATCHER_DEFAULT_EVENTS_CACHESIZE);
+    explicit HsmEventDispatcherBase(const size_t eventsCacheSize = DISPATCHER_DEFAULT_EVENTS_CACHESIZE,
+                                    const size_t readyQueueSize = DISPATCHER_DEFAULT_READY_QUEUE_SIZE);
 
     /**
      * Destructor.
@@ -177,8 +273,7 @@ protected:
      *
      * @return Enqueued events handler callback or nullptr if handlerID is invalid.
      *
-     * @notthreadsafe{Used only in dispatchEnqueuedEvents(), but data race can happen if registerEnqueuedEventHandler() or
-     * unregisterEnqueuedEventHandler() are called from a different thread.}
+     * @threadsafe{ }
      */
     EnqueuedEventHandlerFunc_t getEnqueuedEventHandlerFunc(const HandlerID_t handlerID) const;
 
@@ -198,13 +293,52 @@ protected:
      * @brief Platform specific implementation to start a timer.
      * @details Must be implemented by derived classes. Default implementation does nothing.
      *
-     * @param timerID       unique timer id
+     * @param timerID       dispatcher-wide unique timer id which must be passed to handleTimerEvent(). It's assigned by
+     *                      HsmEventDispatcherBase and differs from the ID provided to startTimer() since different
+     *                      handlers are allowed to use the same timer IDs
      * @param intervalMs    timer interval in milliseconds
      * @param isSingleShot  true - timer will run only once and then will stop
      *                      false - timer will keep running until stopTimer() is called or dispatcher is destroyed
      */
     virtual void startTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot);
 
+    /**
+     * @brief Platform specific implementation to restart a running or expired timer.
+     * @details Default implementation calls stopTimerImpl() and startTimerImpl(). Dispatchers which manage timers on
+     * their own can override it to postpone deadline of a running timer without waking up the thread which waits for
+     * timers. Is called with mHandlersSync locked.
+     *
+     * @param timerID       id of running or expired timer
+     * @param intervalMs    timer interval in milliseconds
+     * @param isSingleShot  true - timer will run only once and then will stop
+     *                      false - timer will keep running until stopTimer() is called or dispatcher is destroyed
+     */
+    virtual void restartTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot);
+
+    /**
+     * @brief Get slack of an active timer.
+     * @details Intended to be used from startTimerImpl() by dispatchers which support coarse timers.
+     *
+     * @param timerID dispatcher-wide id of active timer (see startTimerImpl())
+     *
+     * @return slack in milliseconds provided to startTimerWithSlack() or 0 if timer doesn't exist
+     *
+     * @notthreadsafe{Must be called with mHandlersSync locked (which is always the case for startTimerImpl()).}
+     */
+    unsigned int getTimerSlack(const TimerID_t timerID) const;
+
+    /**
+     * @brief Get interval of an active timer with microseconds resolution.
+     * @details Intended to be used from startTimerImpl() by dispatchers which support sub-millisecond timers.
+     *
+     * @param timerID dispatcher-wide id of active timer (see startTimerImpl())
+     *
+     * @return interval in microseconds or 0 if timer doesn't exist
+     *
+     * @notthreadsafe{Must be called with mHandlersSync locked (which is always the case for startTimerImpl()).}
+     */
+    uint64_t getTimerIntervalUs(const TimerID_t timerID) const;
+
     /**
      * @brief Platform specific implementation to stop a timer.
      * @details Must be implemented by derived classes. Default implementation does nothing.
@@ -213,6 +347,47 @@ protected:
      */
     virtual void stopTimerImpl(const TimerID_t timerID);
 
+    /**
+     * @brief Platform specific implementation to start watching a file descriptor.
+     * @details Default implementation does nothing and returns false. Is called with mHandlersSync locked.
+     *
+     * @param watchID   unique watch id which must be passed to handleFdWatchEvent()
+     * @param fd        file descriptor to watch
+     * @param events    bitmask of conditions to watch for
+     *
+     * @retval true file descriptor is watched
+     * @retval false file descriptors watching is not supported or failed
+     */
+    virtual bool watchFdImpl(const HandlerID_t watchID, const int fd, const FdEvents_t events);
+
+    /**
+     * @brief Platform specific implementation to stop watching a file descriptor.
+     * @details Default implementation does nothing. Is called with mHandlersSync locked.
+     *
+     * @param watchID   watch id
+     * @param fd        watched file descriptor
+     */
+    virtual void unwatchFdImpl(const HandlerID_t watchID, const int fd);
+
+    /**
+     * @brief Contains common logic for handling file descriptor readiness.
+     * @details Calls watch handler and stops watching if handler returned false. Events for unknown (already removed)
+     * watches are ignored.
+     *
+     * @param watchID   id of the watch
+     * @param events    bitmask of conditions which became true
+     *
+     * @return true if file descriptor is still watched
+     */
+    bool handleFdWatchEvent(const HandlerID_t watchID, const FdEvents_t events);
+
+    /**
+     * @brief Stop watching all file descriptors.
+     *
+     * @threadsafe{ }
+     */
+    void unwatchAllFds();
+
     /**
      * @brief Contains common logic for handling timer event
      *
@@ -223,6 +398,19 @@ protected:
      */
     unsigned int handleTimerEvent(const TimerID_t timerID);
 
+    /**
+     * @brief Same as handleTimerEvent(timerID), but provides precise interval and slack of the timer.
+     * @details Used by dispatchers which manage timers on their own to calculate the next deadline of repeating timers.
+     *
+     * @param timerID       id of the expired timer
+     * @param nextIntervalUs [out] interval in microseconds to use for restarting the timer
+     * @param nextSlackMs   [out] slack in milliseconds to use for restarting the timer
+     *
+     * @retval true timer must be restarted
+     * @retval false timer can be deleted (usually because it's a singleshot timer)
+     */
+    bool handleTimerEvent(const TimerID_t timerID, uint64_t& nextIntervalUs, unsigned int& nextSlackMs);
+
     /**
      * @brief Wakeup dispatching thread to process pending events.
      * @details Must be implemented by derived classes.
@@ -255,27 +443,59 @@ protected:
 
     /**
      * @brief Dispatch pending events based on provided list.
+     * @details Each handler is called once per its entry in the list.
      *
-     * @param events list of events to dispatch
+     * @param events list of handlers to call. Each handler must be present only once
      *
      * @threadsafe{ }
      */
-    void dispatchPendingEventsImpl(const std::list<HandlerID_t>& events);
+    void dispatchPendingEventsImpl(const std::vector<HandlerID_t>& events);
+
+    /**
+     * @brief Check if there are handlers queued by emitEvent() or actions queued by enqueueAction().
+     * @remark Must be called only from the thread which calls dispatchPendingEvents(). Result is approximate if
+     * there are handlers which didn't fit into lock-free queue.
+     */
+    bool hasPendingEvents() const;
+
+private:
+    void startTimerInternal(const HandlerID_t handlerID,
+                            const TimerID_t timerID,
+                            const uint64_t intervalUs,
+                            const unsigned int slackMs,
+                            const bool isSingleShot);
+    static uint64_t makeTimerKey(const HandlerID_t handlerID, const TimerID_t timerID);
+    TimerID_t findTimer(const HandlerID_t handlerID, const TimerID_t timerID) const;
+    TimerID_t allocateTimerID();
+    std::unordered_map<TimerID_t, TimerInfo>::iterator eraseTimer(std::unordered_map<TimerID_t, TimerInfo>::iterator it);
 
 protected:
     HandlerID_t mNextHandlerId = 1;
-    std::map<TimerID_t, TimerInfo> mActiveTimers;                              // protected by mHandlersSync
-    std::map<HandlerID_t, EventHandlerFunc_t> mEventHandlers;                  // protected by mHandlersSync
-    std::map<HandlerID_t, EnqueuedEventHandlerFunc_t> mEnqueuedEventHandlers;  // protected by mHandlersSync
+    TimerID_t mNextTimerID = 1;                                                // protected by mHandlersSync
+    std::unordered_map<TimerID_t, TimerInfo> mActiveTimers;                    // protected by mHandlersSync
+    // (handlerID, timerID) => dispatcher-wide timer ID used as a key in mActiveTimers. protected by mHandlersSync
+    std::unordered_map<uint64_t, TimerID_t> mTimerIDs;
+    // NOTE: event handlers are called without locking or copying them. Handlers can be registered and unregistered
+    //       from inside of other handlers
+    HsmHandlerRegistry<EventHandlerFunc_t> mEventHandlers;
+    HsmHandlerRegistry<EnqueuedEventHandlerFunc_t> mEnqueuedEventHandlers;
     std::map<HandlerID_t, TimerHandlerFunc_t> mTimerHandlers;                  // protected by mHandlersSync
+    std::map<HandlerID_t, FdWatchInfo> mFdWatches;                             // protected by mHandlersSync
     std::list<ActionHandlerFunc_t> mPendingActions;                            // protected by mEmitSync
-    std::list<HandlerID_t> mPendingEvents;                                     // protected by mEmitSync
+    // NOTE: handler is queued only on the first emitEvent() since it was dispatched last time, so number of queued
+    //       handlers is bounded by the number of handlers. Producers add them to mReadyEvents without locks. Handlers
+    //       which don't fit there are added to mPendingEvents
+    HsmMpscQueue<HandlerID_t> mReadyEvents;
+    std::vector<HandlerID_t> mPendingEvents;                                   // protected by mEmitSync
+    // keeps capacity of previously dispatched events. Used only by dispatcher thread
+    std::vector<HandlerID_t> mSparePendingEvents;
     std::vector<EnqueuedEventInfo> mEnqueuedEvents;                            // protected by mEnqueuedEventsSync
     Mutex mEmitSync;
     Mutex mHandlersSync;
     Mutex mEnqueuedEventsSync;
     Mutex mRunningTimersSync;
     bool mStopDispatcher = false;
+    MissedTicksPolicy mMissedTicksPolicy = MissedTicksPolicy::SKIP;
 };
 
 }  // namespace hsmcpp
@@ -0,0 +1,174 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_HSMEVENTDISPATCHERBUSYPOLL_HPP
+#define HSMCPP_HSMEVENTDISPATCHERBUSYPOLL_HPP
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "HsmEventDispatcherBase.hpp"
+#include "HsmTimerQueue.hpp"
+
+namespace hsmcpp {
+
+/**
+ * @brief Default maximum number of event handlers which can be queued in HsmEventDispatcherBusyPoll without locks.
+ */
+constexpr size_t DISPATCHER_BUSYPOLL_DEFAULT_QUEUE_SIZE = 1024;
+
+/**
+ * @brief Value of cpu parameter of HsmEventDispatcherBusyPoll::create() which doesn't pin dispatcher thread to a CPU.
+ */
+constexpr int DISPATCHER_ANY_CPU = -1;
+
+/**
+ * @brief HsmEventDispatcherBusyPoll provides dispatcher implementation for ultra-low-latency applications.
+ * @details Dispatcher thread never blocks. It constantly polls for handlers which have pending events (they are queued
+ * by HsmEventDispatcherBase without locks) and checks deadline of the earliest timer inline. Emitting an event doesn't
+ * require any locks or syscalls, so event latency is limited only by cache coherency traffic between CPU cores.
+ *
+ * Dispatcher thread is supposed to have a dedicated CPU core. It can be pinned to this core with create(). When there
+ * is nothing to do, dispatcher thread can back off according to IdleMode to trade latency for CPU time.
+ *
+ * @remark If number of handlers with pending events exceeds queue size, the rest of them are queued with a mutex.
+ */
+class HsmEventDispatcherBusyPoll : public HsmEventDispatcherBase {
+public:
+    /**
+     * @brief Defines what dispatcher thread does when it doesn't have any events or expired timers.
+     */
+    enum class IdleMode {
+        SPIN,   ///< keep polling using CPU pause instruction. Lowest latency, always uses 100% of the core
+        YIELD,  ///< after a short spin give up remaining time slice to other threads
+        SLEEP   ///< after a short spin and a few yields sleep for a short time. Adds latency when dispatcher was idle
+    };
+
+public:
+    /**
+     * @brief Create dispatcher instance.
+     * @param idleMode what dispatcher thread does when it runs out of work
+     * @param cpu index of the CPU to pin dispatcher thread to or DISPATCHER_ANY_CPU. Supported only on Linux. Thread is
+     * not pinned if index is out of range
+     * @param queueSize maximum number of handlers which can be queued without locks
+     * @param eventsCacheSize size of the queue preallocated for delayed events
+     * @return New dispatcher instance.
+     *
+     * @threadsafe{Instance can be safely created and destroyed from any thread.}
+     */
+    // cppcheck-suppress misra-c2012-17.8 ; false positive. setting default parameter value is not parameter modification
+    static std::shared_ptr<HsmEventDispatcherBusyPoll> create(
+        const IdleMode idleMode = IdleMode::SPIN,
+        const int cpu = DISPATCHER_ANY_CPU,
+        const size_t queueSize = DISPATCHER_BUSYPOLL_DEFAULT_QUEUE_SIZE,
+        const size_t eventsCacheSize = DISPATCHER_DEFAULT_EVENTS_CACHESIZE);
+
+    /**
+     * @brief See IHsmEventDispatcher::emitEvent()
+     * @details Doesn't use locks unless queue is full.
+     * @threadsafe{ }
+     */
+    void emitEvent(const HandlerID_t handlerID) override;
+
+    /**
+     * @copydoc IHsmEventDispatcher::start()
+     * @details Function starts a new std::thread for dispatching events. Thread can be stopped by calling stop().
+     *
+     * @notthreadsafe{This API is intended to be called only once during startup.}
+     */
+    bool start() override;
+
+    /**
+     * @copydoc IHsmEventDispatcher::stop()
+     * @details Instructs dispatcher thread to stop.
+     *
+     * @remark Operation is performed asynchronously. Call join() if you need to wait for dispatcher to fully stop.
+     *
+     * @threadsafe{ }
+     */
+    void stop() override;
+
+    /**
+     * @brief Blocks current thread until dispatcher is stopped.
+     * @remark: Make sure you call stop() before you use join() API.
+     */
+    void join();
+
+protected:
+    /**
+     * @brief Constructor
+     * @param idleMode what dispatcher thread does when it runs out of work
+     * @param cpu index of the CPU to pin dispatcher thread to or DISPATCHER_ANY_CPU
+     * @param queueSize maximum number of handlers which can be queued without locks
+     * @param eventsCacheSize size of the queue preallocated for delayed events
+     */
+    HsmEventDispatcherBusyPoll(const IdleMode idleMode, const int cpu, const size_t queueSize, const size_t eventsCacheSize);
+
+    /**
+     * @brief Destructor
+     * @details Internally calls stop() and join().
+     *
+     * @threadsafe{ }
+     */
+    virtual ~HsmEventDispatcherBusyPoll();
+
+    /**
+     * @copydoc HsmEventDispatcherBase::deleteSafe()
+     */
+    bool deleteSafe() override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::startTimerImpl()
+     * @threadsafe{ }
+     */
+    void startTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::stopTimerImpl()
+     * @threadsafe{ }
+     */
+    void stopTimerImpl(const TimerID_t timerID) override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::restartTimerImpl()
+     * @details Deadline of a running timer is postponed. New deadline is applied when the old one is reached.
+     * @threadsafe{ }
+     */
+    void restartTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) override;
+
+    /**
+     * @brief Tells dispatcher thread that HsmEventDispatcherBase has something to dispatch.
+     * @details Dispatcher thread never sleeps, so it's enough to set a flag. Doesn't use locks or syscalls.
+     */
+    void notifyDispatcherAboutEvent() override;
+
+    void doDispatching();
+    bool processExpiredTimers();
+    void backOff(const unsigned int idleIterations) const;
+    void pinToCpu();
+
+    /**
+     * @brief Publish deadline of the earliest timer to dispatcher thread.
+     * @remark Must be called with mRunningTimersSync locked.
+     */
+    void updateNextDeadline();
+
+private:
+    using ClockRep_t = HsmTimerQueue::Clock_t::rep;
+
+    const IdleMode mIdleMode;
+    const int mCpu;
+    std::thread mDispatcherThread;
+    std::atomic<bool> mIsStarted;
+    // set when there is something to process with HsmEventDispatcherBase::dispatchPendingEvents()
+    std::atomic<bool> mHasPendingEvents;
+    // deadline of the earliest timer in HsmTimerQueue::Clock_t ticks. Allows to check timers without locking
+    std::atomic<ClockRep_t> mNextDeadline;
+    HsmTimerQueue mRunningTimers;  // protected by mRunningTimersSync
+    std::vector<HsmTimerQueue::Expiration_t> mExpiredTimers;  // used only by dispatcher thread
+};
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_HSMEVENTDISPATCHERBUSYPOLL_HPP
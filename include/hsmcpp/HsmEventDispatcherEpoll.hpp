@@ -0,0 +1,188 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_HSMEVENTDISPATCHEREPOLL_HPP
+#define HSMCPP_HSMEVENTDISPATCHEREPOLL_HPP
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "HsmEventDispatcherBase.hpp"
+#include "HsmTimerQueue.hpp"
+
+struct epoll_event;
+
+namespace hsmcpp {
+
+/**
+ * @brief HsmEventDispatcherEpoll provides Linux specific dispatcher implementation based on epoll.
+ * @details Events are signaled through a single eventfd. Multiple emitEvent() calls done before dispatcher wakes up are
+ * coalesced into a single write. All timers are handled with a single timerfd which is always armed to the earliest
+ * timer deadline, so starting or stopping timers doesn't require waking up dispatcher thread.
+ *
+ * Dispatcher can run in its own thread (RunMode::OWN_THREAD) or inside application's event loop
+ * (RunMode::EXTERNAL_LOOP). In the latter case application must add file descriptor returned by getFd() to its own
+ * epoll/poll/select loop and call dispatch() every time it becomes readable.
+ *
+ * File descriptors watched with watchFd() are added directly to dispatcher's epoll instance, so their handlers are
+ * called on dispatcher's thread without any additional thread hops.
+ */
+class HsmEventDispatcherEpoll : public HsmEventDispatcherBase {
+public:
+    /**
+     * @brief Defines who is responsible for waiting for dispatcher events.
+     */
+    enum class RunMode {
+        OWN_THREAD,    ///< dispatcher starts a thread which waits for events in epoll_wait()
+        EXTERNAL_LOOP  ///< application waits for getFd() to become readable and calls dispatch()
+    };
+
+public:
+    /**
+     * @brief Create dispatcher instance.
+     * @param eventsCacheSize size of the queue preallocated for delayed events
+     * @param runMode defines who is responsible for waiting for dispatcher events
+     * @return New dispatcher instance or nullptr if system resources could not be allocated.
+     *
+     * @threadsafe{Instance can be safely created and destroyed from any thread.}
+     */
+    // cppcheck-suppress misra-c2012-17.8 ; false positive. setting default parameter value is not parameter modification
+    static std::shared_ptr<HsmEventDispatcherEpoll> create(const size_t eventsCacheSize = DISPATCHER_DEFAULT_EVENTS_CACHESIZE,
+                                                           const RunMode runMode = RunMode::OWN_THREAD);
+
+    /**
+     * @brief See IHsmEventDispatcher::emitEvent()
+     * @threadsafe{ }
+     */
+    void emitEvent(const HandlerID_t handlerID) override;
+
+    /**
+     * @copydoc IHsmEventDispatcher::start()
+     * @details In RunMode::OWN_THREAD mode starts a new std::thread for dispatching events. In RunMode::EXTERNAL_LOOP
+     * mode only enables dispatching.
+     *
+     * @notthreadsafe{This API is intended to be called only once during startup.}
+     */
+    bool start() override;
+
+    /**
+     * @copydoc IHsmEventDispatcher::stop()
+     * @details Wakes up dispatcher thread and instructs it to stop.
+     *
+     * @remark Operation is performed asynchronously. Call join() if you need to wait for dispatcher to fully stop.
+     *
+     * @threadsafe{ }
+     */
+    void stop() override;
+
+    /**
+     * @brief Blocks current thread until dispatcher thread is stopped.
+     * @details Has no effect in RunMode::EXTERNAL_LOOP mode.
+     *
+     * @remark: Make sure you call stop() before you use join() API.
+     */
+    void join();
+
+    /**
+     * @brief Returns epoll file descriptor used by dispatcher.
+     * @details File descriptor becomes readable when dispatcher has events or expired timers to process. Intended to
+     * be added to application's event loop when dispatcher is used in RunMode::EXTERNAL_LOOP mode.
+     *
+     * @remark File descriptor is owned by dispatcher and must not be closed by application.
+     *
+     * @return epoll file descriptor or -1 if dispatcher failed to initialize.
+     */
+    int getFd() const;
+
+    /**
+     * @brief Process all pending events and expired timers.
+     * @details Doesn't block. Must be called from application's event loop when getFd() becomes readable. Should not
+     * be used in RunMode::OWN_THREAD mode.
+     *
+     * @notthreadsafe{Must be always called from the same thread.}
+     */
+    void dispatch();
+
+protected:
+    /**
+     * @brief Constructor
+     * @param eventsCacheSize size of the queue preallocated for delayed events
+     * @param runMode defines who is responsible for waiting for dispatcher events
+     */
+    HsmEventDispatcherEpoll(const size_t eventsCacheSize, const RunMode runMode);
+
+    /**
+     * @brief Destructor
+     * @details Internally calls stop() and join(). Closes all file descriptors.
+     *
+     * @threadsafe{ }
+     */
+    virtual ~HsmEventDispatcherEpoll();
+
+    /**
+     * @copydoc HsmEventDispatcherBase::deleteSafe()
+     */
+    bool deleteSafe() override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::startTimerImpl()
+     * @threadsafe{ }
+     */
+    void startTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::stopTimerImpl()
+     * @threadsafe{ }
+     */
+    void stopTimerImpl(const TimerID_t timerID) override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::restartTimerImpl()
+     * @details Deadline of a running timer is postponed without waking up the thread which processes timers.
+     * @threadsafe{ }
+     */
+    void restartTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::watchFdImpl()
+     * @threadsafe{ }
+     */
+    bool watchFdImpl(const HandlerID_t watchID, const int fd, const FdEvents_t events) override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::unwatchFdImpl()
+     * @threadsafe{ }
+     */
+    void unwatchFdImpl(const HandlerID_t watchID, const int fd) override;
+
+    void notifyDispatcherAboutEvent() override;
+
+    bool initialize();
+    void doDispatching();
+    void handleFdEvent(const epoll_event& readyEvent);
+    void processExpiredTimers();
+
+    /**
+     * @brief Arm timerfd to expire at the specified time.
+     * @param deadline time when timerfd should expire. TimePoint_t::max() disarms the timer.
+     */
+    void armTimer(const HsmTimerQueue::TimePoint_t& deadline);
+
+private:
+    const RunMode mRunMode;
+    std::thread mDispatcherThread;
+    int mEpollFd = -1;
+    int mEventFd = -1;
+    int mTimerFd = -1;
+    std::atomic<bool> mIsStarted;
+    std::atomic<bool> mWakeupPending;  // used to coalesce writes to mEventFd
+    HsmTimerQueue mRunningTimers;      // protected by mRunningTimersSync
+    // deadline mTimerFd is currently armed to. protected by mRunningTimersSync
+    HsmTimerQueue::TimePoint_t mArmedDeadline = HsmTimerQueue::TimePoint_t::max();
+    std::vector<HsmTimerQueue::Expiration_t> mExpiredTimers;  // used only by dispatcher thread
+};
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_HSMEVENTDISPATCHEREPOLL_HPP
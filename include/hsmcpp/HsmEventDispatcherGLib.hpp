@@ -20,6 +20,7 @@ namespace hsmcpp {
 class HsmEventDispatcherGLib : public HsmEventDispatcherBase {
 private:
     using TimerData_t = std::pair<HsmEventDispatcherGLib*, TimerID_t>;
+    using FdWatchData_t = std::pair<HsmEventDispatcherGLib*, HandlerID_t>;
 
 public:
     /**
@@ -102,6 +103,16 @@ private:
     static gboolean onTimerEvent(const TimerData_t* timerData);
     static void onFreeTimerData(void* timerData);
 
+    /**
+     * @brief See HsmEventDispatcherBase::watchFdImpl()
+     * @details Creates GIOChannel watch attached to dispatcher's GMainContext.
+     */
+    bool watchFdImpl(const HandlerID_t watchID, const int fd, const FdEvents_t events) override;
+    void unwatchFdImpl(const HandlerID_t watchID, const int fd) override;
+
+    static gboolean onFdEvent(GIOChannel* gio, GIOCondition condition, gpointer data);
+    static void onFreeFdWatchData(void* watchData);
+
     void notifyDispatcherAboutEvent() override;
     static gboolean onPipeDataAvailable(GIOChannel* gio, GIOCondition condition, gpointer data);
 
@@ -115,6 +126,7 @@ private:
     std::mutex mDispatchingSync;
     std::condition_variable mDispatchingDoneEvent;
     std::map<TimerID_t, GSource*> mNativeTimerHandlers; // protected by mRunningTimersSync
+    std::map<HandlerID_t, GSource*> mNativeFdWatches; // protected by mHandlersSync
 };
 
 }  // namespace hsmcpp
@@ -0,0 +1,198 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_HSMEVENTDISPATCHERMANUAL_HPP
+#define HSMCPP_HSMEVENTDISPATCHERMANUAL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "HsmEventDispatcherBase.hpp"
+#include "HsmTimerQueue.hpp"
+
+namespace hsmcpp {
+
+/**
+ * @brief HsmEventDispatcherManual provides dispatcher implementation with a virtual clock.
+ * @details Dispatcher doesn't have its own thread and never looks at the system clock. Events are processed only when
+ * application calls runUntilIdle() or advance(). Timers use virtual time which starts at zero and moves forward only
+ * with advance(), so hours of timer driven behavior can be simulated in a few milliseconds.
+ *
+ * Processing is fully deterministic:
+ *   \li timers expire in order of their deadlines. Timers with equal deadlines expire in the order they were started
+ *   \li events emitted by timer handlers are dispatched before virtual clock moves to the next deadline
+ *
+ * Intended for unit tests and simulations.
+ *
+ * @remark Since events are processed by the thread which calls runUntilIdle() or advance(), synchronous transitions
+ * of HSMs which use this dispatcher must not be called from this thread.
+ */
+class HsmEventDispatcherManual : public HsmEventDispatcherBase {
+public:
+    using TimePoint_t = HsmTimerQueue::TimePoint_t;
+
+public:
+    /**
+     * @brief Create dispatcher instance.
+     * @param eventsCacheSize size of the queue preallocated for delayed events
+     * @return New dispatcher instance.
+     *
+     * @threadsafe{Instance can be safely created and destroyed from any thread.}
+     */
+    // cppcheck-suppress misra-c2012-17.8 ; false positive. setting default parameter value is not parameter modification
+    static std::shared_ptr<HsmEventDispatcherManual> create(
+        const size_t eventsCacheSize = DISPATCHER_DEFAULT_EVENTS_CACHESIZE);
+
+    /**
+     * @brief See IHsmEventDispatcher::emitEvent()
+     * @details Event is only queued. It will be processed by the next call to runUntilIdle() or advance().
+     * @threadsafe{ }
+     */
+    void emitEvent(const HandlerID_t handlerID) override;
+
+    /**
+     * @copydoc IHsmEventDispatcher::start()
+     * @details Only enables dispatching. Doesn't start any threads.
+     *
+     * @notthreadsafe{This API is intended to be called only once during startup.}
+     */
+    bool start() override;
+
+    /**
+     * @copydoc IHsmEventDispatcher::stop()
+     * @details Pending events and running timers are discarded.
+     *
+     * @threadsafe{ }
+     */
+    void stop() override;
+
+    /**
+     * @brief Returns current virtual time.
+     * @details Virtual time starts at TimePoint_t() and is changed only by advance().
+     *
+     * @threadsafe{ }
+     */
+    TimePoint_t now() const;
+
+    /**
+     * @brief Process all pending events and timers which expired at current virtual time.
+     * @details Keeps processing until there is nothing left to do, so events emitted by handlers are processed too.
+     * Virtual clock is not changed.
+     *
+     * @remark Function never returns if handlers keep emitting new events.
+     *
+     * @return true if at least one event or timer was processed
+     *
+     * @notthreadsafe{Must be always called from the same thread.}
+     */
+    bool runUntilIdle();
+
+    /**
+     * @brief Move virtual clock forward and process everything what happened during this time.
+     * @details Virtual clock jumps from one timer deadline to the next one. At each deadline expired timers are
+     * processed and then runUntilIdle() is called. Timers started by handlers are taken into account if their deadline
+     * is within the advanced interval.
+     *
+     * @param duration time to add to virtual clock
+     *
+     * @return number of timer expirations which were processed
+     *
+     * @notthreadsafe{Must be always called from the same thread.}
+     */
+    size_t advance(const std::chrono::microseconds& duration);
+
+    /**
+     * @brief Move virtual clock to the deadline of the earliest running timer and process it.
+     * @details Does nothing if there are no running timers.
+     *
+     * @return number of timer expirations which were processed
+     *
+     * @notthreadsafe{Must be always called from the same thread.}
+     */
+    size_t advanceToNextTimer();
+
+    /**
+     * @brief Returns deadline of the earliest running timer or TimePoint_t::max() if there are no running timers.
+     * @threadsafe{ }
+     */
+    TimePoint_t getNextTimerDeadline();
+
+protected:
+    /**
+     * @brief Constructor
+     * @param eventsCacheSize size of the queue preallocated for delayed events
+     */
+    explicit HsmEventDispatcherManual(const size_t eventsCacheSize);
+
+    /**
+     * @brief Destructor
+     * @details Internally calls stop().
+     *
+     * @threadsafe{ }
+     */
+    virtual ~HsmEventDispatcherManual();
+
+    /**
+     * @copydoc HsmEventDispatcherBase::deleteSafe()
+     */
+    bool deleteSafe() override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::startTimerImpl()
+     * @threadsafe{ }
+     */
+    void startTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::stopTimerImpl()
+     * @threadsafe{ }
+     */
+    void stopTimerImpl(const TimerID_t timerID) override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::restartTimerImpl()
+     * @details Timer is rescheduled relative to current virtual time.
+     * @threadsafe{ }
+     */
+    void restartTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) override;
+
+    /**
+     * @brief Marks that HsmEventDispatcherBase has something to dispatch.
+     */
+    void notifyDispatcherAboutEvent() override;
+
+    /**
+     * @brief Implementation of runUntilIdle().
+     * @param expiredTimers [in/out] incremented by the number of processed timer expirations
+     * @return true if at least one event or timer was processed
+     */
+    bool dispatchUntilIdle(size_t& expiredTimers);
+
+    /**
+     * @brief Process timers which expired at current virtual time.
+     * @return number of processed timers
+     */
+    size_t processExpiredTimers();
+
+    /**
+     * @brief Calculate deadline of a timer which is started at current virtual time.
+     * @remark Must be called with mHandlersSync locked.
+     */
+    TimePoint_t getTimerDeadline(const TimerID_t timerID) const;
+
+private:
+    using ClockRep_t = HsmTimerQueue::Clock_t::rep;
+
+    std::atomic<bool> mIsStarted;
+    // set when there is something to process with HsmEventDispatcherBase::dispatchPendingEvents()
+    std::atomic<bool> mHasPendingEvents;
+    // virtual time in HsmTimerQueue::Clock_t ticks
+    std::atomic<ClockRep_t> mNow;
+    HsmTimerQueue mRunningTimers;  // protected by mRunningTimersSync
+    std::vector<HsmTimerQueue::Expiration_t> mExpiredTimers;  // used only by dispatching thread
+};
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_HSMEVENTDISPATCHERMANUAL_HPP
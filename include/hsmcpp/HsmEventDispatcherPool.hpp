@@ -0,0 +1,213 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_HSMEVENTDISPATCHERPOOL_HPP
+#define HSMCPP_HSMEVENTDISPATCHERPOOL_HPP
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "HsmEventDispatcherBase.hpp"
+#include "HsmTimerQueue.hpp"
+#include "os/ConditionVariable.hpp"
+#include "os/Mutex.hpp"
+
+namespace hsmcpp {
+
+/**
+ * @brief HsmEventDispatcherPool provides multi-threaded dispatcher implementation based on std::thread.
+ * @details Dispatcher runs a pool of worker threads. Every registered event handler (HSM instances register one handler
+ * each) is a serial "strand": events of the same handler are always processed one at a time and in order, but different
+ * handlers are processed in parallel by different workers. This allows to use multiple CPU cores for many HSM instances
+ * without manually sharding them between multiple single-threaded dispatchers.
+ *
+ * Scheduling:
+ *  \li every worker has its own queue of ready handlers;
+ *  \li handler which becomes ready is added to the queue of the worker which processed it the last time (or of the
+ *      current worker if event was emitted from the pool itself) to keep handler's data in a warm CPU cache;
+ *  \li idle workers steal ready handlers from the queues of other workers.
+ *
+ * Timers are processed in a separate thread which is started with the first timer. Enqueued events are processed by
+ * any worker, but never concurrently. Enqueued actions are executed exclusively: worker waits for all running handlers to
+ * finish their current events and no handlers are started until actions are done.
+ *
+ * @remark HSM callbacks of a single HSM instance are never executed concurrently, but they can be called from different
+ * threads of the pool. Callbacks of different HSM instances can be executed at the same time.
+ */
+class HsmEventDispatcherPool : public HsmEventDispatcherBase {
+public:
+    /**
+     * @brief Create dispatcher instance.
+     * @param workersCount number of worker threads. If 0 is passed, std::thread::hardware_concurrency() is used
+     * @param eventsCacheSize size of the queue preallocated for delayed events
+     * @return New dispatcher instance.
+     *
+     * @threadsafe{Instance can be safely created and destroyed from any thread.}
+     */
+    // cppcheck-suppress misra-c2012-17.8 ; false positive. setting default parameter value is not parameter modification
+    static std::shared_ptr<HsmEventDispatcherPool> create(const size_t workersCount = 0,
+                                                          const size_t eventsCacheSize = DISPATCHER_DEFAULT_EVENTS_CACHESIZE);
+
+    /**
+     * @brief See IHsmEventDispatcher::registerEventHandler()
+     * @details Creates a new strand for the handler.
+     * @threadsafe{ }
+     */
+    HandlerID_t registerEventHandler(const EventHandlerFunc_t& handler) override;
+
+    /**
+     * @brief See IHsmEventDispatcher::unregisterEventHandler()
+     * @details If handler is currently being executed by one of the workers it will finish processing the current event.
+     * @threadsafe{ }
+     */
+    void unregisterEventHandler(const HandlerID_t handlerID) override;
+
+    /**
+     * @brief See IHsmEventDispatcher::emitEvent()
+     * @threadsafe{ }
+     */
+    void emitEvent(const HandlerID_t handlerID) override;
+
+    /**
+     * @copydoc IHsmEventDispatcher::start()
+     * @details Starts worker threads.
+     *
+     * @notthreadsafe{This API is intended to be called only once during startup.}
+     */
+    bool start() override;
+
+    /**
+     * @copydoc IHsmEventDispatcher::stop()
+     * @details Wakes up all worker threads and instructs them to stop.
+     *
+     * @remark Operation is performed asynchronously. Call join() if you need to wait for dispatcher to fully stop.
+     *
+     * @threadsafe{ }
+     */
+    void stop() override;
+
+    /**
+     * @brief Blocks current thread until all worker threads are stopped.
+     * @remark: Make sure you call stop() before you use join() API. Must not be called from worker threads.
+     */
+    void join();
+
+    /**
+     * @brief Returns number of worker threads.
+     */
+    size_t getWorkersCount() const;
+
+protected:
+    /**
+     * @brief Constructor
+     * @param workersCount number of worker threads
+     * @param eventsCacheSize size of the queue preallocated for delayed events
+     */
+    HsmEventDispatcherPool(const size_t workersCount, const size_t eventsCacheSize);
+
+    /**
+     * @brief Destructor
+     * @details Internally calls stop() and join().
+     *
+     * @threadsafe{ }
+     */
+    virtual ~HsmEventDispatcherPool();
+
+    /**
+     * @copydoc HsmEventDispatcherBase::deleteSafe()
+     */
+    bool deleteSafe() override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::startTimerImpl()
+     * @threadsafe{ }
+     */
+    void startTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::stopTimerImpl()
+     * @threadsafe{ }
+     */
+    void stopTimerImpl(const TimerID_t timerID) override;
+
+    /**
+     * @brief See HsmEventDispatcherBase::restartTimerImpl()
+     * @details Deadline of a running timer is postponed without waking up the thread which processes timers.
+     * @threadsafe{ }
+     */
+    void restartTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) override;
+
+    /**
+     * @brief Used by enqueueEvent() and enqueueAction() to request processing of enqueued events and actions.
+     */
+    void notifyDispatcherAboutEvent() override;
+
+private:
+    struct Strand {
+        HandlerID_t handlerID = INVALID_HSM_DISPATCHER_HANDLER_ID;
+        EventHandlerFunc_t handler;
+        std::atomic<size_t> pendingEvents;  // strand is queued or running while this value is not zero
+        std::atomic<bool> isRegistered;
+        std::atomic<size_t> lastWorker;  // index of the worker which processed this strand the last time
+
+        Strand(const HandlerID_t id, const EventHandlerFunc_t& func, const size_t worker);
+    };
+
+    struct Worker {
+        Mutex queueSync;
+        std::deque<std::shared_ptr<Strand>> readyStrands;  // protected by queueSync
+        std::thread thread;
+    };
+
+    void doWork(const size_t workerIndex);
+    void schedule(const std::shared_ptr<Strand>& strand);
+    std::shared_ptr<Strand> takeStrand(const size_t workerIndex);
+    void runStrand(const size_t workerIndex, const std::shared_ptr<Strand>& strand);
+    void processSystemWork();
+    void beginExclusiveSection();
+    void endExclusiveSection();
+    void acquireStrandSlot();
+    void releaseStrandSlot();
+    void wakeupWorker();
+    void unregisterAllStrands();
+
+    void notifyTimersThread();
+    void handleTimers();
+    void processExpiredTimers();
+
+private:
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    // NOTE: mHandlersSync can't be used for strands because timer handlers are called while holding it and they
+    //       usually emit events
+    Mutex mStrandsSync;
+    std::unordered_map<HandlerID_t, std::shared_ptr<Strand>> mStrands;  // protected by mStrandsSync
+    size_t mNextWorker = 0;                                              // protected by mStrandsSync
+    std::atomic<bool> mIsStarted;
+
+    // used to put idle workers to sleep
+    Mutex mIdleSync;
+    ConditionVariable mWorkAvailable;
+    std::atomic<int> mQueuedStrands;  // can be temporarily negative while strand is being added to the queue
+    std::atomic<int> mIdleWorkers;
+    std::atomic<bool> mSystemWorkPending;  // enqueued events or actions need to be processed
+    Mutex mSystemWorkSync;            // used to process enqueued events and actions by one worker at a time
+    std::atomic<int> mRunningStrands;
+    std::atomic<bool> mExclusiveRequested;  // workers must not start new strands while enqueued actions are executed
+    ConditionVariable mStrandsFinished;  // used with mIdleSync
+
+    std::thread mTimersThread;
+    ConditionVariable mTimerEvent;
+    bool mNotifiedTimersThread = false;  // protected by mRunningTimersSync
+    HsmTimerQueue mRunningTimers;        // protected by mRunningTimersSync
+    // deadline timers thread is currently sleeping until. protected by mRunningTimersSync
+    HsmTimerQueue::TimePoint_t mTimersThreadDeadline = HsmTimerQueue::TimePoint_t::max();
+    std::vector<HsmTimerQueue::Expiration_t> mExpiredTimers;  // used only by timers thread
+};
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_HSMEVENTDISPATCHERPOOL_HPP
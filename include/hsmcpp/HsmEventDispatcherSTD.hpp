@@ -4,11 +4,14 @@
 #ifndef HSMCPP_HSMEVENTDISPATCHERSTD_HPP
 #define HSMCPP_HSMEVENTDISPATCHERSTD_HPP
 
+#include <atomic>
 #include <chrono>
-#include <map>
 #include <thread>
+#include <vector>
 
 #include "HsmEventDispatcherBase.hpp"
+#include "HsmTimerQueue.hpp"
+#include "HsmTimerService.hpp"
 #include "os/ConditionVariable.hpp"
 
 namespace hsmcpp {
@@ -18,22 +21,32 @@ namespace hsmcpp {
  * @details See @rstref{platforms-dispatcher-std} for details.
  */
 class HsmEventDispatcherSTD : public HsmEventDispatcherBase {
-private:
-    struct RunningTimerInfo {
-        std::chrono::time_point<std::chrono::steady_clock> startedAt;  ///< time when timer was started (monotonic, ms)
-        std::chrono::time_point<std::chrono::steady_clock> elapseAfter;  ///< time when timer should elapse next (monotonic , ms)
+public:
+    /**
+     * @brief Defines which thread is used to process timers.
+     */
+    enum class TimersMode {
+        SEPARATE_THREAD,    ///< timers are processed in a dedicated thread which is started with the first timer
+        DISPATCHER_THREAD,  ///< dispatcher thread waits for the next timer deadline and processes timers itself
+        SHARED_SERVICE      ///< process-wide HsmTimerService waits for deadlines of all dispatchers using a single
+                            ///< thread. Expired timers are processed in dispatcher thread
     };
 
 public:
     /**
      * @brief Create dispatcher instance.
      * @param eventsCacheSize size of the queue preallocated for delayed events
+     * @param timersMode thread used to process timers. TimersMode::DISPATCHER_THREAD doesn't require an additional
+     *                   thread and executes timer handlers on the same thread as the rest of the events.
+     *                   TimersMode::SHARED_SERVICE is intended for applications with many dispatchers: all of them
+     *                   share a single timers thread.
      * @return New dispatcher instance.
      *
      * @threadsafe{Instance can be safely created and destroyed from any thread.}
      */
     // cppcheck-suppress misra-c2012-17.8 ; false positive. setting default parameter value is not parameter modification
-    static std::shared_ptr<HsmEventDispatcherSTD> create(const size_t eventsCacheSize = DISPATCHER_DEFAULT_EVENTS_CACHESIZE);
+    static std::shared_ptr<HsmEventDispatcherSTD> create(const size_t eventsCacheSize = DISPATCHER_DEFAULT_EVENTS_CACHESIZE,
+                                                         const TimersMode timersMode = TimersMode::SEPARATE_THREAD);
 
     /**
      * @brief See IHsmEventDispatcher::emitEvent()
@@ -68,11 +81,26 @@ public:
      */
     void join();
 
+    /**
+     * @brief Make dispatcher thread spin for a while before blocking when it runs out of events.
+     * @details Events emitted during this time are picked up without a context switch and without a syscall on the
+     * producer side. This reduces event latency at the cost of CPU time, so it's intended for low-latency deployments
+     * where dispatcher thread has a dedicated CPU core. Otherwise spinning steals CPU time from producers. Spinning is
+     * disabled by default.
+     *
+     * @param duration maximum time to spin. Zero disables spinning
+     *
+     * @notthreadsafe{Must be called before start().}
+     */
+    void setIdleSpinDuration(const std::chrono::microseconds& duration);
+
 protected:
     /**
-     * @copydoc HsmEventDispatcherBase::HsmEventDispatcherBase()
+     * @brief Constructor
+     * @param eventsCacheSize size of the queue preallocated for delayed events
+     * @param timersMode thread used to process timers
      */
-    explicit HsmEventDispatcherSTD(const size_t eventsCacheSize);
+    HsmEventDispatcherSTD(const size_t eventsCacheSize, const TimersMode timersMode);
 
     /**
      * @brief Destructor
@@ -96,21 +124,55 @@ protected:
      * @threadsafe{ }
      */
     void stopTimerImpl(const TimerID_t timerID) override;
+    /**
+     * @brief See HsmEventDispatcherBase::restartTimerImpl()
+     * @details Deadline of a running timer is postponed without waking up the thread which processes timers.
+     * @threadsafe{ }
+     */
+    void restartTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) override;
 
+    /**
+     * @brief Wake up dispatcher thread.
+     * @details Condition variable is notified only if dispatcher thread is blocked (or about to block) waiting for events.
+     * Otherwise it will see the new event on its own, so producers don't pay for a syscall.
+     */
     void notifyDispatcherAboutEvent() override;
     void doDispatching();
+    bool hasPendingWork() const;
+    void spinForEvents();
+    void waitForEvents(UniqueLock& lck, const HsmTimerQueue::TimePoint_t& nextDeadline);
 
     void notifyTimersThread();
     void handleTimers();
+    void processExpiredTimers();
+
+    /**
+     * @brief Called from HsmTimerService thread when timer expires. Used only with TimersMode::SHARED_SERVICE.
+     */
+    void onServiceTimerExpired(const TimerID_t timerID, const HsmTimerQueue::TimePoint_t& deadline);
+    void processServiceExpiredTimers();
 
 private:
+    const TimersMode mTimersMode;
     std::thread mDispatcherThread;
     std::thread mTimersThread;
     // NOTE: ideally it would be better to use a semaphore here, but there are no semaphores in C++11
     ConditionVariable mEmitEvent;
     ConditionVariable mTimerEvent;
-    bool mNotifiedTimersThread = false;
-    std::map<TimerID_t, RunningTimerInfo> mRunningTimers; // protected by mRunningTimersSync
+    // set by dispatcher thread under mEmitSync before it checks for events and waits for mEmitEvent. Producers check
+    // it after adding an event (see notifyDispatcherAboutEvent()), so wakeup can't be lost
+    std::atomic<bool> mIsWaitingForEvents;
+    std::chrono::microseconds mIdleSpinDuration = std::chrono::microseconds(0);
+    bool mNotifiedTimersThread = false;  // protected by mRunningTimersSync
+    bool mTimersUpdated = false;         // protected by mEmitSync. Used only with TimersMode::DISPATCHER_THREAD
+    HsmTimerQueue mRunningTimers;        // protected by mRunningTimersSync
+    // deadline thread which processes timers is currently sleeping until. protected by mRunningTimersSync
+    HsmTimerQueue::TimePoint_t mTimersThreadDeadline = HsmTimerQueue::TimePoint_t::max();
+    std::vector<HsmTimerQueue::Expiration_t> mExpiredTimers;  // used only by thread which processes timers
+    // members below are used only with TimersMode::SHARED_SERVICE
+    std::shared_ptr<HsmTimerService> mTimerService;
+    HandlerID_t mTimerServiceClientID = INVALID_HSM_DISPATCHER_HANDLER_ID;
+    std::vector<HsmTimerQueue::Expiration_t> mServiceExpiredTimers;  // protected by mEmitSync
 };
 
 }  // namespace hsmcpp
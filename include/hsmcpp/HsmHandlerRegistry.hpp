@@ -0,0 +1,481 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_HSMHANDLERREGISTRY_HPP
+#define HSMCPP_HSMHANDLERREGISTRY_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "HsmTypes.hpp"
+#include "os/LockGuard.hpp"
+#include "os/Mutex.hpp"
+
+namespace hsmcpp {
+
+/**
+ * @brief Registry of dispatcher handlers which can be read without locks and copies.
+ * @details Handlers are stored in a slot-indexed table. Handler ID encodes index of the slot and its generation, so
+ * lookup is O(1) and ID of a removed handler never matches a new handler which reuses the same slot.
+ *
+ * Readers use handlers inside a ReadGuard scope without taking any locks. Writers (add(), remove(), clear()) are
+ * serialized with a mutex, but never wait for readers: removed handlers (and tables replaced when registry grows) are
+ * retired and destroyed later, when all readers which could still see them have left their ReadGuard scope
+ * (epoch-based reclamation). This makes it safe to add or remove handlers from inside a handler which is being executed.
+ *
+ * Retired handlers are destroyed by the following writes or by collect().
+ *
+ * @tparam HandlerFunc_t handler callback type
+ *
+ * @threadsafe{All APIs are thread-safe.}
+ */
+template <typename HandlerFunc_t>
+class HsmHandlerRegistry {
+public:
+    /**
+     * @brief Scope in which pointers returned by find() stay valid.
+     * @details Entering and leaving the scope costs a few atomic operations. Scopes can be nested.
+     */
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const HsmHandlerRegistry& registry);
+        ~ReadGuard();
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+    private:
+        const HsmHandlerRegistry& mRegistry;
+        uint32_t mEpoch = 0;
+    };
+
+public:
+    HsmHandlerRegistry();
+    ~HsmHandlerRegistry();
+
+    HsmHandlerRegistry(const HsmHandlerRegistry&) = delete;
+    HsmHandlerRegistry& operator=(const HsmHandlerRegistry&) = delete;
+
+    /**
+     * @brief Add a new handler.
+     * @param handler handler callback
+     * @return unique handler ID or INVALID_HSM_DISPATCHER_HANDLER_ID if maximum number of handlers was reached
+     */
+    HandlerID_t add(const HandlerFunc_t& handler);
+
+    /**
+     * @brief Remove handler.
+     * @details Handler object is destroyed when it's not used by readers anymore.
+     *
+     * @param handlerID handler ID returned by add()
+     *
+     * @return true if handler was registered
+     */
+    bool remove(const HandlerID_t handlerID);
+
+    /**
+     * @brief Remove all handlers.
+     */
+    void clear();
+
+    /**
+     * @brief Find handler.
+     * @remark Must be called inside ReadGuard scope. Returned pointer is valid until the scope is left even if handler
+     * is removed in the meantime.
+     *
+     * @param handlerID handler ID returned by add()
+     *
+     * @return pointer to handler or nullptr if handler is not registered
+     */
+    const HandlerFunc_t* find(const HandlerID_t handlerID) const;
+
+    /**
+     * @brief Mark handler as scheduled for a call.
+     * @details Costs a single atomic exchange if handler is already scheduled. Used by dispatchers to queue each handler
+     * only once no matter how many times it was triggered before the call.
+     *
+     * @param handlerID handler ID returned by add()
+     *
+     * @return true if handler exists and was not scheduled before
+     */
+    bool trySchedule(const HandlerID_t handlerID);
+
+    /**
+     * @brief Find handler and clear its scheduled mark.
+     * @details Must be called right before calling the handler, so that it could be scheduled again while it's being
+     * executed.
+     * @remark Must be called inside ReadGuard scope. See find().
+     *
+     * @param handlerID handler ID returned by add()
+     *
+     * @return pointer to handler or nullptr if handler is not registered
+     */
+    const HandlerFunc_t* takeScheduled(const HandlerID_t handlerID);
+
+    /**
+     * @brief Destroy retired handlers which are not used by readers anymore.
+     * @details Doesn't block if there is nothing to destroy. Dispatchers are expected to call it after leaving
+     * ReadGuard scope.
+     */
+    void collect();
+
+private:
+    struct Record {
+        Record(const HandlerID_t newID, const HandlerFunc_t& newHandler);
+
+        HandlerID_t id = INVALID_HSM_DISPATCHER_HANDLER_ID;
+        HandlerFunc_t handler;
+        std::atomic<bool> scheduled;
+    };
+
+    struct Table {
+        explicit Table(const size_t newCapacity);
+
+        size_t capacity = 0;
+        std::unique_ptr<std::atomic<Record*>[]> slots;
+    };
+
+    struct RetiredObjects {
+        std::vector<Record*> records;
+        std::vector<Table*> tables;
+    };
+
+    // lower bits of handler ID store index of the slot (+1 to avoid 0 which is an invalid ID). Higher bits store
+    // generation of the slot. The highest bit is never used to keep IDs positive
+    static constexpr uint32_t SLOT_BITS = 20u;
+    static constexpr uint32_t SLOT_MASK = (1u << SLOT_BITS) - 1u;
+    static constexpr uint32_t GENERATION_MASK = (1u << (31u - SLOT_BITS)) - 1u;
+    static constexpr size_t MAX_SLOTS = SLOT_MASK - 1u;
+    static constexpr size_t INITIAL_CAPACITY = 16u;
+
+    Record* findRecord(const HandlerID_t handlerID) const;
+    void reserveSlot(const size_t slot);
+    void removeSlot(const size_t slot, Record* record);
+    void retire(Record* record);
+    void retire(Table* table);
+    void collectLocked(RetiredObjects& garbage);
+    static void destroy(RetiredObjects& garbage);
+
+private:
+    Mutex mWriteSync;
+    std::atomic<Table*> mTable;
+    // readers are counted separately for two consecutive epochs. Epoch is advanced only when there are no readers left
+    // from the previous one
+    mutable std::atomic<uint32_t> mEpoch;
+    mutable std::atomic<uint32_t> mReaders[2];
+    std::atomic<size_t> mRetiredCount;
+    RetiredObjects mRetired[2];      // objects retired during even and odd epochs. protected by mWriteSync
+    std::vector<uint32_t> mGenerations;  // generation of each used slot. protected by mWriteSync
+    std::vector<size_t> mFreeSlots;      // protected by mWriteSync
+};
+
+template <typename HandlerFunc_t>
+constexpr uint32_t HsmHandlerRegistry<HandlerFunc_t>::SLOT_BITS;
+template <typename HandlerFunc_t>
+constexpr uint32_t HsmHandlerRegistry<HandlerFunc_t>::SLOT_MASK;
+template <typename HandlerFunc_t>
+constexpr uint32_t HsmHandlerRegistry<HandlerFunc_t>::GENERATION_MASK;
+template <typename HandlerFunc_t>
+constexpr size_t HsmHandlerRegistry<HandlerFunc_t>::MAX_SLOTS;
+template <typename HandlerFunc_t>
+constexpr size_t HsmHandlerRegistry<HandlerFunc_t>::INITIAL_CAPACITY;
+
+// =================================================================================================================
+template <typename HandlerFunc_t>
+HsmHandlerRegistry<HandlerFunc_t>::ReadGuard::ReadGuard(const HsmHandlerRegistry& registry)
+    : mRegistry(registry) {
+    while (true) {
+        mEpoch = mRegistry.mEpoch.load();
+        (void)mRegistry.mReaders[mEpoch & 1u].fetch_add(1u);
+
+        // NOTE: if epoch was advanced in the meantime, writer could have missed this reader
+        if (mRegistry.mEpoch.load() == mEpoch) {
+            break;
+        }
+
+        (void)mRegistry.mReaders[mEpoch & 1u].fetch_sub(1u);
+    }
+}
+
+template <typename HandlerFunc_t>
+HsmHandlerRegistry<HandlerFunc_t>::ReadGuard::~ReadGuard() {
+    (void)mRegistry.mReaders[mEpoch & 1u].fetch_sub(1u, std::memory_order_release);
+}
+
+template <typename HandlerFunc_t>
+HsmHandlerRegistry<HandlerFunc_t>::Record::Record(const HandlerID_t newID, const HandlerFunc_t& newHandler)
+    : id(newID)
+    , handler(newHandler)
+    , scheduled(false) {}
+
+template <typename HandlerFunc_t>
+HsmHandlerRegistry<HandlerFunc_t>::Table::Table(const size_t newCapacity)
+    : capacity(newCapacity)
+    , slots(new std::atomic<Record*>[newCapacity]) {
+    for (size_t i = 0; i < capacity; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template <typename HandlerFunc_t>
+HsmHandlerRegistry<HandlerFunc_t>::HsmHandlerRegistry()
+    : mTable(nullptr)
+    , mEpoch(0u)
+    , mRetiredCount(0u) {
+    mReaders[0].store(0u);
+    mReaders[1].store(0u);
+}
+
+template <typename HandlerFunc_t>
+HsmHandlerRegistry<HandlerFunc_t>::~HsmHandlerRegistry() {
+    Table* table = mTable.load();
+
+    // NOTE: registry can't be used by anyone at this point
+    if (nullptr != table) {
+        for (size_t i = 0; i < table->capacity; ++i) {
+            delete table->slots[i].load();
+        }
+
+        delete table;
+    }
+
+    destroy(mRetired[0]);
+    destroy(mRetired[1]);
+}
+
+template <typename HandlerFunc_t>
+HandlerID_t HsmHandlerRegistry<HandlerFunc_t>::add(const HandlerFunc_t& handler) {
+    HandlerID_t id = INVALID_HSM_DISPATCHER_HANDLER_ID;
+    RetiredObjects garbage;
+
+    {
+        LockGuard lck(mWriteSync);
+        size_t slot = mGenerations.size();
+
+        if (false == mFreeSlots.empty()) {
+            slot = mFreeSlots.back();
+            mFreeSlots.pop_back();
+        } else if (mGenerations.size() < MAX_SLOTS) {
+            mGenerations.push_back(0u);
+            reserveSlot(slot);
+        } else {
+            // do nothing. registry is full
+        }
+
+        if (slot < mGenerations.size()) {
+            id = static_cast<HandlerID_t>((mGenerations[slot] << SLOT_BITS) | static_cast<uint32_t>(slot + 1u));
+            mTable.load(std::memory_order_relaxed)->slots[slot].store(new Record(id, handler), std::memory_order_release);
+        }
+
+        collectLocked(garbage);
+    }
+
+    destroy(garbage);
+
+    return id;
+}
+
+template <typename HandlerFunc_t>
+bool HsmHandlerRegistry<HandlerFunc_t>::remove(const HandlerID_t handlerID) {
+    bool wasRemoved = false;
+    RetiredObjects garbage;
+
+    {
+        LockGuard lck(mWriteSync);
+        const size_t slot = static_cast<size_t>(static_cast<uint32_t>(handlerID) & SLOT_MASK);
+
+        if ((handlerID > 0) && (slot > 0u) && (slot <= mGenerations.size())) {
+            Record* record = mTable.load(std::memory_order_relaxed)->slots[slot - 1u].load(std::memory_order_relaxed);
+
+            if ((nullptr != record) && (handlerID == record->id)) {
+                removeSlot(slot - 1u, record);
+                wasRemoved = true;
+            }
+        }
+
+        collectLocked(garbage);
+    }
+
+    // NOTE: handlers are destroyed without holding the lock because their destructors could access the registry
+    destroy(garbage);
+
+    return wasRemoved;
+}
+
+template <typename HandlerFunc_t>
+void HsmHandlerRegistry<HandlerFunc_t>::clear() {
+    RetiredObjects garbage;
+
+    {
+        LockGuard lck(mWriteSync);
+        Table* table = mTable.load(std::memory_order_relaxed);
+
+        for (size_t slot = 0; slot < mGenerations.size(); ++slot) {
+            Record* record = table->slots[slot].load(std::memory_order_relaxed);
+
+            if (nullptr != record) {
+                removeSlot(slot, record);
+            }
+        }
+
+        collectLocked(garbage);
+    }
+
+    destroy(garbage);
+}
+
+template <typename HandlerFunc_t>
+const HandlerFunc_t* HsmHandlerRegistry<HandlerFunc_t>::find(const HandlerID_t handlerID) const {
+    const HandlerFunc_t* handler = nullptr;
+    const Record* record = findRecord(handlerID);
+
+    if (nullptr != record) {
+        handler = &record->handler;
+    }
+
+    return handler;
+}
+
+template <typename HandlerFunc_t>
+bool HsmHandlerRegistry<HandlerFunc_t>::trySchedule(const HandlerID_t handlerID) {
+    bool wasScheduled = false;
+    ReadGuard readGuard(*this);
+    Record* record = findRecord(handlerID);
+
+    if (nullptr != record) {
+        wasScheduled = (false == record->scheduled.exchange(true));
+    }
+
+    return wasScheduled;
+}
+
+template <typename HandlerFunc_t>
+const HandlerFunc_t* HsmHandlerRegistry<HandlerFunc_t>::takeScheduled(const HandlerID_t handlerID) {
+    const HandlerFunc_t* handler = nullptr;
+    Record* record = findRecord(handlerID);
+
+    if (nullptr != record) {
+        // NOTE: exchange (instead of store) synchronizes with the thread which scheduled the handler
+        (void)record->scheduled.exchange(false);
+        handler = &record->handler;
+    }
+
+    return handler;
+}
+
+template <typename HandlerFunc_t>
+void HsmHandlerRegistry<HandlerFunc_t>::collect() {
+    if (mRetiredCount.load(std::memory_order_relaxed) > 0u) {
+        RetiredObjects garbage;
+
+        {
+            LockGuard lck(mWriteSync);
+            collectLocked(garbage);
+        }
+
+        destroy(garbage);
+    }
+}
+
+template <typename HandlerFunc_t>
+typename HsmHandlerRegistry<HandlerFunc_t>::Record* HsmHandlerRegistry<HandlerFunc_t>::findRecord(
+    const HandlerID_t handlerID) const {
+    Record* record = nullptr;
+    const Table* table = mTable.load(std::memory_order_acquire);
+    const size_t slot = static_cast<size_t>(static_cast<uint32_t>(handlerID) & SLOT_MASK);
+
+    if ((nullptr != table) && (handlerID > 0) && (slot > 0u) && (slot <= table->capacity)) {
+        record = table->slots[slot - 1u].load(std::memory_order_acquire);
+
+        // slot could be reused by a different handler
+        if ((nullptr != record) && (handlerID != record->id)) {
+            record = nullptr;
+        }
+    }
+
+    return record;
+}
+
+template <typename HandlerFunc_t>
+void HsmHandlerRegistry<HandlerFunc_t>::reserveSlot(const size_t slot) {
+    Table* table = mTable.load(std::memory_order_relaxed);
+
+    if ((nullptr == table) || (slot >= table->capacity)) {
+        // NOTE: readers could still use the old table, so the new one is created instead of resizing it
+        Table* newTable = new Table((nullptr != table) ? (table->capacity * 2u) : INITIAL_CAPACITY);
+
+        if (nullptr != table) {
+            for (size_t i = 0; i < table->capacity; ++i) {
+                newTable->slots[i].store(table->slots[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+
+            retire(table);
+        }
+
+        mTable.store(newTable, std::memory_order_release);
+    }
+}
+
+template <typename HandlerFunc_t>
+void HsmHandlerRegistry<HandlerFunc_t>::removeSlot(const size_t slot, Record* record) {
+    mTable.load(std::memory_order_relaxed)->slots[slot].store(nullptr, std::memory_order_release);
+    mGenerations[slot] = (mGenerations[slot] + 1u) & GENERATION_MASK;
+    mFreeSlots.push_back(slot);
+    retire(record);
+}
+
+template <typename HandlerFunc_t>
+void HsmHandlerRegistry<HandlerFunc_t>::retire(Record* record) {
+    mRetired[mEpoch.load() & 1u].records.push_back(record);
+    (void)mRetiredCount.fetch_add(1u, std::memory_order_relaxed);
+}
+
+template <typename HandlerFunc_t>
+void HsmHandlerRegistry<HandlerFunc_t>::retire(Table* table) {
+    mRetired[mEpoch.load() & 1u].tables.push_back(table);
+    (void)mRetiredCount.fetch_add(1u, std::memory_order_relaxed);
+}
+
+template <typename HandlerFunc_t>
+void HsmHandlerRegistry<HandlerFunc_t>::collectLocked(RetiredObjects& garbage) {
+    // NOTE: objects retired during epoch N can't be seen by readers which entered after epoch was advanced to N+1. So
+    //       they can be destroyed when epoch is advanced to N+2 since it requires all readers of epoch N to leave.
+    //       Two attempts are needed to destroy objects retired during the current epoch.
+    for (int i = 0; (i < 2) && (mRetiredCount.load(std::memory_order_relaxed) > 0u); ++i) {
+        const uint32_t epoch = mEpoch.load();
+        const uint32_t prevParity = (epoch + 1u) & 1u;
+
+        if (0u != mReaders[prevParity].load()) {
+            break;
+        }
+
+        RetiredObjects& retired = mRetired[prevParity];
+
+        (void)mRetiredCount.fetch_sub(retired.records.size() + retired.tables.size(), std::memory_order_relaxed);
+        garbage.records.insert(garbage.records.end(), retired.records.begin(), retired.records.end());
+        garbage.tables.insert(garbage.tables.end(), retired.tables.begin(), retired.tables.end());
+        retired.records.clear();
+        retired.tables.clear();
+        mEpoch.store(epoch + 1u);
+    }
+}
+
+template <typename HandlerFunc_t>
+void HsmHandlerRegistry<HandlerFunc_t>::destroy(RetiredObjects& garbage) {
+    for (Record* record : garbage.records) {
+        delete record;
+    }
+
+    for (Table* table : garbage.tables) {
+        delete table;
+    }
+
+    garbage.records.clear();
+    garbage.tables.clear();
+}
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_HSMHANDLERREGISTRY_HPP
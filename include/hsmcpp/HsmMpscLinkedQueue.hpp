@@ -0,0 +1,140 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_HSMMPSCLINKEDQUEUE_HPP
+#define HSMCPP_HSMMPSCLINKEDQUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+namespace hsmcpp {
+
+/**
+ * @brief Unbounded multi-producer/single-consumer queue which doesn't use locks.
+ * @details Linked list of nodes (D. Vyukov's non-intrusive MPSC queue). Producer adds a node with a single atomic
+ * exchange, so producers never retry and throughput doesn't collapse when multiple threads push at the same time.
+ * Consumer doesn't use any read-modify-write operations. Each element is allocated separately (same as std::list).
+ *
+ * @remark Queue is not linearizable: if producer is preempted between exchanging the head and linking its node,
+ * consumer won't see elements pushed after it until producer resumes. Producer must notify consumer only after push()
+ * returns.
+ *
+ * @tparam T type of elements. Must be default constructible and movable
+ *
+ * @threadsafe{push() can be called from any thread. pop() and empty() must not be called concurrently.}
+ */
+template <typename T>
+class HsmMpscLinkedQueue {
+public:
+    HsmMpscLinkedQueue();
+    ~HsmMpscLinkedQueue();
+
+    HsmMpscLinkedQueue(const HsmMpscLinkedQueue&) = delete;
+    HsmMpscLinkedQueue& operator=(const HsmMpscLinkedQueue&) = delete;
+
+    /**
+     * @brief Add element to the end of the queue.
+     * @param value element to add
+     */
+    void push(const T& value);
+
+    /**
+     * @copydoc push()
+     */
+    void push(T&& value);
+
+    /**
+     * @brief Take element from the beginning of the queue.
+     * @param value extracted element
+     * @return false if queue is empty
+     */
+    bool pop(T& value);
+
+    /**
+     * @brief Check if there are elements to pop.
+     * @remark Must be called only by consumer.
+     */
+    bool empty() const;
+
+private:
+    struct Node {
+        std::atomic<Node*> next;
+        T value;
+
+        Node()
+            : next(nullptr) {}
+
+        explicit Node(T&& newValue)
+            : next(nullptr)
+            , value(std::move(newValue)) {}
+    };
+
+    void pushNode(Node* node);
+
+private:
+    std::atomic<Node*> mHead;  // last added node. modified by producers
+    Node* mTail;               // already consumed node which points to the first element. used only by consumer
+};
+
+// =================================================================================================================
+template <typename T>
+HsmMpscLinkedQueue<T>::HsmMpscLinkedQueue()
+    : mHead(nullptr)
+    , mTail(new Node()) {
+    mHead.store(mTail, std::memory_order_relaxed);
+}
+
+template <typename T>
+HsmMpscLinkedQueue<T>::~HsmMpscLinkedQueue() {
+    T value;
+
+    while (true == pop(value)) {
+        // destroy remaining elements
+    }
+
+    delete mTail;
+}
+
+template <typename T>
+void HsmMpscLinkedQueue<T>::push(const T& value) {
+    T copy = value;
+
+    pushNode(new Node(std::move(copy)));
+}
+
+template <typename T>
+void HsmMpscLinkedQueue<T>::push(T&& value) {
+    pushNode(new Node(std::move(value)));
+}
+
+template <typename T>
+bool HsmMpscLinkedQueue<T>::pop(T& value) {
+    bool wasRemoved = false;
+    Node* next = mTail->next.load(std::memory_order_acquire);
+
+    if (nullptr != next) {
+        // NOTE: next node becomes the new consumed node. Its value is not needed anymore
+        value = std::move(next->value);
+        delete mTail;
+        mTail = next;
+        wasRemoved = true;
+    }
+
+    return wasRemoved;
+}
+
+template <typename T>
+bool HsmMpscLinkedQueue<T>::empty() const {
+    return (nullptr == mTail->next.load(std::memory_order_acquire));
+}
+
+template <typename T>
+void HsmMpscLinkedQueue<T>::pushNode(Node* node) {
+    Node* prev = mHead.exchange(node, std::memory_order_acq_rel);
+
+    prev->next.store(node, std::memory_order_release);
+}
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_HSMMPSCLINKEDQUEUE_HPP
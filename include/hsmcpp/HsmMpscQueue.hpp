@@ -0,0 +1,168 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_HSMMPSCQUEUE_HPP
+#define HSMCPP_HSMMPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace hsmcpp {
+
+/**
+ * @brief Bounded multi-producer/single-consumer queue which doesn't use locks.
+ * @details Based on a ring of cells where each cell has a sequence number which tells if it's ready to be written or
+ * read (D. Vyukov's bounded queue). Producers reserve a cell with a single CAS, consumer doesn't use any
+ * read-modify-write operations. Memory is allocated only once in constructor.
+ *
+ * @remark Queue is not wait-free: if producer is preempted between reserving and filling a cell, consumer won't see
+ * elements pushed after it until producer resumes.
+ *
+ * @tparam T type of elements. Must be default constructible and movable
+ *
+ * @threadsafe{push() can be called from any thread. pop() must be always called from the same thread.}
+ */
+template <typename T>
+class HsmMpscQueue {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity maximum number of elements. Rounded up to the nearest power of two
+     */
+    explicit HsmMpscQueue(const size_t capacity);
+    ~HsmMpscQueue() = default;
+
+    HsmMpscQueue(const HsmMpscQueue&) = delete;
+    HsmMpscQueue& operator=(const HsmMpscQueue&) = delete;
+
+    /**
+     * @brief Add element to the end of the queue.
+     * @param value element to add
+     * @return false if queue is full
+     */
+    bool push(const T& value);
+
+    /**
+     * @brief Take element from the beginning of the queue.
+     * @param value extracted element
+     * @return false if queue is empty
+     */
+    bool pop(T& value);
+
+    /**
+     * @brief Check if there are elements to pop.
+     * @remark Must be called only by consumer.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Maximum number of elements which queue can hold.
+     */
+    size_t capacity() const;
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    // NOTE: producers and consumer positions are kept on different cache lines to avoid false sharing
+    static constexpr size_t CACHE_LINE_SIZE = 64u;
+
+    static size_t roundUpCapacity(const size_t capacity);
+
+private:
+    const size_t mMask;
+    std::unique_ptr<Cell[]> mCells;
+    char mPaddingBefore[CACHE_LINE_SIZE];
+    std::atomic<size_t> mEnqueuePos;
+    char mPaddingAfter[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    size_t mDequeuePos = 0;  // used only by consumer
+};
+
+template <typename T>
+constexpr size_t HsmMpscQueue<T>::CACHE_LINE_SIZE;
+
+// =================================================================================================================
+template <typename T>
+HsmMpscQueue<T>::HsmMpscQueue(const size_t capacity)
+    : mMask(roundUpCapacity(capacity) - 1u)
+    , mCells(new Cell[roundUpCapacity(capacity)])
+    , mEnqueuePos(0u) {
+    for (size_t i = 0; i <= mMask; ++i) {
+        mCells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool HsmMpscQueue<T>::push(const T& value) {
+    bool wasAdded = false;
+    size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+
+    while (true) {
+        Cell& cell = mCells[pos & mMask];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+        if (0 == diff) {
+            // cell is free. try to reserve it
+            if (true == mEnqueuePos.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+                cell.value = value;
+                cell.sequence.store(pos + 1u, std::memory_order_release);
+                wasAdded = true;
+                break;
+            }
+        } else if (diff < 0) {
+            // cell still holds an element from the previous lap. queue is full
+            break;
+        } else {
+            // another producer reserved this cell
+            pos = mEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    return wasAdded;
+}
+
+template <typename T>
+bool HsmMpscQueue<T>::pop(T& value) {
+    bool wasRemoved = false;
+    Cell& cell = mCells[mDequeuePos & mMask];
+
+    if (cell.sequence.load(std::memory_order_acquire) == (mDequeuePos + 1u)) {
+        value = std::move(cell.value);
+        // make cell available for producers during the next lap
+        cell.sequence.store(mDequeuePos + mMask + 1u, std::memory_order_release);
+        ++mDequeuePos;
+        wasRemoved = true;
+    }
+
+    return wasRemoved;
+}
+
+template <typename T>
+bool HsmMpscQueue<T>::empty() const {
+    return mCells[mDequeuePos & mMask].sequence.load(std::memory_order_acquire) != (mDequeuePos + 1u);
+}
+
+template <typename T>
+size_t HsmMpscQueue<T>::capacity() const {
+    return mMask + 1u;
+}
+
+template <typename T>
+size_t HsmMpscQueue<T>::roundUpCapacity(const size_t capacity) {
+    size_t result = 2u;
+
+    while (result < capacity) {
+        result <<= 1u;
+    }
+
+    return result;
+}
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_HSMMPSCQUEUE_HPP
@@ -0,0 +1,189 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_HSMSEQLOCK_HPP
+#define HSMCPP_HSMSEQLOCK_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "os/CpuRelax.hpp"
+
+namespace hsmcpp {
+
+/**
+ * @brief Fixed size array which is published by a single writer and can be read by any number of threads without locks.
+ * @details Protected by a sequence lock: writer makes sequence number odd before modifying the array and even again
+ * when it's done. Reader copies the array and repeats the copy if sequence number was odd or changed in the meantime.
+ * Readers never write to shared memory, so they don't slow down the writer or each other. Elements are stored as
+ * relaxed atomics to keep concurrent copying well defined.
+ *
+ * Array keeps number of elements which were published even if it's bigger than Capacity. Only the first Capacity
+ * elements are stored.
+ *
+ * @remark Readers spin while writer is modifying the array. Writer is not blocked by readers.
+ *
+ * @tparam T type of elements. Must be trivially copyable and small enough for std::atomic<T> to be lock-free
+ * @tparam Capacity maximum number of stored elements
+ *
+ * @threadsafe{publish() must be always called from the same thread. read() and version() can be called from any thread.}
+ */
+template <typename T, size_t Capacity>
+class HsmSeqLockArray {
+    static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+    static_assert(Capacity > 0u, "Capacity must not be zero");
+
+public:
+    using Version_t = uint32_t;
+
+public:
+    HsmSeqLockArray();
+    ~HsmSeqLockArray() = default;
+
+    HsmSeqLockArray(const HsmSeqLockArray&) = delete;
+    HsmSeqLockArray& operator=(const HsmSeqLockArray&) = delete;
+
+    /**
+     * @brief Replace content of the array with elements from [first, last) range.
+     * @details Nothing is published (and version is not changed) if new elements are the same as the current ones.
+     * @remark Must be called only by writer.
+     *
+     * @tparam ForwardIt forward iterator type
+     * @param first beginning of the range
+     * @param last end of the range
+     * @return true if new elements were published
+     */
+    template <typename ForwardIt>
+    bool publish(const ForwardIt first, const ForwardIt last);
+
+    /**
+     * @brief Copy consistent content of the array.
+     *
+     * @param outValues buffer for elements. Must be able to hold Capacity elements
+     * @param outCount number of published elements. Only min(outCount, Capacity) elements are copied to outValues
+     * @return version of the copied content
+     */
+    Version_t read(T* outValues, size_t& outCount) const;
+
+    /**
+     * @brief Number of publications done so far.
+     * @details Can be used to cheaply check if content changed since the last read(). Wraps around on overflow.
+     */
+    Version_t version() const;
+
+    /**
+     * @brief Maximum number of stored elements.
+     */
+    static constexpr size_t capacity();
+
+private:
+    template <typename ForwardIt>
+    bool isSame(ForwardIt first, const ForwardIt last) const;
+
+private:
+    std::atomic<Version_t> mSequence;  // odd while writer is modifying the array
+    std::atomic<size_t> mCount;
+    std::atomic<T> mValues[Capacity];
+};
+
+// =================================================================================================================
+template <typename T, size_t Capacity>
+HsmSeqLockArray<T, Capacity>::HsmSeqLockArray()
+    : mSequence(0u)
+    , mCount(0u) {
+    for (std::atomic<T>& value : mValues) {
+        value.store(T(), std::memory_order_relaxed);
+    }
+}
+
+template <typename T, size_t Capacity>
+template <typename ForwardIt>
+bool HsmSeqLockArray<T, Capacity>::publish(const ForwardIt first, const ForwardIt last) {
+    bool wasPublished = false;
+
+    if (false == isSame(first, last)) {
+        const Version_t sequence = mSequence.load(std::memory_order_relaxed);
+        size_t count = 0u;
+
+        mSequence.store(sequence + 1u, std::memory_order_relaxed);
+        // NOTE: prevents stores to the array from being reordered before sequence becomes odd
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (ForwardIt it = first; it != last; ++it) {
+            if (count < Capacity) {
+                mValues[count].store(*it, std::memory_order_relaxed);
+            }
+
+            ++count;
+        }
+
+        mCount.store(count, std::memory_order_relaxed);
+        mSequence.store(sequence + 2u, std::memory_order_release);
+        wasPublished = true;
+    }
+
+    return wasPublished;
+}
+
+template <typename T, size_t Capacity>
+typename HsmSeqLockArray<T, Capacity>::Version_t HsmSeqLockArray<T, Capacity>::read(T* outValues, size_t& outCount) const {
+    Version_t sequence = 0u;
+
+    while (true) {
+        sequence = mSequence.load(std::memory_order_acquire);
+
+        if (0u == (sequence & 1u)) {
+            const size_t count = mCount.load(std::memory_order_relaxed);
+            const size_t copyCount = ((count < Capacity) ? count : Capacity);
+
+            for (size_t i = 0u; i < copyCount; ++i) {
+                outValues[i] = mValues[i].load(std::memory_order_relaxed);
+            }
+
+            // NOTE: prevents loads from the array from being reordered after the second check of the sequence
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (mSequence.load(std::memory_order_relaxed) == sequence) {
+                outCount = count;
+                break;
+            }
+        }
+
+        cpuRelax();
+    }
+
+    return sequence / 2u;
+}
+
+template <typename T, size_t Capacity>
+typename HsmSeqLockArray<T, Capacity>::Version_t HsmSeqLockArray<T, Capacity>::version() const {
+    return mSequence.load(std::memory_order_acquire) / 2u;
+}
+
+template <typename T, size_t Capacity>
+constexpr size_t HsmSeqLockArray<T, Capacity>::capacity() {
+    return Capacity;
+}
+
+template <typename T, size_t Capacity>
+template <typename ForwardIt>
+bool HsmSeqLockArray<T, Capacity>::isSame(ForwardIt first, const ForwardIt last) const {
+    // NOTE: only writer modifies the array, so it can be accessed without checking the sequence. Elements which
+    //       didn't fit into the array can't be compared, so such content is always treated as changed
+    const size_t count = mCount.load(std::memory_order_relaxed);
+    size_t i = 0u;
+    bool same = true;
+
+    for (; (first != last) && (true == same); ++first) {
+        same = (i < count) && (i < Capacity) && (mValues[i].load(std::memory_order_relaxed) == *first);
+        ++i;
+    }
+
+    return (true == same) && (i == count);
+}
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_HSMSEQLOCK_HPP
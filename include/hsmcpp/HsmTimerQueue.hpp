@@ -0,0 +1,172 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_HSMTIMERQUEUE_HPP
+#define HSMCPP_HSMTIMERQUEUE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "HsmTypes.hpp"
+
+namespace hsmcpp {
+
+/**
+ * @brief Priority queue of running timers ordered by their deadlines.
+ * @details Implemented as an indexed binary min-heap: position of each timer in the heap is tracked, so start, restart
+ * and stop operations are O(log n) and getting the earliest deadline is O(1). Timers with equal deadlines are returned
+ * in the order they were scheduled.
+ *
+ * Deadline of a scheduled timer can also be moved forward lazily with postpone() in O(1). Such timers keep their old
+ * position in the heap until the old deadline is reached and are moved to the new position by popExpired().
+ *
+ * Used by dispatchers which manage timers on their own (see HsmEventDispatcherSTD).
+ *
+ * @notthreadsafe{Access must be synchronized by the owner.}
+ */
+class HsmTimerQueue {
+public:
+    using Clock_t = std::chrono::steady_clock;
+    using TimePoint_t = Clock_t::time_point;
+    using Expiration_t = std::pair<TimerID_t, TimePoint_t>;  ///< expired timer ID and deadline it was scheduled for
+
+public:
+    HsmTimerQueue() = default;
+    ~HsmTimerQueue() = default;
+
+    /**
+     * @brief Add timer to the queue or update deadline of already scheduled timer.
+     *
+     * @param timerID   timer ID
+     * @param deadline  time when timer should expire
+     */
+    void schedule(const TimerID_t timerID, const TimePoint_t& deadline);
+
+    /**
+     * @brief Remove timer from the queue.
+     *
+     * @param timerID timer ID
+     *
+     * @return true if timer was in the queue
+     */
+    bool remove(const TimerID_t timerID);
+
+    /**
+     * @brief Check if timer is scheduled.
+     *
+     * @param timerID timer ID
+     */
+    bool contains(const TimerID_t timerID) const;
+
+    /**
+     * @brief Get ID of the timer with the earliest deadline.
+     * @return timer ID or INVALID_HSM_TIMER_ID if queue is empty
+     */
+    TimerID_t top() const;
+
+    /**
+     * @brief Get the earliest deadline.
+     * @return deadline of top() timer or TimePoint_t::max() if queue is empty
+     */
+    TimePoint_t topDeadline() const;
+
+    /**
+     * @brief Remove timer with the earliest deadline from the queue.
+     */
+    void pop();
+
+    /**
+     * @brief Lazily move deadline of a scheduled timer to a later time.
+     * @details Heap is not modified: new deadline is only stored and will be applied when the current deadline is
+     * reached. Until then topDeadline() can return a deadline which is earlier than the real one, so owner of the queue
+     * will wake up once at the old deadline and let popExpired() reconcile the timer.
+     *
+     * @param timerID       timer ID
+     * @param newDeadline   time when timer should expire
+     *
+     * @retval true deadline was postponed
+     * @retval false timer is not scheduled or newDeadline is earlier than its current deadline. schedule() must be
+     *         used in this case
+     */
+    bool postpone(const TimerID_t timerID, const TimePoint_t& newDeadline);
+
+    /**
+     * @brief Remove timer with the earliest deadline if it has expired.
+     * @details Postponed timers which reached their old deadline are moved to their new position instead of being
+     * returned.
+     *
+     * @param now           current time
+     * @param expiration    [out] ID and deadline of expired timer
+     *
+     * @retval true expired timer was removed from the queue
+     * @retval false there are no expired timers
+     */
+    bool popExpired(const TimePoint_t& now, Expiration_t& expiration);
+
+    /**
+     * @brief Remove all timers.
+     */
+    void clear();
+
+    bool empty() const;
+    size_t size() const;
+
+    /**
+     * @brief Calculate deadline for a coarse timer.
+     * @details Moves deadline forward to the nearest point of a grid which is shared by all timers with similar slack.
+     * Grid step is the largest power of two (in milliseconds) which doesn't exceed slackMs. This way timers with nearby
+     * deadlines expire at exactly the same moment and can be processed during a single wakeup.
+     *
+     * @param deadline  requested deadline
+     * @param slackMs   maximum allowed delay in milliseconds
+     *
+     * @return deadline in range [deadline, deadline + slackMs)
+     */
+    static TimePoint_t alignDeadline(const TimePoint_t& deadline, const unsigned int slackMs);
+
+    /**
+     * @brief Calculate the next deadline of a repeating timer.
+     * @details Next deadline is calculated from the previous one (not from the time when timer was processed), so
+     * periodic timers don't drift. If timer is late by more than one period, result depends on the policy:
+     *   \li MissedTicksPolicy::FIRE_ALL - deadline + period (could be in the past, so timer will expire immediately)
+     *   \li MissedTicksPolicy::FIRE_ONCE - now + period
+     *   \li MissedTicksPolicy::SKIP - the first deadline of the original schedule which is after now
+     *
+     * @param deadline  deadline at which timer expired
+     * @param periodUs  timer interval in microseconds
+     * @param now       time when timer was processed
+     * @param policy    missed ticks policy
+     *
+     * @return next deadline of the timer
+     */
+    static TimePoint_t getNextDeadline(const TimePoint_t& deadline,
+                                       const uint64_t periodUs,
+                                       const TimePoint_t& now,
+                                       const MissedTicksPolicy policy);
+
+private:
+    struct Entry {
+        TimePoint_t deadline;
+        TimePoint_t postponedDeadline;  ///< deadline set by postpone() which is not applied to the heap yet
+        uint64_t sequence = 0;  ///< used to keep FIFO order for timers with equal deadlines
+        TimerID_t timerID = INVALID_HSM_TIMER_ID;
+    };
+
+    bool isEarlier(const size_t left, const size_t right) const;
+    void swapEntries(const size_t left, const size_t right);
+    void removeAt(const size_t index);
+    size_t siftUp(size_t index);
+    void siftDown(size_t index);
+
+private:
+    std::vector<Entry> mHeap;
+    std::unordered_map<TimerID_t, size_t> mPositions;  // timer ID => index in mHeap
+    uint64_t mNextSequence = 0;
+};
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_HSMTIMERQUEUE_HPP
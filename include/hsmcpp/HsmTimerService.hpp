@@ -0,0 +1,152 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_HSMTIMERSERVICE_HPP
+#define HSMCPP_HSMTIMERSERVICE_HPP
+
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "HsmTimerQueue.hpp"
+#include "os/ConditionVariable.hpp"
+#include "os/Mutex.hpp"
+
+namespace hsmcpp {
+
+/**
+ * @brief Callback used by HsmTimerService to notify client about expired timer.
+ * @details Called from timer service thread. Implementation is expected to only post expiration to the client's own
+ * queue and return as soon as possible: all clients of the service share the same thread.
+ *
+ * @param timerID   ID of the expired timer
+ * @param deadline  deadline at which timer was scheduled to expire. Can be used to reschedule repeating timers
+ *                  without drift
+ */
+using ExpiredTimerHandlerFunc_t = std::function<void(const TimerID_t, const HsmTimerQueue::TimePoint_t&)>;
+
+/**
+ * @brief HsmTimerService processes timers of multiple dispatchers using a single thread.
+ * @details Every dispatcher normally needs its own thread (or OS timer) to wait for timer deadlines. When application
+ * has many dispatchers most of these threads are idle. Timer service keeps timers of all its clients in a single
+ * HsmTimerQueue and uses one thread to wait for the earliest deadline. When timer expires, service notifies the client
+ * which owns it and client is responsible to process expiration in its own thread.
+ *
+ * Timer IDs are unique only within a client, so different clients can use the same IDs.
+ *
+ * Service thread is started with the first scheduled timer and stopped when service is destroyed.
+ *
+ * @threadsafe{All APIs are thread-safe.}
+ */
+class HsmTimerService {
+public:
+    using TimePoint_t = HsmTimerQueue::TimePoint_t;
+
+public:
+    /**
+     * @brief Returns process-wide timer service instance.
+     * @details Instance is created on the first call and destroyed when the last user releases it.
+     */
+    static std::shared_ptr<HsmTimerService> getInstance();
+
+    /**
+     * @brief Create a new timer service which is not shared with the rest of the process.
+     */
+    static std::shared_ptr<HsmTimerService> create();
+
+    /**
+     * @brief Destructor
+     * @details Stops service thread. All timers are dropped without notifying clients.
+     */
+    ~HsmTimerService();
+
+    /**
+     * @brief Register a new client.
+     * @param handler callback which will be called from service thread when client's timer expires
+     * @return client ID which must be used with the rest of the APIs
+     */
+    HandlerID_t registerClient(const ExpiredTimerHandlerFunc_t& handler);
+
+    /**
+     * @brief Unregister client and cancel all its timers.
+     * @details If client's handler is being executed at the moment, function blocks until it's finished. After
+     * function returns handler is guaranteed to not be called anymore.
+     *
+     * @remark Must not be called from ExpiredTimerHandlerFunc_t callback.
+     *
+     * @param clientID client ID returned by registerClient()
+     */
+    void unregisterClient(const HandlerID_t clientID);
+
+    /**
+     * @brief Schedule timer or update deadline of already scheduled timer.
+     *
+     * @param clientID  client ID returned by registerClient()
+     * @param timerID   client's timer ID
+     * @param deadline  time when timer should expire
+     */
+    void schedule(const HandlerID_t clientID, const TimerID_t timerID, const TimePoint_t& deadline);
+
+    /**
+     * @brief Cancel scheduled timer.
+     *
+     * @param clientID  client ID returned by registerClient()
+     * @param timerID   client's timer ID
+     *
+     * @return true if timer was scheduled
+     */
+    bool cancel(const HandlerID_t clientID, const TimerID_t timerID);
+
+    /**
+     * @brief Check if timer is scheduled and didn't expire yet.
+     *
+     * @param clientID  client ID returned by registerClient()
+     * @param timerID   client's timer ID
+     */
+    bool isScheduled(const HandlerID_t clientID, const TimerID_t timerID);
+
+    /**
+     * @brief Returns number of scheduled timers of all clients.
+     */
+    size_t getTimersCount();
+
+private:
+    using TimerKey_t = std::pair<HandlerID_t, TimerID_t>;
+    using ExpiredTimer_t = std::pair<TimerKey_t, TimePoint_t>;
+
+    HsmTimerService() = default;
+
+    static uint64_t packKey(const HandlerID_t clientID, const TimerID_t timerID);
+    TimerID_t allocateTimerID();
+    void removeTimer(const TimerID_t serviceTimerID);
+    void notifyServiceThread();
+    void handleTimers();
+    void processExpiredTimers();
+
+private:
+    std::thread mServiceThread;
+    Mutex mSync;
+    // NOTE: held while clients handlers are called. Used to make sure that handler is not called after client was
+    //       unregistered. Must be always locked before mSync
+    Mutex mHandlersSync;
+    ConditionVariable mTimerEvent;
+    bool mStopService = false;                                        // protected by mSync
+    bool mNotifiedServiceThread = false;                              // protected by mSync
+    HandlerID_t mNextClientID = 1;                                    // protected by mSync
+    TimerID_t mNextTimerID = 1;                                       // protected by mSync
+    std::unordered_map<HandlerID_t, ExpiredTimerHandlerFunc_t> mClients;  // protected by mSync
+    // timers of all clients use service-wide IDs in mRunningTimers
+    HsmTimerQueue mRunningTimers;                                // protected by mSync
+    std::unordered_map<uint64_t, TimerID_t> mServiceTimerIDs;   // client timer => service timer ID. protected by mSync
+    std::unordered_map<TimerID_t, TimerKey_t> mClientTimers;     // service timer ID => client timer. protected by mSync
+    // deadline service thread is currently sleeping until. protected by mSync
+    TimePoint_t mServiceThreadDeadline = TimePoint_t::max();
+    std::vector<ExpiredTimer_t> mExpiredTimers;  // used only by service thread
+};
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_HSMTIMERSERVICE_HPP
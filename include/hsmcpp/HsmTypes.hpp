@@ -8,7 +8,10 @@
 #ifndef HSMCPP_HSMTYPES_HPP
 #define HSMCPP_HSMTYPES_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <utility>
 
 #include "variant.hpp"
 
@@ -35,6 +38,41 @@ constexpr hsmcpp::TimerID_t INVALID_HSM_TIMER_ID = static_cast<hsmcpp::TimerID_t
 /** Invalid dispatcher handler ID. Used in relation with HandlerID_t type. */
 constexpr hsmcpp::HandlerID_t INVALID_HSM_DISPATCHER_HANDLER_ID = 0;
 
+/** Bitmask of file descriptor readiness conditions. Used with IHsmEventDispatcher::watchFd() and similar API. */
+using FdEvents_t = uint8_t;
+/** File descriptor has data available for reading. */
+constexpr hsmcpp::FdEvents_t HSM_FD_READABLE = 0x01U;
+/** File descriptor can be written without blocking. */
+constexpr hsmcpp::FdEvents_t HSM_FD_WRITABLE = 0x02U;
+/** Error condition or hang-up happened on file descriptor. Is always reported, even if it wasn't requested. */
+constexpr hsmcpp::FdEvents_t HSM_FD_ERROR = 0x04U;
+
+/**
+ * @enum HsmEventStatus
+ * @brief Result of processing an event by HierarchicalStateMachine.
+ */
+enum class HsmEventStatus {
+    PENDING,      ///< event is waiting in the queue or is being processed
+    DONE_OK,      ///< event was processed and caused a transition
+    DONE_FAILED,  ///< no matching transitions were found or event was removed from the queue before it was processed
+    CANCELED      ///< transition was canceled by an exit or enter callback
+};
+
+/** Maximum number of states stored in ActiveStatesSnapshot. */
+constexpr size_t HSM_ACTIVE_STATES_SNAPSHOT_CAPACITY = 16U;
+
+/**
+ * @struct ActiveStatesSnapshot
+ * @brief Consistent copy of HSM active states which can be obtained from any thread.
+ * @details See HierarchicalStateMachine::getActiveStatesSnapshot().
+ */
+struct ActiveStatesSnapshot {
+    uint32_t version = 0;  ///< incremented every time active states change. Wraps around on overflow
+    /** number of active states. If it's bigger than HSM_ACTIVE_STATES_SNAPSHOT_CAPACITY only the first states are stored */
+    size_t count = 0;
+    StateID_t states[HSM_ACTIVE_STATES_SNAPSHOT_CAPACITY] = {};  ///< active states in the same order as getActiveStates()
+};
+
 /**
  * Function type for HierarchicalStateMachine transition callbacks.
  *
@@ -75,6 +113,97 @@ using HsmStateExitCallback_t = std::function<bool(void)>;
  * @param VariantVector_t \c args value provided in HierarchicalStateMachine::transition() or similar API
  */
 using HsmTransitionFailedCallback_t = std::function<void(const std::list<StateID_t>&, const EventID_t, const VariantVector_t&)>;
+/**
+ * Function type for notifications about completion of event processing. Called exactly once for each event. For events
+ * which cause transitions into states with substates it's called after all entry point transitions were finished.
+ *
+ * @param HsmEventStatus result of processing the event. Never HsmEventStatus::PENDING
+ */
+using HsmTransitionDoneCallback_t = std::function<void(const HsmEventStatus)>;
+
+/**
+ * User context of HSM instance (see HierarchicalStateMachine::setUserContext()).
+ */
+struct HsmUserContext {
+    void* object;      ///< object for which class member callbacks are executed. nullptr to use original handlers
+    const void* type;  ///< type tag of the object (see hsmTypeTag())
+};
+
+/**
+ * Returns unique tag of a type. Used to validate user context in debug builds.
+ *
+ * @tparam T any type
+ * @return address which is unique for each type
+ */
+template <class T>
+const void* hsmTypeTag() {
+    static const char tag = 0;
+    return &tag;
+}
+
+/**
+ * @brief Context-aware callback. Used to store callbacks inside HsmDefinition which could be shared between multiple
+ * HierarchicalStateMachine instances.
+ * @details Holds either a regular callback, which ignores user context, or a callback which receives user context of
+ * the HSM instance which executes it (used for class member callbacks). Regular callbacks are stored as is without any
+ * extra wrapping.
+ *
+ * @tparam Ret return type of the callback
+ * @tparam Args arguments of the callback
+ */
+template <typename Ret, typename... Args>
+class HsmContextCallback {
+public:
+    using Callback_t = std::function<Ret(Args...)>;
+    using ContextCallback_t = std::function<Ret(const HsmUserContext&, Args...)>;
+
+public:
+    HsmContextCallback() = default;
+    // NOLINTNEXTLINE(google-explicit-constructor): allows to use "= nullptr" like with std::function
+    HsmContextCallback(std::nullptr_t);
+    // NOLINTNEXTLINE(google-explicit-constructor): regular callbacks are converted implicitly
+    HsmContextCallback(Callback_t callback);
+    explicit HsmContextCallback(ContextCallback_t callback);
+
+    /**
+     * @brief Checks if callback is set.
+     */
+    explicit operator bool() const;
+
+    /**
+     * @brief Executes callback.
+     * @remark Callback must be set.
+     *
+     * @param context user context of the HSM instance
+     * @param args callback arguments
+     */
+    Ret operator()(const HsmUserContext& context, Args... args) const;
+
+private:
+    Callback_t mCallback;
+    ContextCallback_t mContextCallback;
+};
+
+/**
+ * Context-aware version of HsmTransitionCallback_t. See HsmContextCallback for details.
+ */
+using HsmContextTransitionCallback_t = HsmContextCallback<void, const VariantVector_t&>;
+/**
+ * Context-aware version of HsmTransitionConditionCallback_t. See HsmContextCallback for details.
+ */
+using HsmContextTransitionConditionCallback_t = HsmContextCallback<bool, const VariantVector_t&>;
+/**
+ * Context-aware version of HsmStateChangedCallback_t. See HsmContextCallback for details.
+ */
+using HsmContextStateChangedCallback_t = HsmContextCallback<void, const VariantVector_t&>;
+/**
+ * Context-aware version of HsmStateEnterCallback_t. See HsmContextCallback for details.
+ */
+using HsmContextStateEnterCallback_t = HsmContextCallback<bool, const VariantVector_t&>;
+/**
+ * Context-aware version of HsmStateExitCallback_t. See HsmContextCallback for details.
+ */
+using HsmContextStateExitCallback_t = HsmContextCallback<bool>;
 
 // cppcheck-suppress misra-c2012-20.7 ; enclosing input expressions in parentheses is not needed (and will not compile)
 #define HsmTransitionCallbackPtr_t(_class, _func) void (_class::*_func)(const VariantVector_t&)
@@ -118,6 +247,18 @@ enum class StateActionTrigger {
     ON_STATE_EXIT    ///< trigger action on state exit
 };
 
+/**
+ * @enum MissedTicksPolicy
+ * @brief Defines how repeating timers behave when dispatcher couldn't process them in time.
+ * @details Repeating timers are rescheduled based on their previous deadline, so processing delays don't accumulate.
+ * If dispatcher falls behind by more than one period, the policy decides what to do with missed expirations.
+ */
+enum class MissedTicksPolicy {
+    FIRE_ALL,   ///< all missed expirations are delivered one after another until timer catches up with its schedule
+    FIRE_ONCE,  ///< missed expirations are delivered as a single one and schedule is shifted to start from current time
+    SKIP        ///< missed expirations are delivered as a single one and timer stays aligned to its original schedule
+};
+
 /**
  * @enum StateAction
  * @brief Defines the type of state action (see @rstref{features-states-actions} for details).
@@ -132,6 +273,41 @@ enum class StateAction {
     TRANSITION,     ///< **Arguments**: EventID_t eventID
 };
 
+// =================================================================================================================
+// Template Functions
+// =================================================================================================================
+template <typename Ret, typename... Args>
+HsmContextCallback<Ret, Args...>::HsmContextCallback(std::nullptr_t) {}
+
+template <typename Ret, typename... Args>
+HsmContextCallback<Ret, Args...>::HsmContextCallback(Callback_t callback)
+    : mCallback(std::move(callback)) {}
+
+template <typename Ret, typename... Args>
+HsmContextCallback<Ret, Args...>::HsmContextCallback(ContextCallback_t callback)
+    : mContextCallback(std::move(callback)) {}
+
+template <typename Ret, typename... Args>
+HsmContextCallback<Ret, Args...>::operator bool() const {
+    return (static_cast<bool>(mCallback) || static_cast<bool>(mContextCallback));
+}
+
+template <typename Ret, typename... Args>
+Ret HsmContextCallback<Ret, Args...>::operator()(const HsmUserContext& context, Args... args) const {
+    // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::function has a bool() operator
+    return (mCallback ? mCallback(args...) : mContextCallback(context, args...));
+}
+
+template <typename Ret, typename... Args>
+bool operator==(const HsmContextCallback<Ret, Args...>& callback, std::nullptr_t) {
+    return (false == static_cast<bool>(callback));
+}
+
+template <typename Ret, typename... Args>
+bool operator==(std::nullptr_t, const HsmContextCallback<Ret, Args...>& callback) {
+    return (false == static_cast<bool>(callback));
+}
+
 }  // namespace hsmcpp
 
 #endif  // HSMCPP_HSMTYPES_HPP
\ No newline at end of file
@@ -5,6 +5,11 @@
 #define HSMCPP_IHSMEVENTDISPATCHER_HPP
 
 #include "HsmTypes.hpp"
+#include "os/os.hpp"
+
+#if defined(STL_AVAILABLE)
+  #include <chrono>
+#endif
 
 namespace hsmcpp {
 /**
@@ -42,6 +47,18 @@ using EnqueuedEventHandlerFunc_t = std::function<bool(const EventID_t)>;
  */
 using ActionHandlerFunc_t = std::function<void()>;
 
+/**
+ * @brief File descriptor watch handler callback.
+ * @details When using class members, developers are responsible to track corresponding object's lifetime. Clients can notify
+ * dispatcher that callback became invalid by returning FALSE. In this case file descriptor will stop being watched.
+ *
+ * @param fd      file descriptor which became ready
+ * @param events  bitmask of conditions which triggered the callback (HSM_FD_READABLE, HSM_FD_WRITABLE, HSM_FD_ERROR)
+ * @retval true handler's callback can be used further
+ * @retval false handler's callback is invalid and file descriptor should not be watched anymore
+ */
+using FdWatchHandlerFunc_t = std::function<bool(const int, const FdEvents_t)>;
+
 /**
  * @brief IHsmEventDispatcher provides an interface for events dispatcher implementations.
  * @details The IHsmEventDispatcher class defines the standard dispatcher interface that HSM uses to process internal events. It
@@ -61,10 +78,17 @@ using ActionHandlerFunc_t = std::function<void()>;
  *  \li stopTimer()
  *  \li isTimerRunning()
  *
+ * Coarse timers are optional. Dispatchers which can reduce wakeups by aligning timers should override
+ * startTimerWithSlack().
+ *
  * For interrupt-safe transitions you need to implement:
  *  \li registerEnqueuedEventHandler()
  *  \li unregisterEnqueuedEventHandler()
  *  \li enqueueEvent()
+ *
+ * File descriptors watching is optional and is supported only by dispatchers which override:
+ *  \li watchFd()
+ *  \li unwatchFd()
  */
 class IHsmEventDispatcher {
 public:
@@ -138,6 +162,8 @@ public:
     /**
      * @brief Add a new event to the queue for later dispatching.
      * @details Dispatcher should initiate processing of the new event as soon as possible.
+     * @remark Dispatcher is allowed to coalesce multiple events emitted for the same handler into a single call of this
+     * handler. Handlers must process all their pending work or emit a new event if they can't.
      *
      * @param handlerID id of the handler that should process the event
      *
@@ -193,10 +219,11 @@ public:
 
     /**
      * @brief Start a timer.
-     * @details If timer with this ID is already running it will be restarted with new settings.
+     * @details If timer with this ID is already running for handlerID it will be restarted with new settings. Different
+     * handlers can use the same timer IDs, so multiple state machines can share a dispatcher.
      *
      * @param handlerID     handler id for wich to start the timer (returned from registerTimerHandler())
-     * @param timerID       unique timer id
+     * @param timerID       timer id. Must be unique only within handlerID
      * @param intervalMs    timer interval in milliseconds
      * @param isSingleShot  true - timer will run only once and then will stop
      *                      false - timer will keep running until stopTimer() is called or dispatcher is destroyed
@@ -208,18 +235,114 @@ public:
                             const unsigned int intervalMs,
                             const bool isSingleShot) = 0;
 
+    /**
+     * @brief Start a timer with microseconds resolution.
+     * @details Same as startTimer(), but interval is provided in microseconds. Actual precision depends on the platform
+     * and dispatcher implementation.
+     *
+     * Default implementation rounds interval up to milliseconds and calls startTimer().
+     *
+     * @param handlerID     handler id for wich to start the timer (returned from registerTimerHandler())
+     * @param timerID       timer id. Must be unique only within handlerID
+     * @param intervalUs    timer interval in microseconds
+     * @param isSingleShot  true - timer will run only once and then will stop
+     *                      false - timer will keep running until stopTimer() is called or dispatcher is destroyed
+     *
+     * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
+     */
+    virtual void startTimerUs(const HandlerID_t handlerID,
+                              const TimerID_t timerID,
+                              const uint64_t intervalUs,
+                              const bool isSingleShot) {
+        startTimer(handlerID, timerID, static_cast<unsigned int>((intervalUs + 999u) / 1000u), isSingleShot);
+    }
+
+#if defined(STL_AVAILABLE)
+    /**
+     * @brief Start a timer using std::chrono duration.
+     * @details Convenience wrapper for startTimerUs(). Interval is rounded up to microseconds.
+     *
+     * @param handlerID     handler id for wich to start the timer (returned from registerTimerHandler())
+     * @param timerID       timer id. Must be unique only within handlerID
+     * @param interval      timer interval
+     * @param isSingleShot  true - timer will run only once and then will stop
+     *                      false - timer will keep running until stopTimer() is called or dispatcher is destroyed
+     *
+     * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
+     */
+    template <class Rep, class Period>
+    void startTimer(const HandlerID_t handlerID,
+                    const TimerID_t timerID,
+                    const std::chrono::duration<Rep, Period>& interval,
+                    const bool isSingleShot) {
+        auto intervalUs = std::chrono::duration_cast<std::chrono::microseconds>(interval);
+
+        if (intervalUs < interval) {
+            intervalUs += std::chrono::microseconds(1);
+        }
+
+        startTimerUs(handlerID, timerID, static_cast<uint64_t>(intervalUs.count()), isSingleShot);
+    }
+#endif
+
+    /**
+     * @brief Start a timer which is allowed to expire later than requested.
+     * @details Same as startTimer(), but dispatcher is allowed to delay timer expiration by up to slackMs milliseconds.
+     * This allows dispatcher to align expirations of multiple timers and process them during a single wakeup, which
+     * reduces CPU wakeups (and power consumption) when application has many timers which don't require exact timing.
+     * Timer never expires earlier than intervalMs. Repeating timers get the same slack for every period.
+     *
+     * Default implementation ignores slack and calls startTimer().
+     *
+     * @param handlerID     handler id for wich to start the timer (returned from registerTimerHandler())
+     * @param timerID       timer id. Must be unique only within handlerID
+     * @param intervalMs    timer interval in milliseconds
+     * @param slackMs       maximum allowed delay of timer expiration in milliseconds. 0 - timer is not coarse
+     * @param isSingleShot  true - timer will run only once and then will stop
+     *                      false - timer will keep running until stopTimer() is called or dispatcher is destroyed
+     *
+     * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
+     */
+    virtual void startTimerWithSlack(const HandlerID_t handlerID,
+                                     const TimerID_t timerID,
+                                     const unsigned int intervalMs,
+                                     const unsigned int slackMs,
+                                     const bool isSingleShot) {
+        (void)slackMs;
+        startTimer(handlerID, timerID, intervalMs, isSingleShot);
+    }
+
     /**
      * @brief Restart running or expired timer.
      * @details Timer is restarted with the same arguments which were provided to startTimer(). Only currently running or
      * expired timers (with isSingleShot set to true) will be restarted. Has no effect if called for a timer which was not
      * started.
      *
+     * @deprecated Timer IDs are unique only within a timer handler, so this function affects timers with the same ID of
+     * all handlers. Use restartTimer(handlerID, timerID) instead.
+     *
      * @param timerID       id of running timer
      *
      * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
      */
     virtual void restartTimer(const TimerID_t timerID) = 0;
 
+    /**
+     * @brief Restart running or expired timer of a specific handler.
+     * @details Same as restartTimer(timerID), but affects only timer started for handlerID.
+     *
+     * Default implementation ignores handlerID and calls restartTimer(timerID).
+     *
+     * @param handlerID     handler id which was used to start the timer
+     * @param timerID       id of running timer
+     *
+     * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
+     */
+    virtual void restartTimer(const HandlerID_t handlerID, const TimerID_t timerID) {
+        (void)handlerID;
+        restartTimer(timerID);
+    }
+
     /**
      * @brief Stop active timer.
      * @details Function stops an active timer without triggering any notifications and unregisters it. Further calls to
@@ -227,15 +350,37 @@ public:
      *
      * @remark For expired timers (which have isSingleShot property set to true), funtion simply unregisters them.
      *
+     * @deprecated Timer IDs are unique only within a timer handler, so this function affects timers with the same ID of
+     * all handlers. Use stopTimer(handlerID, timerID) instead.
+     *
      * @param timerID id of running or expired timer
      *
      * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
      */
     virtual void stopTimer(const TimerID_t timerID) = 0;
 
+    /**
+     * @brief Stop active timer of a specific handler.
+     * @details Same as stopTimer(timerID), but affects only timer started for handlerID.
+     *
+     * Default implementation ignores handlerID and calls stopTimer(timerID).
+     *
+     * @param handlerID     handler id which was used to start the timer
+     * @param timerID       id of running or expired timer
+     *
+     * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
+     */
+    virtual void stopTimer(const HandlerID_t handlerID, const TimerID_t timerID) {
+        (void)handlerID;
+        stopTimer(timerID);
+    }
+
     /**
      * @brief Check if timer is currently running.
      *
+     * @deprecated Timer IDs are unique only within a timer handler, so this function checks timers with the same ID of
+     * all handlers. Use isTimerRunning(handlerID, timerID) instead.
+     *
      * @param timerID id of the timer to check
      *
      * @retval true timer is running
@@ -244,6 +389,61 @@ public:
      * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
      */
     virtual bool isTimerRunning(const TimerID_t timerID) = 0;
+
+    /**
+     * @brief Check if timer of a specific handler is currently running.
+     * @details Default implementation ignores handlerID and calls isTimerRunning(timerID).
+     *
+     * @param handlerID     handler id which was used to start the timer
+     * @param timerID       id of the timer to check
+     *
+     * @retval true timer is running
+     * @retval false timer is not running
+     *
+     * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
+     */
+    virtual bool isTimerRunning(const HandlerID_t handlerID, const TimerID_t timerID) {
+        (void)handlerID;
+        return isTimerRunning(timerID);
+    }
+
+    /**
+     * @brief Start watching file descriptor for readiness.
+     * @details Handler is called on dispatcher's thread every time one of the requested conditions becomes true. Watching
+     * is level-triggered: handler will be called again on the next dispatching iteration if condition is still true (for
+     * example, if not all available data was read from the file descriptor).
+     *
+     * Default implementation doesn't support file descriptors watching and always fails.
+     *
+     * @remark File descriptor is not owned by dispatcher. Make sure to call unwatchFd() before closing it.
+     *
+     * @param fd        file descriptor to watch
+     * @param events    bitmask of conditions to watch for (HSM_FD_READABLE, HSM_FD_WRITABLE)
+     * @param handler   handler callback
+     *
+     * @return unique watch ID or INVALID_HSM_DISPATCHER_HANDLER_ID if file descriptor can't be watched
+     *
+     * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
+     */
+    virtual HandlerID_t watchFd(const int fd, const FdEvents_t events, const FdWatchHandlerFunc_t& handler) {
+        (void)fd;
+        (void)events;
+        (void)handler;
+
+        return INVALID_HSM_DISPATCHER_HANDLER_ID;
+    }
+
+    /**
+     * @brief Stop watching file descriptor.
+     * @details Has no effect if watch ID is invalid.
+     *
+     * @param watchID id received from watchFd()
+     *
+     * @threadsafe{Dispatcher implementation **must guarantee** that this call is thread-safe.}
+     */
+    virtual void unwatchFd(const HandlerID_t watchID) {
+        (void)watchID;
+    }
 };
 
 }  // namespace hsmcpp
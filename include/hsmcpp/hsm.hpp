@@ -4,17 +4,38 @@
 #ifndef HSMCPP_HSM_HPP
 #define HSMCPP_HSM_HPP
 
+#include <cassert>
 #include <list>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "HsmTypes.hpp"
+#include "os/os.hpp"
 #include "variant.hpp"
 
+#if defined(STL_AVAILABLE)
+  #include <chrono>
+#endif
+
+// C++20 coroutines support is enabled automatically when compiler supports it. Define HSM_DISABLE_COROUTINES to turn it off
+#if defined(STL_AVAILABLE) && defined(__cpp_impl_coroutine) && (__cpp_impl_coroutine >= 201902L) && \
+    !defined(HSM_DISABLE_COROUTINES)
+  // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+  #define HSM_COROUTINES_AVAILABLE (1)
+#endif
+
+#if defined(HSM_COROUTINES_AVAILABLE)
+  #include <coroutine>
+
+  #include "IHsmEventDispatcher.hpp"
+#endif
+
 namespace hsmcpp {
 
 class IHsmEventDispatcher;
+class HsmDefinition;
 
 /**
  * @brief Implements a Hierarchical State Machine (HSM) for event-driven systems.
@@ -42,6 +63,23 @@ public:
      */
     explicit HierarchicalStateMachine(const StateID_t initialState);
 
+    /**
+     * @brief Constructor that creates HSM using existing structure.
+     *
+     * @details All instances created from the same definition share a single copy of the HSM structure (states,
+     * transitions, callbacks, actions, etc.) and only keep their own runtime data (active states, history, pending events).
+     * This allows to significantly reduce memory usage when running a large number of identical state machines.
+     *
+     * Definition is never modified while it's shared. Registering anything new in one of the instances will make this
+     * instance use its own copy of the definition.
+     *
+     * Callbacks which were registered using class member functions (register*() API with \c handler argument) will be
+     * called for object set with setUserContext(). See setUserContext() for details.
+     *
+     * @param definition structure of the HSM obtained from another instance with getDefinition()
+     */
+    explicit HierarchicalStateMachine(const std::shared_ptr<const HsmDefinition>& definition);
+
     /**
      * @brief Destructor.
 
@@ -59,6 +97,53 @@ public:
      */
     void setInitialState(const StateID_t initialState);
 
+    /**
+     * @brief Returns structure of the HSM.
+     * @details Returned definition can be used to create new HSM instances which share the same structure (see
+     * HierarchicalStateMachine(const std::shared_ptr<const HsmDefinition>&)). After calling this API current HSM will
+     * stop modifying its definition in place.
+     *
+     * @return shared HSM definition
+     *
+     * @notthreadsafe{Must not be called in parallel with register*() API.}
+     */
+    std::shared_ptr<const HsmDefinition> getDefinition() const;
+
+    /**
+     * @brief Sets user context of this HSM instance.
+     * @details Context is passed to callbacks which were registered using class member functions (register*() API with
+     * \c handler argument). If context is not nullptr, callbacks are executed for the object pointed by context instead
+     * of the original \c handler object. This makes it possible to share a single HsmDefinition between multiple
+     * instances and still execute callbacks for the correct object.
+     *
+     * @remark Context must have the same type as \c handler used during registration. Usually it's the HSM object
+     * itself: setUserContext(this). Type of the context is validated with assert() when callback is executed.
+     *
+     * @tparam HsmHandlerClass class which was used to register callbacks
+     * @param context user context
+     *
+     * @notthreadsafe{Must be called before initialize().}
+     */
+    template <class HsmHandlerClass>
+    void setUserContext(HsmHandlerClass* context);
+
+    /**
+     * @brief Resets user context of this HSM instance.
+     * @details Callbacks which were registered using class member functions will be executed for the original
+     * \c handler objects.
+     *
+     * @notthreadsafe{Must be called before initialize().}
+     */
+    void setUserContext(std::nullptr_t);
+
+    /**
+     * @brief Returns user context set with setUserContext().
+     * @return user context or nullptr
+     *
+     * @concurrencysafe{ }
+     */
+    void* getUserContext() const;
+
     /**
      * @brief Initializes the HSM.
      * @details Registers HSM with provided event dispatcher and transitions state machine into it's initial state. HSM
@@ -426,9 +511,38 @@ public:
      * @brief Get the list of currently active states.
      *
      * @return list of currently active states.
+     *
+     * @notthreadsafe{List is modified by dispatcher thread without synchronization. Use getActiveStatesSnapshot() to
+     *                access active states from other threads.}
      */
     const std::list<StateID_t>& getActiveStates() const;
 
+    /**
+     * @brief Get consistent copy of currently active states.
+     * @details Active states are published by HSM every time they change (right before state changed callback is
+     * called and after each event was processed). Snapshot is protected by a sequence lock, so reading it doesn't use
+     * mutexes, doesn't allocate memory and doesn't affect dispatcher thread.
+     *
+     * @remark Only the first HSM_ACTIVE_STATES_SNAPSHOT_CAPACITY states are stored. Check ActiveStatesSnapshot::count
+     * if HSM can have more active states at the same time.
+     *
+     * @param outSnapshot copy of active states
+     *
+     * @threadsafe{ }
+     */
+    void getActiveStatesSnapshot(ActiveStatesSnapshot& outSnapshot) const;
+
+    /**
+     * @brief Get version of active states.
+     * @details Version is incremented every time active states change. Can be used to cheaply check if
+     * getActiveStatesSnapshot() needs to be called again.
+     *
+     * @return same value as ActiveStatesSnapshot::version of the latest snapshot
+     *
+     * @threadsafe{ }
+     */
+    uint32_t getActiveStatesVersion() const;
+
     /**
      * @brief Check if a state is active.
      * @details This function checks if a specific state is currently active in the HSM.
@@ -438,6 +552,40 @@ public:
      */
     bool isStateActive(const StateID_t state) const;
 
+    /**
+     * @brief Block calling thread until a state becomes active.
+     * @details Returns right away if state is already active. Otherwise calling thread sleeps until HSM activates the
+     * state and is woken up right after state changed callback was called. No polling is involved.
+     *
+     * @remark State could become inactive again by the time calling thread checks the result. Function only guarantees
+     * that state was activated at least once.
+     * @warning calling this function from HSM callback blocks HSM events processing. State can't change while dispatcher
+     * is blocked, so function will fail after timeoutMs or will never return if timeoutMs is HSM_WAIT_INDEFINITELY.
+     *
+     * @param state ID of the state to wait for
+     * @param timeoutMs maximum time in milliseconds to wait. Use HSM_WAIT_INDEFINITELY to wait indefinitely.
+     *
+     * @retval true state is active
+     * @retval false timeoutMs expired or HSM was released before state was activated
+     *
+     * @threadsafe{ }
+     */
+    bool waitForState(const StateID_t state, const int timeoutMs);
+
+    /**
+     * @brief Block calling thread until any of the states becomes active.
+     * @details Same as waitForState(), but waits for multiple states at once.
+     *
+     * @param states IDs of the states to wait for
+     * @param timeoutMs maximum time in milliseconds to wait. Use HSM_WAIT_INDEFINITELY to wait indefinitely.
+     *
+     * @retval true at least one of the states is active
+     * @retval false timeoutMs expired or HSM was released before any of the states was activated
+     *
+     * @threadsafe{ }
+     */
+    bool waitForAnyState(const std::list<StateID_t>& states, const int timeoutMs);
+
     /**
      * @brief Trigger a transition in the HSM.
      * @details This function sends event to HSM to trigger a potential transition. The transition is executed asynchronously,
@@ -478,6 +626,30 @@ public:
     template <typename... Args>
     bool transitionEx(const EventID_t event, const bool clearQueue, const bool sync, const int timeoutMs, Args&&... args);
 
+    /**
+     * @brief Trigger a transition in the HSM and get notified when it's processed.
+     * @details Non-blocking alternative to transitionEx() with sync=true. Event is sent to HSM the same way as with
+     * transition(), but calling thread doesn't wait for the result. Instead onDone is called once with the result of
+     * processing the event:
+     *      \li from dispatcher thread right after the transition finished. If transition leads to a state with substates,
+     *      onDone is called after entry point transitions were finished
+     *      \li from the thread which removed the event from the queue (clearQueue=true) or released HSM. Status is
+     *      HsmEventStatus::DONE_FAILED in this case
+     *      \li right away from calling thread with HsmEventStatus::DONE_FAILED if HSM is not initialized
+     *
+     * It's safe to send new events to HSM from onDone.
+     *
+     * @param event ID of event to send to HSM
+     * @param clearQueue indicates whether to clear the pending events queue before adding a new event
+     * @param onDone callback compatible with HsmTransitionDoneCallback_t
+     * @param args (optional) arguments to pass to the callbacks
+     *
+     * @threadsafe{ }
+     */
+    template <typename Callback, typename... Args>
+    auto transitionEx(const EventID_t event, const bool clearQueue, Callback&& onDone, Args&&... args)
+        -> decltype(onDone(HsmEventStatus::DONE_OK), void());
+
     /**
      * @brief Trigger a transition in the HSM with arguments passed as a vector.
      * @copydetails transition()
@@ -527,6 +699,62 @@ public:
     template <typename... Args>
     void transitionWithQueueClear(const EventID_t event, Args&&... args);
 
+#if defined(HSM_COROUTINES_AVAILABLE)
+    /**
+     * @brief Function used by awaitables to resume a suspended coroutine.
+     * @details Receives a function which resumes the coroutine. Executor must call it (right away or later) on the thread
+     * where coroutine is supposed to continue.
+     */
+    using CoroutineExecutor_t = std::function<void(std::function<void()>)>;
+
+    class TransitionAwaitable;
+    class StateAwaitable;
+
+    /**
+     * @brief Trigger a transition in the HSM and suspend calling coroutine until the event is processed.
+     * @details C++20 coroutines alternative to transitionSync(). Event is sent the same way as with transition(), but
+     * instead of blocking the calling thread the coroutine is suspended and later resumed with the result of processing
+     * the event.
+     *
+     * By default coroutine is resumed on HSM dispatcher (using IHsmEventDispatcher::enqueueAction()). If dispatcher
+     * doesn't exist anymore, coroutine is resumed right away on the thread which completed the event. Use
+     * TransitionAwaitable::via() to resume on a different executor:
+     * @code
+     * const HsmEventStatus status = co_await hsm.transitionAsync(EVENT_1, arg1).via(myExecutor);
+     * @endcode
+     *
+     * @remark Only available if compiler supports C++20 coroutines and HSM_DISABLE_COROUTINES is not defined.
+     * @warning coroutine must not be destroyed while it's suspended.
+     *
+     * @param event ID of event to send to HSM
+     * @param args (optional) arguments to pass to the callbacks
+     * @return awaitable which resumes coroutine with HsmEventStatus::DONE_OK, HsmEventStatus::DONE_FAILED or
+     * HsmEventStatus::CANCELED
+     *
+     * @threadsafe{ }
+     */
+    template <typename... Args>
+    [[nodiscard]] TransitionAwaitable transitionAsync(const EventID_t event, Args&&... args);
+
+    /**
+     * @brief Suspend calling coroutine until a state becomes active.
+     * @details Coroutine is not suspended if state is already active. Otherwise it's resumed right after the state was
+     * activated (after its state changed callback). Resumption follows the same rules as for transitionAsync().
+     *
+     * @remark Only available if compiler supports C++20 coroutines and HSM_DISABLE_COROUTINES is not defined.
+     * @remark Not to be confused with blocking waitForState(state, timeoutMs). Returned awaitable does nothing unless
+     * it's co_await-ed, so compiler warns if it's discarded.
+     * @warning coroutine must not be destroyed while it's suspended.
+     *
+     * @param state ID of the state to wait for
+     * @return awaitable which resumes coroutine with true if state is active or with false if HSM was released before
+     * state was activated
+     *
+     * @threadsafe{ }
+     */
+    [[nodiscard]] StateAwaitable waitForState(const StateID_t state);
+#endif  // HSM_COROUTINES_AVAILABLE
+
     /**
      * @brief Interrupt/signal safe version of transition
      * @details This is a simplified version of transition that can be safely used from an interrupt/signal. Event is processed
@@ -579,6 +807,57 @@ public:
      */
     void startTimer(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot);
 
+    /**
+     * @brief Start a timer with microseconds resolution.
+     * @details Same as startTimer(), but interval is provided in microseconds. Repeating timers are rescheduled based on
+     * their previous deadline, so they don't drift. Actual precision depends on the dispatcher: dispatchers which don't
+     * support sub-millisecond timers round interval up to milliseconds. See IHsmEventDispatcher::startTimerUs().
+     *
+     * @param timerID       unique timer id
+     * @param intervalUs    timer interval in microseconds
+     * @param isSingleShot  true - timer will run only once and then will stop
+     *                      false - timer will keep running until stopTimer() is called or dispatcher is destroyed
+     *
+     * @threadsafe{ }
+     */
+    void startTimerUs(const TimerID_t timerID, const uint64_t intervalUs, const bool isSingleShot);
+
+#if defined(STL_AVAILABLE)
+    /**
+     * @brief Start a timer using std::chrono duration.
+     * @details Convenience wrapper for startTimerUs(). Interval is rounded up to microseconds.
+     *
+     * @param timerID       unique timer id
+     * @param interval      timer interval
+     * @param isSingleShot  true - timer will run only once and then will stop
+     *                      false - timer will keep running until stopTimer() is called or dispatcher is destroyed
+     *
+     * @threadsafe{ }
+     */
+    template <class Rep, class Period>
+    void startTimer(const TimerID_t timerID, const std::chrono::duration<Rep, Period>& interval, const bool isSingleShot);
+#endif
+
+    /**
+     * @brief Start a coarse timer.
+     * @details Same as startTimer(), but allows dispatcher to delay timer expiration by up to slackMs milliseconds. This
+     * allows dispatcher to process multiple timers during a single wakeup. Use it for timers which don't require exact
+     * timing (timeouts, periodic polling, etc.). If dispatcher doesn't support coarse timers, slack is ignored.
+     * See IHsmEventDispatcher::startTimerWithSlack() for details.
+     *
+     * @param timerID       unique timer id
+     * @param intervalMs    timer interval in milliseconds
+     * @param slackMs       maximum allowed delay of timer expiration in milliseconds
+     * @param isSingleShot  true - timer will run only once and then will stop
+     *                      false - timer will keep running until stopTimer() is called or dispatcher is destroyed
+     *
+     * @threadsafe{ }
+     */
+    void startTimerWithSlack(const TimerID_t timerID,
+                             const unsigned int intervalMs,
+                             const unsigned int slackMs,
+                             const bool isSingleShot);
+
     /**
      * @brief Restart running timer.
      * @details Timer is restarted with the same arguments which were provided to startTimer(). Only currently running or
@@ -616,6 +895,39 @@ public:
      */
     bool isTimerRunning(const TimerID_t timerID);
 
+    /**
+     * @brief Start watching file descriptor and send an event to HSM when it becomes ready.
+     * @details Readiness is detected by HSM's dispatcher (see IHsmEventDispatcher::watchFd()) and event is processed right
+     * away on dispatcher's thread, without any additional thread hops. HSM receives two transition arguments:
+     *  \li args[0] - file descriptor (int32_t)
+     *  \li args[1] - bitmask of ready conditions (FdEvents_t: HSM_FD_READABLE, HSM_FD_WRITABLE, HSM_FD_ERROR)
+     *
+     * Watching is level-triggered: handling of the event must read/write the file descriptor. Otherwise event will be sent
+     * again on the next dispatching iteration.
+     *
+     * @remark HSM must be initialized. Dispatcher must support file descriptors watching.
+     * @remark File descriptor is not owned by HSM. Make sure to call unwatchFd() before closing it. All file descriptors are
+     * automatically unwatched in release().
+     *
+     * @param fd        file descriptor to watch
+     * @param events    bitmask of conditions to watch for (HSM_FD_READABLE, HSM_FD_WRITABLE)
+     * @param event     id of the event to send to HSM
+     *
+     * @return unique watch ID or INVALID_HSM_DISPATCHER_HANDLER_ID in case of error
+     *
+     * @threadsafe{ }
+     */
+    HandlerID_t watchFd(const int fd, const FdEvents_t events, const EventID_t event);
+
+    /**
+     * @brief Stop watching file descriptor.
+     *
+     * @param watchID id received from watchFd()
+     *
+     * @threadsafe{ }
+     */
+    void unwatchFd(const HandlerID_t watchID);
+
     /**
      * @brief Enable debugging for HSM instance.
      * @details Enables creation of the log file that can be later analyzed with hsmdebugger. By default log will be written to
@@ -690,17 +1002,122 @@ private:
     template <typename... Args>
     void makeVariantList(VariantVector_t& vList, Args&&... args);
 
+    template <class HsmHandlerClass>
+    static HsmHandlerClass* getCallbackHandler(HsmHandlerClass* handler, const HsmUserContext& context);
+
+    template <class HsmHandlerClass, typename Ret, typename... Args>
+    static HsmContextCallback<Ret, Args...> makeMemberCallback(HsmHandlerClass* handler,
+                                                               Ret (HsmHandlerClass::*callback)(Args...));
+
+    void setUserContextImpl(const HsmUserContext& context);
+
+    void registerStateImpl(const StateID_t state,
+                           HsmContextStateChangedCallback_t onStateChanged,
+                           HsmContextStateEnterCallback_t onEntering,
+                           HsmContextStateExitCallback_t onExiting);
+    void registerFinalStateImpl(const StateID_t state,
+                                const EventID_t event,
+                                HsmContextStateChangedCallback_t onStateChanged,
+                                HsmContextStateEnterCallback_t onEntering,
+                                HsmContextStateExitCallback_t onExiting);
+    void registerHistoryImpl(const StateID_t parent,
+                             const StateID_t historyState,
+                             const HistoryType type,
+                             const StateID_t defaultTarget,
+                             HsmContextTransitionCallback_t transitionCallback);
+    bool registerSubstateEntryPointImpl(const StateID_t parent,
+                                        const StateID_t substate,
+                                        const EventID_t onEvent,
+                                        HsmContextTransitionConditionCallback_t conditionCallback,
+                                        const bool expectedConditionValue);
+    void registerTransitionImpl(const StateID_t fromState,
+                                const StateID_t toState,
+                                const EventID_t onEvent,
+                                HsmContextTransitionCallback_t transitionCallback,
+                                HsmContextTransitionConditionCallback_t conditionCallback,
+                                const bool expectedConditionValue);
+    void registerSelfTransitionImpl(const StateID_t state,
+                                    const EventID_t onEvent,
+                                    const TransitionType type,
+                                    HsmContextTransitionCallback_t transitionCallback,
+                                    HsmContextTransitionConditionCallback_t conditionCallback,
+                                    const bool expectedConditionValue);
+
     bool registerStateActionImpl(const StateID_t state,
                                  const StateActionTrigger actionTrigger,
                                  const StateAction action,
                                  const VariantVector_t& args);
     bool isTransitionPossibleImpl(const EventID_t event, const VariantVector_t& args);
+    // onDone is called from dispatcher thread once event is processed or dropped
+    void transitionWithCallbackImpl(const EventID_t event,
+                                    const bool clearQueue,
+                                    HsmTransitionDoneCallback_t onDone,
+                                    VariantVector_t&& args);
+    // returns false if one of the states is already active (outIsActive is true) or HSM was released. onDone is not
+    // called in this case
+    bool addStateWaiterImpl(const std::list<StateID_t>& states, std::function<void(const bool)> onDone, bool& outIsActive);
+
+#if defined(HSM_COROUTINES_AVAILABLE)
+    static CoroutineExecutor_t makeDispatcherExecutor(const std::weak_ptr<IHsmEventDispatcher>& dispatcher);
+#endif
 
 private:
     class Impl;
     std::shared_ptr<Impl> mImpl;
 };
 
+#if defined(HSM_COROUTINES_AVAILABLE)
+/**
+ * @brief Awaitable returned by HierarchicalStateMachine::transitionAsync().
+ * @details Event is sent to HSM when coroutine is suspended. Coroutine is resumed with the result of processing the event.
+ */
+class [[nodiscard]] HierarchicalStateMachine::TransitionAwaitable {
+public:
+    TransitionAwaitable(HierarchicalStateMachine* hsm, const EventID_t event, VariantVector_t&& args);
+
+    /**
+     * @brief Resume coroutine using provided executor instead of HSM dispatcher.
+     * @param executor function which will be used to resume the coroutine
+     */
+    [[nodiscard]] TransitionAwaitable via(CoroutineExecutor_t executor) &&;
+
+    bool await_ready() const noexcept;
+    void await_suspend(std::coroutine_handle<> handle);
+    HsmEventStatus await_resume() const noexcept;
+
+private:
+    HierarchicalStateMachine* mHsm;
+    EventID_t mEvent;
+    VariantVector_t mArgs;
+    CoroutineExecutor_t mExecutor;
+    HsmEventStatus mStatus = HsmEventStatus::PENDING;
+};
+
+/**
+ * @brief Awaitable returned by HierarchicalStateMachine::waitForState().
+ */
+class [[nodiscard]] HierarchicalStateMachine::StateAwaitable {
+public:
+    StateAwaitable(HierarchicalStateMachine* hsm, const StateID_t state);
+
+    /**
+     * @brief Resume coroutine using provided executor instead of HSM dispatcher.
+     * @param executor function which will be used to resume the coroutine
+     */
+    [[nodiscard]] StateAwaitable via(CoroutineExecutor_t executor) &&;
+
+    bool await_ready() const noexcept;
+    bool await_suspend(std::coroutine_handle<> handle);
+    bool await_resume() const noexcept;
+
+private:
+    HierarchicalStateMachine* mHsm;
+    StateID_t mState;
+    CoroutineExecutor_t mExecutor;
+    bool mIsActive = false;
+};
+#endif  // HSM_COROUTINES_AVAILABLE
+
 // =================================================================================================================
 // Template Functions
 // =================================================================================================================
@@ -712,30 +1129,55 @@ void HierarchicalStateMachine::registerFailedTransitionCallback(HsmHandlerClass*
 }
 
 template <class HsmHandlerClass>
-void HierarchicalStateMachine::registerState(const StateID_t state,
-                                             HsmHandlerClass* handler,
-                                             HsmStateChangedCallbackPtr_t(HsmHandlerClass, onStateChanged),
-                                             HsmStateEnterCallbackPtr_t(HsmHandlerClass, onEntering),
-                                             HsmStateExitCallbackPtr_t(HsmHandlerClass, onExiting)) {
-    HsmStateChangedCallback_t funcStateChanged;
-    HsmStateEnterCallback_t funcEntering;
-    HsmStateExitCallback_t funcExiting;
+void HierarchicalStateMachine::setUserContext(HsmHandlerClass* context) {
+    static_assert(false == std::is_void<HsmHandlerClass>::value, "context must have the same type as callbacks handler");
+    setUserContextImpl(HsmUserContext{context, hsmTypeTag<HsmHandlerClass>()});
+}
 
-    if (nullptr != handler) {
-        if (nullptr != onStateChanged) {
-            funcStateChanged = std::bind(onStateChanged, handler, std::placeholders::_1);
-        }
+template <class HsmHandlerClass>
+HsmHandlerClass* HierarchicalStateMachine::getCallbackHandler(HsmHandlerClass* handler, const HsmUserContext& context) {
+    HsmHandlerClass* result = handler;
 
-        if (nullptr != onEntering) {
-            funcEntering = std::bind(onEntering, handler, std::placeholders::_1);
-        }
+    if (nullptr != context.object) {
+        // NOTE: context must be set using the same class which was used to register callbacks
+        assert(hsmTypeTag<HsmHandlerClass>() == context.type);
+        result = static_cast<HsmHandlerClass*>(context.object);
+    }
 
-        if (nullptr != onExiting) {
-            funcExiting = std::bind(onExiting, handler);
-        }
+    return result;
+}
+
+template <class HsmHandlerClass, typename Ret, typename... Args>
+HsmContextCallback<Ret, Args...> HierarchicalStateMachine::makeMemberCallback(HsmHandlerClass* handler,
+                                                                              Ret (HsmHandlerClass::*callback)(Args...)) {
+    HsmContextCallback<Ret, Args...> result;
+
+    if ((nullptr != handler) && (nullptr != callback)) {
+        using ContextCallback_t = typename HsmContextCallback<Ret, Args...>::ContextCallback_t;
+
+        // NOTE: member function is called directly from the stored lambda without any intermediate wrappers
+        const auto invokeMember = [handler, callback](const HsmUserContext& context, Args... args) {
+            // NOTE: false-positive. "return" statement belongs to lambda function, not parent function
+            // cppcheck-suppress misra-c2012-15.5
+            return (getCallbackHandler(handler, context)->*callback)(args...);
+        };
+
+        result = HsmContextCallback<Ret, Args...>(ContextCallback_t(invokeMember));
     }
 
-    registerState(state, std::move(funcStateChanged), std::move(funcEntering), std::move(funcExiting));
+    return result;
+}
+
+template <class HsmHandlerClass>
+void HierarchicalStateMachine::registerState(const StateID_t state,
+                                             HsmHandlerClass* handler,
+                                             HsmStateChangedCallbackPtr_t(HsmHandlerClass, onStateChanged),
+                                             HsmStateEnterCallbackPtr_t(HsmHandlerClass, onEntering),
+                                             HsmStateExitCallbackPtr_t(HsmHandlerClass, onExiting)) {
+    registerStateImpl(state,
+                      makeMemberCallback(handler, onStateChanged),
+                      makeMemberCallback(handler, onEntering),
+                      makeMemberCallback(handler, onExiting));
 }
 
 template <class HsmHandlerClass>
@@ -745,25 +1187,11 @@ void HierarchicalStateMachine::registerFinalState(const StateID_t state,
                                                   HsmStateChangedCallbackPtr_t(HsmHandlerClass, onStateChanged),
                                                   HsmStateEnterCallbackPtr_t(HsmHandlerClass, onEntering),
                                                   HsmStateExitCallbackPtr_t(HsmHandlerClass, onExiting)) {
-    HsmStateChangedCallback_t funcStateChanged;
-    HsmStateEnterCallback_t funcEntering;
-    HsmStateExitCallback_t funcExiting;
-
-    if (nullptr != handler) {
-        if (nullptr != onStateChanged) {
-            funcStateChanged = std::bind(onStateChanged, handler, std::placeholders::_1);
-        }
-
-        if (nullptr != onEntering) {
-            funcEntering = std::bind(onEntering, handler, std::placeholders::_1);
-        }
-
-        if (nullptr != onExiting) {
-            funcExiting = std::bind(onExiting, handler);
-        }
-    }
-
-    registerFinalState(state, event, std::move(funcStateChanged), std::move(funcEntering), std::move(funcExiting));
+    registerFinalStateImpl(state,
+                           event,
+                           makeMemberCallback(handler, onStateChanged),
+                           makeMemberCallback(handler, onEntering),
+                           makeMemberCallback(handler, onExiting));
 }
 
 template <class HsmHandlerClass>
@@ -773,15 +1201,7 @@ void HierarchicalStateMachine::registerHistory(const StateID_t parent,
                                                const StateID_t defaultTarget,
                                                HsmHandlerClass* handler,
                                                HsmTransitionCallbackPtr_t(HsmHandlerClass, transitionCallback)) {
-    HsmTransitionCallback_t funcTransitionCallback;
-
-    if (nullptr != handler) {
-        if (nullptr != transitionCallback) {
-            funcTransitionCallback = std::bind(transitionCallback, handler, std::placeholders::_1);
-        }
-    }
-
-    registerHistory(parent, historyState, type, defaultTarget, std::move(funcTransitionCallback));
+    registerHistoryImpl(parent, historyState, type, defaultTarget, makeMemberCallback(handler, transitionCallback));
 }
 
 template <class HsmHandlerClass>
@@ -792,13 +1212,11 @@ bool HierarchicalStateMachine::registerSubstateEntryPoint(const StateID_t parent
                                                           HsmTransitionConditionCallbackPtr_t(HsmHandlerClass,
                                                                                               conditionCallback),
                                                           const bool expectedConditionValue) {
-    HsmTransitionConditionCallback_t condition;
-
-    if ((nullptr != handler) && (nullptr != conditionCallback)) {
-        condition = std::bind(conditionCallback, handler, std::placeholders::_1);
-    }
-
-    return registerSubstateEntryPoint(parent, substate, onEvent, std::move(condition), expectedConditionValue);
+    return registerSubstateEntryPointImpl(parent,
+                                          substate,
+                                          onEvent,
+                                          makeMemberCallback(handler, conditionCallback),
+                                          expectedConditionValue);
 }
 
 template <typename... Args>
@@ -820,20 +1238,12 @@ void HierarchicalStateMachine::registerTransition(const StateID_t fromState,
                                                   HsmTransitionCallbackPtr_t(HsmHandlerClass, transitionCallback),
                                                   HsmTransitionConditionCallbackPtr_t(HsmHandlerClass, conditionCallback),
                                                   const bool expectedConditionValue) {
-    HsmTransitionCallback_t funcTransitionCallback;
-    HsmTransitionConditionCallback_t funcConditionCallback;
-
-    if (nullptr != handler) {
-        if (nullptr != transitionCallback) {
-            funcTransitionCallback = std::bind(transitionCallback, handler, std::placeholders::_1);
-        }
-
-        if (nullptr != conditionCallback) {
-            funcConditionCallback = std::bind(conditionCallback, handler, std::placeholders::_1);
-        }
-    }
-
-    registerTransition(fromState, toState, onEvent, std::move(funcTransitionCallback), std::move(funcConditionCallback), expectedConditionValue);
+    registerTransitionImpl(fromState,
+                           toState,
+                           onEvent,
+                           makeMemberCallback(handler, transitionCallback),
+                           makeMemberCallback(handler, conditionCallback),
+                           expectedConditionValue);
 }
 
 template <class HsmHandlerClass>
@@ -844,20 +1254,12 @@ void HierarchicalStateMachine::registerSelfTransition(const StateID_t state,
                                                       HsmTransitionCallbackPtr_t(HsmHandlerClass, transitionCallback),
                                                       HsmTransitionConditionCallbackPtr_t(HsmHandlerClass, conditionCallback),
                                                       const bool expectedConditionValue) {
-    HsmTransitionCallback_t funcTransitionCallback;
-    HsmTransitionConditionCallback_t funcConditionCallback;
-
-    if (nullptr != handler) {
-        if (nullptr != transitionCallback) {
-            funcTransitionCallback = std::bind(transitionCallback, handler, std::placeholders::_1);
-        }
-
-        if (nullptr != conditionCallback) {
-            funcConditionCallback = std::bind(conditionCallback, handler, std::placeholders::_1);
-        }
-    }
-
-    registerSelfTransition(state, onEvent, type, std::move(funcTransitionCallback), std::move(funcConditionCallback), expectedConditionValue);
+    registerSelfTransitionImpl(state,
+                               onEvent,
+                               type,
+                               makeMemberCallback(handler, transitionCallback),
+                               makeMemberCallback(handler, conditionCallback),
+                               expectedConditionValue);
 }
 
 template <typename... Args>
@@ -877,6 +1279,18 @@ bool HierarchicalStateMachine::transitionEx(const EventID_t event,
     return transitionExWithArgsArray(event, clearQueue, sync, timeoutMs, std::move(eventArgs));
 }
 
+template <typename Callback, typename... Args>
+auto HierarchicalStateMachine::transitionEx(const EventID_t event, const bool clearQueue, Callback&& onDone, Args&&... args)
+    -> decltype(onDone(HsmEventStatus::DONE_OK), void()) {
+    VariantVector_t eventArgs;
+
+    makeVariantList(eventArgs, std::forward<Args>(args)...);
+    transitionWithCallbackImpl(event,
+                               clearQueue,
+                               HsmTransitionDoneCallback_t(std::forward<Callback>(onDone)),
+                               std::move(eventArgs));
+}
+
 template <typename... Args>
 bool HierarchicalStateMachine::transitionSync(const EventID_t event, const int timeoutMs, Args&&... args) {
     return transitionEx(event, false, true, timeoutMs, std::forward<Args>(args)...);
@@ -888,6 +1302,118 @@ void HierarchicalStateMachine::transitionWithQueueClear(const EventID_t event, A
     (void)transitionEx(event, true, false, 0, std::forward<Args>(args)...);
 }
 
+#if defined(HSM_COROUTINES_AVAILABLE)
+template <typename... Args>
+HierarchicalStateMachine::TransitionAwaitable HierarchicalStateMachine::transitionAsync(const EventID_t event,
+                                                                                        Args&&... args) {
+    VariantVector_t eventArgs;
+
+    makeVariantList(eventArgs, std::forward<Args>(args)...);
+
+    return TransitionAwaitable(this, event, std::move(eventArgs));
+}
+
+inline HierarchicalStateMachine::StateAwaitable HierarchicalStateMachine::waitForState(const StateID_t state) {
+    return StateAwaitable(this, state);
+}
+
+inline HierarchicalStateMachine::CoroutineExecutor_t HierarchicalStateMachine::makeDispatcherExecutor(
+    const std::weak_ptr<IHsmEventDispatcher>& dispatcher) {
+    return [dispatcher](std::function<void()> resume) {
+        auto dispatcherPtr = dispatcher.lock();
+
+        // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
+        if (dispatcherPtr) {
+            dispatcherPtr->enqueueAction(std::move(resume));
+        } else {
+            resume();
+        }
+    };
+}
+
+inline HierarchicalStateMachine::TransitionAwaitable::TransitionAwaitable(HierarchicalStateMachine* hsm,
+                                                                         const EventID_t event,
+                                                                         VariantVector_t&& args)
+    : mHsm(hsm)
+    , mEvent(event)
+    , mArgs(std::move(args)) {}
+
+inline HierarchicalStateMachine::TransitionAwaitable HierarchicalStateMachine::TransitionAwaitable::via(
+    CoroutineExecutor_t executor) && {
+    mExecutor = std::move(executor);
+    return std::move(*this);
+}
+
+inline bool HierarchicalStateMachine::TransitionAwaitable::await_ready() const noexcept {
+    return false;
+}
+
+inline void HierarchicalStateMachine::TransitionAwaitable::await_suspend(std::coroutine_handle<> handle) {
+    CoroutineExecutor_t executor = (mExecutor ? std::move(mExecutor) : makeDispatcherExecutor(mHsm->dispatcher()));
+    HsmEventStatus* status = &mStatus;
+
+    // NOTE: coroutine can be resumed from another thread before transitionWithCallbackImpl() returns, so awaitable must
+    //       not be accessed after this call
+    mHsm->transitionWithCallbackImpl(
+        mEvent,
+        false,
+        [status, handle, executor = std::move(executor)](const HsmEventStatus result) {
+            *status = result;
+            executor([handle]() { handle.resume(); });
+        },
+        std::move(mArgs));
+}
+
+inline HsmEventStatus HierarchicalStateMachine::TransitionAwaitable::await_resume() const noexcept {
+    return mStatus;
+}
+
+inline HierarchicalStateMachine::StateAwaitable::StateAwaitable(HierarchicalStateMachine* hsm, const StateID_t state)
+    : mHsm(hsm)
+    , mState(state) {}
+
+inline HierarchicalStateMachine::StateAwaitable HierarchicalStateMachine::StateAwaitable::via(
+    CoroutineExecutor_t executor) && {
+    mExecutor = std::move(executor);
+    return std::move(*this);
+}
+
+inline bool HierarchicalStateMachine::StateAwaitable::await_ready() const noexcept {
+    // NOTE: active states can't be checked here without registering a waiter. Otherwise state could be activated
+    //       between the check and await_suspend(). await_suspend() doesn't suspend if state is already active
+    return false;
+}
+
+inline bool HierarchicalStateMachine::StateAwaitable::await_suspend(std::coroutine_handle<> handle) {
+    CoroutineExecutor_t executor = (mExecutor ? std::move(mExecutor) : makeDispatcherExecutor(mHsm->dispatcher()));
+    HierarchicalStateMachine* hsm = mHsm;
+    const StateID_t state = mState;
+    bool* isActive = &mIsActive;
+    bool isAlreadyActive = false;
+
+    // NOTE: coroutine can be resumed from another thread before addStateWaiterImpl() returns, so awaitable must not be
+    //       accessed after this call if waiter was added
+    const bool isSuspended = hsm->addStateWaiterImpl(
+        {state},
+        [isActive, handle, executor = std::move(executor)](const bool result) {
+            *isActive = result;
+            executor([handle]() { handle.resume(); });
+        },
+        isAlreadyActive);
+
+    if (false == isSuspended) {
+        // state is already active or HSM was released
+        *isActive = isAlreadyActive;
+    }
+
+    return isSuspended;
+}
+
+inline bool HierarchicalStateMachine::StateAwaitable::await_resume() const noexcept {
+    return mIsActive;
+}
+#endif  // HSM_COROUTINES_AVAILABLE
+
 template <typename... Args>
 bool HierarchicalStateMachine::isTransitionPossible(const EventID_t event, Args&&... args) {
     VariantVector_t eventArgs;
@@ -903,6 +1429,21 @@ void HierarchicalStateMachine::makeVariantList(VariantVector_t& vList, Args&&...
     (void)make_variant;
 }
 
+#if defined(STL_AVAILABLE)
+template <class Rep, class Period>
+void HierarchicalStateMachine::startTimer(const TimerID_t timerID,
+                                          const std::chrono::duration<Rep, Period>& interval,
+                                          const bool isSingleShot) {
+    auto intervalUs = std::chrono::duration_cast<std::chrono::microseconds>(interval);
+
+    if (intervalUs < interval) {
+        intervalUs += std::chrono::microseconds(1);
+    }
+
+    startTimerUs(timerID, static_cast<uint64_t>(intervalUs.count()), isSingleShot);
+}
+#endif
+
 }  // namespace hsmcpp
 
 #endif  // HSMCPP_HSM_HPP
@@ -0,0 +1,33 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#ifndef HSMCPP_OS_CPURELAX_HPP
+#define HSMCPP_OS_CPURELAX_HPP
+
+#include <atomic>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  #include <intrin.h>
+#endif
+
+namespace hsmcpp {
+
+/**
+ * @brief Hint CPU that current thread is spinning in a busy-wait loop.
+ * @details Reduces power consumption and frees execution resources for the sibling hyper-thread without giving up the
+ * CPU. Falls back to a compiler barrier on architectures without a suitable instruction.
+ */
+inline void cpuRelax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_OS_CPURELAX_HPP
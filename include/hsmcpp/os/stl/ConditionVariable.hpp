@@ -5,6 +5,7 @@
 
 #include "hsmcpp/os/common/UniqueLock.hpp"
 #include "Mutex.hpp"
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 
@@ -18,7 +19,11 @@ public:
 
     void wait(UniqueLock& sync, const std::function<bool()>& stopWaiting = nullptr);
     bool wait_for(UniqueLock& sync, const int timeoutMs, const std::function<bool()>& stopWaiting);
+    bool wait_until(UniqueLock& sync,
+                    const std::chrono::steady_clock::time_point& deadline,
+                    const std::function<bool()>& stopWaiting);
     inline void notify();
+    inline void notifyOne();
 
 private:
     ConditionVariable(const ConditionVariable&) = delete;
@@ -33,6 +38,12 @@ inline void ConditionVariable::notify()
     mVariable.notify_all();
 }
 
+// wakes up only one of the waiting threads
+inline void ConditionVariable::notifyOne()
+{
+    mVariable.notify_one();
+}
+
 } // namespace hsmcpp
 
 #endif // HSMCPP_OS_STL_CONDITIONVARIABLE_HPP
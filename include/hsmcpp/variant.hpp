@@ -4,11 +4,14 @@
 #ifndef HSMCPP_VARIANT_HPP
 #define HSMCPP_VARIANT_HPP
 
+#include <cstddef>
 #include <functional>
+#include <iosfwd>
 #include <list>
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -21,6 +24,10 @@ using VariantVector_t = std::vector<Variant>;
 using VariantList_t = std::list<Variant>;
 using VariantMap_t = std::map<Variant, Variant>;
 using VariantPair_t = std::pair<Variant, Variant>;  ///< Provides a way to store two values as a single unit.
+using VariantHashMap_t = std::unordered_map<Variant, Variant>;  ///< Unordered alternative to VariantMap_t. Uses Variant::hash()
+
+/// Value of maxLength argument for Variant::format() which disables output length limit
+constexpr std::size_t VARIANT_FORMAT_UNLIMITED = 0;
 
 // cppcheck-suppress misra-c2012-20.7 ; parentheses are not needed
 #define DEF_CONSTRUCTOR(_val_type, _internal_type)               \
@@ -446,6 +453,31 @@ public:
      */
     std::string toString() const;
 
+    /**
+     * @brief Writes string representation of the Variant object to a caller-provided buffer.
+     * @details Produces the same output as toString(), but doesn't create any intermediate strings. If output doesn't fit
+     * into the buffer it's truncated and last characters are replaced with "...". Formatting of containers stops as soon
+     * as the buffer is full.
+     *
+     * @param buffer destination buffer. Result is always null-terminated (if bufferSize is greater than 0).
+     * @param bufferSize size of the buffer (including null-terminator)
+     *
+     * @return number of characters written to the buffer (not including null-terminator)
+     */
+    std::size_t format(char* buffer, const std::size_t bufferSize) const;
+
+    /**
+     * @brief Writes string representation of the Variant object to a stream.
+     * @details Produces the same output as toString(), but doesn't create any intermediate strings. If output is longer
+     * than maxLength it's truncated and last characters are replaced with "...".
+     *
+     * @param stream destination stream
+     * @param maxLength maximum number of characters to write or VARIANT_FORMAT_UNLIMITED to disable the limit
+     *
+     * @return number of characters written to the stream
+     */
+    std::size_t format(std::ostream& stream, const std::size_t maxLength = VARIANT_FORMAT_UNLIMITED) const;
+
     /**
      * @brief Returns the variant value represented as byte array
      * @details If stored value is not a byte array, method will try to convert it. Supported data types are:
@@ -595,10 +627,37 @@ public:
     template <typename T>
     std::shared_ptr<T> getCustomType() const;
 
+    /**
+     * @brief Compares this Variant object to another Variant object.
+     * @details Both objects are compared in a single pass. Comparing logic depends on the underlying type:
+     *  \li numeric values of any type are compared by value (double values are compared with 0.00000001 precision)
+     *  \li bool or string values are compared using standard operators
+     *  \li vector or list values are compared by size (A.size() > B.size())
+     *  \li custom types are compared using their == and > operators
+     *  \li variants of different non-numeric types are ordered by their Variant::Type (empty variant is always the
+     *      smallest one)
+     *
+     * @param val The Variant object to compare to.
+     * @return 0 if objects are equal, 1 if this object is greater than val, -1 if this object is less than val.
+     */
+    int compare(const Variant& val) const;
+
+    /**
+     * @brief Calculates hash value of the stored data.
+     * @details Hash is consistent with operator==(): numeric variants which are equal to each other have the same hash
+     * regardless of their type. The only exception are double values which are not exactly equal, but are considered equal
+     * because of the comparison precision.
+     *
+     * Content of Type::CUSTOM values is not accessible to Variant, so all such values share the same hash.
+     *
+     * @return hash value
+     */
+    std::size_t hash() const;
+
     /**
      * @brief Compares this Variant object to another Variant object for equality.
      * @details Variant uses the == operator of the stored type to check for equality. Variants of different types will always
-     * compare as not equal.
+     * compare as not equal (except numeric types). Impelemented using compare().
      * @param val The Variant object to compare to.
      * @return true if this object is equal to val, false otherwise.
      */
@@ -614,10 +673,7 @@ public:
 
     /**
      * @brief Checks if this Variant object is greater than another Variant object.
-     * @details Operator only compares variants of the same type. Comparing logic depends on the underlying type:
-     *  \li numeric, bool or string values are compared using standard operator >
-     *  \li vector or list values are compared by size (A.size() > B.size())
-     *  \li other types are not supported and false is always returned
+     * @details Impelemented using compare(). See compare() for comparison rules.
      *
      * @param val The Variant object to compare to.
      * @return true if this object is greater than val, false otherwise.
@@ -626,7 +682,7 @@ public:
 
     /**
      * @brief Checks if this Variant object is greater than or equal to another Variant object.
-     * @details Impelemented using operator==() and operator>().
+     * @details Impelemented using compare().
      *
      * @param val The Variant object to compare to.
      * @return true if this object is greater than or equal to val, false otherwise.
@@ -635,7 +691,7 @@ public:
 
     /**
      * @brief Checks if this Variant object is less than another Variant object.
-     * @details Impelemented using operator!=() and operator>().
+     * @details Impelemented using compare().
      *
      * @param val The Variant object to compare to.
      * @return true if this object is less than val, false otherwise.
@@ -644,7 +700,7 @@ public:
 
     /**
      * @brief Checks if this Variant object is less than or equal to another Variant object.
-     * @details Impelemented using operator==() and operator>().
+     * @details Impelemented using compare().
      *
      * @param val The Variant object to compare to.
      * @return true if this object is less than or equal to val, false otherwise.
@@ -652,6 +708,8 @@ public:
     bool operator<=(const Variant& val) const;
 
 private:
+    class Output;
+
     Variant(std::shared_ptr<void> d, const Type t);
 
     template <typename T>
@@ -659,6 +717,10 @@ private:
 
     bool isSameObject(const Variant& val) const;
 
+    void format(Output& out) const;
+
+    static std::size_t hashCombine(const std::size_t seed, const std::size_t hashValue);
+
     template <typename T>
     void assign(const T& v, const Type t);
 
@@ -904,4 +966,18 @@ void Variant::createMemoryAllocator() {
 
 }  // namespace hsmcpp
 
+namespace std {
+
+/**
+ * @brief Specialization of std::hash for hsmcpp::Variant. Allows to use Variant as a key in unordered containers.
+ */
+template <>
+struct hash<hsmcpp::Variant> {
+    std::size_t operator()(const hsmcpp::Variant& val) const {
+        return val.hash();
+    }
+};
+
+}  // namespace std
+
 #endif  // HSMCPP_VARIANT_HPP
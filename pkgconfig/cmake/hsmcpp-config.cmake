@@ -35,7 +35,7 @@ endif()
 # load requested component
 list(LENGTH hsmcpp_FIND_COMPONENTS COMPONETS_COUNT)
 if (${COMPONETS_COUNT} LESS 1)
-  message(FATAL_ERROR "Please specify at least one 1 component for hsmcpp module. Possible values are: std, glibmm, glib, qt")
+  message(FATAL_ERROR "Please specify at least one 1 component for hsmcpp module. Possible values are: std, epoll, glibmm, glib, qt")
 endif()
 
 set(HSMCPP_INCLUDE_DIRS "")
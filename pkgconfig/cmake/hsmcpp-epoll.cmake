@@ -0,0 +1,5 @@
+pkg_check_modules(HSMCPP_EPOLL REQUIRED hsmcpp_epoll)
+
+set(HSMCPP_INCLUDE_DIRS ${HSMCPP_INCLUDE_DIRS} ${HSMCPP_EPOLL_INCLUDE_DIRS})
+set(HSMCPP_LDFLAGS ${HSMCPP_LDFLAGS} ${HSMCPP_EPOLL_LDFLAGS})
+set(HSMCPP_CFLAGS_OTHER ${HSMCPP_CFLAGS_OTHER} ${HSMCPP_EPOLL_CFLAGS_OTHER})
\ No newline at end of file
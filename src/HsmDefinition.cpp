@@ -0,0 +1,88 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include "HsmDefinition.hpp"
+
+namespace hsmcpp {
+
+namespace {
+// State IDs below this value are mapped to indexes using a plain array. Generated HSMs use sequential state IDs
+// starting from 0, so in practice all lookups are done in O(1) without touching the map
+constexpr StateID_t MAX_DIRECT_INDEXED_STATE_ID = 256;
+}  // namespace
+
+HsmDefinition::HsmDefinition(const StateID_t initial)
+    : initialState(initial) {}
+
+StateIndex_t HsmDefinition::getStateIndex(const StateID_t state) const {
+    StateIndex_t index = INVALID_STATE_INDEX;
+
+    if ((state >= 0) && (static_cast<size_t>(state) < mDirectStateIndexes.size())) {
+        index = mDirectStateIndexes[static_cast<size_t>(state)];
+    } else if ((state < 0) || (state >= MAX_DIRECT_INDEXED_STATE_ID)) {
+        const auto it = mStateIndexes.find(state);
+
+        if (mStateIndexes.end() != it) {
+            index = it->second;
+        }
+    } else {
+        // NOTE: do nothing. state wasn't registered
+    }
+
+    return index;
+}
+
+StateIndex_t HsmDefinition::registerStateIndex(const StateID_t state) {
+    StateIndex_t index = getStateIndex(state);
+
+    if (INVALID_STATE_INDEX == index) {
+        index = static_cast<StateIndex_t>(stateIds.size());
+
+        if ((state >= 0) && (state < MAX_DIRECT_INDEXED_STATE_ID)) {
+            if (static_cast<size_t>(state) >= mDirectStateIndexes.size()) {
+                mDirectStateIndexes.resize(static_cast<size_t>(state) + 1U, INVALID_STATE_INDEX);
+            }
+
+            mDirectStateIndexes[static_cast<size_t>(state)] = index;
+        } else {
+            mStateIndexes[state] = index;
+        }
+
+        stateIds.emplace_back(state);
+        stateFlags.emplace_back(STATE_FLAG_NONE);
+        onStateChangedCallbacks.emplace_back(nullptr);
+        onEnteringCallbacks.emplace_back(nullptr);
+        onExitingCallbacks.emplace_back(nullptr);
+        finalStateEvents.emplace_back(INVALID_HSM_EVENT_ID);
+        entryActions.emplace_back();
+        exitActions.emplace_back();
+    }
+
+    return index;
+}
+
+StateFlags_t HsmDefinition::getStateFlags(const StateIndex_t index) const {
+    StateFlags_t flags = STATE_FLAG_NONE;
+
+    if (index < stateFlags.size()) {
+        flags = stateFlags[index];
+    }
+
+    return flags;
+}
+
+bool HsmDefinition::hasStateFlag(const StateID_t state, const StateFlags_t flag) const {
+    return (0U != (getStateFlags(getStateIndex(state)) & flag));
+}
+
+void HsmDefinition::setStateFlags(const StateIndex_t index, const StateFlags_t flags, const bool enable) {
+    if (index < stateFlags.size()) {
+        if (true == enable) {
+            stateFlags[index] |= flags;
+        } else {
+            stateFlags[index] &= static_cast<StateFlags_t>(~flags);
+        }
+    }
+}
+
+}  // namespace hsmcpp
@@ -0,0 +1,119 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#ifndef HSMCPP_SRC_HSMDEFINITION_HPP
+#define HSMCPP_SRC_HSMDEFINITION_HPP
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "hsmcpp/HsmTypes.hpp"
+#include "HsmImplTypes.hpp"
+
+namespace hsmcpp {
+
+using StateIndex_t = uint32_t;  ///< Compacted index of the state in HsmDefinition per-state tables
+using StateFlags_t = uint8_t;   ///< Bitmask of STATE_FLAG_* values
+
+constexpr StateIndex_t INVALID_STATE_INDEX = UINT32_MAX;
+
+constexpr StateFlags_t STATE_FLAG_NONE = 0x00U;
+constexpr StateFlags_t STATE_FLAG_HAS_ENTER_CALLBACK = 0x01U;
+constexpr StateFlags_t STATE_FLAG_HAS_EXIT_CALLBACK = 0x02U;
+constexpr StateFlags_t STATE_FLAG_HAS_CHANGED_CALLBACK = 0x04U;
+constexpr StateFlags_t STATE_FLAG_FINAL = 0x08U;
+constexpr StateFlags_t STATE_FLAG_HAS_HISTORY = 0x10U;
+constexpr StateFlags_t STATE_FLAG_HAS_ENTRY_ACTIONS = 0x20U;
+constexpr StateFlags_t STATE_FLAG_HAS_EXIT_ACTIONS = 0x40U;
+constexpr StateFlags_t STATE_FLAG_HAS_ENTRY_POINTS = 0x80U;
+
+/**
+ * @brief Structure of the state machine.
+ * @details Contains everything which is registered with HierarchicalStateMachine::register*() API and doesn't change
+ * during HSM execution. Definition is shared between HSM instances created with
+ * HierarchicalStateMachine::HierarchicalStateMachine(const std::shared_ptr<const HsmDefinition>&). Once definition is
+ * shared it's never modified: registering anything new in one of the instances will first create its own copy of the
+ * definition (copy-on-write).
+ *
+ * Per-state data is stored in dense tables (struct-of-arrays) indexed by StateIndex_t. Index is assigned to the state
+ * the first time anything is registered for it. stateFlags allows to check with a single lookup if state has any
+ * callbacks or actions which need to be executed.
+ */
+class HsmDefinition {
+public:
+    explicit HsmDefinition(const StateID_t initial);
+
+    /**
+     * @brief Returns compacted index of the state.
+     * @param state state ID
+     * @return index in per-state tables or INVALID_STATE_INDEX if nothing was registered for this state
+     */
+    StateIndex_t getStateIndex(const StateID_t state) const;
+
+    /**
+     * @brief Returns index of the state. Allocates a new entry in all per-state tables if state didn't have it.
+     * @param state state ID
+     * @return index in per-state tables
+     */
+    StateIndex_t registerStateIndex(const StateID_t state);
+
+    /**
+     * @brief Returns flags of the state.
+     * @param index compacted state index. INVALID_STATE_INDEX is allowed.
+     * @return combination of STATE_FLAG_* values or STATE_FLAG_NONE if index is invalid
+     */
+    StateFlags_t getStateFlags(const StateIndex_t index) const;
+
+    /**
+     * @brief Checks if state has specified flag set.
+     * @param state state ID
+     * @param flag one of STATE_FLAG_* values
+     * @return true if state is registered and has flag set
+     */
+    bool hasStateFlag(const StateID_t state, const StateFlags_t flag) const;
+
+    /**
+     * @brief Sets or clears specified flags of the state.
+     * @param index compacted state index
+     * @param flags combination of STATE_FLAG_* values
+     * @param enable true to set flags, false to clear them
+     */
+    void setStateFlags(const StateIndex_t index, const StateFlags_t flags, const bool enable);
+
+    StateID_t initialState = INVALID_HSM_STATE_ID;
+    std::multimap<std::pair<StateID_t, EventID_t>, TransitionInfo> transitionsByEvent;  // FROM_STATE, EVENT => TO
+    std::multimap<StateID_t, StateID_t> substates;
+    std::multimap<StateID_t, StateEntryPoint> substateEntryPoints;
+    std::map<TimerID_t, EventID_t> timers;
+
+    // parent state, history state
+    std::multimap<StateID_t, StateID_t> historyStates;
+    // history state id, data
+    std::map<StateID_t, HistoryInfo> historyData;
+
+    // per-state tables. All of them have the same size and are indexed by StateIndex_t
+    std::vector<StateID_t> stateIds;
+    std::vector<StateFlags_t> stateFlags;
+    std::vector<HsmContextStateChangedCallback_t> onStateChangedCallbacks;
+    std::vector<HsmContextStateEnterCallback_t> onEnteringCallbacks;
+    std::vector<HsmContextStateExitCallback_t> onExitingCallbacks;
+    std::vector<EventID_t> finalStateEvents;
+    std::vector<std::vector<StateActionInfo>> entryActions;
+    std::vector<std::vector<StateActionInfo>> exitActions;
+
+#ifdef HSM_ENABLE_SAFE_STRUCTURE
+    std::list<StateID_t> topLevelStates;  // list of states which are not substates and dont have substates of their own
+#endif
+
+private:
+    // states with ID in range [0, size) are mapped to indexes directly. Rest of the states are stored in the map
+    std::vector<StateIndex_t> mDirectStateIndexes;
+    std::map<StateID_t, StateIndex_t> mStateIndexes;
+};
+
+}  // namespace hsmcpp
+
+#endif  // HSMCPP_SRC_HSMDEFINITION_HPP
@@ -3,6 +3,9 @@
 
 #include "hsmcpp/HsmEventDispatcherBase.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #include "hsmcpp/logging.hpp"
 #include "hsmcpp/os/CriticalSection.hpp"
 #include "hsmcpp/os/LockGuard.hpp"
@@ -11,11 +14,20 @@ namespace hsmcpp {
 
 constexpr const char* HSM_TRACE_CLASS = "HsmEventDispatcherBase";
 
+namespace {
+// platform timers use milliseconds. interval is rounded up to make sure that timer doesn't expire too early
+unsigned int toIntervalMs(const uint64_t intervalUs) {
+    return static_cast<unsigned int>((intervalUs + 999u) / 1000u);
+}
+}  // namespace
+
 HsmEventDispatcherBase::EnqueuedEventInfo::EnqueuedEventInfo(const HandlerID_t newHandlerID, const EventID_t newEventID)
     : handlerID(newHandlerID)
     , eventID(newEventID) {}
 
-HsmEventDispatcherBase::HsmEventDispatcherBase(const size_t eventsCacheSize) {
+HsmEventDispatcherBase::HsmEventDispatcherBase(const size_t eventsCacheSize, const size_t readyQueueSize)
+    // cppcheck-suppress misra-c2012-10.4 ; false-positive. thinks that ':' is arithmetic operation
+    : mReadyEvents(readyQueueSize) {
     mEnqueuedEvents.reserve(eventsCacheSize);
 }
 
@@ -38,12 +50,8 @@ void HsmEventDispatcherBase::stop() {
 
 HandlerID_t HsmEventDispatcherBase::registerEventHandler(const EventHandlerFunc_t& handler) {
     HSM_TRACE_CALL_DEBUG();
-    HandlerID_t id = getNextHandlerID();
-    LockGuard lck(mHandlersSync);
-
-    mEventHandlers[id] = handler;
 
-    return id;
+    return mEventHandlers.add(handler);
 }
 
 void HsmEventDispatcherBase::unregisterEventHandler(const HandlerID_t handlerID) {
@@ -51,23 +59,25 @@ void HsmEventDispatcherBase::unregisterEventHandler(const HandlerID_t handlerID)
 
     {
         LockGuard lck(mEmitSync);
-        mPendingEvents.remove(handlerID);
-    }
-    {
-        LockGuard lck(mHandlersSync);
-        mEventHandlers.erase(handlerID);
+        mPendingEvents.erase(std::remove(mPendingEvents.begin(), mPendingEvents.end(), handlerID), mPendingEvents.end());
     }
+
+    (void)mEventHandlers.remove(handlerID);
 }
 
 void HsmEventDispatcherBase::emitEvent(const HandlerID_t handlerID) {
     HSM_TRACE_CALL_DEBUG();
 
-    {
-        LockGuard lck(mEmitSync);
-        mPendingEvents.emplace_back(handlerID);
-    }
+    // NOTE: if handler is already in the queue it will process this event too. Handler is unmarked right before it's
+    //       called, so emits done during its execution will schedule it again
+    if (true == mEventHandlers.trySchedule(handlerID)) {
+        if (false == mReadyEvents.push(handlerID)) {
+            LockGuard lck(mEmitSync);
+            mPendingEvents.push_back(handlerID);
+        }
 
-    notifyDispatcherAboutEvent();
+        notifyDispatcherAboutEvent();
+    }
 
     // NOTE: this is not a full implementation. child classes must implement additional logic
 }
@@ -101,19 +111,14 @@ void HsmEventDispatcherBase::enqueueAction(ActionHandlerFunc_t actionCallback) {
 
 HandlerID_t HsmEventDispatcherBase::registerEnqueuedEventHandler(const EnqueuedEventHandlerFunc_t& handler) {
     HSM_TRACE_CALL_DEBUG();
-    HandlerID_t id = getNextHandlerID();
-    LockGuard lck(mHandlersSync);
-
-    mEnqueuedEventHandlers[id] = handler;
 
-    return id;
+    return mEnqueuedEventHandlers.add(handler);
 }
 
 void HsmEventDispatcherBase::unregisterEnqueuedEventHandler(const HandlerID_t handlerID) {
     HSM_TRACE_CALL_DEBUG_ARGS("handlerID=%d", handlerID);
-    LockGuard lck(mHandlersSync);
 
-    mEnqueuedEventHandlers.erase(handlerID);
+    (void)mEnqueuedEventHandlers.remove(handlerID);
 }
 
 HandlerID_t HsmEventDispatcherBase::registerTimerHandler(const TimerHandlerFunc_t& handler) {
@@ -133,7 +138,7 @@ void HsmEventDispatcherBase::unregisterTimerHandler(const HandlerID_t handlerID)
         for (auto itTimer = mActiveTimers.begin(); itTimer != mActiveTimers.end();) {
             if (handlerID == itTimer->second.handlerID) {
                 stopTimerImpl(itTimer->first);
-                itTimer = mActiveTimers.erase(itTimer);
+                itTimer = eraseTimer(itTimer);
             } else {
                 ++itTimer;
             }
@@ -147,68 +152,178 @@ void HsmEventDispatcherBase::startTimer(const HandlerID_t handlerID,
                                         const TimerID_t timerID,
                                         const unsigned int intervalMs,
                                         const bool isSingleShot) {
-    HSM_TRACE_CALL_DEBUG_ARGS("handlerID=%d, timerID=%d, intervalMs=%u, isSingleShot=%d",
+    startTimerInternal(handlerID, timerID, static_cast<uint64_t>(intervalMs) * 1000u, 0u, isSingleShot);
+}
+
+void HsmEventDispatcherBase::startTimerUs(const HandlerID_t handlerID,
+                                          const TimerID_t timerID,
+                                          const uint64_t intervalUs,
+                                          const bool isSingleShot) {
+    startTimerInternal(handlerID, timerID, intervalUs, 0u, isSingleShot);
+}
+
+void HsmEventDispatcherBase::startTimerWithSlack(const HandlerID_t handlerID,
+                                                 const TimerID_t timerID,
+                                                 const unsigned int intervalMs,
+                                                 const unsigned int slackMs,
+                                                 const bool isSingleShot) {
+    startTimerInternal(handlerID, timerID, static_cast<uint64_t>(intervalMs) * 1000u, slackMs, isSingleShot);
+}
+
+void HsmEventDispatcherBase::setMissedTicksPolicy(const MissedTicksPolicy policy) {
+    mMissedTicksPolicy = policy;
+}
+
+MissedTicksPolicy HsmEventDispatcherBase::getMissedTicksPolicy() const {
+    return mMissedTicksPolicy;
+}
+
+void HsmEventDispatcherBase::restartTimer(const TimerID_t timerID) {
+    HSM_TRACE_CALL_DEBUG_ARGS("timerID=%d", SC2INT(timerID));
+    LockGuard lck(mHandlersSync);
+
+    for (const auto& timer : mActiveTimers) {
+        if (timerID == timer.second.timerID) {
+            restartTimerImpl(timer.first, toIntervalMs(timer.second.intervalUs), timer.second.isSingleShot);
+        }
+    }
+}
+
+void HsmEventDispatcherBase::restartTimer(const HandlerID_t handlerID, const TimerID_t timerID) {
+    HSM_TRACE_CALL_DEBUG_ARGS("handlerID=%d, timerID=%d", handlerID, SC2INT(timerID));
+    LockGuard lck(mHandlersSync);
+    auto it = mActiveTimers.find(findTimer(handlerID, timerID));
+
+    if (mActiveTimers.end() != it) {
+        restartTimerImpl(it->first, toIntervalMs(it->second.intervalUs), it->second.isSingleShot);
+    }
+}
+
+void HsmEventDispatcherBase::stopTimer(const TimerID_t timerID) {
+    HSM_TRACE_CALL_DEBUG_ARGS("timerID=%d", SC2INT(timerID));
+    LockGuard lck(mHandlersSync);
+
+    HSM_TRACE_DEBUG("mActiveTimers=%lu", mActiveTimers.size());
+
+    for (auto it = mActiveTimers.begin(); it != mActiveTimers.end();) {
+        if (timerID == it->second.timerID) {
+            stopTimerImpl(it->first);
+            it = eraseTimer(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void HsmEventDispatcherBase::stopTimer(const HandlerID_t handlerID, const TimerID_t timerID) {
+    HSM_TRACE_CALL_DEBUG_ARGS("handlerID=%d, timerID=%d", handlerID, SC2INT(timerID));
+    LockGuard lck(mHandlersSync);
+    auto it = mActiveTimers.find(findTimer(handlerID, timerID));
+
+    if (mActiveTimers.end() != it) {
+        stopTimerImpl(it->first);
+        (void)eraseTimer(it);
+    }
+}
+
+bool HsmEventDispatcherBase::isTimerRunning(const TimerID_t timerID) {
+    LockGuard lck(mHandlersSync);
+    bool isRunning = false;
+
+    for (const auto& timer : mActiveTimers) {
+        if (timerID == timer.second.timerID) {
+            isRunning = true;
+            break;
+        }
+    }
+
+    return isRunning;
+}
+
+bool HsmEventDispatcherBase::isTimerRunning(const HandlerID_t handlerID, const TimerID_t timerID) {
+    LockGuard lck(mHandlersSync);
+    return (INVALID_HSM_TIMER_ID != findTimer(handlerID, timerID));
+}
+
+void HsmEventDispatcherBase::startTimerInternal(const HandlerID_t handlerID,
+                                                const TimerID_t timerID,
+                                                const uint64_t intervalUs,
+                                                const unsigned int slackMs,
+                                                const bool isSingleShot) {
+    HSM_TRACE_CALL_DEBUG_ARGS("handlerID=%d, timerID=%d, intervalUs=%llu, slackMs=%u, isSingleShot=%d",
                               handlerID,
                               timerID,
-                              intervalMs,
+                              static_cast<unsigned long long>(intervalUs),
+                              slackMs,
                               BOOL2INT(isSingleShot));
-    if (intervalMs > 0u) {
+    if (intervalUs > 0u) {
         LockGuard lck(mHandlersSync);
 
         if (mTimerHandlers.find(handlerID) != mTimerHandlers.end()) {
-            auto it = mActiveTimers.find(timerID);
+            auto it = mActiveTimers.find(findTimer(handlerID, timerID));
 
             if (mActiveTimers.end() != it) {
-                it->second.handlerID = handlerID;
-                it->second.intervalMs = intervalMs;
+                it->second.intervalUs = intervalUs;
+                it->second.slackMs = slackMs;
                 it->second.isSingleShot = isSingleShot;
 
                 // restart timer
-                stopTimerImpl(timerID);
-                startTimerImpl(timerID, it->second.intervalMs, it->second.isSingleShot);
+                stopTimerImpl(it->first);
+                startTimerImpl(it->first, toIntervalMs(intervalUs), isSingleShot);
             } else {
+                // NOTE: timer IDs are unique only within a handler. Platform specific implementation gets
+                //       dispatcher-wide ID to avoid collisions between handlers
+                const TimerID_t newTimerID = allocateTimerID();
                 TimerInfo newTimer;
 
                 newTimer.handlerID = handlerID;
-                newTimer.intervalMs = intervalMs;
+                newTimer.timerID = timerID;
+                newTimer.intervalUs = intervalUs;
+                newTimer.slackMs = slackMs;
                 newTimer.isSingleShot = isSingleShot;
 
-                mActiveTimers[timerID] = newTimer;
-                startTimerImpl(timerID, intervalMs, isSingleShot);
+                mActiveTimers[newTimerID] = newTimer;
+                mTimerIDs[makeTimerKey(handlerID, timerID)] = newTimerID;
+                startTimerImpl(newTimerID, toIntervalMs(intervalUs), isSingleShot);
             }
         }
     } else {
-        HSM_TRACE_WARNING("skip. intervalMs must be larger than zero");
+        HSM_TRACE_WARNING("skip. interval must be larger than zero");
     }
 }
 
-void HsmEventDispatcherBase::restartTimer(const TimerID_t timerID) {
-    HSM_TRACE_CALL_DEBUG_ARGS("timerID=%d", SC2INT(timerID));
-    LockGuard lck(mHandlersSync);
-    auto it = mActiveTimers.find(timerID);
+uint64_t HsmEventDispatcherBase::makeTimerKey(const HandlerID_t handlerID, const TimerID_t timerID) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(handlerID)) << 32) |
+           static_cast<uint64_t>(static_cast<uint32_t>(timerID));
+}
 
-    if (mActiveTimers.end() != it) {
-        stopTimerImpl(timerID);
-        startTimerImpl(timerID, it->second.intervalMs, it->second.isSingleShot);
+TimerID_t HsmEventDispatcherBase::findTimer(const HandlerID_t handlerID, const TimerID_t timerID) const {
+    TimerID_t id = INVALID_HSM_TIMER_ID;
+    auto it = mTimerIDs.find(makeTimerKey(handlerID, timerID));
+
+    if (mTimerIDs.end() != it) {
+        id = it->second;
     }
+
+    return id;
 }
 
-void HsmEventDispatcherBase::stopTimer(const TimerID_t timerID) {
-    HSM_TRACE_CALL_DEBUG_ARGS("timerID=%d", SC2INT(timerID));
-    LockGuard lck(mHandlersSync);
-    auto it = mActiveTimers.find(timerID);
+TimerID_t HsmEventDispatcherBase::allocateTimerID() {
+    TimerID_t id = INVALID_HSM_TIMER_ID;
 
-    HSM_TRACE_DEBUG("mActiveTimers=%lu", mActiveTimers.size());
+    // NOTE: after overflow IDs of stopped and expired timers are reused
+    do {
+        id = mNextTimerID;
+        mNextTimerID = ((std::numeric_limits<TimerID_t>::max() == id) ? 1 : (id + 1));
+    } while (mActiveTimers.end() != mActiveTimers.find(id));
 
-    if (mActiveTimers.end() != it) {
-        stopTimerImpl(timerID);
-        mActiveTimers.erase(it);
-    }
+    return id;
 }
 
-bool HsmEventDispatcherBase::isTimerRunning(const TimerID_t timerID) {
-    LockGuard lck(mHandlersSync);
-    return (mActiveTimers.find(timerID) != mActiveTimers.end());
+std::unordered_map<TimerID_t, HsmEventDispatcherBase::TimerInfo>::iterator HsmEventDispatcherBase::eraseTimer(
+    std::unordered_map<TimerID_t, TimerInfo>::iterator it) {
+    (void)mTimerIDs.erase(makeTimerKey(it->second.handlerID, it->second.timerID));
+    return mActiveTimers.erase(it);
 }
 
 int HsmEventDispatcherBase::getNextHandlerID() {
@@ -216,17 +331,17 @@ int HsmEventDispatcherBase::getNextHandlerID() {
 }
 
 void HsmEventDispatcherBase::unregisterAllEventHandlers() {
-    LockGuard lck(mHandlersSync);
     mEventHandlers.clear();
 }
 
 EnqueuedEventHandlerFunc_t HsmEventDispatcherBase::getEnqueuedEventHandlerFunc(const HandlerID_t handlerID) const {
     // cppcheck-suppress misra-c2012-17.7 ; false-positive. This a function pointer, not function call.
     EnqueuedEventHandlerFunc_t func;
-    auto it = mEnqueuedEventHandlers.find(handlerID);
+    HsmHandlerRegistry<EnqueuedEventHandlerFunc_t>::ReadGuard readGuard(mEnqueuedEventHandlers);
+    const EnqueuedEventHandlerFunc_t* handler = mEnqueuedEventHandlers.find(handlerID);
 
-    if (mEnqueuedEventHandlers.end() != it) {
-        func = it->second;
+    if (nullptr != handler) {
+        func = *handler;
     }
 
     return func;
@@ -244,18 +359,146 @@ TimerHandlerFunc_t HsmEventDispatcherBase::getTimerHandlerFunc(const HandlerID_t
     return func;
 }
 
+unsigned int HsmEventDispatcherBase::getTimerSlack(const TimerID_t timerID) const {
+    unsigned int slackMs = 0;
+    auto it = mActiveTimers.find(timerID);
+
+    if (mActiveTimers.end() != it) {
+        slackMs = it->second.slackMs;
+    }
+
+    return slackMs;
+}
+
+uint64_t HsmEventDispatcherBase::getTimerIntervalUs(const TimerID_t timerID) const {
+    uint64_t intervalUs = 0;
+    auto it = mActiveTimers.find(timerID);
+
+    if (mActiveTimers.end() != it) {
+        intervalUs = it->second.intervalUs;
+    }
+
+    return intervalUs;
+}
+
 void HsmEventDispatcherBase::startTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) {
     // do nothing. must be implemented in platfrom specific dispatcher
 }
 
+void HsmEventDispatcherBase::restartTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) {
+    stopTimerImpl(timerID);
+    startTimerImpl(timerID, intervalMs, isSingleShot);
+}
+
 void HsmEventDispatcherBase::stopTimerImpl(const TimerID_t timerID) {
     // do nothing. must be implemented in platfrom specific dispatcher
 }
 
+HandlerID_t HsmEventDispatcherBase::watchFd(const int fd, const FdEvents_t events, const FdWatchHandlerFunc_t& handler) {
+    HSM_TRACE_CALL_DEBUG_ARGS("fd=%d, events=%d", fd, SC2INT(events));
+    HandlerID_t watchID = INVALID_HSM_DISPATCHER_HANDLER_ID;
+
+    if ((fd >= 0) && (0U != (events & (HSM_FD_READABLE | HSM_FD_WRITABLE))) && handler) {
+        LockGuard lck(mHandlersSync);
+        const HandlerID_t newWatchID = getNextHandlerID();
+        FdWatchInfo& watchInfo = mFdWatches[newWatchID];
+
+        // NOTE: watch must be registered before calling watchFdImpl() because some implementations could start
+        //       reporting fd events immediately
+        watchInfo.fd = fd;
+        watchInfo.events = events;
+        watchInfo.handler = handler;
+
+        if (true == watchFdImpl(newWatchID, fd, events)) {
+            watchID = newWatchID;
+        } else {
+            HSM_TRACE_ERROR("failed to watch fd=%d", fd);
+            mFdWatches.erase(newWatchID);
+        }
+    }
+
+    return watchID;
+}
+
+void HsmEventDispatcherBase::unwatchFd(const HandlerID_t watchID) {
+    HSM_TRACE_CALL_DEBUG_ARGS("watchID=%d", watchID);
+    LockGuard lck(mHandlersSync);
+    auto it = mFdWatches.find(watchID);
+
+    if (mFdWatches.end() != it) {
+        unwatchFdImpl(watchID, it->second.fd);
+        mFdWatches.erase(it);
+    }
+}
+
+void HsmEventDispatcherBase::unwatchAllFds() {
+    LockGuard lck(mHandlersSync);
+
+    for (const auto& watch : mFdWatches) {
+        unwatchFdImpl(watch.first, watch.second.fd);
+    }
+
+    mFdWatches.clear();
+}
+
+bool HsmEventDispatcherBase::watchFdImpl(const HandlerID_t watchID, const int fd, const FdEvents_t events) {
+    // do nothing. must be implemented in platfrom specific dispatcher
+    return false;
+}
+
+void HsmEventDispatcherBase::unwatchFdImpl(const HandlerID_t watchID, const int fd) {
+    // do nothing. must be implemented in platfrom specific dispatcher
+}
+
+bool HsmEventDispatcherBase::handleFdWatchEvent(const HandlerID_t watchID, const FdEvents_t events) {
+    HSM_TRACE_CALL_DEBUG_ARGS("watchID=%d, events=%d", watchID, SC2INT(events));
+    bool isWatched = false;
+    // cppcheck-suppress misra-c2012-17.7 ; false-positive. This a function pointer, not function call.
+    FdWatchHandlerFunc_t handler;
+    int fd = -1;
+
+    {
+        LockGuard lck(mHandlersSync);
+        auto it = mFdWatches.find(watchID);
+
+        if (mFdWatches.end() != it) {
+            handler = it->second.handler;
+            fd = it->second.fd;
+        }
+    }
+
+    // NOTE: handler is called without holding mHandlersSync so that it could use watchFd()/unwatchFd() API
+    // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::function has a bool() operator
+    if (handler) {
+        isWatched = handler(fd, events);
+
+        if (false == isWatched) {
+            unwatchFd(watchID);
+        }
+    }
+
+    return isWatched;
+}
+
 unsigned int HsmEventDispatcherBase::handleTimerEvent(const TimerID_t timerID) {
-    HSM_TRACE_CALL_DEBUG_ARGS("timerID=%d", SC2INT(timerID));
+    uint64_t nextIntervalUs = 0;
+    unsigned int nextSlackMs = 0;
     unsigned int nextIntervalMs = 0;
 
+    if (true == handleTimerEvent(timerID, nextIntervalUs, nextSlackMs)) {
+        nextIntervalMs = toIntervalMs(nextIntervalUs);
+    }
+
+    return nextIntervalMs;
+}
+
+bool HsmEventDispatcherBase::handleTimerEvent(const TimerID_t timerID, uint64_t& nextIntervalUs, unsigned int& nextSlackMs) {
+    HSM_TRACE_CALL_DEBUG_ARGS("timerID=%d", SC2INT(timerID));
+    bool restartTimer = false;
+
+    nextIntervalUs = 0;
+    nextSlackMs = 0;
+
     if (INVALID_HSM_TIMER_ID != timerID) {
         // NOTE: should lock the whole block to prevent situation when timer handler is unregistered during handler execution
         LockGuard lck(mHandlersSync);
@@ -267,26 +510,30 @@ unsigned int HsmEventDispatcherBase::handleTimerEvent(const TimerID_t timerID) {
 
             if (INVALID_HSM_DISPATCHER_HANDLER_ID != itTimer->second.handlerID) {
                 TimerHandlerFunc_t timerHandler = getTimerHandlerFunc(itTimer->second.handlerID);
+                const TimerID_t handlerTimerID = itTimer->second.timerID;
 
-                nextIntervalMs = ((true == itTimer->second.isSingleShot) ? 0 : itTimer->second.intervalMs);
+                restartTimer = (false == itTimer->second.isSingleShot);
 
                 // Remove singleshot timer from active list
-                if (0u == nextIntervalMs) {
-                    mActiveTimers.erase(itTimer);
+                if (true == restartTimer) {
+                    nextIntervalUs = itTimer->second.intervalUs;
+                    nextSlackMs = itTimer->second.slackMs;
+                } else {
+                    (void)eraseTimer(itTimer);
                 }
 
-                timerHandler(timerID);
+                timerHandler(handlerTimerID);
             }
         }
     }
 
-    return nextIntervalMs;
+    return restartTimer;
 }
 
 void HsmEventDispatcherBase::dispatchEnqueuedEvents() {
     if ((false == mStopDispatcher) && (false == mEnqueuedEvents.empty())) {
         HandlerID_t prevHandlerID = INVALID_HSM_DISPATCHER_HANDLER_ID;
-        EnqueuedEventHandlerFunc_t callback;
+        const EnqueuedEventHandlerFunc_t* callback = nullptr;
         std::vector<EnqueuedEventInfo> currentEvents;
 
         {
@@ -297,15 +544,23 @@ void HsmEventDispatcherBase::dispatchEnqueuedEvents() {
             mEnqueuedEvents.clear();
         }
 
-        // need to traverse events in reverse order
-        for (auto it = currentEvents.rbegin(); (it != currentEvents.rend()) && (false == mStopDispatcher); ++it) {
-            if (prevHandlerID != it->handlerID) {
-                callback = getEnqueuedEventHandlerFunc(it->handlerID);
-                prevHandlerID = it->handlerID;
-            }
+        {
+            HsmHandlerRegistry<EnqueuedEventHandlerFunc_t>::ReadGuard readGuard(mEnqueuedEventHandlers);
+
+            // need to traverse events in reverse order
+            for (auto it = currentEvents.rbegin(); (it != currentEvents.rend()) && (false == mStopDispatcher); ++it) {
+                if (prevHandlerID != it->handlerID) {
+                    callback = mEnqueuedEventHandlers.find(it->handlerID);
+                    prevHandlerID = it->handlerID;
+                }
 
-            callback(it->eventID);
+                if (nullptr != callback) {
+                    (void)(*callback)(it->eventID);
+                }
+            }
         }
+
+        mEnqueuedEventHandlers.collect();
     }
 }
 
@@ -325,41 +580,66 @@ void HsmEventDispatcherBase::dispatchPendingActions() {
 }
 
 void HsmEventDispatcherBase::dispatchPendingEvents() {
-    std::list<HandlerID_t> events;
+    std::vector<HandlerID_t> events;
+    HandlerID_t handlerID = INVALID_HSM_DISPATCHER_HANDLER_ID;
 
+    // NOTE: spare buffer keeps capacity of previously dispatched events, so dispatching doesn't need to allocate.
+    //       It's empty only if dispatchPendingEvents() is called recursively from a handler
+    events.swap(mSparePendingEvents);
     dispatchPendingActions();
 
+    // NOTE: number of handlers taken at once is limited, so that producers which keep emitting events can't block
+    //       processing of timers and other dispatcher activities
+    for (size_t i = 0; (i < mReadyEvents.capacity()) && (true == mReadyEvents.pop(handlerID)); ++i) {
+        events.push_back(handlerID);
+    }
+
     if (false == mPendingEvents.empty()) {
         LockGuard lck(mEmitSync);
-        events = std::move(mPendingEvents);
+
+        events.insert(events.end(), mPendingEvents.begin(), mPendingEvents.end());
+        mPendingEvents.clear();
     }
 
     dispatchPendingEventsImpl(events);
+    events.clear();
+
+    if (events.capacity() > mSparePendingEvents.capacity()) {
+        mSparePendingEvents.swap(events);
+    }
+
+    // some handlers were left in the queue
+    if (false == mReadyEvents.empty()) {
+        notifyDispatcherAboutEvent();
+    }
 }
 
-void HsmEventDispatcherBase::dispatchPendingEventsImpl(const std::list<HandlerID_t>& events) {
+bool HsmEventDispatcherBase::hasPendingEvents() const {
+    // NOTE: it's assumed that calling empty() is thread-safe. Even if due to a race condition we get wrong value it
+    //       will only cause a small delay in event processing, but won't cause any critical issues
+    return (false == mReadyEvents.empty()) || (false == mPendingEvents.empty()) || (false == mPendingActions.empty());
+}
+
+void HsmEventDispatcherBase::dispatchPendingEventsImpl(const std::vector<HandlerID_t>& events) {
     dispatchEnqueuedEvents();
 
     if ((false == mStopDispatcher) && (false == events.empty())) {
-        std::map<HandlerID_t, EventHandlerFunc_t> eventHandlersCopy;
-
         {
-            // TODO: workaround to prevent recursive lock if registerEventHandler/unregisterEventHandler is called from handler
-            // callback
-            LockGuard lck(mHandlersSync);
-            eventHandlersCopy = mEventHandlers;
-        }
+            HsmHandlerRegistry<EventHandlerFunc_t>::ReadGuard readGuard(mEventHandlers);
 
-        for (auto it = events.begin(); (it != events.end()) && (false == mStopDispatcher); ++it) {
-            auto itHandler = eventHandlersCopy.find(*it);
+            for (auto it = events.begin(); (it != events.end()) && (false == mStopDispatcher); ++it) {
+                const EventHandlerFunc_t* handler = mEventHandlers.takeScheduled(*it);
 
-            if (itHandler != eventHandlersCopy.end()) {
-                // NOTE: if callback returns FALSE it means the handler doesn't want to process more events
-                if (false == itHandler->second()) {
-                    eventHandlersCopy.erase(itHandler);
+                // NOTE: handler returns FALSE if it doesn't want to process more events. Since each handler is present
+                //       in the list only once there is nothing else to skip
+                if (nullptr != handler) {
+                    (void)(*handler)();
                 }
             }
         }
+
+        // destroy handlers which were unregistered while they were being used
+        mEventHandlers.collect();
     }
 }
 
@@ -0,0 +1,281 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include "hsmcpp/HsmEventDispatcherBusyPoll.hpp"
+
+#ifdef __linux__
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+#include <limits>
+
+#include "hsmcpp/logging.hpp"
+#include "hsmcpp/os/CpuRelax.hpp"
+#include "hsmcpp/os/LockGuard.hpp"
+
+namespace hsmcpp {
+
+#undef HSM_TRACE_CLASS
+#define HSM_TRACE_CLASS "HsmEventDispatcherBusyPoll"
+
+namespace {
+// back-off levels of idle dispatcher thread (in number of iterations without any work)
+constexpr unsigned int IDLE_SPIN_ITERATIONS = 1000u;
+constexpr unsigned int IDLE_YIELD_ITERATIONS = IDLE_SPIN_ITERATIONS + 100u;
+constexpr std::chrono::microseconds IDLE_SLEEP_DURATION(50);
+}  // namespace
+
+HsmEventDispatcherBusyPoll::HsmEventDispatcherBusyPoll(const IdleMode idleMode,
+                                                       const int cpu,
+                                                       const size_t queueSize,
+                                                       const size_t eventsCacheSize)
+    // cppcheck-suppress misra-c2012-10.4 ; false-positive. thinks that ':' is arithmetic operation
+    : HsmEventDispatcherBase(eventsCacheSize, queueSize)
+    , mIdleMode(idleMode)
+    , mCpu(cpu)
+    , mIsStarted(false)
+    , mHasPendingEvents(false)
+    , mNextDeadline(std::numeric_limits<ClockRep_t>::max()) {
+    HSM_TRACE_CALL_DEBUG();
+}
+
+HsmEventDispatcherBusyPoll::~HsmEventDispatcherBusyPoll() {
+    HSM_TRACE_CALL_DEBUG();
+
+    HsmEventDispatcherBusyPoll::stop();
+    join();
+}
+
+std::shared_ptr<HsmEventDispatcherBusyPoll> HsmEventDispatcherBusyPoll::create(const IdleMode idleMode,
+                                                                               const int cpu,
+                                                                               const size_t queueSize,
+                                                                               const size_t eventsCacheSize) {
+    return std::shared_ptr<HsmEventDispatcherBusyPoll>(
+        new HsmEventDispatcherBusyPoll(idleMode, cpu, queueSize, eventsCacheSize),
+        &HsmEventDispatcherBase::handleDelete);
+}
+
+bool HsmEventDispatcherBusyPoll::deleteSafe() {
+    bool deleteNow = true;
+
+    // NOTE: destructor joins dispatcher thread, so it can't be called from it. In this case instance is deleted by a
+    //       separate thread once current handler returns (dispatcher is already stopped)
+    if (std::this_thread::get_id() == mDispatcherThread.get_id()) {
+        std::thread([this]() {
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): deleteSafe() is only called from handleDelete()
+            delete this;
+        }).detach();
+
+        deleteNow = false;
+    }
+
+    return deleteNow;
+}
+
+void HsmEventDispatcherBusyPoll::emitEvent(const HandlerID_t handlerID) {
+    HSM_TRACE_CALL_DEBUG();
+
+    HsmEventDispatcherBase::emitEvent(handlerID);
+}
+
+bool HsmEventDispatcherBusyPoll::start() {
+    HSM_TRACE_CALL_DEBUG();
+    bool result = false;
+
+    if (false == mDispatcherThread.joinable()) {
+        HSM_TRACE_DEBUG("starting thread...");
+        mStopDispatcher = false;
+        mIsStarted = true;
+        mDispatcherThread = std::thread(&HsmEventDispatcherBusyPoll::doDispatching, this);
+        result = mDispatcherThread.joinable();
+    } else {
+        result = (mDispatcherThread.get_id() != std::thread::id());
+    }
+
+    return result;
+}
+
+void HsmEventDispatcherBusyPoll::stop() {
+    HSM_TRACE_CALL_DEBUG();
+
+    HsmEventDispatcherBase::stop();
+    // NOTE: dispatcher thread polls mIsStarted since mStopDispatcher is not atomic
+    mIsStarted = false;
+    unregisterAllEventHandlers();
+}
+
+void HsmEventDispatcherBusyPoll::join() {
+    HSM_TRACE_CALL_DEBUG();
+
+    if (true == mDispatcherThread.joinable()) {
+        mDispatcherThread.join();
+    }
+}
+
+void HsmEventDispatcherBusyPoll::startTimerImpl(const TimerID_t timerID,
+                                                const unsigned int intervalMs,
+                                                const bool isSingleShot) {
+    HSM_TRACE_CALL_ARGS("timerID=%d, intervalMs=%d, isSingleShot=%d", SC2INT(timerID), intervalMs, BOOL2INT(isSingleShot));
+    LockGuard lck(mRunningTimersSync);
+    const HsmTimerQueue::TimePoint_t deadline =
+        HsmTimerQueue::alignDeadline(HsmTimerQueue::Clock_t::now() + std::chrono::microseconds(getTimerIntervalUs(timerID)),
+                                     getTimerSlack(timerID));
+
+    mRunningTimers.schedule(timerID, deadline);
+    updateNextDeadline();
+}
+
+void HsmEventDispatcherBusyPoll::stopTimerImpl(const TimerID_t timerID) {
+    HSM_TRACE_CALL_ARGS("timerID=%d", SC2INT(timerID));
+    LockGuard lck(mRunningTimersSync);
+
+    (void)mRunningTimers.remove(timerID);
+    updateNextDeadline();
+}
+
+void HsmEventDispatcherBusyPoll::restartTimerImpl(const TimerID_t timerID,
+                                                  const unsigned int intervalMs,
+                                                  const bool isSingleShot) {
+    HSM_TRACE_CALL_ARGS("timerID=%d, intervalMs=%d, isSingleShot=%d", SC2INT(timerID), intervalMs, BOOL2INT(isSingleShot));
+    const HsmTimerQueue::TimePoint_t deadline =
+        HsmTimerQueue::alignDeadline(HsmTimerQueue::Clock_t::now() + std::chrono::microseconds(getTimerIntervalUs(timerID)),
+                                     getTimerSlack(timerID));
+    bool isPostponed = false;
+
+    {
+        LockGuard lck(mRunningTimersSync);
+
+        // NOTE: postponed timer doesn't change the earliest deadline. Timer is moved to the new deadline when the old
+        //       one is reached
+        isPostponed = mRunningTimers.postpone(timerID, deadline);
+    }
+
+    // timer already expired (or is being processed right now)
+    if (false == isPostponed) {
+        HsmEventDispatcherBase::restartTimerImpl(timerID, intervalMs, isSingleShot);
+    }
+}
+
+void HsmEventDispatcherBusyPoll::notifyDispatcherAboutEvent() {
+    // NOTE: release guarantees that dispatcher thread will see everything what was queued before the flag was set
+    mHasPendingEvents.store(true, std::memory_order_release);
+}
+
+void HsmEventDispatcherBusyPoll::doDispatching() {
+    HSM_TRACE_CALL_DEBUG();
+    unsigned int idleIterations = 0;
+
+    if (DISPATCHER_ANY_CPU != mCpu) {
+        pinToCpu();
+    }
+
+    while (true == mIsStarted.load(std::memory_order_relaxed)) {
+        bool hasWork = false;
+
+        // NOTE: relaxed load avoids writing to the shared cache line while there are no events
+        if ((true == mHasPendingEvents.load(std::memory_order_relaxed)) && (true == mHasPendingEvents.exchange(false))) {
+            HsmEventDispatcherBase::dispatchPendingEvents();
+            hasWork = true;
+        }
+
+        if (HsmTimerQueue::Clock_t::now().time_since_epoch().count() >= mNextDeadline.load(std::memory_order_acquire)) {
+            hasWork = processExpiredTimers() || hasWork;
+        }
+
+        if (true == hasWork) {
+            idleIterations = 0;
+        } else {
+            backOff(idleIterations);
+
+            if (idleIterations < IDLE_YIELD_ITERATIONS) {
+                ++idleIterations;
+            }
+        }
+    }
+
+    HSM_TRACE_DEBUG("EXIT");
+}
+
+bool HsmEventDispatcherBusyPoll::processExpiredTimers() {
+    const auto now = HsmTimerQueue::Clock_t::now();
+
+    {
+        LockGuard lck(mRunningTimersSync);
+        HsmTimerQueue::Expiration_t expiration;
+
+        // NOTE: restarted timers which reached their old deadline are moved to the new one instead of expiring
+        while (true == mRunningTimers.popExpired(now, expiration)) {
+            mExpiredTimers.push_back(expiration);
+        }
+
+        updateNextDeadline();
+    }
+
+    const bool hasWork = (false == mExpiredTimers.empty());
+
+    // NOTE: timer handlers must be called without holding mRunningTimersSync. Otherwise we could get a deadlock with
+    //       startTimer() which locks mHandlersSync and mRunningTimersSync in the opposite order
+    for (const HsmTimerQueue::Expiration_t& expiredTimer : mExpiredTimers) {
+        uint64_t nextIntervalUs = 0;
+        unsigned int nextSlackMs = 0;
+
+        if (true == handleTimerEvent(expiredTimer.first, nextIntervalUs, nextSlackMs)) {
+            LockGuard lck(mRunningTimersSync);
+
+            // timer could have been restarted from the handler. In this case it's already in the queue
+            if (false == mRunningTimers.contains(expiredTimer.first)) {
+                // next deadline is based on the previous one to avoid drift of repeating timers
+                const HsmTimerQueue::TimePoint_t nextDeadline = HsmTimerQueue::getNextDeadline(
+                    expiredTimer.second, nextIntervalUs, HsmTimerQueue::Clock_t::now(), getMissedTicksPolicy());
+
+                mRunningTimers.schedule(expiredTimer.first, HsmTimerQueue::alignDeadline(nextDeadline, nextSlackMs));
+                updateNextDeadline();
+            }
+        }
+    }
+
+    mExpiredTimers.clear();
+
+    return hasWork;
+}
+
+void HsmEventDispatcherBusyPoll::backOff(const unsigned int idleIterations) const {
+    if ((IdleMode::SPIN == mIdleMode) || (idleIterations < IDLE_SPIN_ITERATIONS)) {
+        cpuRelax();
+    } else if ((IdleMode::YIELD == mIdleMode) || (idleIterations < IDLE_YIELD_ITERATIONS)) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(IDLE_SLEEP_DURATION);
+    }
+}
+
+void HsmEventDispatcherBusyPoll::pinToCpu() {
+#ifdef __linux__
+    // NOTE: CPU_SET() doesn't check its arguments
+    if ((mCpu >= 0) && (mCpu < CPU_SETSIZE)) {
+        cpu_set_t cpuSet;
+
+        CPU_ZERO(&cpuSet);
+        CPU_SET(mCpu, &cpuSet);
+
+        const int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+
+        if (0 != rc) {
+            HSM_TRACE_ERROR("failed to pin dispatcher thread to CPU %d (error=%d)", mCpu, rc);
+        }
+    } else {
+        HSM_TRACE_ERROR("invalid CPU index %d. dispatcher thread is not pinned", mCpu);
+    }
+#else
+    HSM_TRACE_ERROR("pinning dispatcher thread to CPU is not supported on this platform");
+#endif
+}
+
+void HsmEventDispatcherBusyPoll::updateNextDeadline() {
+    const HsmTimerQueue::TimePoint_t deadline = mRunningTimers.topDeadline();
+
+    mNextDeadline.store(deadline.time_since_epoch().count(), std::memory_order_release);
+}
+
+}  // namespace hsmcpp
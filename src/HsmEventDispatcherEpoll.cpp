@@ -0,0 +1,402 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include "hsmcpp/HsmEventDispatcherEpoll.hpp"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+
+#include "hsmcpp/logging.hpp"
+#include "hsmcpp/os/LockGuard.hpp"
+
+namespace hsmcpp {
+
+#undef HSM_TRACE_CLASS
+#define HSM_TRACE_CLASS "HsmEventDispatcherEpoll"
+
+namespace {
+constexpr int MAX_EPOLL_EVENTS = 16;
+
+// NOTE: epoll_event::data stores watch ID for watched file descriptors. Internal file descriptors use keys which can't
+//       collide with valid handler IDs
+constexpr uint64_t EVENTFD_KEY = UINT64_MAX;
+constexpr uint64_t TIMERFD_KEY = UINT64_MAX - 1U;
+
+uint32_t toEpollEvents(const FdEvents_t events) {
+    uint32_t epollEvents = 0;
+
+    if (0U != (events & HSM_FD_READABLE)) {
+        epollEvents |= EPOLLIN;
+    }
+
+    if (0U != (events & HSM_FD_WRITABLE)) {
+        epollEvents |= EPOLLOUT;
+    }
+
+    return epollEvents;
+}
+
+FdEvents_t fromEpollEvents(const uint32_t epollEvents) {
+    FdEvents_t events = 0;
+
+    if (0U != (epollEvents & EPOLLIN)) {
+        events |= HSM_FD_READABLE;
+    }
+
+    if (0U != (epollEvents & EPOLLOUT)) {
+        events |= HSM_FD_WRITABLE;
+    }
+
+    if (0U != (epollEvents & (EPOLLERR | EPOLLHUP))) {
+        events |= HSM_FD_ERROR;
+    }
+
+    return events;
+}
+
+void closeFd(int& fd) {
+    if (fd >= 0) {
+        (void)close(fd);
+        fd = -1;
+    }
+}
+}  // namespace
+
+HsmEventDispatcherEpoll::HsmEventDispatcherEpoll(const size_t eventsCacheSize, const RunMode runMode)
+    // cppcheck-suppress misra-c2012-10.4 ; false-positive. thinks that ':' is arithmetic operation
+    : HsmEventDispatcherBase(eventsCacheSize)
+    , mRunMode(runMode)
+    , mIsStarted(false)
+    , mWakeupPending(false) {
+    HSM_TRACE_CALL_DEBUG();
+}
+
+HsmEventDispatcherEpoll::~HsmEventDispatcherEpoll() {
+    HSM_TRACE_CALL_DEBUG();
+
+    HsmEventDispatcherEpoll::stop();
+    join();
+
+    closeFd(mTimerFd);
+    closeFd(mEventFd);
+    closeFd(mEpollFd);
+}
+
+std::shared_ptr<HsmEventDispatcherEpoll> HsmEventDispatcherEpoll::create(const size_t eventsCacheSize, const RunMode runMode) {
+    std::shared_ptr<HsmEventDispatcherEpoll> dispatcher(new HsmEventDispatcherEpoll(eventsCacheSize, runMode),
+                                                        &HsmEventDispatcherBase::handleDelete);
+
+    if (false == dispatcher->initialize()) {
+        dispatcher.reset();
+    }
+
+    return dispatcher;
+}
+
+bool HsmEventDispatcherEpoll::deleteSafe() {
+    bool deleteNow = true;
+
+    // NOTE: destructor joins dispatcher thread, so it can't be called from it. In this case instance is deleted by a
+    //       separate thread once current handler returns (dispatcher is already stopped)
+    if (std::this_thread::get_id() == mDispatcherThread.get_id()) {
+        std::thread([this]() {
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): deleteSafe() is only called from handleDelete()
+            delete this;
+        }).detach();
+
+        deleteNow = false;
+    }
+
+    return deleteNow;
+}
+
+bool HsmEventDispatcherEpoll::initialize() {
+    HSM_TRACE_CALL_DEBUG();
+    bool result = false;
+
+    mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    mEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    mTimerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    if ((mEpollFd >= 0) && (mEventFd >= 0) && (mTimerFd >= 0)) {
+        epoll_event eventInfo = {};
+
+        // NOTE: eventfd is registered in edge-triggered mode. Every write() generates a new edge, so there is no need
+        //       to read() it to reset the counter. This saves one syscall per wakeup.
+        eventInfo.events = EPOLLIN | EPOLLET;
+        eventInfo.data.u64 = EVENTFD_KEY;
+
+        if (0 == epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mEventFd, &eventInfo)) {
+            eventInfo.events = EPOLLIN;
+            eventInfo.data.u64 = TIMERFD_KEY;
+            result = (0 == epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mTimerFd, &eventInfo));
+        }
+    }
+
+    if (false == result) {
+        HSM_TRACE_ERROR("failed to initialize epoll dispatcher (errno=%d)", errno);
+    }
+
+    return result;
+}
+
+void HsmEventDispatcherEpoll::emitEvent(const HandlerID_t handlerID) {
+    HSM_TRACE_CALL_DEBUG();
+
+    if (true == mIsStarted) {
+        HsmEventDispatcherBase::emitEvent(handlerID);
+    }
+}
+
+bool HsmEventDispatcherEpoll::start() {
+    HSM_TRACE_CALL_DEBUG();
+    bool result = false;
+
+    if (mEpollFd >= 0) {
+        if (RunMode::OWN_THREAD == mRunMode) {
+            if (false == mDispatcherThread.joinable()) {
+                HSM_TRACE_DEBUG("starting thread...");
+                mStopDispatcher = false;
+                mIsStarted = true;
+                mDispatcherThread = std::thread(&HsmEventDispatcherEpoll::doDispatching, this);
+                result = mDispatcherThread.joinable();
+            } else {
+                result = (mDispatcherThread.get_id() != std::thread::id());
+            }
+        } else {
+            mStopDispatcher = false;
+            mIsStarted = true;
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+void HsmEventDispatcherEpoll::stop() {
+    HSM_TRACE_CALL_DEBUG();
+
+    HsmEventDispatcherBase::stop();
+    unregisterAllEventHandlers();
+    unwatchAllFds();
+
+    // always wakeup dispatcher thread so it could check mStopDispatcher flag
+    if (mEventFd >= 0) {
+        const uint64_t value = 1U;
+
+        (void)write(mEventFd, &value, sizeof(value));
+    }
+}
+
+void HsmEventDispatcherEpoll::join() {
+    HSM_TRACE_CALL_DEBUG();
+
+    if (true == mDispatcherThread.joinable()) {
+        mDispatcherThread.join();
+    }
+}
+
+int HsmEventDispatcherEpoll::getFd() const {
+    return mEpollFd;
+}
+
+void HsmEventDispatcherEpoll::dispatch() {
+    if ((true == mIsStarted) && (false == mStopDispatcher)) {
+        epoll_event readyEvents[MAX_EPOLL_EVENTS];
+        const int readyCount = epoll_wait(mEpollFd, readyEvents, MAX_EPOLL_EVENTS, 0);
+
+        for (int i = 0; (i < readyCount) && (false == mStopDispatcher); ++i) {
+            handleFdEvent(readyEvents[i]);
+        }
+    }
+}
+
+void HsmEventDispatcherEpoll::startTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) {
+    HSM_TRACE_CALL_ARGS("timerID=%d, intervalMs=%d, isSingleShot=%d", SC2INT(timerID), intervalMs, BOOL2INT(isSingleShot));
+    LockGuard lck(mRunningTimersSync);
+    // coarse timers are aligned to a shared deadline so that a single timerfd expiration could serve all of them
+    const HsmTimerQueue::TimePoint_t deadline =
+        HsmTimerQueue::alignDeadline(HsmTimerQueue::Clock_t::now() + std::chrono::microseconds(getTimerIntervalUs(timerID)),
+                                     getTimerSlack(timerID));
+
+    mRunningTimers.schedule(timerID, deadline);
+
+    // timerfd needs to be rearmed only if new timer expires earlier
+    if (deadline < mArmedDeadline) {
+        armTimer(deadline);
+    }
+}
+
+void HsmEventDispatcherEpoll::stopTimerImpl(const TimerID_t timerID) {
+    HSM_TRACE_CALL_ARGS("timerID=%d", SC2INT(timerID));
+    LockGuard lck(mRunningTimersSync);
+
+    // NOTE: timerfd is not rearmed. If it was armed for this timer, dispatcher will wakeup and rearm it for the next timer
+    (void)mRunningTimers.remove(timerID);
+}
+
+void HsmEventDispatcherEpoll::restartTimerImpl(const TimerID_t timerID,
+                                               const unsigned int intervalMs,
+                                               const bool isSingleShot) {
+    HSM_TRACE_CALL_ARGS("timerID=%d, intervalMs=%d, isSingleShot=%d", SC2INT(timerID), intervalMs, BOOL2INT(isSingleShot));
+    const HsmTimerQueue::TimePoint_t deadline =
+        HsmTimerQueue::alignDeadline(HsmTimerQueue::Clock_t::now() + std::chrono::microseconds(getTimerIntervalUs(timerID)),
+                                     getTimerSlack(timerID));
+    bool isPostponed = false;
+
+    {
+        LockGuard lck(mRunningTimersSync);
+
+        // NOTE: restarted timer never expires earlier than before, so timerfd doesn't need to be rearmed. Dispatcher
+        //       will wakeup at the old deadline and move timer to the new one
+        isPostponed = mRunningTimers.postpone(timerID, deadline);
+    }
+
+    // timer already expired (or is being processed right now)
+    if (false == isPostponed) {
+        HsmEventDispatcherBase::restartTimerImpl(timerID, intervalMs, isSingleShot);
+    }
+}
+
+void HsmEventDispatcherEpoll::notifyDispatcherAboutEvent() {
+    // coalesce wakeups: there is no need to write to eventfd if dispatcher wasn't woken up yet by the previous write
+    if (false == mWakeupPending.exchange(true)) {
+        const uint64_t value = 1U;
+
+        (void)write(mEventFd, &value, sizeof(value));
+    }
+}
+
+void HsmEventDispatcherEpoll::doDispatching() {
+    HSM_TRACE_CALL_DEBUG();
+    epoll_event readyEvents[MAX_EPOLL_EVENTS];
+
+    while (false == mStopDispatcher) {
+        const int readyCount = epoll_wait(mEpollFd, readyEvents, MAX_EPOLL_EVENTS, -1);
+
+        if (readyCount >= 0) {
+            for (int i = 0; (i < readyCount) && (false == mStopDispatcher); ++i) {
+                handleFdEvent(readyEvents[i]);
+            }
+        } else if (EINTR != errno) {
+            HSM_TRACE_ERROR("epoll_wait failed (errno=%d)", errno);
+            break;
+        } else {
+            // do nothing. wait was interrupted by a signal
+        }
+    }
+
+    HSM_TRACE_DEBUG("EXIT");
+}
+
+bool HsmEventDispatcherEpoll::watchFdImpl(const HandlerID_t watchID, const int fd, const FdEvents_t events) {
+    HSM_TRACE_CALL_ARGS("watchID=%d, fd=%d, events=%d", watchID, fd, SC2INT(events));
+    epoll_event eventInfo = {};
+
+    eventInfo.events = toEpollEvents(events);
+    eventInfo.data.u64 = static_cast<uint64_t>(watchID);
+
+    return (0 == epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &eventInfo));
+}
+
+void HsmEventDispatcherEpoll::unwatchFdImpl(const HandlerID_t watchID, const int fd) {
+    HSM_TRACE_CALL_ARGS("watchID=%d, fd=%d", watchID, fd);
+
+    // NOTE: will fail if fd was already closed. This is fine since closed fds are removed from epoll automatically
+    (void)epoll_ctl(mEpollFd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+void HsmEventDispatcherEpoll::handleFdEvent(const epoll_event& readyEvent) {
+    if (EVENTFD_KEY == readyEvent.data.u64) {
+        // NOTE: flag must be cleared before reading events. Otherwise events emitted after the queue was processed
+        //       could be lost. exchange() also makes handlers queued before the flag was set visible to this thread
+        (void)mWakeupPending.exchange(false);
+        HsmEventDispatcherBase::dispatchPendingEvents();
+    } else if (TIMERFD_KEY == readyEvent.data.u64) {
+        uint64_t expirations = 0;
+
+        (void)read(mTimerFd, &expirations, sizeof(expirations));
+        processExpiredTimers();
+    } else {
+        (void)handleFdWatchEvent(static_cast<HandlerID_t>(readyEvent.data.u64), fromEpollEvents(readyEvent.events));
+    }
+}
+
+void HsmEventDispatcherEpoll::processExpiredTimers() {
+    const auto wakeupTime = HsmTimerQueue::Clock_t::now();
+
+    {
+        LockGuard lck(mRunningTimersSync);
+
+        // timerfd is disarmed after expiration
+        mArmedDeadline = HsmTimerQueue::TimePoint_t::max();
+
+        HsmTimerQueue::Expiration_t expiration;
+
+        // NOTE: restarted timers which reached their old deadline are moved to the new one instead of expiring
+        while (true == mRunningTimers.popExpired(wakeupTime, expiration)) {
+            mExpiredTimers.push_back(expiration);
+        }
+    }
+
+    // NOTE: timer handlers must be called without holding mRunningTimersSync. Otherwise we could get a deadlock with
+    //       startTimer() which locks mHandlersSync and mRunningTimersSync in the opposite order
+    for (const HsmTimerQueue::Expiration_t& expiredTimer : mExpiredTimers) {
+        uint64_t nextIntervalUs = 0;
+        unsigned int nextSlackMs = 0;
+
+        if (true == handleTimerEvent(expiredTimer.first, nextIntervalUs, nextSlackMs)) {
+            LockGuard lck(mRunningTimersSync);
+
+            // timer could have been restarted from the handler. In this case it's already in the queue
+            if (false == mRunningTimers.contains(expiredTimer.first)) {
+                // next deadline is based on the previous one to avoid drift of repeating timers
+                const HsmTimerQueue::TimePoint_t nextDeadline = HsmTimerQueue::getNextDeadline(
+                    expiredTimer.second, nextIntervalUs, HsmTimerQueue::Clock_t::now(), getMissedTicksPolicy());
+
+                mRunningTimers.schedule(expiredTimer.first, HsmTimerQueue::alignDeadline(nextDeadline, nextSlackMs));
+            }
+        }
+    }
+
+    mExpiredTimers.clear();
+
+    {
+        LockGuard lck(mRunningTimersSync);
+        const HsmTimerQueue::TimePoint_t nextDeadline = mRunningTimers.topDeadline();
+
+        if (nextDeadline < mArmedDeadline) {
+            armTimer(nextDeadline);
+        }
+    }
+}
+
+void HsmEventDispatcherEpoll::armTimer(const HsmTimerQueue::TimePoint_t& deadline) {
+    itimerspec timerValue = {};
+
+    if (HsmTimerQueue::TimePoint_t::max() != deadline) {
+        // NOTE: std::chrono::steady_clock uses CLOCK_MONOTONIC on Linux
+        const auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+
+        timerValue.it_value.tv_sec = static_cast<time_t>(sinceEpoch / 1000000000LL);
+        timerValue.it_value.tv_nsec = static_cast<long>(sinceEpoch % 1000000000LL);
+
+        // zero value would disarm the timer
+        if ((0 == timerValue.it_value.tv_sec) && (0 == timerValue.it_value.tv_nsec)) {
+            timerValue.it_value.tv_nsec = 1;
+        }
+    }
+
+    if (0 == timerfd_settime(mTimerFd, TFD_TIMER_ABSTIME, &timerValue, nullptr)) {
+        mArmedDeadline = deadline;
+    } else {
+        HSM_TRACE_ERROR("timerfd_settime failed (errno=%d)", errno);
+    }
+}
+
+}  // namespace hsmcpp
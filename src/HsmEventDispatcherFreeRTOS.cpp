@@ -30,7 +30,8 @@ constexpr const char* HSM_TRACE_CLASS = "HsmEventDispatcherFreeRTOS";
 HsmEventDispatcherFreeRTOS::HsmEventDispatcherFreeRTOS(const configSTACK_DEPTH_TYPE stackDepth,
                                                        const UBaseType_t priority,
                                                        const size_t eventsCacheSize)
-    : HsmEventDispatcherBase(eventsCacheSize)
+    // NOTE: handlers are queued by emitEvent() of this class, so lock-free queue of HsmEventDispatcherBase is not used
+    : HsmEventDispatcherBase(eventsCacheSize, 0u)
     , mStackDepth(stackDepth)
     , mPriority(priority) {
     HSM_TRACE_CALL_DEBUG_ARGS("stackDepth=%d, priority=%d", static_cast<int>(stackDepth), static_cast<int>(priority));
@@ -61,13 +62,16 @@ void HsmEventDispatcherFreeRTOS::emitEvent(const HandlerID_t handlerID) {
     if (nullptr != mDispatcherTask) {
         dispatchEnqueuedEvents();
 
-        {
-            // TODO: this will work only for single-core FreeRTOS
-            InterruptsFreeSection lck;
-            mPendingEvents.emplace_back(handlerID);
-        }
+        // NOTE: handler needs to be queued only once until it's dispatched. See HsmEventDispatcherBase::emitEvent()
+        if (true == mEventHandlers.trySchedule(handlerID)) {
+            {
+                // TODO: this will work only for single-core FreeRTOS
+                InterruptsFreeSection lck;
+                mPendingEvents.push_back(handlerID);
+            }
 
-        notifyDispatcherAboutEvent();
+            notifyDispatcherAboutEvent();
+        }
     }
 }
 
@@ -228,19 +232,21 @@ void HsmEventDispatcherFreeRTOS::doDispatching(void* pvParameters) {
     HsmEventDispatcherFreeRTOS* pThis = static_cast<HsmEventDispatcherFreeRTOS*>(pvParameters);
 
     if (nullptr != pThis) {
-        while (false == pThis->mStopDispatcher) {
-            std::list<HandlerID_t> events;
+        // NOTE: events buffer is swapped with mPendingEvents on each iteration to reuse allocated memory
+        std::vector<HandlerID_t> events;
 
+        while (false == pThis->mStopDispatcher) {
             pThis->dispatchPendingActions();
 
             {
                 // NOTE: this will work only on a single core implementation of FreeRTOS
                 //       for multi-core system mutex lock will be required
                 InterruptsFreeSection lck;
-                events = std::move(pThis->mPendingEvents);
+                events.swap(pThis->mPendingEvents);
             }
 
             pThis->dispatchPendingEventsImpl(events);
+            events.clear();
 
             if (false == pThis->mStopDispatcher) {
                 if (true == pThis->mPendingEvents.empty()) {
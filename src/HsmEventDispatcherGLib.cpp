@@ -111,6 +111,7 @@ void HsmEventDispatcherGLib::stop() {
     HsmEventDispatcherBase::stop();
     unregisterAllTimerHandlers();
     unregisterAllEventHandlers();
+    unwatchAllFds();
 
     if (nullptr != mIoSource) {
         g_source_destroy(mIoSource);
@@ -156,7 +157,18 @@ void HsmEventDispatcherGLib::startTimerImpl(const TimerID_t timerID, const unsig
     auto it = mNativeTimerHandlers.find(timerID);
 
     if (mNativeTimerHandlers.end() == it) {
-        GSource* timeoutSource = g_timeout_source_new(intervalMs);
+        // NOTE: keep at least 1 second margin because GLib can round expiration of seconds based timeouts down
+        const unsigned int intervalSec = (intervalMs + 1999u) / 1000u;
+        GSource* timeoutSource = nullptr;
+
+        // NOTE: GLib aligns all seconds based timeouts of the process to the same wakeup time. Expiration of such timer
+        //       can be moved by up to 1 second in both directions so it can be used only if timer's slack covers
+        //       the margin and the delay
+        if ((intervalSec * 1000u - intervalMs + 1000u) <= getTimerSlack(timerID)) {
+            timeoutSource = g_timeout_source_new_seconds(intervalSec);
+        } else {
+            timeoutSource = g_timeout_source_new(intervalMs);
+        }
 
         g_source_set_callback(timeoutSource,
                               G_SOURCE_FUNC(&HsmEventDispatcherGLib::onTimerEvent),
@@ -209,6 +221,82 @@ void HsmEventDispatcherGLib::onFreeTimerData(void* timerData) {
     delete reinterpret_cast<TimerData_t*>(timerData);
 }
 
+bool HsmEventDispatcherGLib::watchFdImpl(const HandlerID_t watchID, const int fd, const FdEvents_t events) {
+    HSM_TRACE_CALL_DEBUG_ARGS("watchID=%d, fd=%d, events=%d", watchID, fd, SC2INT(events));
+    bool result = false;
+    GIOChannel* channel = g_io_channel_unix_new(fd);
+
+    if (nullptr != channel) {
+        int condition = G_IO_ERR | G_IO_HUP;
+
+        if (0U != (events & HSM_FD_READABLE)) {
+            condition |= G_IO_IN;
+        }
+
+        if (0U != (events & HSM_FD_WRITABLE)) {
+            condition |= G_IO_OUT;
+        }
+
+        GSource* watchSource = g_io_create_watch(channel, static_cast<GIOCondition>(condition));
+
+        if (nullptr != watchSource) {
+            g_source_set_callback(watchSource,
+                                  reinterpret_cast<GSourceFunc>(&HsmEventDispatcherGLib::onFdEvent),
+                                  new FdWatchData_t(this, watchID),
+                                  &HsmEventDispatcherGLib::onFreeFdWatchData);
+            g_source_attach(watchSource, mContext);
+            mNativeFdWatches[watchID] = watchSource;
+            result = true;
+        }
+
+        // NOTE: source keeps its own reference to the channel. fd is not closed when channel is released
+        g_io_channel_unref(channel);
+    }
+
+    return result;
+}
+
+void HsmEventDispatcherGLib::unwatchFdImpl(const HandlerID_t watchID, const int fd) {
+    HSM_TRACE_CALL_DEBUG_ARGS("watchID=%d, fd=%d", watchID, fd);
+    auto it = mNativeFdWatches.find(watchID);
+
+    if (mNativeFdWatches.end() != it) {
+        g_source_destroy(it->second);
+        g_source_unref(it->second);
+        mNativeFdWatches.erase(it);
+    }
+}
+
+gboolean HsmEventDispatcherGLib::onFdEvent(GIOChannel* gio, GIOCondition condition, gpointer data) {
+    gboolean keepWatching = FALSE;
+    const FdWatchData_t* watchData = static_cast<const FdWatchData_t*>(data);
+
+    if (nullptr != watchData) {
+        FdEvents_t events = 0;
+
+        if (0 != (condition & G_IO_IN)) {
+            events |= HSM_FD_READABLE;
+        }
+
+        if (0 != (condition & G_IO_OUT)) {
+            events |= HSM_FD_WRITABLE;
+        }
+
+        if (0 != (condition & (G_IO_ERR | G_IO_HUP | G_IO_NVAL))) {
+            events |= HSM_FD_ERROR;
+        }
+
+        // NOTE: if handler returns false, watch is removed (and source is destroyed) by handleFdWatchEvent()
+        keepWatching = ((true == watchData->first->handleFdWatchEvent(watchData->second, events)) ? TRUE : FALSE);
+    }
+
+    return keepWatching;
+}
+
+void HsmEventDispatcherGLib::onFreeFdWatchData(void* watchData) {
+    delete reinterpret_cast<FdWatchData_t*>(watchData);
+}
+
 void HsmEventDispatcherGLib::notifyDispatcherAboutEvent() {
     std::lock_guard<std::mutex> lck(mPipeSync);
     char dummy = 1;
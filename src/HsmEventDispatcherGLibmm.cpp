@@ -126,9 +126,21 @@ void HsmEventDispatcherGLibmm::startTimerImpl(const TimerID_t timerID, const uns
     auto it = mNativeTimerHandlers.find(timerID);
 
     if (mNativeTimerHandlers.end() == it) {
-        mNativeTimerHandlers[timerID] = mMainContext->signal_timeout().connect(
-            sigc::bind(sigc::mem_fun(this, &HsmEventDispatcherGLibmm::onTimerEvent), timerID),
-            intervalMs);
+        // NOTE: keep at least 1 second margin because GLib can round expiration of seconds based timeouts down
+        const unsigned int intervalSec = (intervalMs + 1999u) / 1000u;
+
+        // NOTE: GLib aligns all seconds based timeouts of the process to the same wakeup time. Expiration of such timer
+        //       can be moved by up to 1 second in both directions so it can be used only if timer's slack covers
+        //       the margin and the delay
+        if ((intervalSec * 1000u - intervalMs + 1000u) <= getTimerSlack(timerID)) {
+            mNativeTimerHandlers[timerID] = mMainContext->signal_timeout().connect_seconds(
+                sigc::bind(sigc::mem_fun(this, &HsmEventDispatcherGLibmm::onTimerEvent), timerID),
+                intervalSec);
+        } else {
+            mNativeTimerHandlers[timerID] = mMainContext->signal_timeout().connect(
+                sigc::bind(sigc::mem_fun(this, &HsmEventDispatcherGLibmm::onTimerEvent), timerID),
+                intervalMs);
+        }
     } else {
         HSM_TRACE_ERROR("timer with id=%d already exists", timerID);
     }
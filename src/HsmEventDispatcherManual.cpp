@@ -0,0 +1,219 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include "hsmcpp/HsmEventDispatcherManual.hpp"
+
+#include <algorithm>
+
+#include "hsmcpp/logging.hpp"
+#include "hsmcpp/os/LockGuard.hpp"
+
+namespace hsmcpp {
+
+#undef HSM_TRACE_CLASS
+#define HSM_TRACE_CLASS "HsmEventDispatcherManual"
+
+namespace {
+// repeating timers must move virtual clock forward. Otherwise advance() would never finish
+constexpr uint64_t MIN_REPEATING_INTERVAL_US = 1u;
+}  // namespace
+
+HsmEventDispatcherManual::HsmEventDispatcherManual(const size_t eventsCacheSize)
+    // cppcheck-suppress misra-c2012-10.4 ; false-positive. thinks that ':' is arithmetic operation
+    : HsmEventDispatcherBase(eventsCacheSize)
+    , mIsStarted(false)
+    , mHasPendingEvents(false)
+    , mNow(0) {
+    HSM_TRACE_CALL_DEBUG();
+}
+
+HsmEventDispatcherManual::~HsmEventDispatcherManual() {
+    HSM_TRACE_CALL_DEBUG();
+
+    HsmEventDispatcherManual::stop();
+}
+
+std::shared_ptr<HsmEventDispatcherManual> HsmEventDispatcherManual::create(const size_t eventsCacheSize) {
+    return std::shared_ptr<HsmEventDispatcherManual>(new HsmEventDispatcherManual(eventsCacheSize),
+                                                     &HsmEventDispatcherBase::handleDelete);
+}
+
+bool HsmEventDispatcherManual::deleteSafe() {
+    // NOTE: dispatcher doesn't have its own thread, so instance can be deleted right away
+    return true;
+}
+
+void HsmEventDispatcherManual::emitEvent(const HandlerID_t handlerID) {
+    HSM_TRACE_CALL_DEBUG();
+
+    if (true == mIsStarted.load()) {
+        HsmEventDispatcherBase::emitEvent(handlerID);
+    }
+}
+
+bool HsmEventDispatcherManual::start() {
+    HSM_TRACE_CALL_DEBUG();
+
+    mStopDispatcher = false;
+    mIsStarted = true;
+
+    return true;
+}
+
+void HsmEventDispatcherManual::stop() {
+    HSM_TRACE_CALL_DEBUG();
+
+    HsmEventDispatcherBase::stop();
+    mIsStarted = false;
+    unregisterAllEventHandlers();
+
+    {
+        LockGuard lck(mRunningTimersSync);
+        mRunningTimers.clear();
+    }
+}
+
+HsmEventDispatcherManual::TimePoint_t HsmEventDispatcherManual::now() const {
+    return TimePoint_t(TimePoint_t::duration(mNow.load()));
+}
+
+bool HsmEventDispatcherManual::runUntilIdle() {
+    size_t expiredTimers = 0;
+
+    return dispatchUntilIdle(expiredTimers);
+}
+
+size_t HsmEventDispatcherManual::advance(const std::chrono::microseconds& duration) {
+    HSM_TRACE_CALL_ARGS("duration=%lld us", static_cast<long long>(duration.count()));
+    const TimePoint_t targetTime = now() + duration;
+    size_t expiredTimers = 0;
+
+    (void)dispatchUntilIdle(expiredTimers);
+
+    // NOTE: handlers can start new timers, so the earliest deadline must be checked after each step
+    for (TimePoint_t deadline = getNextTimerDeadline(); (true == mIsStarted.load()) && (deadline <= targetTime);
+         deadline = getNextTimerDeadline()) {
+        mNow = deadline.time_since_epoch().count();
+        (void)dispatchUntilIdle(expiredTimers);
+    }
+
+    mNow = targetTime.time_since_epoch().count();
+
+    return expiredTimers;
+}
+
+size_t HsmEventDispatcherManual::advanceToNextTimer() {
+    const TimePoint_t deadline = getNextTimerDeadline();
+    size_t expiredTimers = 0;
+
+    if (TimePoint_t::max() != deadline) {
+        expiredTimers = advance(std::chrono::duration_cast<std::chrono::microseconds>(deadline - now()));
+    }
+
+    return expiredTimers;
+}
+
+HsmEventDispatcherManual::TimePoint_t HsmEventDispatcherManual::getNextTimerDeadline() {
+    LockGuard lck(mRunningTimersSync);
+
+    return mRunningTimers.topDeadline();
+}
+
+void HsmEventDispatcherManual::startTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) {
+    HSM_TRACE_CALL_ARGS("timerID=%d, intervalMs=%d, isSingleShot=%d", SC2INT(timerID), intervalMs, BOOL2INT(isSingleShot));
+    LockGuard lck(mRunningTimersSync);
+
+    mRunningTimers.schedule(timerID, getTimerDeadline(timerID));
+}
+
+void HsmEventDispatcherManual::stopTimerImpl(const TimerID_t timerID) {
+    HSM_TRACE_CALL_ARGS("timerID=%d", SC2INT(timerID));
+    LockGuard lck(mRunningTimersSync);
+
+    (void)mRunningTimers.remove(timerID);
+}
+
+void HsmEventDispatcherManual::restartTimerImpl(const TimerID_t timerID,
+                                                const unsigned int intervalMs,
+                                                const bool isSingleShot) {
+    HSM_TRACE_CALL_ARGS("timerID=%d, intervalMs=%d, isSingleShot=%d", SC2INT(timerID), intervalMs, BOOL2INT(isSingleShot));
+    LockGuard lck(mRunningTimersSync);
+
+    // NOTE: using schedule() instead of postpone() keeps the order of timers with equal deadlines the same as if
+    //       timer was started again
+    mRunningTimers.schedule(timerID, getTimerDeadline(timerID));
+}
+
+void HsmEventDispatcherManual::notifyDispatcherAboutEvent() {
+    mHasPendingEvents = true;
+}
+
+bool HsmEventDispatcherManual::dispatchUntilIdle(size_t& expiredTimers) {
+    bool hasProcessedWork = false;
+    bool hasWork = true;
+
+    while ((true == hasWork) && (true == mIsStarted.load())) {
+        const size_t processedTimers = processExpiredTimers();
+
+        hasWork = (processedTimers > 0u);
+        expiredTimers += processedTimers;
+
+        if (true == mHasPendingEvents.exchange(false)) {
+            HsmEventDispatcherBase::dispatchPendingEvents();
+            hasWork = true;
+        }
+
+        hasProcessedWork = hasProcessedWork || hasWork;
+    }
+
+    return hasProcessedWork;
+}
+
+size_t HsmEventDispatcherManual::processExpiredTimers() {
+    const TimePoint_t currentTime = now();
+
+    {
+        LockGuard lck(mRunningTimersSync);
+        HsmTimerQueue::Expiration_t expiration;
+
+        // NOTE: HsmTimerQueue returns timers with equal deadlines in the order they were scheduled
+        while (true == mRunningTimers.popExpired(currentTime, expiration)) {
+            mExpiredTimers.push_back(expiration);
+        }
+    }
+
+    const size_t expiredCount = mExpiredTimers.size();
+
+    // NOTE: timer handlers must be called without holding mRunningTimersSync. Otherwise we could get a deadlock with
+    //       startTimer() which locks mHandlersSync and mRunningTimersSync in the opposite order
+    for (const HsmTimerQueue::Expiration_t& expiredTimer : mExpiredTimers) {
+        uint64_t nextIntervalUs = 0;
+        unsigned int nextSlackMs = 0;
+
+        if (true == handleTimerEvent(expiredTimer.first, nextIntervalUs, nextSlackMs)) {
+            LockGuard lck(mRunningTimersSync);
+
+            // timer could have been restarted from the handler. In this case it's already in the queue
+            if (false == mRunningTimers.contains(expiredTimer.first)) {
+                const HsmTimerQueue::TimePoint_t nextDeadline =
+                    HsmTimerQueue::getNextDeadline(expiredTimer.second,
+                                                   std::max(nextIntervalUs, MIN_REPEATING_INTERVAL_US),
+                                                   currentTime,
+                                                   getMissedTicksPolicy());
+
+                mRunningTimers.schedule(expiredTimer.first, HsmTimerQueue::alignDeadline(nextDeadline, nextSlackMs));
+            }
+        }
+    }
+
+    mExpiredTimers.clear();
+
+    return expiredCount;
+}
+
+HsmEventDispatcherManual::TimePoint_t HsmEventDispatcherManual::getTimerDeadline(const TimerID_t timerID) const {
+    return HsmTimerQueue::alignDeadline(now() + std::chrono::microseconds(getTimerIntervalUs(timerID)),
+                                        getTimerSlack(timerID));
+}
+
+}  // namespace hsmcpp
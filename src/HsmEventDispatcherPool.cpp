@@ -0,0 +1,526 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include "hsmcpp/HsmEventDispatcherPool.hpp"
+
+#include <algorithm>
+
+#include "hsmcpp/logging.hpp"
+#include "hsmcpp/os/LockGuard.hpp"
+#include "hsmcpp/os/UniqueLock.hpp"
+
+namespace hsmcpp {
+
+#undef HSM_TRACE_CLASS
+#define HSM_TRACE_CLASS "HsmEventDispatcherPool"
+
+namespace {
+// identifies worker which is running in the current thread. Used to schedule strands to the current worker
+thread_local const HsmEventDispatcherPool* gCurrentPool = nullptr;
+thread_local size_t gCurrentWorker = 0;
+}  // namespace
+
+HsmEventDispatcherPool::Strand::Strand(const HandlerID_t id, const EventHandlerFunc_t& func, const size_t worker)
+    // cppcheck-suppress misra-c2012-10.4 ; false-positive. thinks that ':' is arithmetic operation
+    : handlerID(id)
+    , handler(func)
+    , pendingEvents(0)
+    , isRegistered(true)
+    , lastWorker(worker) {}
+
+HsmEventDispatcherPool::HsmEventDispatcherPool(const size_t workersCount, const size_t eventsCacheSize)
+    // cppcheck-suppress misra-c2012-10.4 ; false-positive. thinks that ':' is arithmetic operation
+    : HsmEventDispatcherBase(eventsCacheSize)
+    , mIsStarted(false)
+    , mQueuedStrands(0)
+    , mIdleWorkers(0)
+    , mSystemWorkPending(false)
+    , mRunningStrands(0)
+    , mExclusiveRequested(false) {
+    HSM_TRACE_CALL_DEBUG_ARGS("workersCount=%d", static_cast<int>(workersCount));
+
+    mWorkers.reserve(workersCount);
+
+    for (size_t i = 0; i < workersCount; ++i) {
+        mWorkers.emplace_back(new Worker());
+    }
+}
+
+HsmEventDispatcherPool::~HsmEventDispatcherPool() {
+    HSM_TRACE_CALL_DEBUG();
+
+    HsmEventDispatcherPool::stop();
+    join();
+}
+
+std::shared_ptr<HsmEventDispatcherPool> HsmEventDispatcherPool::create(const size_t workersCount, const size_t eventsCacheSize) {
+    size_t count = workersCount;
+
+    if (0u == count) {
+        // NOTE: hardware_concurrency() is allowed to return 0 if value is not computable
+        count = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+    }
+
+    return std::shared_ptr<HsmEventDispatcherPool>(new HsmEventDispatcherPool(count, eventsCacheSize),
+                                                   &HsmEventDispatcherBase::handleDelete);
+}
+
+bool HsmEventDispatcherPool::deleteSafe() {
+    bool deleteNow = true;
+
+    // NOTE: destructor joins workers and timers thread, so it can't be called from any of them. In this case
+    //       instance is deleted by a separate thread once current handler returns (dispatcher is already stopped)
+    if ((this == gCurrentPool) || (std::this_thread::get_id() == mTimersThread.get_id())) {
+        std::thread([this]() {
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): deleteSafe() is only called from handleDelete()
+            delete this;
+        }).detach();
+
+        deleteNow = false;
+    }
+
+    return deleteNow;
+}
+
+HandlerID_t HsmEventDispatcherPool::registerEventHandler(const EventHandlerFunc_t& handler) {
+    HSM_TRACE_CALL_DEBUG();
+    const HandlerID_t id = getNextHandlerID();
+    LockGuard lck(mStrandsSync);
+
+    // new strands are distributed between workers in round-robin order
+    mStrands[id] = std::make_shared<Strand>(id, handler, mNextWorker);
+    mNextWorker = (mNextWorker + 1u) % mWorkers.size();
+
+    return id;
+}
+
+void HsmEventDispatcherPool::unregisterEventHandler(const HandlerID_t handlerID) {
+    HSM_TRACE_CALL_DEBUG_ARGS("handlerID=%d", handlerID);
+    LockGuard lck(mStrandsSync);
+    auto it = mStrands.find(handlerID);
+
+    if (mStrands.end() != it) {
+        // NOTE: strand could be in one of the workers queues. It will be dropped when worker takes it
+        it->second->isRegistered = false;
+        mStrands.erase(it);
+    }
+}
+
+void HsmEventDispatcherPool::emitEvent(const HandlerID_t handlerID) {
+    HSM_TRACE_CALL_DEBUG_ARGS("handlerID=%d", handlerID);
+
+    if (true == mIsStarted) {
+        std::shared_ptr<Strand> strand;
+
+        {
+            LockGuard lck(mStrandsSync);
+            auto it = mStrands.find(handlerID);
+
+            if (mStrands.end() != it) {
+                strand = it->second;
+            }
+        }
+
+        // strand needs to be scheduled only when it gets the first pending event. Otherwise it's already queued or
+        // running and worker will process the new event too
+        if ((nullptr != strand) && (0u == strand->pendingEvents.fetch_add(1u))) {
+            schedule(strand);
+        }
+    }
+}
+
+bool HsmEventDispatcherPool::start() {
+    HSM_TRACE_CALL_DEBUG();
+
+    if (false == mIsStarted) {
+        HSM_TRACE_DEBUG("starting %d workers...", static_cast<int>(mWorkers.size()));
+        mStopDispatcher = false;
+
+        for (size_t i = 0; i < mWorkers.size(); ++i) {
+            if (false == mWorkers[i]->thread.joinable()) {
+                mWorkers[i]->thread = std::thread(&HsmEventDispatcherPool::doWork, this, i);
+            }
+        }
+
+        mIsStarted = true;
+    }
+
+    return mIsStarted;
+}
+
+void HsmEventDispatcherPool::stop() {
+    HSM_TRACE_CALL_DEBUG();
+
+    {
+        // stop flag must be set under the same lock which is used by workers to wait for events
+        LockGuard lck(mIdleSync);
+        HsmEventDispatcherBase::stop();
+        mIsStarted = false;
+    }
+
+    unregisterAllStrands();
+    mWorkAvailable.notify();
+    mStrandsFinished.notify();
+    notifyTimersThread();
+}
+
+void HsmEventDispatcherPool::join() {
+    HSM_TRACE_CALL_DEBUG();
+
+    for (const std::unique_ptr<Worker>& worker : mWorkers) {
+        if (true == worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    if (true == mTimersThread.joinable()) {
+        mTimersThread.join();
+    }
+}
+
+size_t HsmEventDispatcherPool::getWorkersCount() const {
+    return mWorkers.size();
+}
+
+void HsmEventDispatcherPool::startTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) {
+    HSM_TRACE_CALL_ARGS("timerID=%d, intervalMs=%d, isSingleShot=%d", SC2INT(timerID), intervalMs, BOOL2INT(isSingleShot));
+    bool wakeupTimersThread = false;
+
+    // lazy initialization of timers thread
+    if (false == mTimersThread.joinable()) {
+        mTimersThread = std::thread(&HsmEventDispatcherPool::handleTimers, this);
+    }
+
+    {
+        LockGuard lck(mRunningTimersSync);
+        // coarse timers are aligned to a shared deadline so that they could be processed during a single wakeup
+        const HsmTimerQueue::TimePoint_t deadline =
+            HsmTimerQueue::alignDeadline(std::chrono::steady_clock::now() + std::chrono::microseconds(getTimerIntervalUs(timerID)),
+                                         getTimerSlack(timerID));
+
+        mRunningTimers.schedule(timerID, deadline);
+
+        // timers thread needs to be woken up only if it's sleeping longer than the new timer
+        if (deadline < mTimersThreadDeadline) {
+            mTimersThreadDeadline = deadline;
+            mNotifiedTimersThread = true;
+            wakeupTimersThread = true;
+        }
+    }
+
+    if (true == wakeupTimersThread) {
+        mTimerEvent.notify();
+    }
+}
+
+void HsmEventDispatcherPool::stopTimerImpl(const TimerID_t timerID) {
+    HSM_TRACE_CALL_ARGS("timerID=%d", SC2INT(timerID));
+    LockGuard lck(mRunningTimersSync);
+
+    // NOTE: there is no need to wakeup timers thread. If it was waiting for this timer it will recalculate the next
+    //       deadline after waking up
+    (void)mRunningTimers.remove(timerID);
+}
+
+void HsmEventDispatcherPool::restartTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) {
+    HSM_TRACE_CALL_ARGS("timerID=%d, intervalMs=%d, isSingleShot=%d", SC2INT(timerID), intervalMs, BOOL2INT(isSingleShot));
+    const HsmTimerQueue::TimePoint_t deadline =
+        HsmTimerQueue::alignDeadline(std::chrono::steady_clock::now() + std::chrono::microseconds(getTimerIntervalUs(timerID)),
+                                     getTimerSlack(timerID));
+    bool isPostponed = false;
+
+    {
+        LockGuard lck(mRunningTimersSync);
+
+        // NOTE: restarted timer never expires earlier than before, so there is no need to wakeup timers thread. It
+        //       will wakeup at the old deadline and move timer to the new one
+        isPostponed = mRunningTimers.postpone(timerID, deadline);
+    }
+
+    // timer already expired (or is being processed right now)
+    if (false == isPostponed) {
+        HsmEventDispatcherBase::restartTimerImpl(timerID, intervalMs, isSingleShot);
+    }
+}
+
+void HsmEventDispatcherPool::notifyDispatcherAboutEvent() {
+    mSystemWorkPending = true;
+    wakeupWorker();
+}
+
+void HsmEventDispatcherPool::doWork(const size_t workerIndex) {
+    HSM_TRACE_CALL_DEBUG_ARGS("workerIndex=%d", static_cast<int>(workerIndex));
+
+    gCurrentPool = this;
+    gCurrentWorker = workerIndex;
+
+    while (false == mStopDispatcher) {
+        if (true == mSystemWorkPending.exchange(false)) {
+            processSystemWork();
+        }
+
+        std::shared_ptr<Strand> strand = takeStrand(workerIndex);
+
+        if (nullptr != strand) {
+            acquireStrandSlot();
+            runStrand(workerIndex, strand);
+            releaseStrandSlot();
+        } else {
+            UniqueLock lck(mIdleSync);
+
+            // NOTE: mIdleWorkers must be incremented before checking for available work. schedule() increments
+            //       mQueuedStrands before checking mIdleWorkers, so at least one of the threads will see the change
+            ++mIdleWorkers;
+            // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+            mWorkAvailable.wait(lck, [&]() {
+                // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+                return (mQueuedStrands > 0) || (true == mSystemWorkPending) || (true == mStopDispatcher);
+            });
+            --mIdleWorkers;
+        }
+    }
+
+    gCurrentPool = nullptr;
+    HSM_TRACE_DEBUG("EXIT");
+}
+
+void HsmEventDispatcherPool::schedule(const std::shared_ptr<Strand>& strand) {
+    size_t targetWorker = 0;
+
+    if (this == gCurrentPool) {
+        // event was emitted from one of the workers. Most likely strand will use the same data (for example, it's
+        // the same HSM which emitted event to itself) so keep it on the current worker
+        targetWorker = gCurrentWorker;
+    } else {
+        // keep strand on the worker which processed it the last time to reuse warm CPU cache
+        targetWorker = strand->lastWorker;
+    }
+
+    {
+        Worker& worker = *mWorkers[targetWorker];
+        LockGuard lck(worker.queueSync);
+
+        worker.readyStrands.push_back(strand);
+    }
+
+    ++mQueuedStrands;
+    wakeupWorker();
+}
+
+std::shared_ptr<HsmEventDispatcherPool::Strand> HsmEventDispatcherPool::takeStrand(const size_t workerIndex) {
+    std::shared_ptr<Strand> strand;
+    const size_t workersCount = mWorkers.size();
+
+    // own queue is processed in FIFO order. Stealing is done from the opposite end of the queue to reduce contention
+    // with the owner and to take strands which are least likely to still be in owner's cache
+    for (size_t i = 0; (i < workersCount) && (nullptr == strand); ++i) {
+        Worker& worker = *mWorkers[(workerIndex + i) % workersCount];
+        LockGuard lck(worker.queueSync);
+
+        if (false == worker.readyStrands.empty()) {
+            if (0u == i) {
+                strand = std::move(worker.readyStrands.front());
+                worker.readyStrands.pop_front();
+            } else {
+                strand = std::move(worker.readyStrands.back());
+                worker.readyStrands.pop_back();
+            }
+        }
+    }
+
+    if (nullptr != strand) {
+        --mQueuedStrands;
+    }
+
+    return strand;
+}
+
+void HsmEventDispatcherPool::runStrand(const size_t workerIndex, const std::shared_ptr<Strand>& strand) {
+    // NOTE: only events which were emitted before this point are processed. This guarantees fairness between strands
+    //       which constantly emit events to themselves
+    const size_t eventsCount = strand->pendingEvents;
+
+    strand->lastWorker = workerIndex;
+
+    for (size_t i = 0; (i < eventsCount) && (true == strand->isRegistered) && (false == mStopDispatcher); ++i) {
+        if (false == strand->handler()) {
+            unregisterEventHandler(strand->handlerID);
+        }
+    }
+
+    // if new events were emitted while strand was running it must be queued again. Nobody else could schedule it
+    // because pendingEvents was not zero
+    if ((strand->pendingEvents.fetch_sub(eventsCount) != eventsCount) && (true == strand->isRegistered)) {
+        {
+            Worker& worker = *mWorkers[workerIndex];
+            LockGuard lck(worker.queueSync);
+
+            worker.readyStrands.push_back(strand);
+        }
+
+        ++mQueuedStrands;
+        wakeupWorker();
+    }
+}
+
+void HsmEventDispatcherPool::processSystemWork() {
+    // NOTE: enqueued events and actions must be processed in the same order they were added
+    LockGuard lck(mSystemWorkSync);
+
+    // NOTE: it's assumed that calling empty() is thread-safe. Even if due to a race condition we get wrong value
+    //       actions will be processed on the next notification
+    if (false == mPendingActions.empty()) {
+        // actions are usually used to safely delete HSM instances so they can't be executed while any of the handlers
+        // is running
+        beginExclusiveSection();
+        dispatchPendingActions();
+        endExclusiveSection();
+    }
+
+    dispatchEnqueuedEvents();
+}
+
+void HsmEventDispatcherPool::beginExclusiveSection() {
+    UniqueLock lck(mIdleSync);
+
+    mExclusiveRequested = true;
+    // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+    mStrandsFinished.wait(lck, [&]() { return (0 == mRunningStrands) || (true == mStopDispatcher); });
+}
+
+void HsmEventDispatcherPool::endExclusiveSection() {
+    {
+        LockGuard lck(mIdleSync);
+        mExclusiveRequested = false;
+    }
+
+    mStrandsFinished.notify();
+}
+
+void HsmEventDispatcherPool::acquireStrandSlot() {
+    // NOTE: mRunningStrands must be incremented before checking mExclusiveRequested. beginExclusiveSection() does the
+    //       same in the opposite order, so at least one of the threads will see the change
+    ++mRunningStrands;
+
+    // enqueued actions have higher priority than events. If some other worker is already executing them
+    // processSystemWork() will block until it's done
+    while (((true == mExclusiveRequested) || (false == mPendingActions.empty())) && (false == mStopDispatcher)) {
+        releaseStrandSlot();
+        processSystemWork();
+        ++mRunningStrands;
+    }
+}
+
+void HsmEventDispatcherPool::releaseStrandSlot() {
+    if ((0 == --mRunningStrands) && (true == mExclusiveRequested)) {
+        {
+            LockGuard lck(mIdleSync);
+        }
+
+        mStrandsFinished.notify();
+    }
+}
+
+void HsmEventDispatcherPool::wakeupWorker() {
+    if (mIdleWorkers > 0) {
+        {
+            // NOTE: lock is needed to make sure that worker is either already waiting or will see the new state before
+            //       going to sleep
+            LockGuard lck(mIdleSync);
+        }
+
+        mWorkAvailable.notifyOne();
+    }
+}
+
+void HsmEventDispatcherPool::unregisterAllStrands() {
+    LockGuard lck(mStrandsSync);
+
+    for (const auto& strand : mStrands) {
+        strand.second->isRegistered = false;
+    }
+
+    mStrands.clear();
+}
+
+void HsmEventDispatcherPool::notifyTimersThread() {
+    HSM_TRACE_CALL_DEBUG();
+
+    {
+        LockGuard lck(mRunningTimersSync);
+        mNotifiedTimersThread = true;
+    }
+
+    mTimerEvent.notify();
+}
+
+void HsmEventDispatcherPool::handleTimers() {
+    HSM_TRACE_CALL_DEBUG();
+
+    while (false == mStopDispatcher) {
+        UniqueLock lck(mRunningTimersSync);
+
+        // all notifications received before this point are already reflected in mRunningTimers
+        mNotifiedTimersThread = false;
+        mTimersThreadDeadline = mRunningTimers.topDeadline();
+
+        if (true == mRunningTimers.empty()) {
+            // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+            mTimerEvent.wait(lck, [&]() { return mNotifiedTimersThread; });
+        } else {
+            // if deadline is in the past it means that timer already expired and we only need to trigger event
+            if (mTimersThreadDeadline > std::chrono::steady_clock::now()) {
+                // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+                (void)mTimerEvent.wait_until(lck, mTimersThreadDeadline, [&]() { return mNotifiedTimersThread; });
+            } else {
+                lck.unlock();
+            }
+        }
+
+        // NOTE: ConditionVariable always releases the lock on exit
+        if (false == mStopDispatcher) {
+            processExpiredTimers();
+        }
+    }
+
+    HSM_TRACE_DEBUG("EXIT");
+}
+
+void HsmEventDispatcherPool::processExpiredTimers() {
+    const auto wakeupTime = std::chrono::steady_clock::now();
+
+    {
+        LockGuard lck(mRunningTimersSync);
+
+        HsmTimerQueue::Expiration_t expiration;
+
+        // NOTE: restarted timers which reached their old deadline are moved to the new one instead of expiring
+        while (true == mRunningTimers.popExpired(wakeupTime, expiration)) {
+            mExpiredTimers.push_back(expiration);
+        }
+    }
+
+    // NOTE: timer handlers must be called without holding mRunningTimersSync. Otherwise we could get a deadlock with
+    //       startTimer() which locks mHandlersSync and mRunningTimersSync in the opposite order
+    for (const HsmTimerQueue::Expiration_t& expiredTimer : mExpiredTimers) {
+        uint64_t nextIntervalUs = 0;
+        unsigned int nextSlackMs = 0;
+
+        if (true == handleTimerEvent(expiredTimer.first, nextIntervalUs, nextSlackMs)) {
+            LockGuard lck(mRunningTimersSync);
+
+            // timer could have been restarted from the handler. In this case it's already in the queue
+            if (false == mRunningTimers.contains(expiredTimer.first)) {
+                // next deadline is based on the previous one to avoid drift of repeating timers
+                const HsmTimerQueue::TimePoint_t nextDeadline = HsmTimerQueue::getNextDeadline(
+                    expiredTimer.second, nextIntervalUs, HsmTimerQueue::Clock_t::now(), getMissedTicksPolicy());
+
+                mRunningTimers.schedule(expiredTimer.first, HsmTimerQueue::alignDeadline(nextDeadline, nextSlackMs));
+            }
+        }
+    }
+
+    mExpiredTimers.clear();
+}
+
+}  // namespace hsmcpp
@@ -4,17 +4,28 @@
 #include "hsmcpp/HsmEventDispatcherSTD.hpp"
 
 #include "hsmcpp/logging.hpp"
-#include "hsmcpp/os/CriticalSection.hpp"
+#include "hsmcpp/os/CpuRelax.hpp"
+#include "hsmcpp/os/LockGuard.hpp"
 
 namespace hsmcpp {
 
 #undef HSM_TRACE_CLASS
 #define HSM_TRACE_CLASS "HsmEventDispatcherSTD"
 
-HsmEventDispatcherSTD::HsmEventDispatcherSTD(const size_t eventsCacheSize)
+HsmEventDispatcherSTD::HsmEventDispatcherSTD(const size_t eventsCacheSize, const TimersMode timersMode)
     // cppcheck-suppress misra-c2012-10.4 ; false-positive. thinks that ':' is arithmetic operation
-    : HsmEventDispatcherBase(eventsCacheSize) {
+    : HsmEventDispatcherBase(eventsCacheSize)
+    , mTimersMode(timersMode)
+    , mIsWaitingForEvents(false) {
     HSM_TRACE_CALL_DEBUG();
+
+    if (TimersMode::SHARED_SERVICE == mTimersMode) {
+        mTimerService = HsmTimerService::getInstance();
+        mTimerServiceClientID =
+            mTimerService->registerClient([this](const TimerID_t timerID, const HsmTimerQueue::TimePoint_t& deadline) {
+                onServiceTimerExpired(timerID, deadline);
+            });
+    }
 }
 
 HsmEventDispatcherSTD::~HsmEventDispatcherSTD() {
@@ -22,16 +33,36 @@ HsmEventDispatcherSTD::~HsmEventDispatcherSTD() {
 
     HsmEventDispatcherSTD::stop();
     join();
+
+    // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
+    if (mTimerService) {
+        // NOTE: blocks if service is currently notifying this dispatcher about expired timer
+        mTimerService->unregisterClient(mTimerServiceClientID);
+    }
 }
 
-std::shared_ptr<HsmEventDispatcherSTD> HsmEventDispatcherSTD::create(const size_t eventsCacheSize) {
-    return std::shared_ptr<HsmEventDispatcherSTD>(new HsmEventDispatcherSTD(eventsCacheSize),
+std::shared_ptr<HsmEventDispatcherSTD> HsmEventDispatcherSTD::create(const size_t eventsCacheSize, const TimersMode timersMode) {
+    return std::shared_ptr<HsmEventDispatcherSTD>(new HsmEventDispatcherSTD(eventsCacheSize, timersMode),
                                                   &HsmEventDispatcherBase::handleDelete);
 }
 
 bool HsmEventDispatcherSTD::deleteSafe() {
-    // NOTE: just delete the instance. Calling destructor from any thread is safe
-    return true;
+    bool deleteNow = true;
+    const std::thread::id currentThread = std::this_thread::get_id();
+
+    // NOTE: destructor joins dispatcher and timers threads, so it can't be called from any of them. This happens
+    //       when the last reference to dispatcher is released by a handler. In this case instance is deleted by a
+    //       separate thread once current handler returns (dispatcher is already stopped)
+    if ((currentThread == mDispatcherThread.get_id()) || (currentThread == mTimersThread.get_id())) {
+        std::thread([this]() {
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory): deleteSafe() is only called from handleDelete()
+            delete this;
+        }).detach();
+
+        deleteNow = false;
+    }
+
+    return deleteNow;
 }
 
 void HsmEventDispatcherSTD::emitEvent(const HandlerID_t handlerID) {
@@ -42,6 +73,10 @@ void HsmEventDispatcherSTD::emitEvent(const HandlerID_t handlerID) {
     }
 }
 
+void HsmEventDispatcherSTD::setIdleSpinDuration(const std::chrono::microseconds& duration) {
+    mIdleSpinDuration = duration;
+}
+
 bool HsmEventDispatcherSTD::start() {
     HSM_TRACE_CALL_DEBUG();
     bool result = false;
@@ -60,9 +95,14 @@ bool HsmEventDispatcherSTD::start() {
 
 void HsmEventDispatcherSTD::stop() {
     HSM_TRACE_CALL_DEBUG();
-    UniqueLock lck(mEmitSync);
 
-    HsmEventDispatcherBase::stop();
+    {
+        // stop flag must be set under the same lock which is used by doDispatching() to wait for events
+        LockGuard lck(mEmitSync);
+        HsmEventDispatcherBase::stop();
+    }
+
+    // NOTE: mEmitSync must not be held here: startTimer() locks mHandlersSync before mEmitSync
     unregisterAllEventHandlers();
     notifyDispatcherAboutEvent();
     notifyTimersThread();
@@ -82,49 +122,105 @@ void HsmEventDispatcherSTD::join() {
 
 void HsmEventDispatcherSTD::startTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) {
     HSM_TRACE_CALL_ARGS("timerID=%d, intervalMs=%d, isSingleShot=%d", SC2INT(timerID), intervalMs, BOOL2INT(isSingleShot));
+    bool wakeupTimersThread = false;
 
     // lazy initialization of timers thread
-    if (false == mTimersThread.joinable()) {
+    if ((TimersMode::SEPARATE_THREAD == mTimersMode) && (false == mTimersThread.joinable())) {
         mTimersThread = std::thread(&HsmEventDispatcherSTD::handleTimers, this);
     }
 
-    {
-        CriticalSection cs(mRunningTimersSync);
-        auto it = mRunningTimers.find(timerID);
+    // coarse timers are aligned to a shared deadline so that they could be processed during a single wakeup
+    const HsmTimerQueue::TimePoint_t deadline =
+        HsmTimerQueue::alignDeadline(std::chrono::steady_clock::now() + std::chrono::microseconds(getTimerIntervalUs(timerID)),
+                                     getTimerSlack(timerID));
+
+    if (TimersMode::SHARED_SERVICE == mTimersMode) {
+        mTimerService->schedule(mTimerServiceClientID, timerID, deadline);
+    } else {
+        LockGuard lck(mRunningTimersSync);
 
-        // new timer
-        if (mRunningTimers.end() == it) {
-            RunningTimerInfo newTimer;
+        mRunningTimers.schedule(timerID, deadline);
 
-            newTimer.startedAt = std::chrono::steady_clock::now();
-            newTimer.elapseAfter = newTimer.startedAt + std::chrono::milliseconds(intervalMs);
+        // thread which processes timers needs to be woken up only if it's sleeping longer than the new timer
+        if (deadline < mTimersThreadDeadline) {
+            mTimersThreadDeadline = deadline;
+            mNotifiedTimersThread = true;
+            wakeupTimersThread = true;
+        }
+    }
 
-            mRunningTimers[timerID] = newTimer;
+    if (true == wakeupTimersThread) {
+        if (TimersMode::SEPARATE_THREAD == mTimersMode) {
+            mTimerEvent.notify();
+        } else if (std::this_thread::get_id() != mDispatcherThread.get_id()) {
+            // NOTE: if timer was started from dispatcher thread the next deadline will be calculated before waiting
+            {
+                LockGuard lckEmit(mEmitSync);
+                mTimersUpdated = true;
+            }
+
+            notifyDispatcherAboutEvent();
         } else {
-            // restart timer
-            it->second.startedAt = std::chrono::steady_clock::now();
-            it->second.elapseAfter = it->second.startedAt + std::chrono::milliseconds(intervalMs);
+            // do nothing
         }
     }
-
-    // wakeup timers thread
-    notifyTimersThread();
 }
 
 void HsmEventDispatcherSTD::stopTimerImpl(const TimerID_t timerID) {
     HSM_TRACE_CALL_ARGS("timerID=%d", SC2INT(timerID));
 
-    {
-        CriticalSection cs(mRunningTimersSync);
-        mRunningTimers.erase(timerID);
+    if (TimersMode::SHARED_SERVICE == mTimersMode) {
+        (void)mTimerService->cancel(mTimerServiceClientID, timerID);
+    } else {
+        LockGuard lck(mRunningTimersSync);
+
+        // NOTE: there is no need to wakeup timers thread. If it was waiting for this timer it will recalculate the next
+        //       deadline after waking up
+        (void)mRunningTimers.remove(timerID);
     }
+}
 
-    // wakeup timers thread
-    notifyTimersThread();
+void HsmEventDispatcherSTD::restartTimerImpl(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) {
+    HSM_TRACE_CALL_ARGS("timerID=%d, intervalMs=%d, isSingleShot=%d", SC2INT(timerID), intervalMs, BOOL2INT(isSingleShot));
+
+    if (TimersMode::SHARED_SERVICE == mTimersMode) {
+        // service updates deadline of already scheduled timer and doesn't wakeup its thread for a later deadline
+        startTimerImpl(timerID, intervalMs, isSingleShot);
+    } else {
+        const HsmTimerQueue::TimePoint_t deadline =
+            HsmTimerQueue::alignDeadline(HsmTimerQueue::Clock_t::now() + std::chrono::microseconds(getTimerIntervalUs(timerID)),
+                                         getTimerSlack(timerID));
+        bool isPostponed = false;
+
+        {
+            LockGuard lck(mRunningTimersSync);
+
+            // NOTE: restarted timer never expires earlier than before, so there is no need to wakeup timers thread. It
+            //       will wakeup at the old deadline and move timer to the new one
+            isPostponed = mRunningTimers.postpone(timerID, deadline);
+        }
+
+        // timer already expired (or is being processed right now)
+        if (false == isPostponed) {
+            HsmEventDispatcherBase::restartTimerImpl(timerID, intervalMs, isSingleShot);
+        }
+    }
 }
 
 void HsmEventDispatcherSTD::notifyDispatcherAboutEvent() {
-    mEmitEvent.notify();
+    // NOTE: handlers are queued without locking mEmitSync. Fence guarantees that either producer sees the flag or
+    //       dispatcher sees the new event when it checks for pending work (see waitForEvents())
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (true == mIsWaitingForEvents.load()) {
+        // NOTE: dispatcher could have checked for events, but didn't start waiting yet. Locking mEmitSync
+        //       guarantees that notification is sent only after it releases the lock inside of wait()
+        {
+            LockGuard lck(mEmitSync);
+        }
+
+        mEmitEvent.notify();
+    }
 }
 
 void HsmEventDispatcherSTD::doDispatching() {
@@ -133,21 +229,33 @@ void HsmEventDispatcherSTD::doDispatching() {
     while (false == mStopDispatcher) {
         HsmEventDispatcherBase::dispatchPendingEvents();
 
+        if ((TimersMode::DISPATCHER_THREAD == mTimersMode) && (false == mStopDispatcher)) {
+            processExpiredTimers();
+        } else if ((TimersMode::SHARED_SERVICE == mTimersMode) && (false == mStopDispatcher)) {
+            processServiceExpiredTimers();
+        } else {
+            // do nothing
+        }
+
+        if ((mIdleSpinDuration.count() > 0) && (false == mStopDispatcher)) {
+            spinForEvents();
+        }
+
         if (false == mStopDispatcher) {
             UniqueLock lck(mEmitSync);
+            HsmTimerQueue::TimePoint_t nextDeadline = HsmTimerQueue::TimePoint_t::max();
 
-            if (true == mPendingEvents.empty()) {
-                HSM_TRACE_DEBUG("wait for emit...");
-                // NOTE: false-positive. "A function should have a single point of exit at the end" is not vialated because
-                //       "return" statement belogs to a lamda function, not doDispatching.
-                // cppcheck-suppress misra-c2012-15.5
-                mEmitEvent.wait(lck, [=]() {
-                    // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
-                    // NOTE: it's assumed that calling empty() is thread-safe. Even if due to a race condition we get
-                    //       wrong value it will only cause a small delay in event processing, but won't cause any critical issues
-                    return (false == mPendingEvents.empty()) || (false == mEnqueuedEvents.empty()) || (true == mStopDispatcher);
-                });
-                HSM_TRACE_DEBUG("woke up. pending events=%lu", mPendingEvents.size());
+            if (TimersMode::DISPATCHER_THREAD == mTimersMode) {
+                LockGuard lckTimers(mRunningTimersSync);
+
+                // all timer changes done before this point are already reflected in mRunningTimers
+                mTimersUpdated = false;
+                nextDeadline = mRunningTimers.topDeadline();
+                mTimersThreadDeadline = nextDeadline;
+            }
+
+            if ((false == hasPendingEvents()) && (true == mServiceExpiredTimers.empty())) {
+                waitForEvents(lck, nextDeadline);
             }
         }
     }
@@ -155,89 +263,177 @@ void HsmEventDispatcherSTD::doDispatching() {
     HSM_TRACE_DEBUG("EXIT");
 }
 
+bool HsmEventDispatcherSTD::hasPendingWork() const {
+    // NOTE: it's assumed that calling empty() is thread-safe. Even if due to a race condition we get
+    //       wrong value it will only cause a small delay in event processing, but won't cause any critical issues
+    return (true == hasPendingEvents()) || (false == mEnqueuedEvents.empty()) || (true == mStopDispatcher) ||
+           (true == mTimersUpdated) || (false == mServiceExpiredTimers.empty());
+}
+
+void HsmEventDispatcherSTD::spinForEvents() {
+    const auto spinUntil = std::chrono::steady_clock::now() + mIdleSpinDuration;
+
+    // NOTE: clock is checked only once per multiple iterations to make spinning cheaper
+    while (false == hasPendingWork()) {
+        for (int i = 0; i < 64; ++i) {
+            cpuRelax();
+        }
+
+        if (std::chrono::steady_clock::now() >= spinUntil) {
+            break;
+        }
+    }
+}
+
+void HsmEventDispatcherSTD::waitForEvents(UniqueLock& lck, const HsmTimerQueue::TimePoint_t& nextDeadline) {
+    HSM_TRACE_DEBUG("wait for emit...");
+    // NOTE: false-positive. "A function should have a single point of exit at the end" is not vialated because
+    //       "return" statement belogs to a lamda function, not waitForEvents.
+    // cppcheck-suppress misra-c2012-15.5
+    auto hasEvents = [&]() {
+        // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+        return hasPendingWork();
+    };
+
+    // NOTE: must be set under mEmitSync before checking for events. Producers check this flag after adding an event,
+    //       so they either see it or their event is visible to hasEvents()
+    mIsWaitingForEvents.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (HsmTimerQueue::TimePoint_t::max() == nextDeadline) {
+        mEmitEvent.wait(lck, hasEvents);
+    } else {
+        // if deadline is in the past it means that timer already expired and we only need to process it
+        if (nextDeadline > std::chrono::steady_clock::now()) {
+            (void)mEmitEvent.wait_until(lck, nextDeadline, hasEvents);
+        }
+    }
+
+    mIsWaitingForEvents.store(false);
+    HSM_TRACE_DEBUG("woke up");
+}
+
 void HsmEventDispatcherSTD::notifyTimersThread() {
     HSM_TRACE_CALL_DEBUG();
-    mNotifiedTimersThread = true;
+
+    {
+        LockGuard lck(mRunningTimersSync);
+        mNotifiedTimersThread = true;
+    }
+
     mTimerEvent.notify();
 }
 
 void HsmEventDispatcherSTD::handleTimers() {
     HSM_TRACE_CALL_DEBUG();
-    Mutex timerEventSync;
-    UniqueLock lck(timerEventSync);
 
     while (false == mStopDispatcher) {
-        mRunningTimersSync.lock();
-
-        // NOTE: it's assumed that calling empty() is thread-safe. Even if due to
-        //       a race condition we get wrong value it will only cause a small delay in timer processing,
-        //       but won't cause any critical issues
-        if (false == mRunningTimers.empty()) {
-            auto itTimeout = mRunningTimers.begin();
-
-            for (auto it = mRunningTimers.begin(); it != mRunningTimers.end(); ++it) {
-                if (it->second.elapseAfter < itTimeout->second.elapseAfter) {
-                    itTimeout = it;
-                }
-            }
-
-            TimerID_t waitingTimerId = itTimeout->first;
-            const int waitDurationMs = std::chrono::duration_cast<std::chrono::milliseconds>(itTimeout->second.elapseAfter -
-                                                                                         std::chrono::steady_clock::now())
-                                       .count();
-
-            // unlock after itTimeout value is not needed anymore
-            mRunningTimersSync.unlock();
-            // NOTE: make sure we don't use itTimeout value after this line
+        UniqueLock lck(mRunningTimersSync);
 
-            bool waitResult = false;
+        // all notifications received before this point are already reflected in mRunningTimers
+        mNotifiedTimersThread = false;
+        mTimersThreadDeadline = mRunningTimers.topDeadline();
 
-            // if waitDurationMs <= 0 it means that timer already expired and we only need to trigger event
-            if (waitDurationMs > 0) {
+        if (true == mRunningTimers.empty()) {
+            // wait for timer events
+            // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+            mTimerEvent.wait(lck, [&]() { return mNotifiedTimersThread; });
+        } else {
+            // if deadline is in the past it means that timer already expired and we only need to trigger event
+            if (mTimersThreadDeadline > std::chrono::steady_clock::now()) {
                 // NOTE: false-positive. "A function should have a single point of exit at the end" is not vialated because
-                //       "return" statement belogs to a lamda function, not doDispatching.
+                //       "return" statement belogs to a lamda function, not handleTimers.
                 // cppcheck-suppress misra-c2012-15.5
-                waitResult = mTimerEvent.wait_for(lck, waitDurationMs, [&]() { return mNotifiedTimersThread; });
+                (void)mTimerEvent.wait_until(lck, mTimersThreadDeadline, [&]() { return mNotifiedTimersThread; });
+            } else {
+                lck.unlock();
             }
+        }
+
+        // NOTE: ConditionVariable always releases the lock on exit
+        if (false == mStopDispatcher) {
+            processExpiredTimers();
+        }
+    }
+
+    HSM_TRACE_DEBUG("EXIT");
+}
 
-            mNotifiedTimersThread = false;
+void HsmEventDispatcherSTD::processExpiredTimers() {
+    const auto wakeupTime = std::chrono::steady_clock::now();
 
-            if (false == waitResult) {
-                // timeout expired
+    {
+        LockGuard lck(mRunningTimersSync);
 
-                // store wakeup time in case we'll need to calculate new elapseAfter value
-                // needed to avoid potential delays caused by CriticalSection and handleTimerEvent()
-                const auto wakeupTime = std::chrono::steady_clock::now();
-                CriticalSection lckExpired(mRunningTimersSync);
+        HsmTimerQueue::Expiration_t expiration;
 
-                itTimeout = mRunningTimers.find(waitingTimerId);
+        // NOTE: restarted timers which reached their old deadline are moved to the new one instead of expiring
+        while (true == mRunningTimers.popExpired(wakeupTime, expiration)) {
+            mExpiredTimers.push_back(expiration);
+        }
+    }
 
-                if (itTimeout != mRunningTimers.end()) {
-                    const unsigned int nextIntervalMs = handleTimerEvent(waitingTimerId);
+    // NOTE: timer handlers must be called without holding mRunningTimersSync. Otherwise we could get a deadlock with
+    //       startTimer() which locks mHandlersSync and mRunningTimersSync in the opposite order
+    for (const HsmTimerQueue::Expiration_t& expiredTimer : mExpiredTimers) {
+        uint64_t nextIntervalUs = 0;
+        unsigned int nextSlackMs = 0;
 
-                    if (nextIntervalMs > 0u) {
-                        // restart timer
-                        itTimeout->second.startedAt = wakeupTime;
-                        itTimeout->second.elapseAfter = itTimeout->second.startedAt + std::chrono::milliseconds(nextIntervalMs);
-                    } else {
-                        // single shot timer. remove from queue
-                        mRunningTimers.erase(itTimeout);
-                    }
-                } else {
-                    // do nothing
-                }
-            } else {
-                // thread was woken up by start/stop operation. no need to do anything
+        if (true == handleTimerEvent(expiredTimer.first, nextIntervalUs, nextSlackMs)) {
+            LockGuard lck(mRunningTimersSync);
+
+            // timer could have been restarted from the handler. In this case it's already in the queue
+            if (false == mRunningTimers.contains(expiredTimer.first)) {
+                // next deadline is based on the previous one to avoid drift of repeating timers
+                const HsmTimerQueue::TimePoint_t nextDeadline = HsmTimerQueue::getNextDeadline(
+                    expiredTimer.second, nextIntervalUs, HsmTimerQueue::Clock_t::now(), getMissedTicksPolicy());
+
+                mRunningTimers.schedule(expiredTimer.first, HsmTimerQueue::alignDeadline(nextDeadline, nextSlackMs));
             }
-        } else {
-            mRunningTimersSync.unlock();
+        }
+    }
 
-            // wait for timer events
-            mTimerEvent.wait(lck);
+    mExpiredTimers.clear();
+}
+
+void HsmEventDispatcherSTD::onServiceTimerExpired(const TimerID_t timerID, const HsmTimerQueue::TimePoint_t& deadline) {
+    {
+        LockGuard lck(mEmitSync);
+        mServiceExpiredTimers.emplace_back(timerID, deadline);
+    }
+
+    notifyDispatcherAboutEvent();
+}
+
+void HsmEventDispatcherSTD::processServiceExpiredTimers() {
+    {
+        LockGuard lck(mEmitSync);
+
+        // NOTE: mExpiredTimers is always empty here. Swapping allows to reuse memory of both vectors
+        mExpiredTimers.swap(mServiceExpiredTimers);
+    }
+
+    for (const HsmTimerQueue::Expiration_t& expiredTimer : mExpiredTimers) {
+        // timer could have been restarted after service reported its expiration. In this case expiration is outdated
+        if (false == mTimerService->isScheduled(mTimerServiceClientID, expiredTimer.first)) {
+            uint64_t nextIntervalUs = 0;
+            unsigned int nextSlackMs = 0;
+
+            // timer could have been restarted from the handler. In this case it's already scheduled
+            if ((true == handleTimerEvent(expiredTimer.first, nextIntervalUs, nextSlackMs)) &&
+                (false == mTimerService->isScheduled(mTimerServiceClientID, expiredTimer.first))) {
+                // next deadline is based on the previous one to avoid drift of repeating timers
+                const HsmTimerQueue::TimePoint_t nextDeadline = HsmTimerQueue::getNextDeadline(
+                    expiredTimer.second, nextIntervalUs, HsmTimerQueue::Clock_t::now(), getMissedTicksPolicy());
+
+                mTimerService->schedule(mTimerServiceClientID,
+                                        expiredTimer.first,
+                                        HsmTimerQueue::alignDeadline(nextDeadline, nextSlackMs));
+            }
         }
     }
 
-    HSM_TRACE_DEBUG("EXIT");
+    mExpiredTimers.clear();
 }
 
-}  // namespace hsmcpp
\ No newline at end of file
+}  // namespace hsmcpp
@@ -49,6 +49,11 @@ HSM_TRACE_PREINIT()
 
 constexpr const char* HSM_TRACE_CLASS = "HierarchicalStateMachine";
 
+#ifdef HSMBUILD_DEBUGGING
+// Limits length of a single transition argument written to HSM log. Longer values are truncated.
+constexpr std::size_t HSM_LOG_MAX_ARGUMENT_LENGTH = 1024;
+#endif  // HSMBUILD_DEBUGGING
+
 // These macroses can't be converted to 'constexpr' template functions
 // NOLINTBEGIN(cppcoreguidelines-macro-usage)
 
@@ -69,6 +74,12 @@ constexpr const char* HSM_TRACE_CLASS = "HierarchicalStateMachine";
   #define HSM_SYNC_EVENTS_QUEUE() LockGuard lck(mEventsSync)
 #endif  // HSM_DISABLE_THREADSAFETY
 
+#ifdef HSM_DISABLE_THREADSAFETY
+  #define HSM_SYNC_STATE_WAITERS()
+#else
+  #define HSM_SYNC_STATE_WAITERS() LockGuard lckWaiters(mStateWaitersSync)
+#endif  // HSM_DISABLE_THREADSAFETY
+
 // NOLINTEND(cppcoreguidelines-macro-usage)
 
 namespace hsmcpp {
@@ -79,10 +90,24 @@ namespace hsmcpp {
 HierarchicalStateMachine::Impl::Impl(HierarchicalStateMachine* parent, const StateID_t initialState)
     // cppcheck-suppress misra-c2012-10.4 ; false-positive. thinks that ':' is arithmetic operation
     : mParent(parent)
-    , mInitialState(initialState) {
+    , mDefinition(std::make_shared<HsmDefinition>(initialState)) {
     HSM_TRACE_INIT();
 }
 
+HierarchicalStateMachine::Impl::Impl(HierarchicalStateMachine* parent, const std::shared_ptr<const HsmDefinition>& definition)
+    // cppcheck-suppress misra-c2012-10.4 ; false-positive. thinks that ':' is arithmetic operation
+    : mParent(parent)
+    // NOTE: const is removed only to be able to keep a single pointer. modifyDefinition() will always create a copy
+    //       of the definition while it's shared with other instances
+    , mDefinition(std::const_pointer_cast<HsmDefinition>(definition)) {
+    HSM_TRACE_INIT();
+
+    // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
+    if (!mDefinition) {
+        mDefinition = std::make_shared<HsmDefinition>(INVALID_HSM_STATE_ID);
+    }
+}
+
 HierarchicalStateMachine::Impl::~Impl() {
     release();
 }
@@ -95,9 +120,21 @@ void HierarchicalStateMachine::Impl::resetParent() {
     mParent = nullptr;
 }
 
+std::shared_ptr<const HsmDefinition> HierarchicalStateMachine::Impl::getDefinition() const {
+    return mDefinition;
+}
+
+void HierarchicalStateMachine::Impl::setUserContext(const HsmUserContext& context) {
+    mUserContext = context;
+}
+
+void* HierarchicalStateMachine::Impl::getUserContext() const {
+    return mUserContext.object;
+}
+
 void HierarchicalStateMachine::Impl::setInitialState(const StateID_t initialState) {
     if (true == mDispatcher.expired()) {
-        mInitialState = initialState;
+        modifyDefinition().initialState = initialState;
     }
 }
 
@@ -178,12 +215,36 @@ void HierarchicalStateMachine::Impl::release() {
         dispatcherPtr->unregisterEventHandler(mEventsHandlerId);
         dispatcherPtr->unregisterEnqueuedEventHandler(mEnqueuedEventsHandlerId);
         dispatcherPtr->unregisterTimerHandler(mTimerHandlerId);
+
+        std::list<HandlerID_t> fdWatches;
+
+        {
+            HSM_SYNC_EVENTS_QUEUE();
+            fdWatches.swap(mFdWatches);
+        }
+
+        for (const HandlerID_t watchID : fdWatches) {
+            dispatcherPtr->unwatchFd(watchID);
+        }
+
         mDispatcher.reset();
         mEventsHandlerId = INVALID_HSM_DISPATCHER_HANDLER_ID;
 
         // wait for current dispatching to finish if it's ongoing
         mIsDispatching.wait(true);
     }
+
+    std::list<PendingEventInfo> droppedEvents;
+
+    {
+        HSM_SYNC_EVENTS_QUEUE();
+        collectIncomingEvents();
+        droppedEvents.swap(mPendingEvents);
+    }
+
+    // events will never be processed, so there is no reason to keep their senders waiting
+    releasePendingEvents(droppedEvents);
+    cancelStateWaiters();
 }
 
 void HierarchicalStateMachine::Impl::registerFailedTransitionCallback(HsmTransitionFailedCallback_t onFailedTransition) {
@@ -191,26 +252,38 @@ void HierarchicalStateMachine::Impl::registerFailedTransitionCallback(HsmTransit
 }
 
 void HierarchicalStateMachine::Impl::registerState(const StateID_t state,
-                                                   HsmStateChangedCallback_t onStateChanged,
-                                                   HsmStateEnterCallback_t onEntering,
-                                                   HsmStateExitCallback_t onExiting) {
+                                                   HsmContextStateChangedCallback_t onStateChanged,
+                                                   HsmContextStateEnterCallback_t onEntering,
+                                                   HsmContextStateExitCallback_t onExiting) {
+    HsmDefinition& definition = modifyDefinition();
+
 #ifdef HSM_ENABLE_SAFE_STRUCTURE
     if ((false == isSubstate(state)) && (false == isTopState(state))) {
-        mTopLevelStates.emplace_back(state);
+        definition.topLevelStates.emplace_back(state);
     }
 #endif  // HSM_ENABLE_SAFE_STRUCTURE
 
-    mRegisteredStates[state] =
-        std::move(StateCallbacks(std::move(onStateChanged), std::move(onEntering), std::move(onExiting)));
-    HSM_TRACE_CALL_DEBUG_ARGS("mRegisteredStates.size=%ld", mRegisteredStates.size());
+    const StateIndex_t stateIndex = definition.registerStateIndex(state);
+
+    definition.setStateFlags(stateIndex, STATE_FLAG_HAS_CHANGED_CALLBACK, static_cast<bool>(onStateChanged));
+    definition.setStateFlags(stateIndex, STATE_FLAG_HAS_ENTER_CALLBACK, static_cast<bool>(onEntering));
+    definition.setStateFlags(stateIndex, STATE_FLAG_HAS_EXIT_CALLBACK, static_cast<bool>(onExiting));
+    definition.onStateChangedCallbacks[stateIndex] = std::move(onStateChanged);
+    definition.onEnteringCallbacks[stateIndex] = std::move(onEntering);
+    definition.onExitingCallbacks[stateIndex] = std::move(onExiting);
+    HSM_TRACE_CALL_DEBUG_ARGS("registeredStates.size=%ld", definition.stateIds.size());
 }
 
 void HierarchicalStateMachine::Impl::registerFinalState(const StateID_t state,
                                                         const EventID_t event,
-                                                        HsmStateChangedCallback_t onStateChanged,
-                                                        HsmStateEnterCallback_t onEntering,
-                                                        HsmStateExitCallback_t onExiting) {
-    mFinalStates[state] = event;
+                                                        HsmContextStateChangedCallback_t onStateChanged,
+                                                        HsmContextStateEnterCallback_t onEntering,
+                                                        HsmContextStateExitCallback_t onExiting) {
+    HsmDefinition& definition = modifyDefinition();
+    const StateIndex_t stateIndex = definition.registerStateIndex(state);
+
+    definition.setStateFlags(stateIndex, STATE_FLAG_FINAL, true);
+    definition.finalStateEvents[stateIndex] = event;
     registerState(state, std::move(onStateChanged), std::move(onEntering), std::move(onExiting));
 }
 
@@ -218,9 +291,12 @@ void HierarchicalStateMachine::Impl::registerHistory(const StateID_t parent,
                                                      const StateID_t historyState,
                                                      const HistoryType type,
                                                      const StateID_t defaultTarget,
-                                                     HsmTransitionCallback_t transitionCallback) {
-    (void)mHistoryStates.emplace(parent, historyState);
-    mHistoryData[historyState] = std::move(HistoryInfo(type, defaultTarget, std::move(transitionCallback)));
+                                                     HsmContextTransitionCallback_t transitionCallback) {
+    HsmDefinition& definition = modifyDefinition();
+
+    definition.setStateFlags(definition.registerStateIndex(parent), STATE_FLAG_HAS_HISTORY, true);
+    (void)definition.historyStates.emplace(parent, historyState);
+    definition.historyData[historyState] = std::move(HistoryInfo(type, defaultTarget, std::move(transitionCallback)));
 }
 
 bool HierarchicalStateMachine::Impl::registerSubstate(const StateID_t parent, const StateID_t substate) {
@@ -230,20 +306,20 @@ bool HierarchicalStateMachine::Impl::registerSubstate(const StateID_t parent, co
 bool HierarchicalStateMachine::Impl::registerSubstateEntryPoint(const StateID_t parent,
                                                                 const StateID_t substate,
                                                                 const EventID_t onEvent,
-                                                                HsmTransitionConditionCallback_t conditionCallback,
+                                                                HsmContextTransitionConditionCallback_t conditionCallback,
                                                                 const bool expectedConditionValue) {
     return registerSubstate(parent, substate, true, onEvent, std::move(conditionCallback), expectedConditionValue);
 }
 
 void HierarchicalStateMachine::Impl::registerTimer(const TimerID_t timerID, const EventID_t event) {
-    mTimers[timerID] = event;
+    modifyDefinition().timers[timerID] = event;
 }
 
 bool HierarchicalStateMachine::Impl::registerSubstate(const StateID_t parent,
                                                       const StateID_t substate,
                                                       const bool isEntryPoint,
                                                       const EventID_t eventCondition,
-                                                      HsmTransitionConditionCallback_t conditionCallback,
+                                                      HsmContextTransitionConditionCallback_t conditionCallback,
                                                       const bool expectedConditionValue) {
     bool registrationAllowed = false;
 
@@ -279,6 +355,8 @@ bool HierarchicalStateMachine::Impl::registerSubstate(const StateID_t parent,
 #endif  // HSM_ENABLE_SAFE_STRUCTURE
 
     if (registrationAllowed) {
+        HsmDefinition& definition = modifyDefinition();
+
         // NOTE: false-positive. isEntryPoint is of type bool
         // cppcheck-suppress misra-c2012-14.4
         if (isEntryPoint) {
@@ -289,14 +367,15 @@ bool HierarchicalStateMachine::Impl::registerSubstate(const StateID_t parent,
             entryInfo.checkCondition = std::move(conditionCallback);
             entryInfo.expectedConditionValue = expectedConditionValue;
 
-            (void)mSubstateEntryPoints.emplace(parent, entryInfo);
+            definition.setStateFlags(definition.registerStateIndex(parent), STATE_FLAG_HAS_ENTRY_POINTS, true);
+            (void)definition.substateEntryPoints.emplace(parent, entryInfo);
         }
 
-        (void)mSubstates.emplace(parent, substate);
+        (void)definition.substates.emplace(parent, substate);
 
 #ifdef HSM_ENABLE_SAFE_STRUCTURE
         if (true == isTopState(substate)) {
-            mTopLevelStates.remove(substate);
+            definition.topLevelStates.remove(substate);
         }
 #endif  // HSM_ENABLE_SAFE_STRUCTURE
     }
@@ -316,20 +395,33 @@ bool HierarchicalStateMachine::Impl::registerStateAction(const StateID_t state,
     bool argsValid = false;
     StateActionInfo newAction;
 
-    newAction.actionArgs = args;
-
-    // validate arguments
+    // validate and decode arguments
     switch (action) {
         case StateAction::START_TIMER:
-            argsValid = (newAction.actionArgs.size() == 3U) && newAction.actionArgs[0].isNumeric() &&
-                        newAction.actionArgs[1].isNumeric() && newAction.actionArgs[2].isBool();
+            argsValid = (args.size() == 3U) && args[0].isNumeric() && args[1].isNumeric() && args[2].isBool();
+
+            if (true == argsValid) {
+                newAction.params.timer.timerID = static_cast<TimerID_t>(args[0].toInt64());
+                newAction.params.timer.intervalMs = static_cast<unsigned int>(args[1].toInt64());
+                newAction.params.timer.isSingleShot = args[2].toBool();
+            }
             break;
         case StateAction::RESTART_TIMER:
         case StateAction::STOP_TIMER:
-            argsValid = (newAction.actionArgs.size() == 1U) && newAction.actionArgs[0].isNumeric();
+            argsValid = (args.size() == 1U) && args[0].isNumeric();
+
+            if (true == argsValid) {
+                newAction.params.timer.timerID = static_cast<TimerID_t>(args[0].toInt64());
+            }
             break;
         case StateAction::TRANSITION:
-            argsValid = (false == newAction.actionArgs.empty()) && newAction.actionArgs[0].isNumeric();
+            argsValid = (false == args.empty()) && args[0].isNumeric();
+
+            if (true == argsValid) {
+                newAction.params.event = static_cast<EventID_t>(args[0].toInt64());
+                // store arguments except for the first one
+                newAction.transitionArgs.assign(args.begin() + 1, args.end());
+            }
             break;
         default:
             // do nothing
@@ -337,9 +429,22 @@ bool HierarchicalStateMachine::Impl::registerStateAction(const StateID_t state,
     }
 
     if (true == argsValid) {
+        HsmDefinition& definition = modifyDefinition();
+        const StateIndex_t stateIndex = definition.registerStateIndex(state);
+
         newAction.action = action;
-        (void)mRegisteredActions.emplace(std::make_pair(state, actionTrigger), newAction);
-        result = true;
+
+        if (StateActionTrigger::ON_STATE_ENTRY == actionTrigger) {
+            definition.entryActions[stateIndex].emplace_back(std::move(newAction));
+            definition.setStateFlags(stateIndex, STATE_FLAG_HAS_ENTRY_ACTIONS, true);
+            result = true;
+        } else if (StateActionTrigger::ON_STATE_EXIT == actionTrigger) {
+            definition.exitActions[stateIndex].emplace_back(std::move(newAction));
+            definition.setStateFlags(stateIndex, STATE_FLAG_HAS_EXIT_ACTIONS, true);
+            result = true;
+        } else {
+            HSM_TRACE_ERROR("unsupported action trigger");
+        }
     } else {
         HSM_TRACE_ERROR("invalid arguments");
     }
@@ -357,31 +462,31 @@ bool HierarchicalStateMachine::Impl::registerStateAction(const StateID_t state,
 void HierarchicalStateMachine::Impl::registerTransition(const StateID_t fromState,
                                                         const StateID_t toState,
                                                         const EventID_t onEvent,
-                                                        HsmTransitionCallback_t transitionCallback,
-                                                        HsmTransitionConditionCallback_t conditionCallback,
+                                                        HsmContextTransitionCallback_t transitionCallback,
+                                                        HsmContextTransitionConditionCallback_t conditionCallback,
                                                         const bool expectedConditionValue) {
-    (void)mTransitionsByEvent.emplace(std::make_pair(fromState, onEvent),
-                                      TransitionInfo(fromState,
-                                                     toState,
-                                                     TransitionType::EXTERNAL_TRANSITION,
-                                                     std::move(transitionCallback),
-                                                     std::move(conditionCallback),
-                                                     expectedConditionValue));
+    (void)modifyDefinition().transitionsByEvent.emplace(std::make_pair(fromState, onEvent),
+                                                        TransitionInfo(fromState,
+                                                                       toState,
+                                                                       TransitionType::EXTERNAL_TRANSITION,
+                                                                       std::move(transitionCallback),
+                                                                       std::move(conditionCallback),
+                                                                       expectedConditionValue));
 }
 
 void HierarchicalStateMachine::Impl::registerSelfTransition(const StateID_t state,
                                                             const EventID_t onEvent,
                                                             const TransitionType type,
-                                                            HsmTransitionCallback_t transitionCallback,
-                                                            HsmTransitionConditionCallback_t conditionCallback,
+                                                            HsmContextTransitionCallback_t transitionCallback,
+                                                            HsmContextTransitionConditionCallback_t conditionCallback,
                                                             const bool expectedConditionValue) {
-    (void)mTransitionsByEvent.emplace(std::make_pair(state, onEvent),
-                                      TransitionInfo(state,
-                                                     state,
-                                                     type,
-                                                     std::move(transitionCallback),
-                                                     std::move(conditionCallback),
-                                                     expectedConditionValue));
+    (void)modifyDefinition().transitionsByEvent.emplace(std::make_pair(state, onEvent),
+                                                        TransitionInfo(state,
+                                                                       state,
+                                                                       type,
+                                                                       std::move(transitionCallback),
+                                                                       std::move(conditionCallback),
+                                                                       expectedConditionValue));
 }
 
 StateID_t HierarchicalStateMachine::Impl::getLastActiveState() const {
@@ -402,6 +507,14 @@ bool HierarchicalStateMachine::Impl::isStateActive(const StateID_t state) const
     return (std::find(mActiveStates.begin(), mActiveStates.end(), state) != mActiveStates.end());
 }
 
+void HierarchicalStateMachine::Impl::getActiveStatesSnapshot(ActiveStatesSnapshot& outSnapshot) const {
+    outSnapshot.version = mActiveStatesSnapshot.read(outSnapshot.states, outSnapshot.count);
+}
+
+uint32_t HierarchicalStateMachine::Impl::getActiveStatesVersion() const {
+    return mActiveStatesSnapshot.version();
+}
+
 void HierarchicalStateMachine::Impl::transitionWithArgsArray(const EventID_t event, const VariantVector_t& args) {
     VariantVector_t argsCopy = args;
     transitionWithArgsArray(event, std::move(argsCopy));
@@ -438,15 +551,7 @@ bool HierarchicalStateMachine::Impl::transitionExWithArgsArray(const EventID_t e
             eventInfo.initLock();
         }
 
-        {
-            HSM_SYNC_EVENTS_QUEUE();
-
-            if (true == clearQueue) {
-                clearPendingEvents();
-            }
-
-            mPendingEvents.emplace_back(eventInfo);
-        }
+        addPendingEvent(eventInfo, clearQueue);
 
         HSM_TRACE_DEBUG("transitionEx: emit");
         dispatcherPtr->emitEvent(mEventsHandlerId);
@@ -467,6 +572,40 @@ bool HierarchicalStateMachine::Impl::transitionExWithArgsArray(const EventID_t e
     return status;
 }
 
+void HierarchicalStateMachine::Impl::transitionWithCallback(const EventID_t event,
+                                                            const bool clearQueue,
+                                                            HsmTransitionDoneCallback_t onDone,
+                                                            VariantVector_t&& args) {
+    HSM_TRACE_CALL_DEBUG_ARGS("event=<%s>, clearQueue=%s, args.size=%lu",
+                              getEventName(event).c_str(),
+                              BOOL2STR(clearQueue),
+                              args.size());
+    auto dispatcherPtr = mDispatcher.lock();
+
+    // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
+    if (dispatcherPtr) {
+        PendingEventInfo eventInfo;
+
+        eventInfo.id = event;
+        eventInfo.args = std::make_shared<VariantVector_t>(std::move(args));
+
+        // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::function has a bool() operator
+        if (onDone) {
+            eventInfo.onTransitionDone = std::make_shared<HsmTransitionDoneCallback_t>(std::move(onDone));
+        }
+
+        addPendingEvent(eventInfo, clearQueue);
+        dispatcherPtr->emitEvent(mEventsHandlerId);
+    } else {
+        HSM_TRACE_ERROR("HSM is not initialized");
+
+        // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::function has a bool() operator
+        if (onDone) {
+            onDone(HsmEventStatus::DONE_FAILED);
+        }
+    }
+}
+
 bool HierarchicalStateMachine::Impl::transitionInterruptSafe(const EventID_t event) {
     bool res = false;
     // TODO: this part needs testing with real interrupts. Not sure if it's safe to use weak_ptr.lock()
@@ -497,13 +636,23 @@ bool HierarchicalStateMachine::Impl::isTransitionPossible(const EventID_t event,
 }
 
 void HierarchicalStateMachine::Impl::startTimer(const TimerID_t timerID,
-                                                const unsigned int intervalMs,
+                                                const uint64_t intervalUs,
+                                                const unsigned int slackMs,
                                                 const bool isSingleShot) {
     auto dispatcherPtr = mDispatcher.lock();
 
     // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
     if (dispatcherPtr) {
-        dispatcherPtr->startTimer(mTimerHandlerId, timerID, intervalMs, isSingleShot);
+        if (0u == slackMs) {
+            dispatcherPtr->startTimerUs(mTimerHandlerId, timerID, intervalUs, isSingleShot);
+        } else {
+            // NOTE: coarse timers don't need sub-millisecond precision
+            dispatcherPtr->startTimerWithSlack(mTimerHandlerId,
+                                               timerID,
+                                               static_cast<unsigned int>((intervalUs + 999u) / 1000u),
+                                               slackMs,
+                                               isSingleShot);
+        }
     }
 }
 
@@ -512,7 +661,7 @@ void HierarchicalStateMachine::Impl::restartTimer(const TimerID_t timerID) {
 
     // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
     if (dispatcherPtr) {
-        dispatcherPtr->restartTimer(timerID);
+        dispatcherPtr->restartTimer(mTimerHandlerId, timerID);
     }
 }
 
@@ -521,7 +670,7 @@ void HierarchicalStateMachine::Impl::stopTimer(const TimerID_t timerID) {
 
     // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
     if (dispatcherPtr) {
-        dispatcherPtr->stopTimer(timerID);
+        dispatcherPtr->stopTimer(mTimerHandlerId, timerID);
     }
 }
 
@@ -531,12 +680,61 @@ bool HierarchicalStateMachine::Impl::isTimerRunning(const TimerID_t timerID) {
 
     // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
     if (dispatcherPtr) {
-        running = dispatcherPtr->isTimerRunning(timerID);
+        running = dispatcherPtr->isTimerRunning(mTimerHandlerId, timerID);
     }
 
     return running;
 }
 
+HandlerID_t HierarchicalStateMachine::Impl::watchFd(const int fd, const FdEvents_t events, const EventID_t event) {
+    HSM_TRACE_CALL_DEBUG_ARGS("fd=%d, events=%d, event=<%s>", fd, SC2INT(events), getEventName(event).c_str());
+    HandlerID_t watchID = INVALID_HSM_DISPATCHER_HANDLER_ID;
+    auto dispatcherPtr = mDispatcher.lock();
+
+    // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
+    if (dispatcherPtr) {
+        // NOTE: HSM can be initialized only if it's owned by a shared_ptr, so shared_from_this() is safe here
+        const std::weak_ptr<Impl> ptrInstance = shared_from_this();
+
+        // cppcheck-suppress misra-c2012-13.1 ; false-positive. this is a functor, not initializer list
+        watchID = dispatcherPtr->watchFd(fd, events, [ptrInstance, event](const int readyFd, const FdEvents_t readyEvents) {
+            bool handlerIsValid = false;
+            auto pThis = ptrInstance.lock();
+
+            // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
+            if (pThis && (false == pThis->mStopDispatching)) {
+                pThis->dispatchFdEvent(readyFd, readyEvents, event);
+                handlerIsValid = true;
+            }
+
+            // NOTE: false-positive. "return" statement belongs to lambda function, not parent function
+            // cppcheck-suppress misra-c2012-15.5
+            return handlerIsValid;
+        });
+
+        if (INVALID_HSM_DISPATCHER_HANDLER_ID != watchID) {
+            HSM_SYNC_EVENTS_QUEUE();
+            mFdWatches.emplace_back(watchID);
+        }
+    }
+
+    return watchID;
+}
+
+void HierarchicalStateMachine::Impl::unwatchFd(const HandlerID_t watchID) {
+    auto dispatcherPtr = mDispatcher.lock();
+
+    // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
+    if (dispatcherPtr) {
+        {
+            HSM_SYNC_EVENTS_QUEUE();
+            mFdWatches.remove(watchID);
+        }
+
+        dispatcherPtr->unwatchFd(watchID);
+    }
+}
+
 // ============================================================================
 // PRIVATE
 // ============================================================================
@@ -604,14 +802,15 @@ void HierarchicalStateMachine::Impl::handleStartup() {
 
     // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
     if (dispatcherPtr) {
-        HSM_TRACE_DEBUG("state=<%s>", getStateName(mInitialState).c_str());
+        const StateID_t initialState = mDefinition->initialState;
+        HSM_TRACE_DEBUG("state=<%s>", getStateName(initialState).c_str());
         std::list<StateID_t> entryPoints;
 
-        (void)onStateEntering(mInitialState, VariantVector_t());
-        mActiveStates.emplace_back(mInitialState);
-        onStateChanged(mInitialState, VariantVector_t());
+        (void)onStateEntering(initialState, VariantVector_t());
+        mActiveStates.emplace_back(initialState);
+        onStateChanged(initialState, VariantVector_t());
 
-        if (true == getEntryPoints(mInitialState, INVALID_HSM_EVENT_ID, VariantVector_t(), entryPoints)) {
+        if (true == getEntryPoints(initialState, INVALID_HSM_EVENT_ID, VariantVector_t(), entryPoints)) {
             PendingEventInfo entryPointTransitionEvent;
 
             entryPointTransitionEvent.transitionType = TransitionBehavior::ENTRYPOINT;
@@ -623,7 +822,7 @@ void HierarchicalStateMachine::Impl::handleStartup() {
             }
         }
 
-        if (false == mPendingEvents.empty()) {
+        if (true == hasPendingEvents()) {
             dispatcherPtr->emitEvent(mEventsHandlerId);
         }
     }
@@ -633,6 +832,15 @@ void HierarchicalStateMachine::Impl::transitionSimple(const EventID_t event) {
     (void)transitionExWithArgsArray(event, false, false, 0, VariantVector_t());
 }
 
+HsmDefinition& HierarchicalStateMachine::Impl::modifyDefinition() {
+    // NOTE: HSM structure is not allowed to be modified from multiple threads, so it's fine to rely on use_count()
+    if (mDefinition.use_count() > 1) {
+        mDefinition = std::make_shared<HsmDefinition>(*mDefinition);
+    }
+
+    return *mDefinition;
+}
+
 void HierarchicalStateMachine::Impl::dispatchEvents() {
     HSM_TRACE_CALL_DEBUG_ARGS("mPendingEvents.size=%ld", mPendingEvents.size());
     auto dispatcherPtr = mDispatcher.lock();
@@ -642,22 +850,36 @@ void HierarchicalStateMachine::Impl::dispatchEvents() {
         UniqueLock lk = mIsDispatching.lock();
 
         if (false == mStopDispatching) {
-            if (false == mPendingEvents.empty()) {
-                PendingEventInfo pendingEvent;
+            PendingEventInfo pendingEvent;
+            bool hasEvent = false;
 
-                {
-                    HSM_SYNC_EVENTS_QUEUE();
+            {
+                HSM_SYNC_EVENTS_QUEUE();
+                collectIncomingEvents();
+
+                if (false == mPendingEvents.empty()) {
                     pendingEvent = std::move(mPendingEvents.front());
                     mPendingEvents.pop_front();
+                    hasEvent = true;
                 }
+            }
 
+            if (true == hasEvent) {
                 HsmEventStatus transitiontStatus = doTransition(pendingEvent);
 
+                // NOTE: not every change of active states is followed by onStateChanged() (states can be exited without
+                //       activating new ones), so final configuration is always published here
+                publishActiveStates();
+
                 HSM_TRACE_DEBUG("unlock with status %d", SC2INT(transitiontStatus));
                 pendingEvent.unlock(transitiontStatus);
             }
 
-            if ((false == mStopDispatching) && (false == mPendingEvents.empty())) {
+            if (true == mStateWaitersRecheck.exchange(false)) {
+                notifyActiveStateWaiters();
+            }
+
+            if ((false == mStopDispatching) && ((true == hasPendingEvents()) || (true == mStateWaitersRecheck.load()))) {
                 dispatcherPtr->emitEvent(mEventsHandlerId);
             }
         }
@@ -669,20 +891,41 @@ void HierarchicalStateMachine::Impl::dispatchEvents() {
 
 void HierarchicalStateMachine::Impl::dispatchTimerEvent(const TimerID_t id) {
     HSM_TRACE_CALL_DEBUG_ARGS("id=%d", SC2INT(id));
-    auto it = mTimers.find(id);
+    auto it = mDefinition->timers.find(id);
 
-    if (mTimers.end() != it) {
+    if (mDefinition->timers.end() != it) {
         transitionSimple(it->second);
     }
 }
 
+void HierarchicalStateMachine::Impl::dispatchFdEvent(const int fd, const FdEvents_t events, const EventID_t event) {
+    HSM_TRACE_CALL_DEBUG_ARGS("fd=%d, events=%d", fd, SC2INT(events));
+    size_t eventsToProcess = 0;
+
+    transitionWithArgsArray(event, VariantVector_t{Variant(fd), Variant(events)});
+
+    {
+        HSM_SYNC_EVENTS_QUEUE();
+        collectIncomingEvents();
+        eventsToProcess = mPendingEvents.size();
+    }
+
+    // NOTE: we are already on dispatcher's thread. Process the new event (and all events enqueued before it) right
+    //       away so that fd is handled before dispatcher checks its readiness again. Events which will be added
+    //       during this processing are left for the regular dispatching.
+    for (size_t i = 0; (i < eventsToProcess) && (false == mStopDispatching); ++i) {
+        dispatchEvents();
+    }
+}
+
 bool HierarchicalStateMachine::Impl::onStateExiting(const StateID_t state) {
     HSM_TRACE_CALL_DEBUG_ARGS("state=<%s>", getStateName(state).c_str());
     bool res = true;
-    auto it = mRegisteredStates.find(state);
+    const StateIndex_t stateIndex = mDefinition->getStateIndex(state);
+    const StateFlags_t flags = mDefinition->getStateFlags(stateIndex);
 
-    if ((mRegisteredStates.end() != it) && it->second.onExiting) {
-        res = it->second.onExiting();
+    if (0U != (flags & STATE_FLAG_HAS_EXIT_CALLBACK)) {
+        res = mDefinition->onExitingCallbacks[stateIndex](mUserContext);
         logHsmAction(HsmLogAction::CALLBACK_EXIT,
                      state,
                      INVALID_HSM_STATE_ID,
@@ -692,8 +935,8 @@ bool HierarchicalStateMachine::Impl::onStateExiting(const StateID_t state) {
     }
 
     // execute state action only if transition was accepted by client
-    if (true == res) {
-        executeStateAction(state, StateActionTrigger::ON_STATE_EXIT);
+    if ((true == res) && (0U != (flags & STATE_FLAG_HAS_EXIT_ACTIONS))) {
+        executeStateAction(stateIndex, StateActionTrigger::ON_STATE_EXIT);
     }
 
     return res;
@@ -706,16 +949,17 @@ bool HierarchicalStateMachine::Impl::onStateEntering(const StateID_t state, cons
     // since we can have a situation when same state is entered twice (parallel transitions) there
     // is no need to call callbacks multiple times
     if (false == isStateActive(state)) {
-        auto it = mRegisteredStates.find(state);
+        const StateIndex_t stateIndex = mDefinition->getStateIndex(state);
+        const StateFlags_t flags = mDefinition->getStateFlags(stateIndex);
 
-        if ((mRegisteredStates.end() != it) && it->second.onEntering) {
-            res = it->second.onEntering(args);
+        if (0U != (flags & STATE_FLAG_HAS_ENTER_CALLBACK)) {
+            res = mDefinition->onEnteringCallbacks[stateIndex](mUserContext, args);
             logHsmAction(HsmLogAction::CALLBACK_ENTER, INVALID_HSM_STATE_ID, state, INVALID_HSM_EVENT_ID, (false == res), args);
         }
 
         // execute state action only if transition was accepted by client
-        if (true == res) {
-            executeStateAction(state, StateActionTrigger::ON_STATE_ENTRY);
+        if ((true == res) && (0U != (flags & STATE_FLAG_HAS_ENTRY_ACTIONS))) {
+            executeStateAction(stateIndex, StateActionTrigger::ON_STATE_ENTRY);
         }
     }
 
@@ -724,23 +968,227 @@ bool HierarchicalStateMachine::Impl::onStateEntering(const StateID_t state, cons
 
 void HierarchicalStateMachine::Impl::onStateChanged(const StateID_t state, const VariantVector_t& args) {
     HSM_TRACE_CALL_DEBUG_ARGS("state=<%s>", getStateName(state).c_str());
-    auto it = mRegisteredStates.find(state);
+    const StateIndex_t stateIndex = mDefinition->getStateIndex(state);
 
-    if ((mRegisteredStates.end() != it) && it->second.onStateChanged) {
-        it->second.onStateChanged(args);
+    publishActiveStates();
+
+    if (0U != (mDefinition->getStateFlags(stateIndex) & STATE_FLAG_HAS_CHANGED_CALLBACK)) {
+        mDefinition->onStateChangedCallbacks[stateIndex](mUserContext, args);
         logHsmAction(HsmLogAction::CALLBACK_STATE, INVALID_HSM_STATE_ID, state, INVALID_HSM_EVENT_ID, false, args);
     } else {
         HSM_TRACE_WARNING("no callback registered for state <%s>", getStateName(state).c_str());
     }
+
+    notifyStateWaiters(state);
+}
+
+void HierarchicalStateMachine::Impl::notifyStateWaiters(const StateID_t state) {
+    std::list<StateWaiterInfo> activatedWaiters;
+
+    {
+        HSM_SYNC_STATE_WAITERS();
+
+        for (auto it = mStateWaiters.begin(); it != mStateWaiters.end();) {
+            auto itCurrent = it++;
+
+            if (std::find(itCurrent->states.begin(), itCurrent->states.end(), state) != itCurrent->states.end()) {
+                activatedWaiters.splice(activatedWaiters.end(), mStateWaiters, itCurrent);
+            }
+        }
+    }
+
+    // NOTE: waiters are called without holding mStateWaitersSync so that they could register new waiters
+    for (const StateWaiterInfo& waiter : activatedWaiters) {
+        waiter.onDone(true);
+    }
+}
+
+void HierarchicalStateMachine::Impl::notifyActiveStateWaiters() {
+    std::list<StateWaiterInfo> activatedWaiters;
+
+    {
+        HSM_SYNC_STATE_WAITERS();
+
+        for (auto it = mStateWaiters.begin(); it != mStateWaiters.end();) {
+            auto itCurrent = it++;
+
+            // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+            if (true == std::any_of(itCurrent->states.begin(), itCurrent->states.end(), [&](const StateID_t state) {
+                    return isStateActive(state);
+                })) {
+                activatedWaiters.splice(activatedWaiters.end(), mStateWaiters, itCurrent);
+            }
+        }
+    }
+
+    for (const StateWaiterInfo& waiter : activatedWaiters) {
+        waiter.onDone(true);
+    }
+}
+
+bool HierarchicalStateMachine::Impl::isAnyStatePublished(const std::list<StateID_t>& states, bool& outIsKnown) const {
+    ActiveStatesSnapshot snapshot;
+
+    getActiveStatesSnapshot(snapshot);
+
+    const size_t storedCount = ((snapshot.count < HSM_ACTIVE_STATES_SNAPSHOT_CAPACITY) ? snapshot.count
+                                                                                      : HSM_ACTIVE_STATES_SNAPSHOT_CAPACITY);
+    const StateID_t* const itBegin = &snapshot.states[0];
+    const StateID_t* const itEnd = itBegin + storedCount;
+    // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+    const bool isActive = std::any_of(states.begin(), states.end(), [&](const StateID_t state) {
+        return (std::find(itBegin, itEnd, state) != itEnd);
+    });
+
+    outIsKnown = (true == isActive) || (snapshot.count <= HSM_ACTIVE_STATES_SNAPSHOT_CAPACITY);
+    return isActive;
+}
+
+void HierarchicalStateMachine::Impl::publishActiveStates() {
+    if (true == mActiveStatesSnapshot.publish(mActiveStates.begin(), mActiveStates.end())) {
+        HSM_TRACE_DEBUG("active states version=%u", static_cast<unsigned int>(mActiveStatesSnapshot.version()));
+    }
+}
+
+void HierarchicalStateMachine::Impl::cancelStateWaiters() {
+    std::list<StateWaiterInfo> canceledWaiters;
+
+    {
+        HSM_SYNC_STATE_WAITERS();
+        mStateWaitersCanceled = true;
+        canceledWaiters.swap(mStateWaiters);
+    }
+
+    for (const StateWaiterInfo& waiter : canceledWaiters) {
+        waiter.onDone(false);
+    }
+}
+
+bool HierarchicalStateMachine::Impl::addStateWaiter(const std::list<StateID_t>& states,
+                                                    StateWaiterCallback_t onDone,
+                                                    bool& outIsActive) {
+    StateWaiterID_t waiterID = 0;
+
+    return addStateWaiter(states, std::move(onDone), outIsActive, waiterID);
+}
+
+bool HierarchicalStateMachine::Impl::addStateWaiter(const std::list<StateID_t>& states,
+                                                    StateWaiterCallback_t onDone,
+                                                    bool& outIsActive,
+                                                    StateWaiterID_t& outWaiterID) {
+    HSM_TRACE_CALL_DEBUG_ARGS("states.size=%lu", states.size());
+    bool wasAdded = false;
+    bool isKnown = true;
+
+    outIsActive = false;
+
+    {
+        // NOTE: mActiveStates can be accessed only by dispatching thread, so published copy is checked instead.
+        //       onStateChanged() publishes active states before notifyStateWaiters() locks mStateWaitersSync. So either
+        //       state will be already in the snapshot here or new waiter will be visible to notifyStateWaiters()
+        HSM_SYNC_STATE_WAITERS();
+
+        if (false == mStateWaitersCanceled) {
+            outIsActive = isAnyStatePublished(states, isKnown);
+
+            if (false == outIsActive) {
+                ++mLastStateWaiterID;
+                outWaiterID = mLastStateWaiterID;
+                mStateWaiters.push_back(StateWaiterInfo{outWaiterID, states, std::move(onDone)});
+                wasAdded = true;
+            }
+        }
+    }
+
+    if ((true == wasAdded) && (false == isKnown)) {
+        // snapshot doesn't contain all active states. Dispatching thread will notify the waiter if state is already active
+        auto dispatcherPtr = mDispatcher.lock();
+
+        mStateWaitersRecheck = true;
+
+        // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
+        if (dispatcherPtr) {
+            dispatcherPtr->emitEvent(mEventsHandlerId);
+        }
+    }
+
+    return wasAdded;
 }
 
-void HierarchicalStateMachine::Impl::executeStateAction(const StateID_t state, const StateActionTrigger actionTrigger) {
+bool HierarchicalStateMachine::Impl::removeStateWaiter(const StateWaiterID_t waiterID) {
+    bool wasRemoved = false;
+    StateWaiterCallback_t onDone;
+
+    {
+        HSM_SYNC_STATE_WAITERS();
+
+        // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+        auto it = std::find_if(mStateWaiters.begin(), mStateWaiters.end(), [&](const StateWaiterInfo& waiter) {
+            return (waiterID == waiter.id);
+        });
+
+        if (mStateWaiters.end() != it) {
+            // NOTE: callback is destroyed outside of the lock since it can own arbitrary user data
+            onDone = std::move(it->onDone);
+            mStateWaiters.erase(it);
+            wasRemoved = true;
+        }
+    }
+
+    return wasRemoved;
+}
+
+bool HierarchicalStateMachine::Impl::waitForAnyState(const std::list<StateID_t>& states, const int timeoutMs) {
+    HSM_TRACE_CALL_DEBUG_ARGS("states.size=%lu, timeoutMs=%d", states.size(), timeoutMs);
+    bool isActive = false;
+    StateWaiterID_t waiterID = 0;
+    // NOTE: waiter can be notified after waitForAnyState() returned, so its state must be shared
+    auto waitInfo = std::make_shared<StateWaitInfo>();
+    auto onDone = [waitInfo](const bool isActivated) {
+        LockGuard lck(waitInfo->sync);
+
+        waitInfo->isDone = true;
+        waitInfo->isActive = isActivated;
+        waitInfo->activated.notify();
+    };
+
+    if (true == addStateWaiter(states, onDone, isActive, waiterID)) {
+        {
+            UniqueLock lck(waitInfo->sync);
+
+            if (timeoutMs > 0) {
+                // NOTE: false-positive. "return" statement belongs to lambda function, not parent function
+                // cppcheck-suppress [misra-c2012-15.5, misra-c2012-17.7]
+                waitInfo->activated.wait_for(lck, timeoutMs, [&]() { return waitInfo->isDone; });
+            } else {
+                // NOTE: false-positive. "return" statement belongs to lambda function, not parent function
+                // cppcheck-suppress [misra-c2012-15.5, misra-c2012-17.7]
+                waitInfo->activated.wait(lck, [&]() { return waitInfo->isDone; });
+            }
+        }
+
+        // NOTE: waiter is still registered if timeout expired. It could be notified while it's being removed, so result
+        //       must be checked only after that
+        (void)removeStateWaiter(waiterID);
+
+        LockGuard lck(waitInfo->sync);
+        isActive = waitInfo->isActive;
+    }
+
+    HSM_TRACE_CALL_RESULT("%d", BOOL2INT(isActive));
+    return isActive;
+}
+
+void HierarchicalStateMachine::Impl::executeStateAction(const StateIndex_t stateIndex, const StateActionTrigger actionTrigger) {
+    const StateID_t state = mDefinition->stateIds[stateIndex];
     HSM_TRACE_CALL_DEBUG_ARGS("state=<%s>, actionTrigger=%d", getStateName(state).c_str(), SC2INT(actionTrigger));
     auto dispatcherPtr = mDispatcher.lock();
-    auto itRange = mRegisteredActions.equal_range(std::make_pair(state, actionTrigger));
+    const std::vector<StateActionInfo>& actions = ((StateActionTrigger::ON_STATE_ENTRY == actionTrigger)
+                                                       ? mDefinition->entryActions[stateIndex]
+                                                       : mDefinition->exitActions[stateIndex]);
 
     // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
-    if (dispatcherPtr && (itRange.first != itRange.second)) {
+    if (dispatcherPtr && (false == actions.empty())) {
         switch (actionTrigger) {
             case StateActionTrigger::ON_STATE_ENTRY:
                 logHsmAction(HsmLogAction::ON_ENTER_ACTIONS, INVALID_HSM_STATE_ID, state);
@@ -753,33 +1201,26 @@ void HierarchicalStateMachine::Impl::executeStateAction(const StateID_t state, c
                 break;
         }
 
-        for (auto it = itRange.first; it != itRange.second; ++it) {
-            const StateActionInfo& actionInfo = it->second;
-
-            if (StateAction::START_TIMER == actionInfo.action) {
-                dispatcherPtr->startTimer(mTimerHandlerId,
-                                          static_cast<TimerID_t>(actionInfo.actionArgs[0].toInt64()),
-                                          actionInfo.actionArgs[1].toInt64(),
-                                          actionInfo.actionArgs[2].toBool());
-            } else if (StateAction::STOP_TIMER == actionInfo.action) {
-                dispatcherPtr->stopTimer(static_cast<TimerID_t>(actionInfo.actionArgs[0].toInt64()));
-            } else if (StateAction::RESTART_TIMER == actionInfo.action) {
-                dispatcherPtr->restartTimer(static_cast<TimerID_t>(actionInfo.actionArgs[0].toInt64()));
-            } else if (StateAction::TRANSITION == actionInfo.action) {
-                VariantVector_t transitionArgs;
-
-                if (actionInfo.actionArgs.size() > 1U) {
-                    transitionArgs.reserve(actionInfo.actionArgs.size() - 1U);
-
-                    // copy arguments except for the first one
-                    for (size_t i = 1; i < actionInfo.actionArgs.size(); ++i) {
-                        transitionArgs.emplace_back(actionInfo.actionArgs[i]);
-                    }
-                }
-
-                transitionWithArgsArray(static_cast<EventID_t>(actionInfo.actionArgs[0].toInt64()), std::move(transitionArgs));
-            } else {
-                HSM_TRACE_WARNING("unsupported action <%d>", SC2INT(actionInfo.action));
+        for (const StateActionInfo& actionInfo : actions) {
+            switch (actionInfo.action) {
+                case StateAction::START_TIMER:
+                    dispatcherPtr->startTimer(mTimerHandlerId,
+                                              actionInfo.params.timer.timerID,
+                                              actionInfo.params.timer.intervalMs,
+                                              actionInfo.params.timer.isSingleShot);
+                    break;
+                case StateAction::STOP_TIMER:
+                    dispatcherPtr->stopTimer(mTimerHandlerId, actionInfo.params.timer.timerID);
+                    break;
+                case StateAction::RESTART_TIMER:
+                    dispatcherPtr->restartTimer(mTimerHandlerId, actionInfo.params.timer.timerID);
+                    break;
+                case StateAction::TRANSITION:
+                    transitionWithArgsArray(actionInfo.params.event, actionInfo.transitionArgs);
+                    break;
+                default:
+                    HSM_TRACE_WARNING("unsupported action <%d>", SC2INT(actionInfo.action));
+                    break;
             }
         }
     }
@@ -787,12 +1228,13 @@ void HierarchicalStateMachine::Impl::executeStateAction(const StateID_t state, c
 
 bool HierarchicalStateMachine::Impl::getParentState(const StateID_t child, StateID_t& outParent) {
     bool wasFound = false;
-    auto it = std::find_if(mSubstates.begin(), mSubstates.end(), [child](const std::pair<StateID_t, StateID_t>& item) {
+    const auto& substates = mDefinition->substates;
+    auto it = std::find_if(substates.begin(), substates.end(), [child](const std::pair<StateID_t, StateID_t>& item) {
         // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
         return (child == item.second);
     });
 
-    if (mSubstates.end() != it) {
+    if (substates.end() != it) {
         outParent = it->first;  // cppcheck-suppress misra-c2012-17.8 ; outParent is used to return result
         wasFound = true;
     }
@@ -801,13 +1243,14 @@ bool HierarchicalStateMachine::Impl::getParentState(const StateID_t child, State
 }
 bool HierarchicalStateMachine::Impl::isSubstateOf(const StateID_t parent, const StateID_t child) {
     HSM_TRACE_CALL_DEBUG_ARGS("parent=<%s>, child=<%s>", getStateName(parent).c_str(), getStateName(child).c_str());
+    const auto& substates = mDefinition->substates;
     StateID_t curState = child;
     bool stopSearch = false;
 
     while ((false == stopSearch) && (parent != curState)) {
         stopSearch = true;
 
-        for (auto itParent = mSubstates.begin(); itParent != mSubstates.end(); ++itParent) {
+        for (auto itParent = substates.begin(); itParent != substates.end(); ++itParent) {
             if (curState == itParent->second) {
                 // found next parent
                 curState = itParent->first;
@@ -815,7 +1258,7 @@ bool HierarchicalStateMachine::Impl::isSubstateOf(const StateID_t parent, const
 
                 if (parent != curState) {
                     // check left siblings
-                    for (auto itSibling = itParent; (itSibling != mSubstates.begin()) && (itSibling->first == itParent->first); --itSibling) {
+                    for (auto itSibling = itParent; (itSibling != substates.begin()) && (itSibling->first == itParent->first); --itSibling) {
                         if (itSibling->second == parent) {
                             stopSearch = true;
                             break;
@@ -823,7 +1266,7 @@ bool HierarchicalStateMachine::Impl::isSubstateOf(const StateID_t parent, const
                     }
 
                     // check right siblings
-                    for (auto itSibling = itParent; (itSibling != mSubstates.end()) && (itSibling->first == itParent->first); ++itSibling) {
+                    for (auto itSibling = itParent; (itSibling != substates.end()) && (itSibling->first == itParent->first); ++itSibling) {
                         if (itSibling->second == parent) {
                             stopSearch = true;
                             break;
@@ -840,7 +1283,7 @@ bool HierarchicalStateMachine::Impl::isSubstateOf(const StateID_t parent, const
 }
 
 bool HierarchicalStateMachine::Impl::isFinalState(const StateID_t state) const {
-    return (mFinalStates.end() != mFinalStates.find(state));
+    return mDefinition->hasStateFlag(state, STATE_FLAG_FINAL);
 }
 
 bool HierarchicalStateMachine::Impl::hasActiveChildren(const StateID_t parent, const bool includeFinal) {
@@ -865,14 +1308,15 @@ bool HierarchicalStateMachine::Impl::hasActiveChildren(const StateID_t parent, c
 
 bool HierarchicalStateMachine::Impl::getHistoryParent(const StateID_t historyState, StateID_t& outParent) {
     bool wasFound = false;
+    const auto& historyStates = mDefinition->historyStates;
     auto it =
-        std::find_if(mHistoryStates.begin(), mHistoryStates.end(), [historyState](const std::pair<StateID_t, StateID_t>& item) {
+        std::find_if(historyStates.begin(), historyStates.end(), [historyState](const std::pair<StateID_t, StateID_t>& item) {
             // NOTE: false-positive. "return" statement belongs to lambda function, not parent function
             // cppcheck-suppress misra-c2012-15.5
             return (historyState == item.second);
         });
 
-    if (mHistoryStates.end() != it) {
+    if (historyStates.end() != it) {
         outParent = it->first;  // cppcheck-suppress misra-c2012-17.8 ; outParent is used to return result
         wasFound = true;
     }
@@ -895,44 +1339,43 @@ void HierarchicalStateMachine::Impl::updateHistory(const StateID_t topLevelState
             HSM_TRACE_DEBUG("curState=<%s>, parentState=<%s>",
                             getStateName(curState).c_str(),
                             getStateName(parentState).c_str());
-            auto itRange = mHistoryStates.equal_range(parentState);
 
             // check if parent state has any history states
-            if (itRange.first != itRange.second) {
+            if (true == mDefinition->hasStateFlag(parentState, STATE_FLAG_HAS_HISTORY)) {
                 HSM_TRACE_DEBUG("parent=<%s> has history items", getStateName(parentState).c_str());
+                auto itRange = mDefinition->historyStates.equal_range(parentState);
 
                 for (auto it = itRange.first; it != itRange.second; ++it) {
-                    auto itCurHistory = mHistoryData.find(it->second);
+                    auto itCurHistory = mDefinition->historyData.find(it->second);
 
-                    if (itCurHistory != mHistoryData.end()) {
+                    if (itCurHistory != mDefinition->historyData.end()) {
+                        std::list<StateID_t>& previousActiveStates = mHistoryPreviousStates[it->second];
                         const auto itUpdatedHistory =
-                            std::find(upatedHistory.begin(), upatedHistory.end(), &itCurHistory->second.previousActiveStates);
+                            std::find(upatedHistory.begin(), upatedHistory.end(), &previousActiveStates);
 
                         // check if this is the first time we are updating this history state
                         if (itUpdatedHistory == upatedHistory.end()) {
                             // clear previos history items
-                            itCurHistory->second.previousActiveStates.clear();
+                            previousActiveStates.clear();
                             // we store pointer to be able to identify if this history state was already cleared or not
-                            upatedHistory.emplace_back(&(itCurHistory->second.previousActiveStates));
+                            upatedHistory.emplace_back(&previousActiveStates);
                         }
 
                         if (HistoryType::SHALLOW == itCurHistory->second.type) {
-                            if (std::find(itCurHistory->second.previousActiveStates.begin(),
-                                          itCurHistory->second.previousActiveStates.end(),
-                                          curState) == itCurHistory->second.previousActiveStates.end()) {
+                            if (std::find(previousActiveStates.begin(), previousActiveStates.end(), curState) ==
+                                previousActiveStates.end()) {
                                 HSM_TRACE_DEBUG("SHALLOW -> store state <%s> in history of parent <%s>",
                                                 getStateName(curState).c_str(),
                                                 getStateName(it->second).c_str());
-                                itCurHistory->second.previousActiveStates.emplace_back(curState);
+                                previousActiveStates.emplace_back(curState);
                             }
                         } else if (HistoryType::DEEP == itCurHistory->second.type) {
-                            if (std::find(itCurHistory->second.previousActiveStates.begin(),
-                                          itCurHistory->second.previousActiveStates.end(),
-                                          activeState) == itCurHistory->second.previousActiveStates.end()) {
+                            if (std::find(previousActiveStates.begin(), previousActiveStates.end(), activeState) ==
+                                previousActiveStates.end()) {
                                 HSM_TRACE_DEBUG("DEEP -> store state <%s> in history of parent <%s>",
                                                 getStateName(activeState).c_str(),
                                                 getStateName(it->second).c_str());
-                                itCurHistory->second.previousActiveStates.emplace_back(activeState);
+                                previousActiveStates.emplace_back(activeState);
                             }
                         } else {
                             // NOTE: do nothing
@@ -965,6 +1408,8 @@ bool HierarchicalStateMachine::Impl::checkTransitionPossibility(const StateID_t
         //       to make a copy of mPendingEvents and work with it
         HSM_SYNC_EVENTS_QUEUE();
 
+        collectIncomingEvents();
+
         for (auto it = mPendingEvents.begin(); (it != mPendingEvents.end()) && (true == possible); ++it) {
             nextEvent = it->id;
             possible = findTransitionTarget(currentState, nextEvent, args, true, possibleTransitions);
@@ -999,7 +1444,7 @@ bool HierarchicalStateMachine::Impl::findTransitionTarget(const StateID_t fromSt
     StateID_t curState = fromState;
 
     do {
-        const auto itRange = mTransitionsByEvent.equal_range(std::make_pair(curState, event));
+        const auto itRange = mDefinition->transitionsByEvent.equal_range(std::make_pair(curState, event));
 
         continueSearch = false;
 
@@ -1017,7 +1462,7 @@ bool HierarchicalStateMachine::Impl::findTransitionTarget(const StateID_t fromSt
             HSM_TRACE_DEBUG("check transition to <%s>...", getStateName(it->second.destinationState).c_str());
 
             if ((nullptr == it->second.checkCondition) ||
-                (it->second.expectedConditionValue == it->second.checkCondition(transitionArgs))) {
+                (it->second.expectedConditionValue == it->second.checkCondition(mUserContext, transitionArgs))) {
                 bool wasFound = false;
                 std::list<StateID_t> parentStates = {it->second.destinationState};
 
@@ -1098,6 +1543,11 @@ HsmEventStatus HierarchicalStateMachine::Impl::doTransition(const PendingEventIn
                         acceptedStates.emplace_back(*it);
                         break;
                     case HsmEventStatus::CANCELED:
+                        // report cancellation only if event wasn't accepted by other states
+                        if (HsmEventStatus::DONE_FAILED == res) {
+                            res = singleTransitionResult;
+                        }
+                        break;
                     case HsmEventStatus::DONE_FAILED:
                     default:
                         // do nothing
@@ -1139,7 +1589,7 @@ HsmEventStatus HierarchicalStateMachine::Impl::processExternalTransition(const P
 
     // cppcheck-suppress misra-c2012-14.4 : false-positive. std::shared_ptr has a bool() operator
     if (curTransition.onTransition) {
-        curTransition.onTransition(event.getArgs());
+        curTransition.onTransition(mUserContext, event.getArgs());
     }
 
     if (true == onStateEntering(curTransition.destinationState, event.getArgs())) {
@@ -1188,6 +1638,8 @@ HsmEventStatus HierarchicalStateMachine::Impl::processExternalTransition(const P
             (void)addActiveState(curState);
             onStateChanged(curState, VariantVector_t());
         }
+
+        res = HsmEventStatus::CANCELED;
     }
 
     return res;
@@ -1275,7 +1727,7 @@ bool HierarchicalStateMachine::Impl::executeSelfTransitions(const PendingEventIn
             // NOTE: false-positive. std::function has a bool() operator
             // cppcheck-suppress misra-c2012-14.4
             if (curTransition.onTransition) {
-                curTransition.onTransition(event.getArgs());
+                curTransition.onTransition(mUserContext, event.getArgs());
             }
 
             hadSelfTransitions = true;
@@ -1341,17 +1793,19 @@ bool HierarchicalStateMachine::Impl::executeExitTransition(const PendingEventInf
 
 bool HierarchicalStateMachine::Impl::processHistoryTransition(const PendingEventInfo& event, const StateID_t destinationState) {
     HSM_TRACE_CALL_DEBUG();
-    auto itHistoryData = mHistoryData.find(destinationState);
+    auto itHistoryData = mDefinition->historyData.find(destinationState);
 
     // check if we transitioned into a history state
-    if (itHistoryData != mHistoryData.end()) {
-        HSM_TRACE_DEBUG("state=<%s> is a history state with %ld stored states",
-                        getStateName(destinationState).c_str(),
-                        itHistoryData->second.previousActiveStates.size());
-
-        if (itHistoryData->second.previousActiveStates.empty() == false) {
-            transitionToPreviousActiveStates(itHistoryData->second.previousActiveStates, event, destinationState);
+    if (itHistoryData != mDefinition->historyData.end()) {
+        auto itPreviousStates = mHistoryPreviousStates.find(destinationState);
+
+        if ((itPreviousStates != mHistoryPreviousStates.end()) && (itPreviousStates->second.empty() == false)) {
+            HSM_TRACE_DEBUG("state=<%s> is a history state with %ld stored states",
+                            getStateName(destinationState).c_str(),
+                            itPreviousStates->second.size());
+            transitionToPreviousActiveStates(itPreviousStates->second, event, destinationState);
         } else {
+            HSM_TRACE_DEBUG("state=<%s> is a history state without stored states", getStateName(destinationState).c_str());
             transitionToDefaultHistoryState(itHistoryData->second.defaultTarget,
                                             itHistoryData->second.defaultTargetTransitionCallback,
                                             event,
@@ -1359,7 +1813,7 @@ bool HierarchicalStateMachine::Impl::processHistoryTransition(const PendingEvent
         }
     }
 
-    return (itHistoryData != mHistoryData.end());
+    return (itHistoryData != mDefinition->historyData.end());
 }
 
 void HierarchicalStateMachine::Impl::transitionToPreviousActiveStates(std::list<StateID_t>& previousActiveStates,
@@ -1417,7 +1871,7 @@ void HierarchicalStateMachine::Impl::transitionToPreviousActiveStates(std::list<
 
 void HierarchicalStateMachine::Impl::transitionToDefaultHistoryState(
     const StateID_t defaultTarget,
-    const HsmTransitionCallback_t& defaultTargetTransitionCallback,
+    const HsmContextTransitionCallback_t& defaultTargetTransitionCallback,
     const PendingEventInfo& event,
     const StateID_t destinationState) {
     HSM_TRACE_CALL_DEBUG();
@@ -1445,7 +1899,7 @@ void HierarchicalStateMachine::Impl::transitionToDefaultHistoryState(
     defHistoryTransitionEvent.transitionType = TransitionBehavior::FORCED;
 
     for (const StateID_t historyTargetState : historyTargets) {
-        HsmTransitionCallback_t cbTransition;
+        HsmContextTransitionCallback_t cbTransition;
 
         defHistoryTransitionEvent.forcedTransitionsInfo = std::make_shared<std::list<TransitionInfo>>();
 
@@ -1467,9 +1921,10 @@ void HierarchicalStateMachine::Impl::transitionToDefaultHistoryState(
 
 bool HierarchicalStateMachine::Impl::processFinalStateTransition(const PendingEventInfo& event,
                                                                  const StateID_t destinationState) {
-    const auto itFinalStateEvent = mFinalStates.find(destinationState);
+    const StateIndex_t stateIndex = mDefinition->getStateIndex(destinationState);
+    const bool isFinal = (0U != (mDefinition->getStateFlags(stateIndex) & STATE_FLAG_FINAL));
 
-    if (itFinalStateEvent != mFinalStates.end()) {
+    if (true == isFinal) {
         StateID_t parentState = INVALID_HSM_STATE_ID;
 
         // don't generate events for top level final states since no one can process them
@@ -1482,8 +1937,8 @@ bool HierarchicalStateMachine::Impl::processFinalStateTransition(const PendingEv
                 finalStateEvent.transitionType = TransitionBehavior::REGULAR;
                 finalStateEvent.args = event.args;
 
-                if (INVALID_HSM_EVENT_ID != itFinalStateEvent->second) {
-                    finalStateEvent.id = itFinalStateEvent->second;
+                if (INVALID_HSM_EVENT_ID != mDefinition->finalStateEvents[stateIndex]) {
+                    finalStateEvent.id = mDefinition->finalStateEvents[stateIndex];
                 } else {
                     finalStateEvent.id = event.id;
                 }
@@ -1496,7 +1951,7 @@ bool HierarchicalStateMachine::Impl::processFinalStateTransition(const PendingEv
         }
     }
 
-    return (itFinalStateEvent != mFinalStates.end());
+    return isFinal;
 }
 
 HsmEventStatus HierarchicalStateMachine::Impl::handleSingleTransition(const StateID_t fromState,
@@ -1552,32 +2007,83 @@ HsmEventStatus HierarchicalStateMachine::Impl::handleSingleTransition(const Stat
     return res;
 }
 
-void HierarchicalStateMachine::Impl::clearPendingEvents() {
-    HSM_TRACE_CALL_DEBUG_ARGS("clearPendingEvents: mPendingEvents.size()=%ld", mPendingEvents.size());
+void HierarchicalStateMachine::Impl::releasePendingEvents(std::list<PendingEventInfo>& events) {
+    HSM_TRACE_CALL_DEBUG_ARGS("releasePendingEvents: events.size()=%ld", events.size());
 
-    for (auto it = mPendingEvents.begin(); (it != mPendingEvents.end()); ++it) {
+    for (auto it = events.begin(); (it != events.end()); ++it) {
         // since ongoing transitions can't be canceled we need to treat entry point transitions as atomic
         if (TransitionBehavior::REGULAR == it->transitionType) {
             it->releaseLock();
         }
     }
 
-    mPendingEvents.clear();
+    events.clear();
+}
+
+void HierarchicalStateMachine::Impl::addPendingEvent(const PendingEventInfo& event, const bool clearQueue) {
+    std::list<PendingEventInfo> droppedEvents;
+
+#ifdef HSM_ENABLE_LOCKFREE_EVENTS_QUEUE
+    if (false == clearQueue) {
+        // NOTE: producers don't lock mEventsSync, so multiple threads can send events without blocking each other
+        mIncomingEvents.push(event);
+    } else {
+        HSM_SYNC_EVENTS_QUEUE();
+
+        collectIncomingEvents();
+        droppedEvents.swap(mPendingEvents);
+        mPendingEvents.emplace_back(event);
+    }
+#else
+    {
+        HSM_SYNC_EVENTS_QUEUE();
+
+        if (true == clearQueue) {
+            droppedEvents.swap(mPendingEvents);
+        }
+
+        mPendingEvents.emplace_back(event);
+    }
+#endif  // HSM_ENABLE_LOCKFREE_EVENTS_QUEUE
+
+    // NOTE: dropped events are released without holding mEventsSync because their completion callbacks are allowed to
+    //       send new events to HSM
+    releasePendingEvents(droppedEvents);
+}
+
+void HierarchicalStateMachine::Impl::collectIncomingEvents() {
+#ifdef HSM_ENABLE_LOCKFREE_EVENTS_QUEUE
+    PendingEventInfo event;
+
+    // NOTE: events added by dispatcher itself (entry points, history, etc.) are always placed in front of the queue,
+    //       so it's fine to append incoming events to the end
+    while (true == mIncomingEvents.pop(event)) {
+        mPendingEvents.emplace_back(std::move(event));
+    }
+#endif  // HSM_ENABLE_LOCKFREE_EVENTS_QUEUE
+}
+
+bool HierarchicalStateMachine::Impl::hasPendingEvents() {
+    HSM_SYNC_EVENTS_QUEUE();
+
+    collectIncomingEvents();
+
+    return (false == mPendingEvents.empty());
 }
 
 bool HierarchicalStateMachine::Impl::hasSubstates(const StateID_t parent) const {
-    return (mSubstates.find(parent) != mSubstates.end());
+    return (mDefinition->substates.find(parent) != mDefinition->substates.end());
 }
 
 bool HierarchicalStateMachine::Impl::hasEntryPoint(const StateID_t state) const {
-    return (mSubstateEntryPoints.find(state) != mSubstateEntryPoints.end());
+    return mDefinition->hasStateFlag(state, STATE_FLAG_HAS_ENTRY_POINTS);
 }
 
 bool HierarchicalStateMachine::Impl::getEntryPoints(const StateID_t state,
                                                     const EventID_t onEvent,
                                                     const VariantVector_t& transitionArgs,
                                                     std::list<StateID_t>& outEntryPoints) const {
-    auto itRange = mSubstateEntryPoints.equal_range(state);
+    auto itRange = mDefinition->substateEntryPoints.equal_range(state);
 
     outEntryPoints.clear();
 
@@ -1585,7 +2091,7 @@ bool HierarchicalStateMachine::Impl::getEntryPoints(const StateID_t state,
         if (((INVALID_HSM_EVENT_ID == it->second.onEvent) || (onEvent == it->second.onEvent)) &&
             // check transition condition if it was defined
             ((nullptr == it->second.checkCondition) ||
-             (it->second.checkCondition(transitionArgs) == it->second.expectedConditionValue))) {
+             (it->second.checkCondition(mUserContext, transitionArgs) == it->second.expectedConditionValue))) {
             outEntryPoints.emplace_back(it->second.state);
         }
     }
@@ -1619,15 +2125,15 @@ bool HierarchicalStateMachine::Impl::addActiveState(const StateID_t newState) {
 #ifdef HSM_ENABLE_SAFE_STRUCTURE
 
 bool HierarchicalStateMachine::Impl::isTopState(const StateID_t state) const {
-    auto it = std::find(mTopLevelStates.begin(), mTopLevelStates.end(), state);
+    auto it = std::find(mDefinition->topLevelStates.begin(), mDefinition->topLevelStates.end(), state);
 
-    return (it == mTopLevelStates.end());
+    return (it == mDefinition->topLevelStates.end());
 }
 
 bool HierarchicalStateMachine::Impl::isSubstate(const StateID_t state) const {
     bool result = false;
 
-    for (const auto& curSubstate : mSubstates) {
+    for (const auto& curSubstate : mDefinition->substates) {
         if (curSubstate.second == state) {
             result = true;
             break;
@@ -1640,7 +2146,7 @@ bool HierarchicalStateMachine::Impl::isSubstate(const StateID_t state) const {
 bool HierarchicalStateMachine::Impl::hasParentState(const StateID_t state, StateID_t& outParent) const {
     bool hasParent = false;
 
-    for (const auto& curSubstate : mSubstates) {
+    for (const auto& curSubstate : mDefinition->substates) {
         if (state == curSubstate.second) {
             hasParent = true;
             outParent = curSubstate.first;  // cppcheck-suppress misra-c2012-17.8 ; outParent is used to return result
@@ -1779,7 +2285,8 @@ void HierarchicalStateMachine::Impl::logHsmAction(const HsmLogAction action,
                     "  args:";
 
         for (const auto& curArg : args) {
-            *mHsmLog << "\n    - " << curArg.toString();
+            *mHsmLog << "\n    - ";
+            (void)curArg.format(*mHsmLog, HSM_LOG_MAX_ARGUMENT_LENGTH);
         }
 
         mHsmLog->flush();
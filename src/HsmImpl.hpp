@@ -4,6 +4,7 @@
 #ifndef HSMCPP_SRC_HSMIMPL_HPP
 #define HSMCPP_SRC_HSMIMPL_HPP
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <memory>
@@ -13,12 +14,21 @@
 #endif
 
 #include "hsmcpp/hsm.hpp"
+#include "hsmcpp/HsmMpscLinkedQueue.hpp"
+#include "hsmcpp/HsmSeqLock.hpp"
 #include "hsmcpp/os/Mutex.hpp"
 #include "hsmcpp/os/ConditionVariable.hpp"
 #include "hsmcpp/os/AtomicFlag.hpp"
 #include "hsmcpp/variant.hpp"
+#include "HsmDefinition.hpp"
 #include "HsmImplTypes.hpp"
 
+// NOTE: FreeRTOS and Arduino targets can lack lock-free atomic pointers, so they keep using HSM_SYNC_EVENTS_QUEUE()
+#if !defined(HSM_DISABLE_THREADSAFETY) && !defined(FREERTOS_AVAILABLE) && !defined(PLATFORM_ARDUINO)
+  // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+  #define HSM_ENABLE_LOCKFREE_EVENTS_QUEUE
+#endif
+
 namespace hsmcpp {
 
 class IHsmEventDispatcher;
@@ -26,10 +36,15 @@ class IHsmEventDispatcher;
 class HierarchicalStateMachine::Impl : public std::enable_shared_from_this<HierarchicalStateMachine::Impl> {
 public:
     explicit Impl(HierarchicalStateMachine* parent, const StateID_t initialState);
+    Impl(HierarchicalStateMachine* parent, const std::shared_ptr<const HsmDefinition>& definition);
     virtual ~Impl();
 
     void resetParent();
 
+    std::shared_ptr<const HsmDefinition> getDefinition() const;
+    void setUserContext(const HsmUserContext& context);
+    void* getUserContext() const;
+
     void setInitialState(const StateID_t initialState);
     bool initialize(const std::weak_ptr<IHsmEventDispatcher>& dispatcher);
     std::weak_ptr<IHsmEventDispatcher> dispatcher() const;
@@ -38,25 +53,25 @@ public:
     void release();
     void registerFailedTransitionCallback(HsmTransitionFailedCallback_t onFailedTransition);
     void registerState(const StateID_t state,
-                       HsmStateChangedCallback_t onStateChanged = nullptr,
-                       HsmStateEnterCallback_t onEntering = nullptr,
-                       HsmStateExitCallback_t onExiting = nullptr);
+                       HsmContextStateChangedCallback_t onStateChanged,
+                       HsmContextStateEnterCallback_t onEntering,
+                       HsmContextStateExitCallback_t onExiting);
     void registerFinalState(const StateID_t state,
-                            const EventID_t event = INVALID_HSM_EVENT_ID,
-                            HsmStateChangedCallback_t onStateChanged = nullptr,
-                            HsmStateEnterCallback_t onEntering = nullptr,
-                            HsmStateExitCallback_t onExiting = nullptr);
+                            const EventID_t event,
+                            HsmContextStateChangedCallback_t onStateChanged,
+                            HsmContextStateEnterCallback_t onEntering,
+                            HsmContextStateExitCallback_t onExiting);
     void registerHistory(const StateID_t parent,
                          const StateID_t historyState,
-                         const HistoryType type = HistoryType::SHALLOW,
-                         const StateID_t defaultTarget = INVALID_HSM_STATE_ID,
-                         HsmTransitionCallback_t transitionCallback = nullptr);
+                         const HistoryType type,
+                         const StateID_t defaultTarget,
+                         HsmContextTransitionCallback_t transitionCallback);
     bool registerSubstate(const StateID_t parent, const StateID_t substate);
     bool registerSubstateEntryPoint(const StateID_t parent,
                                     const StateID_t substate,
-                                    const EventID_t onEvent = INVALID_HSM_EVENT_ID,
-                                    HsmTransitionConditionCallback_t conditionCallback = nullptr,
-                                    const bool expectedConditionValue = true);
+                                    const EventID_t onEvent,
+                                    HsmContextTransitionConditionCallback_t conditionCallback,
+                                    const bool expectedConditionValue);
     void registerTimer(const TimerID_t timerID, const EventID_t event);
     bool registerStateAction(const StateID_t state,
                              const StateActionTrigger actionTrigger,
@@ -69,18 +84,20 @@ public:
     void registerTransition(const StateID_t from,
                             const StateID_t to,
                             const EventID_t onEvent,
-                            HsmTransitionCallback_t transitionCallback = nullptr,
-                            HsmTransitionConditionCallback_t conditionCallback = nullptr,
-                            const bool expectedConditionValue = true);
+                            HsmContextTransitionCallback_t transitionCallback,
+                            HsmContextTransitionConditionCallback_t conditionCallback,
+                            const bool expectedConditionValue);
     void registerSelfTransition(const StateID_t state,
                                 const EventID_t onEvent,
-                                const TransitionType type = TransitionType::EXTERNAL_TRANSITION,
-                                HsmTransitionCallback_t transitionCallback = nullptr,
-                                HsmTransitionConditionCallback_t conditionCallback = nullptr,
-                                const bool expectedConditionValue = true);
+                                const TransitionType type,
+                                HsmContextTransitionCallback_t transitionCallback,
+                                HsmContextTransitionConditionCallback_t conditionCallback,
+                                const bool expectedConditionValue);
     StateID_t getLastActiveState() const;
     const std::list<StateID_t>& getActiveStates() const;
     bool isStateActive(const StateID_t state) const;
+    void getActiveStatesSnapshot(ActiveStatesSnapshot& outSnapshot) const;
+    uint32_t getActiveStatesVersion() const;
 
     void transitionWithArgsArray(const EventID_t event, const VariantVector_t& args);
     void transitionWithArgsArray(const EventID_t event, VariantVector_t&& args);
@@ -89,12 +106,29 @@ public:
                                    const bool sync,
                                    const int timeoutMs,
                                    VariantVector_t&& args);
+    void transitionWithCallback(const EventID_t event,
+                                const bool clearQueue,
+                                HsmTransitionDoneCallback_t onDone,
+                                VariantVector_t&& args);
     bool transitionInterruptSafe(const EventID_t event);
     bool isTransitionPossible(const EventID_t event, const VariantVector_t& args);
-    void startTimer(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot);
+    // returns FALSE if one of the states is already active (outIsActive is TRUE) or HSM was released. onDone is not
+    // called in this case
+    bool addStateWaiter(const std::list<StateID_t>& states, StateWaiterCallback_t onDone, bool& outIsActive);
+    bool addStateWaiter(const std::list<StateID_t>& states,
+                        StateWaiterCallback_t onDone,
+                        bool& outIsActive,
+                        StateWaiterID_t& outWaiterID);
+    // returns FALSE if waiter was already notified
+    bool removeStateWaiter(const StateWaiterID_t waiterID);
+    bool waitForAnyState(const std::list<StateID_t>& states, const int timeoutMs);
+    void startTimer(const TimerID_t timerID, const uint64_t intervalUs, const unsigned int slackMs, const bool isSingleShot);
     void restartTimer(const TimerID_t timerID);
     void stopTimer(const TimerID_t timerID);
     bool isTimerRunning(const TimerID_t timerID);
+
+    HandlerID_t watchFd(const int fd, const FdEvents_t events, const EventID_t event);
+    void unwatchFd(const HandlerID_t watchID);
     bool enableHsmDebugging();
     bool enableHsmDebugging(const std::string& dumpPath);
     void disableHsmDebugging();
@@ -110,21 +144,35 @@ private:
 
     void transitionSimple(const EventID_t event);
 
+    // returns definition which is safe to modify (creates a copy if definition is shared with other instances)
+    HsmDefinition& modifyDefinition();
+
     bool registerSubstate(const StateID_t parent,
                           const StateID_t substate,
                           const bool isEntryPoint,
                           const EventID_t eventCondition = INVALID_HSM_EVENT_ID,
-                          HsmTransitionConditionCallback_t conditionCallback = nullptr,
+                          HsmContextTransitionConditionCallback_t conditionCallback = nullptr,
                           const bool expectedConditionValue = true);
 
     void dispatchEvents();
     void dispatchTimerEvent(const TimerID_t id);
+    void dispatchFdEvent(const int fd, const FdEvents_t events, const EventID_t event);
 
     bool onStateExiting(const StateID_t state);
     bool onStateEntering(const StateID_t state, const VariantVector_t& args);
     void onStateChanged(const StateID_t state, const VariantVector_t& args);
-
-    void executeStateAction(const StateID_t state, const StateActionTrigger actionTrigger);
+    // must be called after state was added to mActiveStates
+    void notifyStateWaiters(const StateID_t state);
+    // notifies waiters of states which are already active. must be called only by dispatching thread
+    void notifyActiveStateWaiters();
+    // checks states using mActiveStatesSnapshot. outIsKnown is FALSE if states were not found, but snapshot doesn't
+    // contain all active states
+    bool isAnyStatePublished(const std::list<StateID_t>& states, bool& outIsKnown) const;
+    void cancelStateWaiters();
+    // copies mActiveStates to mActiveStatesSnapshot. must be called only by dispatching thread
+    void publishActiveStates();
+
+    void executeStateAction(const StateIndex_t stateIndex, const StateActionTrigger actionTrigger);
 
     bool getParentState(const StateID_t child, StateID_t& outParent);
     bool isSubstateOf(const StateID_t parent, const StateID_t child);
@@ -157,12 +205,17 @@ private:
 
     bool processHistoryTransition(const PendingEventInfo& event, const StateID_t destinationState);
     void transitionToPreviousActiveStates(std::list<StateID_t>& previousActiveStates, const PendingEventInfo& event, const StateID_t destinationState);
-    void transitionToDefaultHistoryState(const StateID_t defaultTarget, const HsmTransitionCallback_t& defaultTargetTransitionCallback, const PendingEventInfo& event, const StateID_t destinationState);
+    void transitionToDefaultHistoryState(const StateID_t defaultTarget, const HsmContextTransitionCallback_t& defaultTargetTransitionCallback, const PendingEventInfo& event, const StateID_t destinationState);
 
 
     bool processFinalStateTransition(const PendingEventInfo& event, const StateID_t destinationState);
     HsmEventStatus handleSingleTransition(const StateID_t fromState, const PendingEventInfo& event);
-    void clearPendingEvents();
+    // notifies senders of the events that they will not be processed. Must be called without holding mEventsSync
+    void releasePendingEvents(std::list<PendingEventInfo>& events);
+    void addPendingEvent(const PendingEventInfo& event, const bool clearQueue);
+    // moves events added by producers to mPendingEvents. Must be called with mEventsSync locked
+    void collectIncomingEvents();
+    bool hasPendingEvents();
 
     bool hasSubstates(const StateID_t parent) const;
     bool hasEntryPoint(const StateID_t state) const;
@@ -207,30 +260,32 @@ private:
 
     HsmTransitionFailedCallback_t mFailedTransitionCallback;
 
-    StateID_t mInitialState;
+    // NOTE: definition is never modified while it's shared with other instances (see modifyDefinition())
+    std::shared_ptr<HsmDefinition> mDefinition;
+    HsmUserContext mUserContext = {nullptr, nullptr};
+
     std::list<StateID_t> mActiveStates;
-    std::multimap<std::pair<StateID_t, EventID_t>, TransitionInfo> mTransitionsByEvent;  // FROM_STATE, EVENT => TO
-    std::map<StateID_t, StateCallbacks> mRegisteredStates;
-    std::map<StateID_t, EventID_t> mFinalStates;
-    std::multimap<StateID_t, StateID_t> mSubstates;
-    std::multimap<StateID_t, StateEntryPoint> mSubstateEntryPoints;
+    // copy of mActiveStates for other threads. written only by dispatching thread
+    HsmSeqLockArray<StateID_t, HSM_ACTIVE_STATES_SNAPSHOT_CAPACITY> mActiveStatesSnapshot;
     std::list<PendingEventInfo> mPendingEvents;  // protected by mEventsSync
-    std::map<TimerID_t, EventID_t> mTimers;
-
-    // parent state, history state
-    std::multimap<StateID_t, StateID_t> mHistoryStates;
-    // history state id, data
-    std::map<StateID_t, HistoryInfo> mHistoryData;
-
-    std::multimap<std::pair<StateID_t, StateActionTrigger>, StateActionInfo> mRegisteredActions;
-
-#ifdef HSM_ENABLE_SAFE_STRUCTURE
-    std::list<StateID_t> mTopLevelStates;  // list of states which are not substates and dont have substates of their own
+#ifdef HSM_ENABLE_LOCKFREE_EVENTS_QUEUE
+    // events added by transition(). Producers don't lock mEventsSync. Consumer is the thread which holds mEventsSync
+    HsmMpscLinkedQueue<PendingEventInfo> mIncomingEvents;
 #endif
+    std::list<HandlerID_t> mFdWatches;           // protected by mEventsSync
+    std::list<StateWaiterInfo> mStateWaiters;    // protected by mStateWaitersSync
+    bool mStateWaitersCanceled = false;          // protected by mStateWaitersSync
+    StateWaiterID_t mLastStateWaiterID = 0;      // protected by mStateWaitersSync
+    // set if waiter was added while mActiveStatesSnapshot was incomplete. handled by dispatching thread
+    std::atomic<bool> mStateWaitersRecheck{false};
+
+    // history state id, states which were active when parent of the history state was exited
+    std::map<StateID_t, std::list<StateID_t>> mHistoryPreviousStates;
 
 #ifndef HSM_DISABLE_THREADSAFETY
     AtomicFlag mIsDispatching;
     Mutex mEventsSync;
+    Mutex mStateWaitersSync;
   #if !defined(HSM_DISABLE_DEBUG_TRACES)
     Mutex mParentSync;
   #endif
@@ -3,42 +3,20 @@
 
 #include "HsmImplTypes.hpp"
 
+#include <utility>
+
 #include "hsmcpp/logging.hpp"
 
 namespace hsmcpp {
 
-// ============================================================================
-// StateCallbacks
-// ============================================================================
-StateCallbacks::StateCallbacks(HsmStateChangedCallback_t&& cbStateChanged,
-                               HsmStateEnterCallback_t&& cbEntering,
-                               HsmStateExitCallback_t&& cbExiting)
-    : onStateChanged(std::move(cbStateChanged))
-    , onEntering(std::move(cbEntering))
-    , onExiting(std::move(cbExiting)) {}
-
-StateCallbacks::StateCallbacks(StateCallbacks&& src) noexcept {
-    *this = std::move(src);
-}
-
-StateCallbacks& StateCallbacks::operator=(StateCallbacks&& src) noexcept {
-    if (this != &src) {
-        onStateChanged = std::move(src.onStateChanged);
-        onEntering = std::move(src.onEntering);
-        onExiting = std::move(src.onExiting);
-    }
-
-    return *this;
-}
-
 // ============================================================================
 // TransitionInfo
 // ============================================================================
 TransitionInfo::TransitionInfo(const StateID_t from,
                                const StateID_t to,
                                const TransitionType type,
-                               HsmTransitionCallback_t cbTransition,
-                               HsmTransitionConditionCallback_t cbCondition)
+                               HsmContextTransitionCallback_t cbTransition,
+                               HsmContextTransitionConditionCallback_t cbCondition)
     : fromState(from)
     , destinationState(to)
     , transitionType(type)
@@ -48,8 +26,8 @@ TransitionInfo::TransitionInfo(const StateID_t from,
 TransitionInfo::TransitionInfo(const StateID_t from,
                                const StateID_t to,
                                const TransitionType type,
-                               HsmTransitionCallback_t cbTransition,
-                               HsmTransitionConditionCallback_t cbCondition,
+                               HsmContextTransitionCallback_t cbTransition,
+                               HsmContextTransitionConditionCallback_t cbCondition,
                                const bool conditionValue)
     : fromState(from)
     , destinationState(to)
@@ -63,7 +41,7 @@ TransitionInfo::TransitionInfo(const StateID_t from,
 // ============================================================================
 HistoryInfo::HistoryInfo(const HistoryType newType,
                          const StateID_t newDefaultTarget,
-                         HsmTransitionCallback_t newTransitionCallback)
+                         HsmContextTransitionCallback_t newTransitionCallback)
     : type(newType)
     , defaultTarget(newDefaultTarget)
     , defaultTargetTransitionCallback(std::move(newTransitionCallback)) {}
@@ -77,7 +55,6 @@ HistoryInfo& HistoryInfo::operator=(HistoryInfo&& src) noexcept {
         type = src.type;
         defaultTarget = src.defaultTarget;
         defaultTargetTransitionCallback = std::move(src.defaultTargetTransitionCallback);
-        previousActiveStates = std::move(src.previousActiveStates);
 
         src.type = HistoryType::SHALLOW;
         src.defaultTarget = INVALID_HSM_STATE_ID;
@@ -101,6 +78,11 @@ PendingEventInfo::~PendingEventInfo() {
         unlock(HsmEventStatus::DONE_FAILED);
         cvLock.reset();
         syncProcessed.reset();
+    } else if (true == onTransitionDone.unique()) {
+        HSM_TRACE_CALL_DEBUG_ARGS("event=<%d> was deleted. notifying about failure", SC2INT(id));
+        unlock(HsmEventStatus::DONE_FAILED);
+    } else {
+        // event is still referenced by its copies
     }
 }
 
@@ -112,6 +94,7 @@ PendingEventInfo& PendingEventInfo::operator=(PendingEventInfo&& src) noexcept {
         cvLock = std::move(src.cvLock);
         syncProcessed = std::move(src.syncProcessed);
         transitionStatus = std::move(src.transitionStatus);
+        onTransitionDone = std::move(src.onTransitionDone);
         forcedTransitionsInfo = std::move(src.forcedTransitionsInfo);
         ignoreEntryPoints = src.ignoreEntryPoints;
 
@@ -131,9 +114,10 @@ void PendingEventInfo::initLock() {
 }
 
 void PendingEventInfo::releaseLock() {
+    HSM_TRACE_CALL_DEBUG_ARGS("releaseLock");
+    unlock(HsmEventStatus::DONE_FAILED);
+
     if (true == isSync()) {
-        HSM_TRACE_CALL_DEBUG_ARGS("releaseLock");
-        unlock(HsmEventStatus::DONE_FAILED);
         cvLock.reset();
         syncProcessed.reset();
     }
@@ -178,6 +162,15 @@ void PendingEventInfo::unlock(const HsmEventStatus status) {
     } else {
         HSM_TRACE_DEBUG("ASYNC object");
     }
+
+    // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
+    if ((HsmEventStatus::PENDING != status) && onTransitionDone && (*onTransitionDone)) {
+        HsmTransitionDoneCallback_t callback;
+
+        // NOTE: callback is reset before it's called to make sure it's called only once for all copies of the event
+        std::swap(callback, *onTransitionDone);
+        callback(status);
+    }
 }
 
 const VariantVector_t& PendingEventInfo::getArgs() const {
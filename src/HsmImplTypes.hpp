@@ -26,31 +26,12 @@ enum class HsmLogAction {
     ON_EXIT_ACTIONS,
 };
 
-enum class HsmEventStatus { PENDING, DONE_OK, DONE_FAILED, CANCELED };
-
 enum class TransitionBehavior { REGULAR, ENTRYPOINT, FORCED };
 
-struct StateCallbacks {
-    HsmStateChangedCallback_t onStateChanged = nullptr;
-    HsmStateEnterCallback_t onEntering = nullptr;
-    HsmStateExitCallback_t onExiting = nullptr;
-
-    StateCallbacks() = default;
-    ~StateCallbacks() = default;
-    StateCallbacks(HsmStateChangedCallback_t&& cbStateChanged,
-                   HsmStateEnterCallback_t&& cbEntering,
-                   HsmStateExitCallback_t&& cbExiting);
-
-    StateCallbacks(const StateCallbacks& src) = default;
-    StateCallbacks(StateCallbacks&& src) noexcept;
-    StateCallbacks& operator=(const StateCallbacks& src) = default;
-    StateCallbacks& operator=(StateCallbacks&& src) noexcept;
-};
-
 struct StateEntryPoint {
     StateID_t state = INVALID_HSM_STATE_ID;
     EventID_t onEvent = INVALID_HSM_EVENT_ID;
-    HsmTransitionConditionCallback_t checkCondition = nullptr;
+    HsmContextTransitionConditionCallback_t checkCondition = nullptr;
     bool expectedConditionValue = true;
 };
 
@@ -58,8 +39,8 @@ struct TransitionInfo {
     StateID_t fromState = INVALID_HSM_STATE_ID;
     StateID_t destinationState = INVALID_HSM_STATE_ID;
     TransitionType transitionType = TransitionType::EXTERNAL_TRANSITION;
-    HsmTransitionCallback_t onTransition = nullptr;
-    HsmTransitionConditionCallback_t checkCondition = nullptr;
+    HsmContextTransitionCallback_t onTransition = nullptr;
+    HsmContextTransitionConditionCallback_t checkCondition = nullptr;
     bool expectedConditionValue = true;
 
     TransitionInfo() = default;
@@ -67,14 +48,14 @@ struct TransitionInfo {
     TransitionInfo(const StateID_t from,
                    const StateID_t to,
                    const TransitionType type,
-                   HsmTransitionCallback_t cbTransition,
-                   HsmTransitionConditionCallback_t cbCondition);
+                   HsmContextTransitionCallback_t cbTransition,
+                   HsmContextTransitionConditionCallback_t cbCondition);
 
     TransitionInfo(const StateID_t from,
                    const StateID_t to,
                    const TransitionType type,
-                   HsmTransitionCallback_t cbTransition,
-                   HsmTransitionConditionCallback_t cbCondition,
+                   HsmContextTransitionCallback_t cbTransition,
+                   HsmContextTransitionConditionCallback_t cbCondition,
                    const bool conditionValue);
 };
 
@@ -85,6 +66,8 @@ struct PendingEventInfo {
     std::shared_ptr<Mutex> cvLock;
     std::shared_ptr<ConditionVariable> syncProcessed;
     std::shared_ptr<HsmEventStatus> transitionStatus;
+    // shared between copies of the event (entry points, history). Reset after it was called
+    std::shared_ptr<HsmTransitionDoneCallback_t> onTransitionDone;
     std::shared_ptr<std::list<TransitionInfo>> forcedTransitionsInfo;
     bool ignoreEntryPoints = false;
 
@@ -104,15 +87,34 @@ struct PendingEventInfo {
     const VariantVector_t& getArgs() const;
 };
 
+using StateWaiterCallback_t = std::function<void(const bool)>;
+using StateWaiterID_t = uint32_t;
+
+struct StateWaiterInfo {
+    StateWaiterID_t id;
+    std::list<StateID_t> states;
+    // called with TRUE when one of the states was activated or with FALSE if HSM was released
+    StateWaiterCallback_t onDone;
+};
+
+// state of a thread blocked in HierarchicalStateMachine::waitForAnyState()
+struct StateWaitInfo {
+    Mutex sync;
+    ConditionVariable activated;
+    bool isDone = false;    // protected by sync
+    bool isActive = false;  // protected by sync
+};
+
 struct HistoryInfo {
     HistoryType type = HistoryType::SHALLOW;
     StateID_t defaultTarget = INVALID_HSM_STATE_ID;
-    HsmTransitionCallback_t defaultTargetTransitionCallback = nullptr;
-    std::list<StateID_t> previousActiveStates;
+    HsmContextTransitionCallback_t defaultTargetTransitionCallback = nullptr;
 
     HistoryInfo() = default;
     ~HistoryInfo() = default;
-    HistoryInfo(const HistoryType newType, const StateID_t newDefaultTarget, HsmTransitionCallback_t newTransitionCallback);
+    HistoryInfo(const HistoryType newType,
+                const StateID_t newDefaultTarget,
+                HsmContextTransitionCallback_t newTransitionCallback);
 
     HistoryInfo(const HistoryInfo& src) = default;
     HistoryInfo(HistoryInfo&& src) noexcept;
@@ -121,9 +123,23 @@ struct HistoryInfo {
 
 };
 
+struct TimerActionParams {
+    TimerID_t timerID;
+    unsigned int intervalMs;
+    bool isSingleShot;
+};
+
+// cppcheck-suppress misra-c2012-19.2 ; union is used to keep decoded action compact. Active member is defined by action
+union StateActionParams {
+    TimerActionParams timer;  // START_TIMER, STOP_TIMER, RESTART_TIMER
+    EventID_t event;          // TRANSITION
+};
+
+// Action arguments are validated and decoded once during registration
 struct StateActionInfo {
-    StateAction action;
-    VariantVector_t actionArgs;
+    StateAction action = StateAction::TRANSITION;
+    StateActionParams params = {};
+    VariantVector_t transitionArgs;  // TRANSITION only
 };
 }  // namespace hsmcpp
 
@@ -0,0 +1,225 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include "hsmcpp/HsmTimerQueue.hpp"
+
+#include <utility>
+
+namespace hsmcpp {
+
+void HsmTimerQueue::schedule(const TimerID_t timerID, const TimePoint_t& deadline) {
+    auto it = mPositions.find(timerID);
+
+    if (mPositions.end() != it) {
+        const size_t index = it->second;
+
+        mHeap[index].deadline = deadline;
+        mHeap[index].postponedDeadline = deadline;
+        mHeap[index].sequence = mNextSequence;
+        siftDown(siftUp(index));
+    } else {
+        Entry newEntry;
+
+        newEntry.deadline = deadline;
+        newEntry.postponedDeadline = deadline;
+        newEntry.sequence = mNextSequence;
+        newEntry.timerID = timerID;
+
+        mHeap.emplace_back(newEntry);
+        mPositions[timerID] = mHeap.size() - 1U;
+        (void)siftUp(mHeap.size() - 1U);
+    }
+
+    ++mNextSequence;
+}
+
+bool HsmTimerQueue::remove(const TimerID_t timerID) {
+    auto it = mPositions.find(timerID);
+    bool wasRemoved = false;
+
+    if (mPositions.end() != it) {
+        removeAt(it->second);
+        wasRemoved = true;
+    }
+
+    return wasRemoved;
+}
+
+bool HsmTimerQueue::contains(const TimerID_t timerID) const {
+    return (mPositions.end() != mPositions.find(timerID));
+}
+
+TimerID_t HsmTimerQueue::top() const {
+    return ((false == mHeap.empty()) ? mHeap.front().timerID : INVALID_HSM_TIMER_ID);
+}
+
+HsmTimerQueue::TimePoint_t HsmTimerQueue::topDeadline() const {
+    return ((false == mHeap.empty()) ? mHeap.front().deadline : TimePoint_t::max());
+}
+
+void HsmTimerQueue::pop() {
+    if (false == mHeap.empty()) {
+        removeAt(0U);
+    }
+}
+
+bool HsmTimerQueue::postpone(const TimerID_t timerID, const TimePoint_t& newDeadline) {
+    auto it = mPositions.find(timerID);
+    bool wasPostponed = false;
+
+    if ((mPositions.end() != it) && (newDeadline >= mHeap[it->second].deadline)) {
+        mHeap[it->second].postponedDeadline = newDeadline;
+        wasPostponed = true;
+    }
+
+    return wasPostponed;
+}
+
+bool HsmTimerQueue::popExpired(const TimePoint_t& now, Expiration_t& expiration) {
+    bool hasExpired = false;
+
+    while ((false == hasExpired) && (false == mHeap.empty()) && (mHeap.front().deadline <= now)) {
+        Entry& topEntry = mHeap.front();
+
+        if (topEntry.postponedDeadline > topEntry.deadline) {
+            // timer was postponed after it was scheduled. apply the new deadline instead of reporting expiration
+            topEntry.deadline = topEntry.postponedDeadline;
+            topEntry.sequence = mNextSequence;
+            ++mNextSequence;
+            siftDown(0U);
+        } else {
+            expiration = Expiration_t(topEntry.timerID, topEntry.deadline);
+            removeAt(0U);
+            hasExpired = true;
+        }
+    }
+
+    return hasExpired;
+}
+
+void HsmTimerQueue::clear() {
+    mHeap.clear();
+    mPositions.clear();
+}
+
+bool HsmTimerQueue::empty() const {
+    return mHeap.empty();
+}
+
+size_t HsmTimerQueue::size() const {
+    return mHeap.size();
+}
+
+bool HsmTimerQueue::isEarlier(const size_t left, const size_t right) const {
+    return (mHeap[left].deadline < mHeap[right].deadline) ||
+           ((mHeap[left].deadline == mHeap[right].deadline) && (mHeap[left].sequence < mHeap[right].sequence));
+}
+
+void HsmTimerQueue::swapEntries(const size_t left, const size_t right) {
+    std::swap(mHeap[left], mHeap[right]);
+    mPositions[mHeap[left].timerID] = left;
+    mPositions[mHeap[right].timerID] = right;
+}
+
+void HsmTimerQueue::removeAt(const size_t index) {
+    const size_t lastIndex = mHeap.size() - 1U;
+
+    (void)mPositions.erase(mHeap[index].timerID);
+
+    if (index != lastIndex) {
+        mHeap[index] = mHeap[lastIndex];
+        mPositions[mHeap[index].timerID] = index;
+        mHeap.pop_back();
+        siftDown(siftUp(index));
+    } else {
+        mHeap.pop_back();
+    }
+}
+
+size_t HsmTimerQueue::siftUp(size_t index) {
+    while (index > 0U) {
+        const size_t parent = (index - 1U) / 2U;
+
+        if (true == isEarlier(index, parent)) {
+            swapEntries(index, parent);
+            index = parent;
+        } else {
+            break;
+        }
+    }
+
+    return index;
+}
+
+void HsmTimerQueue::siftDown(size_t index) {
+    const size_t count = mHeap.size();
+
+    while (true) {
+        const size_t left = (2U * index) + 1U;
+        const size_t right = left + 1U;
+        size_t smallest = index;
+
+        if ((left < count) && (true == isEarlier(left, smallest))) {
+            smallest = left;
+        }
+
+        if ((right < count) && (true == isEarlier(right, smallest))) {
+            smallest = right;
+        }
+
+        if (smallest != index) {
+            swapEntries(index, smallest);
+            index = smallest;
+        } else {
+            break;
+        }
+    }
+}
+
+HsmTimerQueue::TimePoint_t HsmTimerQueue::alignDeadline(const TimePoint_t& deadline, const unsigned int slackMs) {
+    TimePoint_t alignedDeadline = deadline;
+
+    if (slackMs > 0u) {
+        unsigned int stepMs = 1u;
+
+        while (stepMs <= (slackMs / 2u)) {
+            stepMs *= 2u;
+        }
+
+        const auto step = std::chrono::duration_cast<TimePoint_t::duration>(std::chrono::milliseconds(stepMs));
+        const auto sinceEpoch = deadline.time_since_epoch();
+        // round up to the next grid point
+        const auto periods = (sinceEpoch + step - TimePoint_t::duration(1)) / step;
+
+        alignedDeadline = TimePoint_t(periods * step);
+    }
+
+    return alignedDeadline;
+}
+
+HsmTimerQueue::TimePoint_t HsmTimerQueue::getNextDeadline(const TimePoint_t& deadline,
+                                                          const uint64_t periodUs,
+                                                          const TimePoint_t& now,
+                                                          const MissedTicksPolicy policy) {
+    const auto period = std::chrono::duration_cast<TimePoint_t::duration>(std::chrono::microseconds(periodUs));
+    TimePoint_t nextDeadline = deadline + period;
+
+    if ((nextDeadline <= now) && (period.count() > 0)) {
+        switch (policy) {
+            case MissedTicksPolicy::FIRE_ONCE:
+                nextDeadline = now + period;
+                break;
+            case MissedTicksPolicy::SKIP:
+                nextDeadline += ((now - nextDeadline) / period + 1) * period;
+                break;
+            case MissedTicksPolicy::FIRE_ALL:
+            default:
+                // keep deadline in the past. timer will expire again as soon as possible
+                break;
+        }
+    }
+
+    return nextDeadline;
+}
+
+}  // namespace hsmcpp
@@ -0,0 +1,268 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include "hsmcpp/HsmTimerService.hpp"
+
+#include <limits>
+
+#include "hsmcpp/logging.hpp"
+#include "hsmcpp/os/LockGuard.hpp"
+#include "hsmcpp/os/UniqueLock.hpp"
+
+namespace hsmcpp {
+
+#undef HSM_TRACE_CLASS
+#define HSM_TRACE_CLASS "HsmTimerService"
+
+std::shared_ptr<HsmTimerService> HsmTimerService::getInstance() {
+    static Mutex sInstanceSync;
+    // NOTE: only weak reference is kept to destroy service (and stop its thread) when it's not used anymore. This also
+    //       avoids issues with destruction order of static objects
+    static std::weak_ptr<HsmTimerService> sInstance;
+    LockGuard lck(sInstanceSync);
+    std::shared_ptr<HsmTimerService> instance = sInstance.lock();
+
+    if (nullptr == instance) {
+        instance = create();
+        sInstance = instance;
+    }
+
+    return instance;
+}
+
+std::shared_ptr<HsmTimerService> HsmTimerService::create() {
+    return std::shared_ptr<HsmTimerService>(new HsmTimerService());
+}
+
+HsmTimerService::~HsmTimerService() {
+    HSM_TRACE_CALL_DEBUG();
+
+    {
+        LockGuard lck(mSync);
+        mStopService = true;
+    }
+
+    notifyServiceThread();
+
+    if (true == mServiceThread.joinable()) {
+        mServiceThread.join();
+    }
+}
+
+HandlerID_t HsmTimerService::registerClient(const ExpiredTimerHandlerFunc_t& handler) {
+    HSM_TRACE_CALL_DEBUG();
+    LockGuard lck(mSync);
+    const HandlerID_t id = mNextClientID;
+
+    ++mNextClientID;
+    mClients[id] = handler;
+
+    return id;
+}
+
+void HsmTimerService::unregisterClient(const HandlerID_t clientID) {
+    HSM_TRACE_CALL_DEBUG_ARGS("clientID=%d", clientID);
+    // wait for handlers which are currently being executed
+    LockGuard lckHandlers(mHandlersSync);
+    LockGuard lck(mSync);
+
+    if (mClients.erase(clientID) > 0u) {
+        for (auto it = mClientTimers.begin(); it != mClientTimers.end();) {
+            if (clientID == it->second.first) {
+                (void)mRunningTimers.remove(it->first);
+                (void)mServiceTimerIDs.erase(packKey(it->second.first, it->second.second));
+                it = mClientTimers.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void HsmTimerService::schedule(const HandlerID_t clientID, const TimerID_t timerID, const TimePoint_t& deadline) {
+    HSM_TRACE_CALL_DEBUG_ARGS("clientID=%d, timerID=%d", clientID, SC2INT(timerID));
+    bool wakeupServiceThread = false;
+
+    {
+        LockGuard lck(mSync);
+
+        if ((false == mStopService) && (mClients.end() != mClients.find(clientID))) {
+            const uint64_t key = packKey(clientID, timerID);
+            auto it = mServiceTimerIDs.find(key);
+            TimerID_t serviceTimerID = INVALID_HSM_TIMER_ID;
+
+            if (mServiceTimerIDs.end() != it) {
+                serviceTimerID = it->second;
+            } else {
+                serviceTimerID = allocateTimerID();
+                mServiceTimerIDs[key] = serviceTimerID;
+                mClientTimers[serviceTimerID] = TimerKey_t(clientID, timerID);
+            }
+
+            mRunningTimers.schedule(serviceTimerID, deadline);
+
+            // lazy initialization of service thread
+            if (false == mServiceThread.joinable()) {
+                mServiceThread = std::thread(&HsmTimerService::handleTimers, this);
+            }
+
+            // service thread needs to be woken up only if it's sleeping longer than the new timer
+            if (deadline < mServiceThreadDeadline) {
+                mServiceThreadDeadline = deadline;
+                mNotifiedServiceThread = true;
+                wakeupServiceThread = true;
+            }
+        }
+    }
+
+    if (true == wakeupServiceThread) {
+        mTimerEvent.notify();
+    }
+}
+
+bool HsmTimerService::cancel(const HandlerID_t clientID, const TimerID_t timerID) {
+    HSM_TRACE_CALL_DEBUG_ARGS("clientID=%d, timerID=%d", clientID, SC2INT(timerID));
+    LockGuard lck(mSync);
+    auto it = mServiceTimerIDs.find(packKey(clientID, timerID));
+    bool wasScheduled = false;
+
+    // NOTE: there is no need to wakeup service thread. If it was waiting for this timer it will recalculate the next
+    //       deadline after waking up
+    if (mServiceTimerIDs.end() != it) {
+        removeTimer(it->second);
+        wasScheduled = true;
+    }
+
+    return wasScheduled;
+}
+
+bool HsmTimerService::isScheduled(const HandlerID_t clientID, const TimerID_t timerID) {
+    LockGuard lck(mSync);
+
+    return (mServiceTimerIDs.end() != mServiceTimerIDs.find(packKey(clientID, timerID)));
+}
+
+size_t HsmTimerService::getTimersCount() {
+    LockGuard lck(mSync);
+
+    return mRunningTimers.size();
+}
+
+uint64_t HsmTimerService::packKey(const HandlerID_t clientID, const TimerID_t timerID) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(clientID)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(timerID));
+}
+
+TimerID_t HsmTimerService::allocateTimerID() {
+    TimerID_t id = INVALID_HSM_TIMER_ID;
+
+    // NOTE: after overflow IDs of expired and canceled timers are reused
+    do {
+        id = mNextTimerID;
+        mNextTimerID = ((std::numeric_limits<TimerID_t>::max() == id) ? 1 : (id + 1));
+    } while (mClientTimers.end() != mClientTimers.find(id));
+
+    return id;
+}
+
+void HsmTimerService::removeTimer(const TimerID_t serviceTimerID) {
+    auto it = mClientTimers.find(serviceTimerID);
+
+    if (mClientTimers.end() != it) {
+        (void)mRunningTimers.remove(serviceTimerID);
+        (void)mServiceTimerIDs.erase(packKey(it->second.first, it->second.second));
+        (void)mClientTimers.erase(it);
+    }
+}
+
+void HsmTimerService::notifyServiceThread() {
+    {
+        LockGuard lck(mSync);
+        mNotifiedServiceThread = true;
+    }
+
+    mTimerEvent.notify();
+}
+
+void HsmTimerService::handleTimers() {
+    HSM_TRACE_CALL_DEBUG();
+    bool stopService = false;
+
+    while (false == stopService) {
+        UniqueLock lck(mSync);
+
+        // all notifications received before this point are already reflected in mRunningTimers
+        mNotifiedServiceThread = false;
+        mServiceThreadDeadline = mRunningTimers.topDeadline();
+
+        if (false == mStopService) {
+            if (true == mRunningTimers.empty()) {
+                // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+                mTimerEvent.wait(lck, [&]() { return mNotifiedServiceThread; });
+            } else {
+                // if deadline is in the past it means that timer already expired and we only need to notify client
+                if (mServiceThreadDeadline > std::chrono::steady_clock::now()) {
+                    // cppcheck-suppress misra-c2012-15.5 ; false-positive. "return" statement belongs to lambda function
+                    (void)mTimerEvent.wait_until(lck, mServiceThreadDeadline, [&]() { return mNotifiedServiceThread; });
+                } else {
+                    lck.unlock();
+                }
+            }
+        } else {
+            lck.unlock();
+        }
+
+        // NOTE: ConditionVariable always releases the lock on exit
+        {
+            LockGuard lckStop(mSync);
+            stopService = mStopService;
+        }
+
+        if (false == stopService) {
+            processExpiredTimers();
+        }
+    }
+
+    HSM_TRACE_DEBUG("EXIT");
+}
+
+void HsmTimerService::processExpiredTimers() {
+    const auto wakeupTime = std::chrono::steady_clock::now();
+    // NOTE: prevents clients from being unregistered while their handlers are called
+    LockGuard lckHandlers(mHandlersSync);
+
+    {
+        LockGuard lck(mSync);
+
+        while ((false == mRunningTimers.empty()) && (mRunningTimers.topDeadline() <= wakeupTime)) {
+            const TimerID_t serviceTimerID = mRunningTimers.top();
+            auto it = mClientTimers.find(serviceTimerID);
+
+            // expired timer is not scheduled anymore. Client can schedule it again from the handler
+            mExpiredTimers.emplace_back(it->second, mRunningTimers.topDeadline());
+            removeTimer(serviceTimerID);
+        }
+    }
+
+    for (const ExpiredTimer_t& expiredTimer : mExpiredTimers) {
+        ExpiredTimerHandlerFunc_t* handler = nullptr;
+
+        {
+            // NOTE: pointer stays valid after mSync is released because clients can't be removed while
+            //       mHandlersSync is locked
+            LockGuard lck(mSync);
+            auto itClient = mClients.find(expiredTimer.first.first);
+
+            if (mClients.end() != itClient) {
+                handler = &itClient->second;
+            }
+        }
+
+        if (nullptr != handler) {
+            (*handler)(expiredTimer.first.second, expiredTimer.second);
+        }
+    }
+
+    mExpiredTimers.clear();
+}
+
+}  // namespace hsmcpp
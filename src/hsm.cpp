@@ -10,6 +10,9 @@ namespace hsmcpp {
 HierarchicalStateMachine::HierarchicalStateMachine(const StateID_t initialState)
     : mImpl(new HierarchicalStateMachine::Impl(this, initialState)) {}
 
+HierarchicalStateMachine::HierarchicalStateMachine(const std::shared_ptr<const HsmDefinition>& definition)
+    : mImpl(new HierarchicalStateMachine::Impl(this, definition)) {}
+
 HierarchicalStateMachine::~HierarchicalStateMachine() {
     mImpl->release();
     mImpl->resetParent();
@@ -19,6 +22,18 @@ void HierarchicalStateMachine::setInitialState(const StateID_t initialState) {
     mImpl->setInitialState(initialState);
 }
 
+std::shared_ptr<const HsmDefinition> HierarchicalStateMachine::getDefinition() const {
+    return mImpl->getDefinition();
+}
+
+void HierarchicalStateMachine::setUserContext(std::nullptr_t) {
+    mImpl->setUserContext(HsmUserContext{nullptr, nullptr});
+}
+
+void* HierarchicalStateMachine::getUserContext() const {
+    return mImpl->getUserContext();
+}
+
 bool HierarchicalStateMachine::initialize(const std::weak_ptr<IHsmEventDispatcher>& dispatcher) {
     return mImpl->initialize(dispatcher);
 }
@@ -71,7 +86,11 @@ bool HierarchicalStateMachine::registerSubstateEntryPoint(const StateID_t parent
                                                           const EventID_t onEvent,
                                                           HsmTransitionConditionCallback_t conditionCallback,
                                                           const bool expectedConditionValue) {
-    return mImpl->registerSubstateEntryPoint(parent, substate, onEvent, std::move(conditionCallback), expectedConditionValue);
+    return mImpl->registerSubstateEntryPoint(parent,
+                                             substate,
+                                             onEvent,
+                                             std::move(conditionCallback),
+                                             expectedConditionValue);
 }
 
 void HierarchicalStateMachine::registerTimer(const TimerID_t timerID, const EventID_t event) {
@@ -106,6 +125,69 @@ void HierarchicalStateMachine::registerSelfTransition(const StateID_t state,
                                   expectedConditionValue);
 }
 
+void HierarchicalStateMachine::registerStateImpl(const StateID_t state,
+                                                 HsmContextStateChangedCallback_t onStateChanged,
+                                                 HsmContextStateEnterCallback_t onEntering,
+                                                 HsmContextStateExitCallback_t onExiting) {
+    mImpl->registerState(state, std::move(onStateChanged), std::move(onEntering), std::move(onExiting));
+}
+
+void HierarchicalStateMachine::registerFinalStateImpl(const StateID_t state,
+                                                      const EventID_t event,
+                                                      HsmContextStateChangedCallback_t onStateChanged,
+                                                      HsmContextStateEnterCallback_t onEntering,
+                                                      HsmContextStateExitCallback_t onExiting) {
+    mImpl->registerFinalState(state, event, std::move(onStateChanged), std::move(onEntering), std::move(onExiting));
+}
+
+void HierarchicalStateMachine::registerHistoryImpl(const StateID_t parent,
+                                                   const StateID_t historyState,
+                                                   const HistoryType type,
+                                                   const StateID_t defaultTarget,
+                                                   HsmContextTransitionCallback_t transitionCallback) {
+    mImpl->registerHistory(parent, historyState, type, defaultTarget, std::move(transitionCallback));
+}
+
+bool HierarchicalStateMachine::registerSubstateEntryPointImpl(const StateID_t parent,
+                                                              const StateID_t substate,
+                                                              const EventID_t onEvent,
+                                                              HsmContextTransitionConditionCallback_t conditionCallback,
+                                                              const bool expectedConditionValue) {
+    return mImpl->registerSubstateEntryPoint(parent, substate, onEvent, std::move(conditionCallback), expectedConditionValue);
+}
+
+void HierarchicalStateMachine::registerTransitionImpl(const StateID_t fromState,
+                                                      const StateID_t toState,
+                                                      const EventID_t onEvent,
+                                                      HsmContextTransitionCallback_t transitionCallback,
+                                                      HsmContextTransitionConditionCallback_t conditionCallback,
+                                                      const bool expectedConditionValue) {
+    mImpl->registerTransition(fromState,
+                              toState,
+                              onEvent,
+                              std::move(transitionCallback),
+                              std::move(conditionCallback),
+                              expectedConditionValue);
+}
+
+void HierarchicalStateMachine::registerSelfTransitionImpl(const StateID_t state,
+                                                          const EventID_t onEvent,
+                                                          const TransitionType type,
+                                                          HsmContextTransitionCallback_t transitionCallback,
+                                                          HsmContextTransitionConditionCallback_t conditionCallback,
+                                                          const bool expectedConditionValue) {
+    mImpl->registerSelfTransition(state,
+                                  onEvent,
+                                  type,
+                                  std::move(transitionCallback),
+                                  std::move(conditionCallback),
+                                  expectedConditionValue);
+}
+
+void HierarchicalStateMachine::setUserContextImpl(const HsmUserContext& context) {
+    mImpl->setUserContext(context);
+}
+
 StateID_t HierarchicalStateMachine::getLastActiveState() const {
     return mImpl->getLastActiveState();
 }
@@ -114,10 +196,26 @@ const std::list<StateID_t>& HierarchicalStateMachine::getActiveStates() const {
     return mImpl->getActiveStates();
 }
 
+void HierarchicalStateMachine::getActiveStatesSnapshot(ActiveStatesSnapshot& outSnapshot) const {
+    mImpl->getActiveStatesSnapshot(outSnapshot);
+}
+
+uint32_t HierarchicalStateMachine::getActiveStatesVersion() const {
+    return mImpl->getActiveStatesVersion();
+}
+
 bool HierarchicalStateMachine::isStateActive(const StateID_t state) const {
     return mImpl->isStateActive(state);
 }
 
+bool HierarchicalStateMachine::waitForState(const StateID_t state, const int timeoutMs) {
+    return mImpl->waitForAnyState({state}, timeoutMs);
+}
+
+bool HierarchicalStateMachine::waitForAnyState(const std::list<StateID_t>& states, const int timeoutMs) {
+    return mImpl->waitForAnyState(states, timeoutMs);
+}
+
 void HierarchicalStateMachine::transitionWithArgsArray(const EventID_t event, VariantVector_t&& args) {
     return mImpl->transitionWithArgsArray(event, std::move(args));
 }
@@ -135,7 +233,18 @@ bool HierarchicalStateMachine::transitionInterruptSafe(const EventID_t event) {
 }
 
 void HierarchicalStateMachine::startTimer(const TimerID_t timerID, const unsigned int intervalMs, const bool isSingleShot) {
-    mImpl->startTimer(timerID, intervalMs, isSingleShot);
+    mImpl->startTimer(timerID, static_cast<uint64_t>(intervalMs) * 1000u, 0u, isSingleShot);
+}
+
+void HierarchicalStateMachine::startTimerUs(const TimerID_t timerID, const uint64_t intervalUs, const bool isSingleShot) {
+    mImpl->startTimer(timerID, intervalUs, 0u, isSingleShot);
+}
+
+void HierarchicalStateMachine::startTimerWithSlack(const TimerID_t timerID,
+                                                   const unsigned int intervalMs,
+                                                   const unsigned int slackMs,
+                                                   const bool isSingleShot) {
+    mImpl->startTimer(timerID, static_cast<uint64_t>(intervalMs) * 1000u, slackMs, isSingleShot);
 }
 
 void HierarchicalStateMachine::restartTimer(const TimerID_t timerID) {
@@ -150,6 +259,14 @@ bool HierarchicalStateMachine::isTimerRunning(const TimerID_t timerID) {
     return mImpl->isTimerRunning(timerID);
 }
 
+HandlerID_t HierarchicalStateMachine::watchFd(const int fd, const FdEvents_t events, const EventID_t event) {
+    return mImpl->watchFd(fd, events, event);
+}
+
+void HierarchicalStateMachine::unwatchFd(const HandlerID_t watchID) {
+    mImpl->unwatchFd(watchID);
+}
+
 bool HierarchicalStateMachine::enableHsmDebugging() {
     return mImpl->enableHsmDebugging();
 }
@@ -186,6 +303,19 @@ bool HierarchicalStateMachine::isTransitionPossibleImpl(const EventID_t event, c
     return mImpl->isTransitionPossible(event, args);
 }
 
+void HierarchicalStateMachine::transitionWithCallbackImpl(const EventID_t event,
+                                                          const bool clearQueue,
+                                                          HsmTransitionDoneCallback_t onDone,
+                                                          VariantVector_t&& args) {
+    mImpl->transitionWithCallback(event, clearQueue, std::move(onDone), std::move(args));
+}
+
+bool HierarchicalStateMachine::addStateWaiterImpl(const std::list<StateID_t>& states,
+                                                  std::function<void(const bool)> onDone,
+                                                  bool& outIsActive) {
+    return mImpl->addStateWaiter(states, std::move(onDone), outIsActive);
+}
+
 bool HierarchicalStateMachine::registerStateActionImpl(const StateID_t state,
                                                        const StateActionTrigger actionTrigger,
                                                        const StateAction action,
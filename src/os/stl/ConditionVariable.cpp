@@ -58,4 +58,33 @@ bool ConditionVariable::wait_for(UniqueLock& sync, const int timeoutMs, const st
     return res;
 }
 
+bool ConditionVariable::wait_until(UniqueLock& sync,
+                                   const std::chrono::steady_clock::time_point& deadline,
+                                   const std::function<bool()>& stopWaiting) {
+    std::unique_lock<std::mutex> lck;
+
+    if (false == sync.owns_lock()) {
+        lck = std::unique_lock<std::mutex>(sync.mutex()->nativeHandle(), std::try_to_lock);
+    } else {
+        lck = std::unique_lock<std::mutex>(sync.mutex()->nativeHandle(), std::adopt_lock);
+    }
+
+    bool res = false;
+
+    // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::function has bool() operator
+    if (stopWaiting) {
+        res = mVariable.wait_until(lck, deadline, stopWaiting);
+    } else {
+        res = (std::cv_status::timeout != mVariable.wait_until(lck, deadline));
+    }
+
+    // no need to unlock on exit if lock already belonged to UniqueLock object
+    if (true == sync.owns_lock()) {
+        lck.release();
+        sync.unlock();
+    }
+
+    return res;
+}
+
 }  // namespace hsmcpp
@@ -3,8 +3,12 @@
 
 #include "hsmcpp/variant.hpp"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
 #include <cstring>
 #include <math.h>
+#include <ostream>
 
 #include "hsmcpp/os/os.hpp"
 
@@ -34,6 +38,120 @@
 
 namespace hsmcpp {
 
+// =================================================================================================================
+// Helper class used by format() and toString() to write data directly to the destination without creating
+// intermediate strings. When output is limited, last characters are held back until it's known if truncation
+// marker has to be written instead of them.
+class Variant::Output {
+public:
+    Output(char* buffer, const std::size_t bufferSize)
+        : mBuffer(buffer)
+        , mMaxLength((bufferSize > 0U) ? (bufferSize - 1U) : 0U)
+        , mIsLimited(true) {
+        initLimits();
+    }
+
+    Output(std::ostream& stream, const std::size_t maxLength)
+        : mStream(&stream)
+        , mMaxLength(maxLength)
+        , mIsLimited(VARIANT_FORMAT_UNLIMITED != maxLength) {
+        initLimits();
+    }
+
+    explicit Output(std::string& str)
+        : mString(&str) {
+        initLimits();
+    }
+
+    void write(const char* data, const std::size_t length) {
+        std::size_t i = 0;
+
+        if ((false == mTruncated) && (length > 0U)) {
+            if (false == mIsLimited) {
+                writeDirect(data, length);
+                i = length;
+            } else if (mLength < mDirectLimit) {
+                i = std::min(length, mDirectLimit - mLength);
+                writeDirect(data, i);
+                mLength += i;
+            } else {
+                // do nothing
+            }
+
+            for (; (false == mTruncated) && (i < length); ++i) {
+                if (mLength < mMaxLength) {
+                    mPending[mLength - mDirectLimit] = data[i];
+                    ++mLength;
+                } else {
+                    mTruncated = true;
+                }
+            }
+        }
+    }
+
+    inline void write(const char* str) {
+        write(str, strlen(str));
+    }
+
+    inline bool isTruncated() const {
+        return mTruncated;
+    }
+
+    std::size_t finish() {
+        std::size_t written = mDirectLength;
+
+        if (mLength > mDirectLimit) {
+            const std::size_t pendingCount = mLength - mDirectLimit;
+
+            writeDirect((true == mTruncated) ? cTruncationMarker : mPending, pendingCount);
+            written += pendingCount;
+        }
+
+        if (nullptr != mBuffer) {
+            mBuffer[mDirectLength] = '\0';
+        }
+
+        return written;
+    }
+
+private:
+    void initLimits() {
+        mDirectLimit = ((mMaxLength > cTruncationMarkerLength) ? (mMaxLength - cTruncationMarkerLength) : 0U);
+    }
+
+    void writeDirect(const char* data, const std::size_t length) {
+        if (nullptr != mBuffer) {
+            (void)memcpy(&mBuffer[mDirectLength], data, length);
+        } else if (nullptr != mStream) {
+            (void)mStream->write(data, static_cast<std::streamsize>(length));
+        } else if (nullptr != mString) {
+            (void)mString->append(data, length);
+        } else {
+            // do nothing
+        }
+
+        mDirectLength += length;
+    }
+
+private:
+    static constexpr const char* cTruncationMarker = "...";
+    static constexpr std::size_t cTruncationMarkerLength = 3U;
+
+    char* mBuffer = nullptr;
+    std::ostream* mStream = nullptr;
+    std::string* mString = nullptr;
+    std::size_t mMaxLength = VARIANT_FORMAT_UNLIMITED;
+    bool mIsLimited = false;
+    std::size_t mDirectLimit = 0;
+    std::size_t mDirectLength = 0;
+    std::size_t mLength = 0;
+    char mPending[cTruncationMarkerLength] = {0};
+    bool mTruncated = false;
+};
+
+constexpr const char* Variant::Output::cTruncationMarker;
+constexpr std::size_t Variant::Output::cTruncationMarkerLength;
+
 // =================================================================================================================
 // make()
 IMPL_MAKE(int8_t)
@@ -167,66 +285,163 @@ bool Variant::operator!=(const Variant& val) const {
 }
 
 bool Variant::operator>(const Variant& val) const {
-    bool isGreater = false;
-
-    if ((data != val.data) && (data) && (val.data)) {
-        if (isNumeric() && val.isNumeric()) {
-            if ((Type::DOUBLE == type) || (Type::DOUBLE == val.type)) {
-                isGreater = toDouble() > val.toDouble();
-            } else if (isUnsignedNumeric() || val.isUnsignedNumeric()) {
-                isGreater = toUInt64() > val.toUInt64();
-            } else {
-                isGreater = toInt64() > val.toInt64();
-            }
-        } else if (type == val.type) {
-            isGreater = (1 == compareOperator(data.get(), val.data.get()));
-        } else {
-            // do nothing
-        }
-    }
-
-    return isGreater;
+    return (compare(val) > 0);
 }
 
 bool Variant::operator>=(const Variant& val) const {
-    return (*this == val) || (*this > val);
+    return (compare(val) >= 0);
 }
 
 bool Variant::operator<(const Variant& val) const {
-    return (*this != val) && !(*this > val);
+    return (compare(val) < 0);
 }
 
 bool Variant::operator<=(const Variant& val) const {
-    return (*this == val) || !(*this > val);
+    return (compare(val) <= 0);
 }
 
 bool Variant::operator==(const Variant& val) const {
+    return (0 == compare(val));
+}
+
+int Variant::compare(const Variant& val) const {
     constexpr double comparePrecision = 0.00000001;
-    bool equal = false;
+    int res = 0;
 
     if (data != val.data) {
-        if ((data) && (val.data)) {
-            if (isNumeric() && val.isNumeric()) {
-                if ((Type::DOUBLE == type) || (Type::DOUBLE == val.type)) {
-                    // compare with precision for double
-                    // cppcheck-suppress misra-c2012-10.4 : false positive. both operands have type double
-                    equal = (fabs(toDouble() - val.toDouble()) < comparePrecision);
-                } else if (isUnsignedNumeric() || val.isUnsignedNumeric()) {
-                    equal = (toUInt64() == val.toUInt64());
-                } else {
-                    equal = (toInt64() == val.toInt64());
+        if ((!data) || (!val.data)) {
+            // empty variant is always less than a non-empty one
+            res = ((!data) ? -1 : 1);
+        } else if (isNumeric() && val.isNumeric()) {
+            if ((Type::DOUBLE == type) || (Type::DOUBLE == val.type)) {
+                const double left = toDouble();
+                const double right = val.toDouble();
+
+                // compare with precision for double
+                // cppcheck-suppress misra-c2012-10.4 : false positive. both operands have type double
+                if (fabs(left - right) >= comparePrecision) {
+                    res = ((left > right) ? 1 : -1);
+                }
+            } else if (isUnsignedNumeric() || val.isUnsignedNumeric()) {
+                const uint64_t left = toUInt64();
+                const uint64_t right = val.toUInt64();
+
+                if (left != right) {
+                    res = ((left > right) ? 1 : -1);
                 }
-            } else if (val.type == type) {
-                equal = (0 == compareOperator(data.get(), val.data.get()));
             } else {
-                // do nothing
+                const int64_t left = toInt64();
+                const int64_t right = val.toInt64();
+
+                if (left != right) {
+                    res = ((left > right) ? 1 : -1);
+                }
             }
+        } else if (val.type == type) {
+            res = compareOperator(data.get(), val.data.get());
+        } else {
+            // variants of different types are ordered by their type to keep ordering strict
+            res = ((static_cast<int>(type) > static_cast<int>(val.type)) ? 1 : -1);
+        }
+    }
+
+    return res;
+}
+
+std::size_t Variant::hash() const {
+    std::size_t result = 0;
+
+    // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
+    if (data) {
+        switch (type) {
+            case Type::BYTE_1:
+            case Type::BYTE_2:
+            case Type::BYTE_4:
+            case Type::BYTE_8:
+            case Type::UBYTE_1:
+            case Type::UBYTE_2:
+            case Type::UBYTE_4:
+            case Type::UBYTE_8:
+                // NOTE: all integer types are hashed using the same 64bit representation which is used by operator==
+                result = std::hash<uint64_t>()(toUInt64());
+                break;
+
+            case Type::DOUBLE: {
+                const double doubleValue = *value<double>();
+
+                // integral doubles must have the same hash as integer variants with the same value
+                if ((doubleValue == floor(doubleValue)) && (doubleValue >= -9223372036854775808.0) &&
+                    (doubleValue < 18446744073709551616.0)) {
+                    const uint64_t intValue =
+                        ((doubleValue < 0.0) ? static_cast<uint64_t>(static_cast<int64_t>(doubleValue))
+                                             : static_cast<uint64_t>(doubleValue));
+
+                    result = std::hash<uint64_t>()(intValue);
+                } else {
+                    result = std::hash<double>()(doubleValue);
+                }
+                break;
+            }
+
+            case Type::BOOL:
+                result = hashCombine(static_cast<std::size_t>(type), std::hash<bool>()(*value<bool>()));
+                break;
+
+            case Type::STRING:
+                result = hashCombine(static_cast<std::size_t>(type), std::hash<std::string>()(*value<std::string>()));
+                break;
+
+            case Type::BYTEARRAY:
+                result = static_cast<std::size_t>(type);
+
+                for (const unsigned char curByte : *value<ByteArray_t>()) {
+                    result = hashCombine(result, static_cast<std::size_t>(curByte));
+                }
+                break;
+
+            case Type::VECTOR:
+                result = static_cast<std::size_t>(type);
+
+                for (const Variant& item : *value<VariantVector_t>()) {
+                    result = hashCombine(result, item.hash());
+                }
+                break;
+
+            case Type::LIST:
+                result = static_cast<std::size_t>(type);
+
+                for (const Variant& item : *value<VariantList_t>()) {
+                    result = hashCombine(result, item.hash());
+                }
+                break;
+
+            case Type::MAP:
+                result = static_cast<std::size_t>(type);
+
+                for (const auto& item : *value<VariantMap_t>()) {
+                    result = hashCombine(result, item.first.hash());
+                    result = hashCombine(result, item.second.hash());
+                }
+                break;
+
+            case Type::PAIR: {
+                const std::shared_ptr<VariantPair_t> pairData = value<VariantPair_t>();
+
+                result = hashCombine(static_cast<std::size_t>(type), pairData->first.hash());
+                result = hashCombine(result, pairData->second.hash());
+                break;
+            }
+
+            case Type::CUSTOM:
+            default:
+                // NOTE: content of custom types is not accessible. All custom values have the same hash which is still
+                //       consistent with operator==
+                result = static_cast<std::size_t>(type);
+                break;
         }
-    } else {
-        equal = true;
     }
 
-    return equal;
+    return result;
 }
 
 void Variant::clear() {
@@ -341,45 +556,87 @@ bool Variant::isBool() const {
 
 std::string Variant::toString() const {
     std::string result;
+    Output out(result);
+
+    format(out);
+    (void)out.finish();
+
+    return result;
+}
+
+std::size_t Variant::format(char* buffer, const std::size_t bufferSize) const {
+    std::size_t written = 0;
+
+    if ((nullptr != buffer) && (bufferSize > 0U)) {
+        Output out(buffer, bufferSize);
+
+        format(out);
+        written = out.finish();
+    }
+
+    return written;
+}
+
+std::size_t Variant::format(std::ostream& stream, const std::size_t maxLength) const {
+    Output out(stream, maxLength);
+
+    format(out);
+
+    return out.finish();
+}
+
+void Variant::format(Output& out) const {
+    constexpr std::size_t numberBufferSize = 32;
+    char numberBuffer[numberBufferSize];
+    int numberLength = -1;
 
     switch (getType()) {
         case Type::BYTE_1:
-            result = std::to_string(*(value<int8_t>()));
-            break;
         case Type::BYTE_2:
-            result = std::to_string(*(value<int16_t>()));
-            break;
         case Type::BYTE_4:
-            result = std::to_string(*(value<int32_t>()));
-            break;
         case Type::BYTE_8:
-            result = std::to_string(*(value<int64_t>()));
+            numberLength = snprintf(numberBuffer, numberBufferSize, "%" PRId64, toInt64());
             break;
         case Type::UBYTE_1:
-            result = std::to_string(*(value<uint8_t>()));
-            break;
         case Type::UBYTE_2:
-            result = std::to_string(*(value<uint16_t>()));
-            break;
         case Type::UBYTE_4:
-            result = std::to_string(*(value<uint32_t>()));
-            break;
         case Type::UBYTE_8:
-            result = std::to_string(*(value<uint64_t>()));
+            numberLength = snprintf(numberBuffer, numberBufferSize, "%" PRIu64, toUInt64());
             break;
-        case Type::DOUBLE:
-            result = std::to_string(*(value<double>()));
+        case Type::DOUBLE: {
+            const double val = *(value<double>());
+
+            // NOTE: same format as used by std::to_string(double)
+            numberLength = snprintf(numberBuffer, numberBufferSize, "%f", val);
+
+            // large values (up to ~320 characters) don't fit into numberBuffer. This is rare enough to use heap
+            if ((numberLength > 0) && (static_cast<std::size_t>(numberLength) >= numberBufferSize)) {
+                std::string longNumber(static_cast<std::size_t>(numberLength) + 1U, '\0');
+
+                numberLength = snprintf(&longNumber[0], longNumber.size(), "%f", val);
+
+                if (numberLength > 0) {
+                    out.write(longNumber.data(), std::min(static_cast<std::size_t>(numberLength), longNumber.size() - 1U));
+                    numberLength = -1;
+                }
+            }
             break;
+        }
         case Type::BOOL:
-            result = (*(value<bool>()) ? "true" : "false");
+            out.write(*(value<bool>()) ? "true" : "false");
             break;
-        case Type::STRING:
-            result = *(value<std::string>());
+        case Type::STRING: {
+            std::shared_ptr<std::string> val = value<std::string>();
+
+            out.write(val->data(), val->size());
             break;
+        }
         case Type::BYTEARRAY: {
             std::shared_ptr<ByteArray_t> val = value<ByteArray_t>();
 
-            result.assign(val->begin(), val->end());
+            if (false == val->empty()) {
+                out.write(reinterpret_cast<const char*>(val->data()), val->size());
+            }
             break;
         }
         case Type::VECTOR: {
@@ -387,12 +644,12 @@ std::string Variant::toString() const {
 
             // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
             if (val) {
-                for (const Variant& item: *val) {
-                    if (false == result.empty()) {
-                        result.append(", ");
+                for (auto it = val->begin(); (it != val->end()) && (false == out.isTruncated()); ++it) {
+                    if (it != val->begin()) {
+                        out.write(", ", 2);
                     }
 
-                    result += item.toString();
+                    it->format(out);
                 }
             }
             break;
@@ -402,12 +659,12 @@ std::string Variant::toString() const {
 
             // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
             if (val) {
-                for (const Variant& item: *val) {
-                    if (false == result.empty()) {
-                        result.append(", ");
+                for (auto it = val->begin(); (it != val->end()) && (false == out.isTruncated()); ++it) {
+                    if (it != val->begin()) {
+                        out.write(", ", 2);
                     }
 
-                    result += item.toString();
+                    it->format(out);
                 }
             }
             break;
@@ -417,24 +674,36 @@ std::string Variant::toString() const {
 
             // cppcheck-suppress misra-c2012-14.4 ; false-positive. std::shared_ptr has a bool() operator
             if (val) {
-                for (const auto& item: *val) {
-                    if (false == result.empty()) {
-                        result.append(", ");
+                for (auto it = val->begin(); (it != val->end()) && (false == out.isTruncated()); ++it) {
+                    if (it != val->begin()) {
+                        out.write(", ", 2);
                     }
-                    result += item.first.toString().append("=[").append(item.second.toString()).append("]");
+
+                    it->first.format(out);
+                    out.write("=[", 2);
+                    it->second.format(out);
+                    out.write("]", 1);
                 }
             }
             break;
         }
-        case Type::PAIR:
-            result = std::string("(") + value<VariantPair_t>()->first.toString() + std::string(", ") +
-                     value<VariantPair_t>()->second.toString() + std::string(")");
+        case Type::PAIR: {
+            std::shared_ptr<VariantPair_t> val = value<VariantPair_t>();
+
+            out.write("(", 1);
+            val->first.format(out);
+            out.write(", ", 2);
+            val->second.format(out);
+            out.write(")", 1);
             break;
+        }
         default:
             break;
     }
 
-    return result;
+    if (numberLength > 0) {
+        out.write(numberBuffer, std::min(static_cast<std::size_t>(numberLength), numberBufferSize - 1U));
+    }
 }
 
 int64_t Variant::toInt64() const {
@@ -775,6 +1044,10 @@ std::shared_ptr<VariantPair_t> Variant::getPair() const {
     return result;
 }
 
+std::size_t Variant::hashCombine(const std::size_t seed, const std::size_t hashValue) {
+    return seed ^ (hashValue + static_cast<std::size_t>(0x9e3779b9U) + (seed << 6) + (seed >> 2));
+}
+
 bool Variant::isSameObject(const Variant& val) const {
     return ((val.data.get() == data.get()) && data);
 }
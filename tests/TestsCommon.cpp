@@ -1,7 +1,9 @@
 #include "TestsCommon.hpp"
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <thread>
 
 #include "ConfigurableEventListener.hpp"
 #include "utils/gtestbadge/BadgeEventListener.h"
@@ -61,6 +63,182 @@ void configureGTest(const std::string& name) {
     listeners.Append(bel);
 }
 
+#if defined(TEST_HSM_MANUAL)
+namespace {
+
+// Processes events of manual dispatcher on a separate thread like other dispatchers do. This allows tests to use
+// synchronous transitions and blocking callbacks. Virtual clock is moved only when test requests it.
+class ManualDispatcherRunner {
+public:
+    using TimePoint_t = HsmEventDispatcherManual::TimePoint_t;
+
+public:
+    ~ManualDispatcherRunner() {
+        stop();
+    }
+
+    void start(const std::shared_ptr<HsmEventDispatcherManual>& dispatcher) {
+        stop();
+
+        mStop = false;
+        mDispatcher = dispatcher;
+        mThread = std::thread(&ManualDispatcherRunner::run, this);
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lck(mSync);
+            mStop = true;
+        }
+
+        mRequestEvent.notify_all();
+
+        if (true == mThread.joinable()) {
+            mThread.join();
+        }
+    }
+
+    std::shared_ptr<HsmEventDispatcherManual> dispatcher() const {
+        return mDispatcher;
+    }
+
+    // moves virtual clock to targetTime and processes everything what happens until then. returns false if
+    // isBlocked() became true before that
+    bool advanceTo(const TimePoint_t& targetTime, const std::function<bool()>& isBlocked) {
+        std::unique_lock<std::mutex> lck(mSync);
+        const uint64_t requestID = ++mLastRequestID;
+        bool isDone = false;
+
+        mRequests.emplace_back(requestID, targetTime);
+        mRequestEvent.notify_all();
+
+        while (false == (isDone = (mLastCompletedID >= requestID))) {
+            if (isBlocked && isBlocked()) {
+                break;
+            }
+
+            // NOTE: handlers block on their own condition variable, so isBlocked() has to be checked periodically
+            mDoneEvent.wait_for(lck, std::chrono::milliseconds(1));
+        }
+
+        // handler was blocked before request was started. drop it, so that virtual clock doesn't move while test is
+        // checking HSM state
+        if ((false == isDone) && (false == mRequests.empty()) && (requestID == mRequests.back().first)) {
+            mRequests.pop_back();
+        }
+
+        return isDone;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lck(mSync);
+
+        while (false == mStop) {
+            if (false == mRequests.empty()) {
+                const std::pair<uint64_t, TimePoint_t> request = mRequests.front();
+
+                mRequests.pop_front();
+                lck.unlock();
+                (void)mDispatcher->advance(getDuration(mDispatcher->now(), request.second));
+                lck.lock();
+                mLastCompletedID = request.first;
+                mDoneEvent.notify_all();
+            } else {
+                lck.unlock();
+
+                const bool hasProcessedWork = mDispatcher->runUntilIdle();
+
+                lck.lock();
+
+                if (false == hasProcessedWork) {
+                    // NOTE: manual dispatcher doesn't notify anyone about new events, so they have to be polled
+                    mRequestEvent.wait_for(lck, std::chrono::milliseconds(1), [&]() {
+                        return (true == mStop) || (false == mRequests.empty());
+                    });
+                }
+            }
+        }
+    }
+
+    static std::chrono::microseconds getDuration(const TimePoint_t& from, const TimePoint_t& to) {
+        std::chrono::microseconds duration(0);
+
+        if (to > from) {
+            // round up to make sure that timer which expires at "to" is processed
+            duration = std::chrono::duration_cast<std::chrono::microseconds>(to - from + std::chrono::microseconds(1) -
+                                                                             TimePoint_t::duration(1));
+        }
+
+        return duration;
+    }
+
+private:
+    std::shared_ptr<HsmEventDispatcherManual> mDispatcher;
+    std::thread mThread;
+    std::mutex mSync;
+    std::condition_variable mRequestEvent;
+    std::condition_variable mDoneEvent;
+    std::deque<std::pair<uint64_t, TimePoint_t>> mRequests;  // protected by mSync
+    uint64_t mLastRequestID = 0;                              // protected by mSync
+    uint64_t mLastCompletedID = 0;                            // protected by mSync
+    bool mStop = false;                                       // protected by mSync
+};
+
+ManualDispatcherRunner gManualDispatcherRunner;
+
+}  // namespace
+
+std::shared_ptr<HsmEventDispatcherManual> createManualDispatcher() {
+    std::shared_ptr<HsmEventDispatcherManual> dispatcher = HsmEventDispatcherManual::create();
+
+    gManualDispatcherRunner.start(dispatcher);
+
+    return dispatcher;
+}
+
+bool advanceTimersUntil(const std::chrono::microseconds& timeout, const std::function<bool()>& isDone) {
+    const std::shared_ptr<HsmEventDispatcherManual> dispatcher = gManualDispatcherRunner.dispatcher();
+    bool done = isDone();
+
+    if (dispatcher) {
+        const HsmEventDispatcherManual::TimePoint_t deadline = dispatcher->now() + timeout;
+        // first step only processes pending events
+        HsmEventDispatcherManual::TimePoint_t nextTime = dispatcher->now();
+
+        while ((false == done) && (nextTime <= deadline)) {
+            (void)gManualDispatcherRunner.advanceTo(nextTime, isDone);
+            done = isDone();
+            nextTime = dispatcher->getNextTimerDeadline();
+        }
+    }
+
+    return done;
+}
+#endif  // TEST_HSM_MANUAL
+
+void waitTimers(const std::chrono::microseconds& duration, const std::function<bool()>& isBlocked) {
+#if defined(TEST_HSM_MANUAL)
+    const std::shared_ptr<HsmEventDispatcherManual> dispatcher = gManualDispatcherRunner.dispatcher();
+
+    if (dispatcher) {
+        (void)gManualDispatcherRunner.advanceTo(dispatcher->now() + duration, isBlocked);
+    }
+#else
+    std::this_thread::sleep_for(duration);
+#endif
+}
+
+std::chrono::steady_clock::time_point timersNow() {
+#if defined(TEST_HSM_MANUAL)
+    const std::shared_ptr<HsmEventDispatcherManual> dispatcher = gManualDispatcherRunner.dispatcher();
+
+    return (dispatcher ? dispatcher->now() : std::chrono::steady_clock::time_point());
+#else
+    return std::chrono::steady_clock::now();
+#endif
+}
+
 #if defined(TEST_HSM_GLIB) || defined(TEST_HSM_GLIBMM) || defined(TEST_HSM_QT)
   #if defined(TEST_HSM_GLIB) || defined(TEST_HSM_GLIBMM)
 gboolean mainThreadCallback(void* data)
@@ -82,7 +260,8 @@ void mainThreadCallback()
 
 bool executeOnMainThread(std::function<bool()> func) {
     // in case of some dispatchers we can just call func()
-#if defined(TEST_HSM_STD) || defined(TEST_HSM_FREERTOS)
+#if defined(TEST_HSM_STD) || defined(TEST_HSM_POOL) || defined(TEST_HSM_EPOLL) || defined(TEST_HSM_MANUAL) || \
+    defined(TEST_HSM_FREERTOS)
     return func();
 #else
     std::unique_lock<std::mutex> lck(gSyncCall);
@@ -115,5 +294,5 @@ bool executeOnMainThread(std::function<bool()> func) {
     gMainThreadCallDoneEvent.wait(lck, [&]() { return gCallDone; });
 
     return gCallResult;
-#endif    // TEST_HSM_STD || TEST_HSM_FREERTOS
+#endif    // TEST_HSM_STD || TEST_HSM_POOL || TEST_HSM_EPOLL || TEST_HSM_MANUAL || TEST_HSM_FREERTOS
 }
\ No newline at end of file
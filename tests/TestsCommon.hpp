@@ -4,6 +4,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <functional>
 #include <list>
 #include <string>
 #include <memory>
@@ -108,7 +110,34 @@ bool executeOnMainThread(std::function<bool()> func);
 #elif defined(TEST_HSM_STD)
   #include "hsmcpp/HsmEventDispatcherSTD.hpp"
 
-  #define CREATE_DISPATCHER() HsmEventDispatcherSTD::create()
+  #if defined(TEST_HSM_STD_TIMERS_IN_DISPATCHER_THREAD)
+    #define CREATE_DISPATCHER() \
+      HsmEventDispatcherSTD::create(DISPATCHER_DEFAULT_EVENTS_CACHESIZE, HsmEventDispatcherSTD::TimersMode::DISPATCHER_THREAD)
+  #elif defined(TEST_HSM_STD_SHARED_TIMERS)
+    #define CREATE_DISPATCHER() \
+      HsmEventDispatcherSTD::create(DISPATCHER_DEFAULT_EVENTS_CACHESIZE, HsmEventDispatcherSTD::TimersMode::SHARED_SERVICE)
+  #else
+    #define CREATE_DISPATCHER() HsmEventDispatcherSTD::create()
+  #endif
+#elif defined(TEST_HSM_MANUAL)
+  #include "hsmcpp/HsmEventDispatcherManual.hpp"
+
+  // events of manual dispatcher are processed by a separate thread. timers use virtual time (see waitTimers())
+  #define CREATE_DISPATCHER() createManualDispatcher()
+
+std::shared_ptr<HsmEventDispatcherManual> createManualDispatcher();
+
+// moves virtual clock of dispatcher forward one timer at a time until isDone() returns true or timeout expires.
+// returns result of isDone()
+bool advanceTimersUntil(const std::chrono::microseconds& timeout, const std::function<bool()>& isDone);
+#elif defined(TEST_HSM_POOL)
+  #include "hsmcpp/HsmEventDispatcherPool.hpp"
+
+  #define CREATE_DISPATCHER() HsmEventDispatcherPool::create(4)
+#elif defined(TEST_HSM_EPOLL)
+  #include "hsmcpp/HsmEventDispatcherEpoll.hpp"
+
+  #define CREATE_DISPATCHER() HsmEventDispatcherEpoll::create()
 #elif defined(TEST_HSM_QT)
   #include "hsmcpp/HsmEventDispatcherQt.hpp"
 
@@ -122,6 +151,14 @@ bool executeOnMainThread(std::function<bool()> func);
   #error HSM Dispatcher not specified
 #endif
 
+// lets timers of gDispatcher run for the specified time. with most dispatchers it's just a sleep. in case of manual
+// dispatcher virtual clock is moved forward instead and function returns earlier if isBlocked() becomes true (handler
+// is blocked and waits for the test)
+void waitTimers(const std::chrono::microseconds& duration, const std::function<bool()>& isBlocked = nullptr);
+
+// returns current time of the clock used by gDispatcher timers
+std::chrono::steady_clock::time_point timersNow();
+
 #define INITIALIZE_HSM()                                                                        \
   ASSERT_TRUE(executeOnMainThread([this]() {                                                    \
     if (!gDispatcher){                                                                          \
@@ -0,0 +1,182 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include <hsmcpp/HsmEventDispatcherBusyPoll.hpp>
+#include <hsmcpp/HsmEventDispatcherSTD.hpp>
+#include <hsmcpp/hsm.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace hsmcpp;
+
+namespace {
+constexpr int WARMUP_ITERATIONS = 1000;
+constexpr int PINGPONG_ITERATIONS = 20000;
+
+namespace States {
+const StateID_t WAITING = 0;
+const StateID_t HAS_BALL = 1;
+}  // namespace States
+
+namespace Events {
+const EventID_t BALL = 0;
+const EventID_t PASS = 1;
+}  // namespace Events
+
+using Clock_t = std::chrono::steady_clock;
+
+// HSM which passes the ball to its partner as soon as it receives it
+class Player : public HierarchicalStateMachine {
+public:
+    Player()
+        : HierarchicalStateMachine(States::WAITING) {
+        registerState(States::WAITING);
+        registerState(States::HAS_BALL, [this](const VariantVector_t& args) { onBallReceived(args); });
+        registerTransition(States::WAITING, States::HAS_BALL, Events::BALL);
+        registerTransition(States::HAS_BALL, States::WAITING, Events::PASS);
+    }
+
+    virtual ~Player() = default;
+
+    Player* partner = nullptr;
+    // called by the player which starts the game. Returns false to stop the game
+    std::function<bool()> onRoundTrip;
+
+private:
+    void onBallReceived(const VariantVector_t& args) {
+        (void)args;
+        transition(Events::PASS);
+
+        if ((!onRoundTrip) || (true == onRoundTrip())) {
+            partner->transition(Events::BALL);
+        }
+    }
+};
+
+void printLatency(const char* name, std::vector<int64_t>& latencyNs) {
+    std::sort(latencyNs.begin(), latencyNs.end());
+
+    int64_t sumNs = 0;
+
+    for (const int64_t value : latencyNs) {
+        sumNs += value;
+    }
+
+    printf("%-44s avg=%8.2f us, p50=%8.2f us, p99=%8.2f us, p99.9=%8.2f us, max=%8.2f us\n",
+           name,
+           static_cast<double>(sumNs) / static_cast<double>(latencyNs.size()) / 1000.0,
+           static_cast<double>(latencyNs[latencyNs.size() / 2U]) / 1000.0,
+           static_cast<double>(latencyNs[(latencyNs.size() * 99U) / 100U]) / 1000.0,
+           static_cast<double>(latencyNs[(latencyNs.size() * 999U) / 1000U]) / 1000.0,
+           static_cast<double>(latencyNs.back()) / 1000.0);
+}
+
+// measures round trip time of an event between two HSMs which run on separate dispatchers
+void runBenchmark(const char* name,
+                  const std::shared_ptr<HsmEventDispatcherBase>& pingDispatcher,
+                  const std::shared_ptr<HsmEventDispatcherBase>& pongDispatcher) {
+    Player ping;
+    Player pong;
+    std::vector<int64_t> latencyNs;
+    std::atomic<bool> isFinished(false);
+    int iteration = 0;
+    Clock_t::time_point sentAt;
+
+    latencyNs.reserve(PINGPONG_ITERATIONS);
+    ping.partner = &pong;
+    pong.partner = &ping;
+    ping.onRoundTrip = [&]() {
+        const auto now = Clock_t::now();
+
+        if (iteration > WARMUP_ITERATIONS) {
+            latencyNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - sentAt).count());
+        }
+
+        ++iteration;
+        sentAt = now;
+
+        if (iteration > (WARMUP_ITERATIONS + PINGPONG_ITERATIONS)) {
+            isFinished = true;
+        }
+
+        return (false == isFinished.load());
+    };
+
+    pingDispatcher->start();
+    pongDispatcher->start();
+
+    if ((true == ping.initialize(pingDispatcher)) && (true == pong.initialize(pongDispatcher))) {
+        sentAt = Clock_t::now();
+        ping.transition(Events::BALL);
+
+        while (false == isFinished.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        printLatency(name, latencyNs);
+    } else {
+        printf("%s: failed to initialize HSM\n", name);
+    }
+
+    ping.release();
+    pong.release();
+    pingDispatcher->stop();
+    pongDispatcher->stop();
+}
+
+HsmEventDispatcherBusyPoll::IdleMode parseIdleMode(const char* value) {
+    HsmEventDispatcherBusyPoll::IdleMode mode = HsmEventDispatcherBusyPoll::IdleMode::SPIN;
+
+    if (0 == strcmp(value, "yield")) {
+        mode = HsmEventDispatcherBusyPoll::IdleMode::YIELD;
+    } else if (0 == strcmp(value, "sleep")) {
+        mode = HsmEventDispatcherBusyPoll::IdleMode::SLEEP;
+    } else if (0 != strcmp(value, "spin")) {
+        printf("unknown idle mode '%s'. Using 'spin'\n", value);
+    } else {
+        // spin
+    }
+
+    return mode;
+}
+}  // namespace
+
+int main(const int argc, const char** argv) {
+    const HsmEventDispatcherBusyPoll::IdleMode idleMode =
+        ((argc > 1) ? parseIdleMode(argv[1]) : HsmEventDispatcherBusyPoll::IdleMode::SPIN);
+    const int pingCpu = ((argc > 2) ? atoi(argv[2]) : DISPATCHER_ANY_CPU);
+    const int pongCpu = ((argc > 3) ? atoi(argv[3]) : DISPATCHER_ANY_CPU);
+
+    printf("\nThis utility measures round trip latency of an event between two HSMs running on separate dispatchers.\n");
+    printf("Usage: benchmark_busypoll [spin|yield|sleep] [ping CPU] [pong CPU]\n");
+    printf("NOTE: busy-poll dispatchers need a dedicated core each. Results are meaningless if there are less than 3 CPUs.\n");
+    printf("Hardware concurrency: %u\n", std::thread::hardware_concurrency());
+    printf("------------------------------------------------------------------\n\n");
+
+    {
+        std::shared_ptr<HsmEventDispatcherSTD> pingDispatcher = HsmEventDispatcherSTD::create();
+        std::shared_ptr<HsmEventDispatcherSTD> pongDispatcher = HsmEventDispatcherSTD::create();
+
+        runBenchmark("HsmEventDispatcherSTD:", pingDispatcher, pongDispatcher);
+        pingDispatcher->join();
+        pongDispatcher->join();
+    }
+
+    {
+        std::shared_ptr<HsmEventDispatcherBusyPoll> pingDispatcher = HsmEventDispatcherBusyPoll::create(idleMode, pingCpu);
+        std::shared_ptr<HsmEventDispatcherBusyPoll> pongDispatcher = HsmEventDispatcherBusyPoll::create(idleMode, pongCpu);
+
+        runBenchmark("HsmEventDispatcherBusyPoll:", pingDispatcher, pongDispatcher);
+        pingDispatcher->join();
+        pongDispatcher->join();
+    }
+
+    return 0;
+}
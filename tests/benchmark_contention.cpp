@@ -0,0 +1,165 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include <hsmcpp/HsmEventDispatcherSTD.hpp>
+#include <hsmcpp/HsmMpscLinkedQueue.hpp>
+#include <hsmcpp/hsm.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace hsmcpp;
+
+namespace {
+constexpr int EVENTS_PER_PRODUCER = 100000;
+const int PRODUCERS_COUNT[] = {1, 2, 4, 8, 16};
+
+namespace States {
+const StateID_t A = 0;
+const StateID_t B = 1;
+}  // namespace States
+
+namespace Events {
+const EventID_t TOGGLE = 0;
+}  // namespace Events
+
+using Clock_t = std::chrono::steady_clock;
+
+// same structure as pending events of HSM before lock-free queue was introduced
+class LockedQueue {
+public:
+    void push(const int value) {
+        std::lock_guard<std::mutex> lck(mSync);
+        mItems.push_back(value);
+    }
+
+    bool pop(int& value) {
+        bool wasRemoved = false;
+        std::lock_guard<std::mutex> lck(mSync);
+
+        if (false == mItems.empty()) {
+            value = mItems.front();
+            mItems.pop_front();
+            wasRemoved = true;
+        }
+
+        return wasRemoved;
+    }
+
+private:
+    std::mutex mSync;
+    std::list<int> mItems;
+};
+
+template <typename Func>
+double measureSec(const Func& func) {
+    const auto startedAt = Clock_t::now();
+
+    func();
+
+    return std::chrono::duration<double>(Clock_t::now() - startedAt).count();
+}
+
+// producers push into the queue while a single consumer drains it. Returns events/sec
+template <typename Queue>
+double runQueueBenchmark(const int producersCount) {
+    Queue queue;
+    const int totalEvents = producersCount * EVENTS_PER_PRODUCER;
+    const double elapsedSec = measureSec([&]() {
+        std::vector<std::thread> producers;
+
+        for (int i = 0; i < producersCount; ++i) {
+            producers.emplace_back([&queue]() {
+                for (int j = 0; j < EVENTS_PER_PRODUCER; ++j) {
+                    queue.push(j);
+                }
+            });
+        }
+
+        int value = 0;
+
+        for (int received = 0; received < totalEvents;) {
+            if (true == queue.pop(value)) {
+                ++received;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+    });
+
+    return static_cast<double>(totalEvents) / elapsedSec;
+}
+
+// producers send transitions to a single HSM. Returns events/sec (until all events are processed)
+double runHsmBenchmark(const int producersCount, double& producerEventsPerSec) {
+    std::shared_ptr<HsmEventDispatcherSTD> dispatcher = HsmEventDispatcherSTD::create();
+    HierarchicalStateMachine hsm(States::A);
+    std::atomic<int> processedEvents(0);
+    const int totalEvents = producersCount * EVENTS_PER_PRODUCER;
+    double sendSec = 0.0;
+
+    hsm.registerState(States::A);
+    hsm.registerState(States::B);
+    hsm.registerTransition(States::A, States::B, Events::TOGGLE, [&](const VariantVector_t&) { ++processedEvents; });
+    hsm.registerTransition(States::B, States::A, Events::TOGGLE, [&](const VariantVector_t&) { ++processedEvents; });
+
+    dispatcher->start();
+    (void)hsm.initialize(dispatcher);
+
+    const double elapsedSec = measureSec([&]() {
+        std::vector<std::thread> producers;
+
+        sendSec = measureSec([&]() {
+            for (int i = 0; i < producersCount; ++i) {
+                producers.emplace_back([&hsm]() {
+                    for (int j = 0; j < EVENTS_PER_PRODUCER; ++j) {
+                        hsm.transition(Events::TOGGLE);
+                    }
+                });
+            }
+
+            for (std::thread& producer : producers) {
+                producer.join();
+            }
+        });
+
+        while (processedEvents.load() < totalEvents) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    hsm.release();
+    dispatcher->stop();
+    dispatcher->join();
+
+    producerEventsPerSec = static_cast<double>(totalEvents) / sendSec;
+    return static_cast<double>(totalEvents) / elapsedSec;
+}
+}  // namespace
+
+int main() {
+    printf("\nThis utility measures throughput of multiple threads sending events to a single consumer.\n");
+    printf("Each producer sends %d events. Hardware concurrency: %u\n", EVENTS_PER_PRODUCER, std::thread::hardware_concurrency());
+    printf("------------------------------------------------------------------\n\n");
+    printf("%10s %20s %20s %20s %20s\n", "producers", "mutex+list ev/s", "lock-free ev/s", "HSM send ev/s", "HSM total ev/s");
+
+    for (const int producersCount : PRODUCERS_COUNT) {
+        double hsmSendPerSec = 0.0;
+        const double lockedPerSec = runQueueBenchmark<LockedQueue>(producersCount);
+        const double lockFreePerSec = runQueueBenchmark<HsmMpscLinkedQueue<int>>(producersCount);
+        const double hsmTotalPerSec = runHsmBenchmark(producersCount, hsmSendPerSec);
+
+        printf("%10d %20.0f %20.0f %20.0f %20.0f\n", producersCount, lockedPerSec, lockFreePerSec, hsmSendPerSec, hsmTotalPerSec);
+    }
+
+    return 0;
+}
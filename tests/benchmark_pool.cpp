@@ -0,0 +1,115 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include <hsmcpp/HsmEventDispatcherPool.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace hsmcpp;
+
+namespace {
+constexpr size_t HANDLERS_COUNT = 512;
+constexpr int EVENTS_PER_HANDLER = 2000;
+constexpr size_t HANDLER_DATA_SIZE = 1024;  // private data of each handler (imitates HSM state)
+const size_t WORKERS_COUNT[] = {1, 2, 4, 8, 16, 32};
+
+using Clock_t = std::chrono::steady_clock;
+
+struct HandlerContext {
+    HandlerID_t id = INVALID_HSM_DISPATCHER_HANDLER_ID;
+    int processedEvents = 0;
+    std::vector<uint32_t> data;
+};
+
+// imitates some work done by HSM callbacks. Touches handler's private data
+void simulateWork(HandlerContext& context) {
+    uint32_t value = static_cast<uint32_t>(context.processedEvents);
+
+    for (uint32_t& item : context.data) {
+        value = (value * 1103515245u) + 12345u;
+        item ^= value;
+    }
+}
+
+double runBenchmark(const size_t workersCount) {
+    std::shared_ptr<HsmEventDispatcherPool> dispatcher = HsmEventDispatcherPool::create(workersCount);
+    std::vector<HandlerContext> contexts(HANDLERS_COUNT);
+    std::atomic<size_t> finishedHandlers(0);
+
+    dispatcher->start();
+
+    for (HandlerContext& context : contexts) {
+        HandlerContext* ctx = &context;
+
+        ctx->data.resize(HANDLER_DATA_SIZE / sizeof(uint32_t));
+        // every handler keeps emitting events to itself until it processes EVENTS_PER_HANDLER events. Same as HSM
+        // which handles a chain of transitions
+        ctx->id = dispatcher->registerEventHandler([ctx, &dispatcher, &finishedHandlers]() {
+            simulateWork(*ctx);
+            ++ctx->processedEvents;
+
+            if (ctx->processedEvents < EVENTS_PER_HANDLER) {
+                dispatcher->emitEvent(ctx->id);
+            } else {
+                ++finishedHandlers;
+            }
+
+            return true;
+        });
+    }
+
+    const auto startedAt = Clock_t::now();
+
+    for (const HandlerContext& context : contexts) {
+        dispatcher->emitEvent(context.id);
+    }
+
+    while (finishedHandlers.load() < HANDLERS_COUNT) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const double elapsedSec = std::chrono::duration<double>(Clock_t::now() - startedAt).count();
+
+    dispatcher->stop();
+    dispatcher->join();
+
+    for (const HandlerContext& context : contexts) {
+        if (EVENTS_PER_HANDLER != context.processedEvents) {
+            printf("ERROR: handler processed %d events instead of %d\n", context.processedEvents, EVENTS_PER_HANDLER);
+            exit(1);
+        }
+    }
+
+    return static_cast<double>(HANDLERS_COUNT * EVENTS_PER_HANDLER) / elapsedSec;
+}
+}  // namespace
+
+int main() {
+    printf("\nThis utility measures scalability of HsmEventDispatcherPool.\n");
+    printf("%d handlers, each processes %d events (~%d bytes of private data are touched per event).\n",
+           static_cast<int>(HANDLERS_COUNT),
+           EVENTS_PER_HANDLER,
+           static_cast<int>(HANDLER_DATA_SIZE));
+    printf("Hardware concurrency: %u\n", std::thread::hardware_concurrency());
+    printf("------------------------------------------------------------------\n\n");
+    printf("%8s %16s %10s\n", "workers", "events/sec", "speedup");
+
+    double baseline = 0.0;
+
+    for (const size_t workersCount : WORKERS_COUNT) {
+        const double eventsPerSec = runBenchmark(workersCount);
+
+        if (baseline <= 0.0) {
+            baseline = eventsPerSec;
+        }
+
+        printf("%8d %16.0f %9.2fx\n", static_cast<int>(workersCount), eventsPerSec, eventsPerSec / baseline);
+    }
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include <hsmcpp/HsmEventDispatcherSTD.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+  #include <sys/resource.h>
+#endif
+
+using namespace hsmcpp;
+
+namespace {
+constexpr TimerID_t TIMERS_COUNT = 500;
+constexpr int RUN_DURATION_MS = 5000;
+constexpr unsigned int SLACK_VALUES_MS[] = {0u, 10u, 100u, 1000u};
+
+using Clock_t = std::chrono::steady_clock;
+
+// returns number of voluntary context switches of the process or -1 if not supported
+long getContextSwitches() {
+    long switches = -1;
+
+#ifdef __linux__
+    struct rusage usage;
+
+    if (0 == getrusage(RUSAGE_SELF, &usage)) {
+        switches = usage.ru_nvcsw;
+    }
+#endif
+
+    return switches;
+}
+
+void runBenchmark(const HsmEventDispatcherSTD::TimersMode mode, const unsigned int slackMs) {
+    std::shared_ptr<HsmEventDispatcherSTD> dispatcher = HsmEventDispatcherSTD::create(DISPATCHER_DEFAULT_EVENTS_CACHESIZE, mode);
+    std::atomic<int> firedTimers(0);
+    std::atomic<int> wakeups(0);
+    // used only from dispatcher thread
+    Clock_t::time_point lastBatch;
+
+    dispatcher->start();
+
+    const HandlerID_t handlerID = dispatcher->registerTimerHandler([&](const TimerID_t) {
+        const Clock_t::time_point now = Clock_t::now();
+
+        // timers which are processed during the same wakeup are called one after another
+        if ((now - lastBatch) > std::chrono::microseconds(500)) {
+            ++wakeups;
+        }
+
+        lastBatch = now;
+        ++firedTimers;
+        return true;
+    });
+
+    const long switchesBefore = getContextSwitches();
+    const Clock_t::time_point startedAt = Clock_t::now();
+
+    // repeating timers with intervals spread between 500 and 1500 ms
+    for (TimerID_t id = 0; id < TIMERS_COUNT; ++id) {
+        dispatcher->startTimerWithSlack(handlerID, id, 500u + static_cast<unsigned int>((id * 7) % 1000), slackMs, false);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(RUN_DURATION_MS));
+    dispatcher->unregisterTimerHandler(handlerID);
+
+    const double elapsedSec =
+        static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock_t::now() - startedAt).count()) / 1000.0;
+    const long switchesAfter = getContextSwitches();
+
+    printf("slack=%5u ms: timers/sec=%8.1f, wakeups/sec=%8.1f", slackMs, firedTimers / elapsedSec, wakeups / elapsedSec);
+
+    if (switchesBefore >= 0) {
+        printf(", context switches/sec=%8.1f", static_cast<double>(switchesAfter - switchesBefore) / elapsedSec);
+    }
+
+    printf("\n");
+
+    dispatcher->stop();
+    dispatcher->join();
+}
+}  // namespace
+
+int main(const int argc, const char** argv) {
+    // usage: benchmark_timer_slack [--dispatcher-thread]
+    const bool useDispatcherThread = (argc > 1) && (0 == strcmp(argv[1], "--dispatcher-thread"));
+
+    printf("\nThis utility measures how many wakeups are needed to process %d repeating timers with different slack.\n",
+           TIMERS_COUNT);
+    printf("Timers are processed in %s thread. Each measurement takes %d ms.\n",
+           (useDispatcherThread ? "dispatcher" : "a separate"),
+           RUN_DURATION_MS);
+    printf("------------------------------------------------------------------\n\n");
+
+    for (const unsigned int slackMs : SLACK_VALUES_MS) {
+        runBenchmark((useDispatcherThread ? HsmEventDispatcherSTD::TimersMode::DISPATCHER_THREAD
+                                          : HsmEventDispatcherSTD::TimersMode::SEPARATE_THREAD),
+                     slackMs);
+    }
+
+    return 0;
+}
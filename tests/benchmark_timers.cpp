@@ -0,0 +1,127 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include <hsmcpp/HsmEventDispatcherSTD.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+using namespace hsmcpp;
+
+namespace {
+constexpr TimerID_t TIMERS_COUNT = 100000;
+
+using Clock_t = std::chrono::steady_clock;
+
+double elapsedUs(const Clock_t::time_point& from) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(Clock_t::now() - from).count());
+}
+
+void printOperationStats(const char* name, const double totalUs) {
+    printf("%-32s total=%10.1f ms, per timer=%8.3f us\n", name, totalUs / 1000.0, totalUs / TIMERS_COUNT);
+}
+}  // namespace
+
+int main(const int argc, const char** argv) {
+    // usage: benchmark_timers [--dispatcher-thread]
+    const bool useDispatcherThread = (argc > 1) && (0 == strcmp(argv[1], "--dispatcher-thread"));
+    std::shared_ptr<HsmEventDispatcherSTD> dispatcher = HsmEventDispatcherSTD::create(
+        DISPATCHER_DEFAULT_EVENTS_CACHESIZE,
+        (useDispatcherThread ? HsmEventDispatcherSTD::TimersMode::DISPATCHER_THREAD
+                             : HsmEventDispatcherSTD::TimersMode::SEPARATE_THREAD));
+    std::atomic<int> firedTimers(0);
+    std::vector<Clock_t::time_point> expectedDeadlines(TIMERS_COUNT);
+    std::vector<int64_t> latenessUs(TIMERS_COUNT, 0);
+
+    printf("\nThis utility measures performance of HsmEventDispatcherSTD timers with %d concurrent timers.\n", TIMERS_COUNT);
+    printf("Timers are processed in %s thread.\n", (useDispatcherThread ? "dispatcher" : "a separate"));
+    printf("------------------------------------------------------------------\n\n");
+
+    dispatcher->start();
+
+    const HandlerID_t handlerID = dispatcher->registerTimerHandler([&](const TimerID_t timerID) {
+        latenessUs[timerID] =
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock_t::now() - expectedDeadlines[timerID]).count();
+        ++firedTimers;
+        return true;
+    });
+
+    //-------------------------------------------
+    // start/restart/stop of long running timers
+    auto startedAt = Clock_t::now();
+
+    for (TimerID_t id = 0; id < TIMERS_COUNT; ++id) {
+        dispatcher->startTimer(handlerID, id, 60000 + (id % 1000), true);
+    }
+
+    printOperationStats("startTimer:", elapsedUs(startedAt));
+
+    // measure CPU usage of the process while all timers are waiting
+    const std::clock_t cpuBefore = std::clock();
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    const std::clock_t cpuAfter = std::clock();
+
+    printf("%-32s %10.1f ms of CPU time during 1000 ms\n",
+           "idle with running timers:",
+           1000.0 * static_cast<double>(cpuAfter - cpuBefore) / CLOCKS_PER_SEC);
+
+    startedAt = Clock_t::now();
+
+    for (TimerID_t id = 0; id < TIMERS_COUNT; ++id) {
+        dispatcher->restartTimer(handlerID, id);
+    }
+
+    printOperationStats("restartTimer:", elapsedUs(startedAt));
+
+    startedAt = Clock_t::now();
+
+    for (TimerID_t id = 0; id < TIMERS_COUNT; ++id) {
+        dispatcher->stopTimer(handlerID, id);
+    }
+
+    printOperationStats("stopTimer:", elapsedUs(startedAt));
+
+    //-------------------------------------------
+    // expiration of single shot timers spread over 1 second
+    startedAt = Clock_t::now();
+
+    for (TimerID_t id = 0; id < TIMERS_COUNT; ++id) {
+        const unsigned int intervalMs = 500u + static_cast<unsigned int>(id % 1000);
+
+        expectedDeadlines[id] = Clock_t::now() + std::chrono::milliseconds(intervalMs);
+        dispatcher->startTimer(handlerID, id, intervalMs, true);
+    }
+
+    while ((firedTimers < TIMERS_COUNT) && (elapsedUs(startedAt) < 10000000.0)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    int64_t maxLatenessUs = 0;
+    int64_t sumLatenessUs = 0;
+
+    for (const int64_t curLateness : latenessUs) {
+        maxLatenessUs = std::max(maxLatenessUs, curLateness);
+        sumLatenessUs += curLateness;
+    }
+
+    printf("%-32s %d of %d timers fired in %.1f ms\n",
+           "expiration:",
+           firedTimers.load(),
+           TIMERS_COUNT,
+           elapsedUs(startedAt) / 1000.0);
+    printf("%-32s avg=%.1f us, max=%lld us\n",
+           "expiration lateness:",
+           static_cast<double>(sumLatenessUs) / TIMERS_COUNT,
+           static_cast<long long>(maxLatenessUs));
+
+    dispatcher->unregisterTimerHandler(handlerID);
+    dispatcher->stop();
+    dispatcher->join();
+
+    return 0;
+}
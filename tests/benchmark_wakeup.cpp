@@ -0,0 +1,164 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+
+#include <sys/resource.h>
+
+#include <hsmcpp/HsmEventDispatcherEpoll.hpp>
+#include <hsmcpp/HsmEventDispatcherSTD.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace hsmcpp;
+
+namespace {
+constexpr int PINGPONG_ITERATIONS = 20000;
+constexpr int BURST_ITERATIONS = 200;
+constexpr int BURST_SIZE = 100;
+
+using Clock_t = std::chrono::steady_clock;
+
+long contextSwitches() {
+    rusage usage = {};
+
+    (void)getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+void runBenchmark(const char* name, const std::shared_ptr<HsmEventDispatcherBase>& dispatcher) {
+    // NOTE: multiple emits can be coalesced into a single handler call. So handler processes all events which were
+    //       emitted before it was called (same as HSM does)
+    std::atomic<int> emittedEvents(0);
+    std::atomic<int> handledEvents(0);
+    std::atomic<int> handlerCalls(0);
+    Clock_t::time_point emittedAt;
+    std::vector<int64_t> latencyNs;
+
+    latencyNs.reserve(PINGPONG_ITERATIONS);
+    dispatcher->start();
+
+    const HandlerID_t handlerID = dispatcher->registerEventHandler([&]() {
+        if (emittedAt != Clock_t::time_point()) {
+            latencyNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_t::now() - emittedAt).count());
+            emittedAt = Clock_t::time_point();
+        }
+
+        handledEvents = emittedEvents.load();
+        ++handlerCalls;
+        return true;
+    });
+
+    //-------------------------------------------
+    // ping-pong: emit single event and wait until it's handled. Measures wake-up latency of the idle dispatcher
+    long switchesBefore = contextSwitches();
+
+    for (int i = 0; i < PINGPONG_ITERATIONS; ++i) {
+        const int expected = handledEvents + 1;
+
+        emittedAt = Clock_t::now();
+        ++emittedEvents;
+        dispatcher->emitEvent(handlerID);
+
+        // NOTE: spin to avoid adding wake-up latency of the benchmark thread itself
+        while (handledEvents.load() < expected) {
+            std::this_thread::yield();
+        }
+    }
+
+    const long pingPongSwitches = contextSwitches() - switchesBefore;
+
+    std::sort(latencyNs.begin(), latencyNs.end());
+
+    int64_t sumNs = 0;
+
+    for (const int64_t value : latencyNs) {
+        sumNs += value;
+    }
+
+    //-------------------------------------------
+    // bursts: emit multiple events at once. Measures how many wake-ups are coalesced
+    switchesBefore = contextSwitches();
+    const int callsBefore = handlerCalls;
+    const auto burstStartedAt = Clock_t::now();
+    int64_t emitNs = 0;
+
+    for (int i = 0; i < BURST_ITERATIONS; ++i) {
+        const int expected = handledEvents + BURST_SIZE;
+        const auto emitStartedAt = Clock_t::now();
+
+        for (int j = 0; j < BURST_SIZE; ++j) {
+            ++emittedEvents;
+            dispatcher->emitEvent(handlerID);
+        }
+
+        // producer side cost: includes waking up the dispatcher (syscall) if it was sleeping
+        emitNs += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_t::now() - emitStartedAt).count();
+
+        while (handledEvents.load() < expected) {
+            std::this_thread::yield();
+        }
+    }
+
+    const double burstUs = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock_t::now() - burstStartedAt).count());
+    const long burstSwitches = contextSwitches() - switchesBefore;
+    const int burstCalls = handlerCalls - callsBefore;
+
+    printf("%s\n", name);
+    printf("  %-28s avg=%8.2f us, p50=%8.2f us, p99=%8.2f us, max=%8.2f us\n",
+           "ping-pong latency:",
+           static_cast<double>(sumNs) / static_cast<double>(latencyNs.size()) / 1000.0,
+           static_cast<double>(latencyNs[latencyNs.size() / 2U]) / 1000.0,
+           static_cast<double>(latencyNs[(latencyNs.size() * 99U) / 100U]) / 1000.0,
+           static_cast<double>(latencyNs.back()) / 1000.0);
+    printf("  %-28s %8.2f per event\n", "ping-pong context switches:", static_cast<double>(pingPongSwitches) / PINGPONG_ITERATIONS);
+    printf("  %-28s %8.3f us per event, %8.2f context switches and %8.2f handler calls per burst of %d\n",
+           "burst:",
+           burstUs / (BURST_ITERATIONS * BURST_SIZE),
+           static_cast<double>(burstSwitches) / BURST_ITERATIONS,
+           static_cast<double>(burstCalls) / BURST_ITERATIONS,
+           BURST_SIZE);
+    printf("  %-28s %8.3f us per emitEvent() call\n",
+           "producer cost:",
+           static_cast<double>(emitNs) / (BURST_ITERATIONS * BURST_SIZE) / 1000.0);
+
+    dispatcher->unregisterEventHandler(handlerID);
+    dispatcher->stop();
+}
+}  // namespace
+
+int main() {
+    printf("\nThis utility compares event wake-up latency and producer side cost of emitEvent() for HsmEventDispatcherSTD\n");
+    printf("and HsmEventDispatcherEpoll.\n");
+    printf("Use 'strace -f -c' to compare number of syscalls.\n");
+    printf("------------------------------------------------------------------\n\n");
+
+    {
+        std::shared_ptr<HsmEventDispatcherSTD> dispatcher = HsmEventDispatcherSTD::create();
+
+        runBenchmark("HsmEventDispatcherSTD", dispatcher);
+        dispatcher->join();
+    }
+
+    {
+        std::shared_ptr<HsmEventDispatcherSTD> dispatcher = HsmEventDispatcherSTD::create();
+
+        // dispatcher thread picks up events emitted within 50 us without blocking
+        dispatcher->setIdleSpinDuration(std::chrono::microseconds(50));
+        runBenchmark("HsmEventDispatcherSTD (idle spin 50 us)", dispatcher);
+        dispatcher->join();
+    }
+
+    {
+        std::shared_ptr<HsmEventDispatcherEpoll> dispatcher = HsmEventDispatcherEpoll::create();
+
+        runBenchmark("HsmEventDispatcherEpoll", dispatcher);
+        dispatcher->join();
+    }
+
+    return 0;
+}
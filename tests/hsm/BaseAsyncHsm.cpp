@@ -32,6 +32,11 @@ bool BaseAsyncHsm::waitAsyncOperation(const bool unblockNext) {
 }
 
 bool BaseAsyncHsm::waitAsyncOperation(const int timeoutMs, const bool unblockNext) {
+#if defined(TEST_HSM_MANUAL)
+    // NOTE: virtual clock of manual dispatcher doesn't move by itself, so timers have to be advanced while waiting
+    (void)advanceTimersUntil(std::chrono::milliseconds(timeoutMs), [&]() { return mSyncVariableCheck.load(); });
+#endif
+
     UniqueLock lck(mSyncLock);
     bool res = true;
 
@@ -56,6 +61,10 @@ void BaseAsyncHsm::unblockNextStep() {
     // printf("-----> notify done\n");
 }
 
+void BaseAsyncHsm::waitTimers(const std::chrono::microseconds& duration) {
+    ::waitTimers(duration, [&]() { return mSyncVariableCheck.load(); });
+}
+
 void BaseAsyncHsm::setSyncMode(const bool enable) {
     mEnableSyncMode = enable;
 }
\ No newline at end of file
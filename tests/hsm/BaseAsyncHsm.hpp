@@ -4,6 +4,7 @@
 #define HSMCPP_TESTS_HSM_BASEASYNCHSM_HPP
 
 #include <atomic>
+#include <chrono>
 
 #include "TestsCommon.hpp"
 #include "hsmcpp/os/ConditionVariable.hpp"
@@ -19,6 +20,8 @@ public:
     bool waitAsyncOperation(const bool unblockNext);
     bool waitAsyncOperation(const int timeoutMs, const bool unblockNext);
     void unblockNextStep();
+    // same as ::waitTimers(), but returns earlier if HSM callback is blocked in blockExecution()
+    void waitTimers(const std::chrono::microseconds& duration);
 
     void setSyncMode(const bool enable);
 
@@ -0,0 +1,14 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "TestsCommon.hpp"
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleMock(&argc, argv);
+    configureGTest("epoll");
+
+    int rc = RUN_ALL_TESTS();
+
+    // NOTE: return 0 to avoid stoppic CI action
+    return 0;
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 // Copyright (C) 2021 Igor Krechetov
 // Distributed under MIT license. See file LICENSE for details
+#include <atomic>
 #include <thread>
 
 #include "hsm/ABCHsm.hpp"
@@ -557,6 +558,133 @@ TEST_F(ABCHsm, transition_sync_deadlock) {
 }
 
 
+TEST_F(ABCHsm, transition_done_callback) {
+    TEST_DESCRIPTION("Completion callback must be called once with the result of processing the event");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    HsmEventStatus status = HsmEventStatus::PENDING;
+    int callbackCounter = 0;
+    VariantVector_t receivedArgs;
+
+    registerState(AbcState::A);
+    registerState(AbcState::B, [&](const VariantVector_t& args) { receivedArgs = args; });
+    registerState(AbcState::C, nullptr, [&](const VariantVector_t&) { return false; });
+    registerTransition(AbcState::A, AbcState::B, AbcEvent::E1);
+    registerTransition(AbcState::B, AbcState::C, AbcEvent::E2);
+
+    initializeHsm();
+    ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::A}));
+
+    auto onDone = [&](const HsmEventStatus result) {
+        status = result;
+        ++callbackCounter;
+        blockExecution("onDone");
+    };
+
+    //-------------------------------------------
+    // ACTIONS
+    // VALIDATION
+    transitionEx(AbcEvent::E1, false, onDone, 5, "test");
+    ASSERT_TRUE(waitAsyncOperation());
+    EXPECT_EQ(status, HsmEventStatus::DONE_OK);
+    ASSERT_EQ(receivedArgs.size(), 2);
+    EXPECT_EQ(receivedArgs[0].toInt64(), 5);
+    EXPECT_EQ(receivedArgs[1].toString(), "test");
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::B}));
+
+    // no transition for this event
+    transitionEx(AbcEvent::E1, false, onDone);
+    ASSERT_TRUE(waitAsyncOperation());
+    EXPECT_EQ(status, HsmEventStatus::DONE_FAILED);
+
+    // C::onEnter cancels transition
+    transitionEx(AbcEvent::E2, false, onDone);
+    ASSERT_TRUE(waitAsyncOperation());
+    EXPECT_EQ(status, HsmEventStatus::CANCELED);
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::B}));
+    EXPECT_EQ(callbackCounter, 3);
+}
+
+TEST_F(ABCHsm, transition_done_callback_entrypoint) {
+    TEST_DESCRIPTION("Completion callback must be called after entry point transitions were finished");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    HsmEventStatus status = HsmEventStatus::PENDING;
+    std::list<StateID_t> activeStates;
+
+    registerState(AbcState::A);
+    registerState(AbcState::B);
+    registerState(AbcState::P1);
+    registerSubstateEntryPoint(AbcState::P1, AbcState::B);
+    registerTransition(AbcState::A, AbcState::P1, AbcEvent::E1);
+
+    initializeHsm();
+
+    //-------------------------------------------
+    // ACTIONS
+    transitionEx(AbcEvent::E1, false, [&](const HsmEventStatus result) {
+        status = result;
+        activeStates = getActiveStates();
+        blockExecution("onDone");
+    });
+
+    //-------------------------------------------
+    // VALIDATION
+    ASSERT_TRUE(waitAsyncOperation());
+    EXPECT_EQ(status, HsmEventStatus::DONE_OK);
+    EXPECT_TRUE(compareStateLists(activeStates, {AbcState::P1, AbcState::B}));
+}
+
+TEST_F(ABCHsm, transition_done_callback_queue_clear) {
+    TEST_DESCRIPTION("Events removed from the queue must be reported as failed. Callback is allowed to send new events");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::atomic<int> droppedCounter(0);
+    std::atomic<bool> isBlocked(false);
+
+    registerState(AbcState::A);
+    registerState(AbcState::B, [&](const VariantVector_t& args) {
+        isBlocked = true;
+        blockExecution("onB");
+    });
+    registerState(AbcState::C);
+    registerTransition(AbcState::A, AbcState::B, AbcEvent::E1);
+    registerTransition(AbcState::B, AbcState::C, AbcEvent::E2);
+    registerTransition(AbcState::B, AbcState::A, AbcEvent::E3);
+
+    initializeHsm();
+
+    //-------------------------------------------
+    // ACTIONS
+    // keep dispatcher busy while queue is being modified
+    transition(AbcEvent::E1);
+    ASSERT_TRUE(waitAsyncOperation(false));
+    ASSERT_TRUE(isBlocked.load());
+
+    for (int i = 0; i < 3; ++i) {
+        transitionEx(AbcEvent::E3, false, [&](const HsmEventStatus result) {
+            if (HsmEventStatus::DONE_FAILED == result) {
+                ++droppedCounter;
+            }
+
+            // sending events from callback must not cause a deadlock
+            transition(AbcEvent::E2);
+        });
+    }
+
+    transitionWithQueueClear(AbcEvent::E2);
+    unblockNextStep();
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(droppedCounter.load(), 3);
+    EXPECT_FALSE(transitionSync(AbcEvent::INVALID, TIMEOUT_SYNC_TRANSITION));
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::C}));
+}
+
 // NOTE: test is obsolete with introduction of parallel feature
 // TEST_F(TrafficLightHsm, transition_conditional_multiple_valid)
 // {
@@ -5,6 +5,11 @@
   #include <signal.h>
 #endif
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 TEST_F(ABCHsm, multithreaded_entrypoint_cancelation) {
     TEST_DESCRIPTION("entrypoint transitions should be atomic and can't be canceled");
     /*
@@ -60,6 +65,290 @@ TEST_F(ABCHsm, multithreaded_entrypoint_cancelation) {
     ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::C}));
 }
 
+TEST_F(ABCHsm, multithreaded_concurrent_producers) {
+    TEST_DESCRIPTION("events sent from multiple threads must be processed exactly once and in the order they were "
+                     "sent by each thread");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int PRODUCERS_COUNT = 4;
+    constexpr int EVENTS_PER_PRODUCER = 500;
+    std::vector<int64_t> lastReceived(PRODUCERS_COUNT, -1);
+    std::atomic<int> processedEvents(0);
+    bool isOrdered = true;
+    std::vector<std::thread> producers;
+
+    auto onTransition = [&](const VariantVector_t& args) {
+        const int64_t producer = args[0].toInt64();
+        const int64_t index = args[1].toInt64();
+
+        isOrdered = isOrdered && (lastReceived[producer] + 1 == index);
+        lastReceived[producer] = index;
+        ++processedEvents;
+    };
+
+    registerState(AbcState::A);
+    registerState(AbcState::B);
+
+    registerTransition(AbcState::A, AbcState::B, AbcEvent::E1, onTransition);
+    registerTransition(AbcState::B, AbcState::A, AbcEvent::E1, onTransition);
+
+    initializeHsm();
+
+    //-------------------------------------------
+    // ACTIONS
+    for (int producer = 0; producer < PRODUCERS_COUNT; ++producer) {
+        producers.emplace_back([this, producer]() {
+            for (int i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+                transition(AbcEvent::E1, producer, i);
+            }
+        });
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    while ((processedEvents.load() < (PRODUCERS_COUNT * EVENTS_PER_PRODUCER)) &&
+           (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(processedEvents.load(), PRODUCERS_COUNT * EVENTS_PER_PRODUCER);
+    EXPECT_TRUE(isOrdered);
+    // even number of transitions
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::A}));
+}
+
+TEST_F(ABCHsm, multithreaded_wait_for_state) {
+    TEST_DESCRIPTION("thread waiting for a state must be woken up when state is activated");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    registerState(AbcState::A);
+    registerState(AbcState::B);
+    registerState(AbcState::C);
+    registerTransition(AbcState::A, AbcState::B, AbcEvent::E1);
+    registerTransition(AbcState::B, AbcState::C, AbcEvent::E2);
+
+    initializeHsm();
+
+    // state is already active
+    ASSERT_TRUE(waitForState(AbcState::A, HSM_WAIT_INDEFINITELY));
+
+    //-------------------------------------------
+    // ACTIONS
+    std::thread sender([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        transition(AbcEvent::E1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        transition(AbcEvent::E2);
+    });
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(waitForAnyState({AbcState::B, AbcState::C}, TIMEOUT_SYNC_TRANSITION));
+    EXPECT_TRUE(waitForState(AbcState::C, TIMEOUT_SYNC_TRANSITION));
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::C}));
+
+    sender.join();
+}
+
+TEST_F(ABCHsm, multithreaded_wait_for_state_timeout) {
+    TEST_DESCRIPTION("wait for a state must fail if state was not activated before timeout or HSM was released");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::atomic<bool> isWaiting(false);
+    std::atomic<bool> waitResult(true);
+
+    registerState(AbcState::A);
+    registerState(AbcState::B);
+    registerTransition(AbcState::A, AbcState::B, AbcEvent::E1);
+
+    initializeHsm();
+
+    //-------------------------------------------
+    // ACTIONS
+    // VALIDATION
+    const auto startedAt = std::chrono::steady_clock::now();
+
+    EXPECT_FALSE(waitForState(AbcState::B, 50));
+    EXPECT_GE(std::chrono::steady_clock::now() - startedAt, std::chrono::milliseconds(50));
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::A}));
+
+    std::thread waiter([&]() {
+        isWaiting = true;
+        waitResult = waitForState(AbcState::B, HSM_WAIT_INDEFINITELY);
+    });
+
+    while (false == isWaiting.load()) {
+        std::this_thread::yield();
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    release();
+    waiter.join();
+
+    EXPECT_FALSE(waitResult.load());
+}
+
+TEST_F(ABCHsm, multithreaded_wait_for_state_concurrent_transitions) {
+    TEST_DESCRIPTION("waiting threads must not access active states while HSM is changing them");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int TRANSITIONS_COUNT = 2000;
+    constexpr int WAITERS_COUNT = 4;
+    std::atomic<bool> isDone(false);
+    std::atomic<int> failedWaits(0);
+    std::vector<std::thread> waiters;
+
+    registerState(AbcState::A);
+    registerState(AbcState::B);
+    registerTransition(AbcState::A, AbcState::B, AbcEvent::E1);
+    registerTransition(AbcState::B, AbcState::A, AbcEvent::E2);
+
+    initializeHsm();
+    ASSERT_TRUE(waitForState(AbcState::A, TIMEOUT_SYNC_TRANSITION));
+
+    //-------------------------------------------
+    // ACTIONS
+    for (int i = 0; i < WAITERS_COUNT; ++i) {
+        waiters.emplace_back([&]() {
+            while (false == isDone.load()) {
+                // one of the states is always active, but waiter can be registered while HSM is between them
+                if (false == waitForAnyState({AbcState::A, AbcState::B}, TIMEOUT_SYNC_TRANSITION)) {
+                    ++failedWaits;
+                }
+
+                (void)waitForState(AbcState::B, 1);
+            }
+        });
+    }
+
+    for (int i = 0; i < TRANSITIONS_COUNT; ++i) {
+        transition((0 == (i % 2)) ? AbcEvent::E1 : AbcEvent::E2);
+    }
+
+    const bool lastTransitionDone = transitionEx(AbcEvent::E1, false, true, HSM_WAIT_INDEFINITELY);
+
+    isDone = true;
+
+    for (std::thread& waiter : waiters) {
+        waiter.join();
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(lastTransitionDone);
+    EXPECT_EQ(failedWaits.load(), 0);
+    EXPECT_TRUE(waitForState(AbcState::B, TIMEOUT_SYNC_TRANSITION));
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::B}));
+}
+
+TEST_F(ABCHsm, multithreaded_wait_for_state_many_active) {
+    TEST_DESCRIPTION("waiting thread must detect active states which don't fit into active states snapshot");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr StateID_t FIRST_NESTED_STATE = 100;
+    constexpr StateID_t NESTED_STATES_COUNT = HSM_ACTIVE_STATES_SNAPSHOT_CAPACITY + 4;
+    constexpr StateID_t LAST_NESTED_STATE = FIRST_NESTED_STATE + NESTED_STATES_COUNT - 1;
+    StateID_t parent = AbcState::A;
+    ActiveStatesSnapshot snapshot;
+
+    registerState(AbcState::A);
+
+    for (StateID_t state = FIRST_NESTED_STATE; state <= LAST_NESTED_STATE; ++state) {
+        registerState(state);
+        registerSubstateEntryPoint(parent, state);
+        parent = state;
+    }
+
+    //-------------------------------------------
+    // ACTIONS
+    initializeHsm();
+
+    //-------------------------------------------
+    // VALIDATION
+    // NOTE: last state is activated by entry point transition, so it's not active right after initialization
+    EXPECT_TRUE(waitForState(LAST_NESTED_STATE, TIMEOUT_SYNC_TRANSITION));
+    getActiveStatesSnapshot(snapshot);
+    EXPECT_EQ(snapshot.count, NESTED_STATES_COUNT + 1u);
+
+    // state is active, but isn't stored in the snapshot
+    EXPECT_TRUE(waitForState(LAST_NESTED_STATE, TIMEOUT_SYNC_TRANSITION));
+    EXPECT_TRUE(waitForAnyState({AbcState::B, LAST_NESTED_STATE}, TIMEOUT_SYNC_TRANSITION));
+    EXPECT_FALSE(waitForState(AbcState::B, 50));
+}
+
+TEST_F(ABCHsm, multithreaded_active_states_snapshot) {
+    TEST_DESCRIPTION("other threads must be able to read consistent active states while HSM is changing them");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int TRANSITIONS_COUNT = 1000;
+    std::atomic<bool> isDone(false);
+    std::atomic<int> invalidSnapshots(0);
+    ActiveStatesSnapshot snapshot;
+
+    registerState(AbcState::A);
+    registerState(AbcState::B);
+    registerTransition(AbcState::A, AbcState::B, AbcEvent::E1);
+    registerTransition(AbcState::B, AbcState::A, AbcEvent::E2);
+
+    initializeHsm();
+    ASSERT_TRUE(waitForState(AbcState::A, TIMEOUT_SYNC_TRANSITION));
+
+    getActiveStatesSnapshot(snapshot);
+    const uint32_t initialVersion = snapshot.version;
+
+    ASSERT_EQ(snapshot.count, 1u);
+    EXPECT_EQ(snapshot.states[0], AbcState::A);
+    EXPECT_EQ(getActiveStatesVersion(), initialVersion);
+
+    //-------------------------------------------
+    // ACTIONS
+    std::thread reader([&]() {
+        ActiveStatesSnapshot readerSnapshot;
+        uint32_t lastVersion = initialVersion;
+
+        while (false == isDone.load()) {
+            getActiveStatesSnapshot(readerSnapshot);
+
+            if ((1u != readerSnapshot.count) ||
+                ((AbcState::A != readerSnapshot.states[0]) && (AbcState::B != readerSnapshot.states[0])) ||
+                (readerSnapshot.version < lastVersion)) {
+                ++invalidSnapshots;
+            }
+
+            lastVersion = readerSnapshot.version;
+        }
+    });
+
+    for (int i = 0; i < TRANSITIONS_COUNT; ++i) {
+        transition((0 == (i % 2)) ? AbcEvent::E1 : AbcEvent::E2);
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    ASSERT_TRUE(transitionEx(AbcEvent::E1, false, true, TIMEOUT_SYNC_TRANSITION));
+    isDone = true;
+    reader.join();
+
+    EXPECT_EQ(invalidSnapshots.load(), 0);
+    getActiveStatesSnapshot(snapshot);
+    ASSERT_EQ(snapshot.count, 1u);
+    EXPECT_EQ(snapshot.states[0], AbcState::B);
+    EXPECT_EQ(snapshot.version, initialVersion + TRANSITIONS_COUNT + 1u);
+    EXPECT_EQ(getActiveStatesVersion(), snapshot.version);
+}
+
 // NOTE: Disable tests because we don't have signals on Windows platfroms
 #ifndef WIN32
 ABCHsm *gABCHsmInstance = nullptr;
@@ -233,3 +233,46 @@ TEST_F(ABCHsm, callbacks_initial_state) {
     EXPECT_EQ(mStateCounterA, 1);
     EXPECT_EQ(mStateCounterAEnter, 1);
 }
+
+TEST_F(ABCHsm, callbacks_sparse_state_ids) {
+    TEST_DESCRIPTION("callbacks should work for states with negative and large IDs");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const StateID_t stateNegative = -5;
+    const StateID_t stateLarge = 100000;
+    int counterNegativeExit = 0;
+    int counterLargeEnter = 0;
+    int counterLarge = 0;
+
+    registerState(AbcState::A);
+    registerState(stateNegative, nullptr, nullptr, [&]() {
+        ++counterNegativeExit;
+        return true;
+    });
+    registerState(
+        stateLarge,
+        [&](const VariantVector_t& args) { ++counterLarge; },
+        [&](const VariantVector_t& args) {
+            ++counterLargeEnter;
+            return true;
+        },
+        nullptr);
+
+    registerTransition(AbcState::A, stateNegative, AbcEvent::E1);
+    registerTransition(stateNegative, stateLarge, AbcEvent::E2);
+
+    initializeHsm();
+
+    //-------------------------------------------
+    // ACTIONS
+    ASSERT_TRUE(transitionSync(AbcEvent::E1, TIMEOUT_SYNC_TRANSITION));
+    ASSERT_TRUE(transitionSync(AbcEvent::E2, TIMEOUT_SYNC_TRANSITION));
+
+    //-------------------------------------------
+    // VALIDATION
+    ASSERT_TRUE(compareStateLists(getActiveStates(), {stateLarge}));
+    EXPECT_EQ(counterNegativeExit, 1);
+    EXPECT_EQ(counterLargeEnter, 1);
+    EXPECT_EQ(counterLarge, 1);
+}
@@ -172,7 +172,8 @@ TEST(dispatchers, stresstest_create_destroy_hsm_later) {
         // wait for HSM to enter state callback
         {
             std::unique_lock<std::mutex> lk(*syncState);
-            waitState->wait_for(lk, std::chrono::milliseconds(1000));
+            // NOTE: predicate is needed because callback could be executed before we start waiting
+            waitState->wait_for(lk, std::chrono::milliseconds(1000), [&]() { return (*pendingCallbackCounter > i); });
         }
 
         dispatcher->enqueueAction([hsm, iterationsCount, &objectsDeleted, &waitCleanup](){
@@ -34,7 +34,7 @@ TEST_F(ABCHsm, timers_onentry) {
 
     //-------------------------------------------
     // ACTIONS
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration + 50));
+    waitTimers(std::chrono::milliseconds(timer1Duration + 50));
 
     //-------------------------------------------
     // VALIDATION
@@ -83,7 +83,7 @@ TEST_F(ABCHsm, timers_onexit) {
 
     //-------------------------------------------
     // ACTIONS
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration + 50));
+    waitTimers(std::chrono::milliseconds(timer1Duration + 50));
 
     //-------------------------------------------
     // VALIDATION
@@ -147,14 +147,14 @@ TEST_F(ABCHsm, timers_multiple_actions) {
 
     //-------------------------------------------
     // ACTIONS
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration));
+    waitTimers(std::chrono::milliseconds(timer1Duration));
     ASSERT_TRUE(waitAsyncOperation(50, false));// wait for C to activate and block HSM
     ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::C}));
     unblockNextStep();// allow HSM to continue
 
     ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::C}));
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer2Duration - timer1Duration));
+    waitTimers(std::chrono::milliseconds(timer2Duration - timer1Duration));
     ASSERT_TRUE(waitAsyncOperation(50, true));// wait for D to activate
 
     //-------------------------------------------
@@ -191,7 +191,7 @@ TEST_F(ABCHsm, timers_singleshot) {
 
     //-------------------------------------------
     // ACTIONS
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration + 50));
+    waitTimers(std::chrono::milliseconds(timer1Duration + 50));
 
     //-------------------------------------------
     // VALIDATION
@@ -230,7 +230,7 @@ TEST_F(ABCHsm, timers_repeating) {
     //-------------------------------------------
     // ACTIONS
     // timer will expire 2-3 times depending on thread scheduling
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration * 2 + 50));
+    waitTimers(std::chrono::milliseconds(timer1Duration * 2 + 50));
 
     //-------------------------------------------
     // VALIDATION
@@ -294,12 +294,12 @@ TEST_F(ABCHsm, timers_repeating_delay) {
     registerTransition<ABCHsm>(AbcState::A, AbcState::B, AbcEvent::E1);
     registerSelfTransition(AbcState::B, AbcEvent::E2, hsmcpp::TransitionType::INTERNAL_TRANSITION,
         [&](const VariantVector_t& args){
-            const auto eventTriggerTime = std::chrono::steady_clock::now();
+            const auto eventTriggerTime = timersNow();
             const int iterationDuration = std::chrono::duration_cast<std::chrono::milliseconds>(eventTriggerTime - timerStartTime).count();
 
             // NOTE: this is not precise since timer event is dispatched on a different thread.
             //       so need to account for iterationDuration being reduced by 1-2ms
-            timerStartTime = std::chrono::steady_clock::now();
+            timerStartTime = timersNow();
 
             // This measurement is not precise so need to count for operational costs
             if ((iterationDuration >= (timer1Duration - 5)) && (iterationDuration <= (timer1Duration + 5))) {
@@ -320,13 +320,13 @@ TEST_F(ABCHsm, timers_repeating_delay) {
     initializeHsm();
 
     ASSERT_TRUE(transitionSync(AbcEvent::E1, TIMEOUT_SYNC_TRANSITION));
-    timerStartTime = std::chrono::steady_clock::now();
+    timerStartTime = timersNow();
     ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::B}));
 
     //-------------------------------------------
     // ACTIONS
     // timer will expire 2-3 times depending on thread scheduling
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration * timer1Repeat + static_cast<int>(timer1Duration * 0.5)));
+    waitTimers(std::chrono::milliseconds(timer1Duration * timer1Repeat + static_cast<int>(timer1Duration * 0.5)));
 
     //-------------------------------------------
     // VALIDATION
@@ -450,16 +450,16 @@ TEST_F(ABCHsm, timers_restart) {
 
     //-------------------------------------------
     // ACTIONS
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer2Duration + 50));
+    waitTimers(std::chrono::milliseconds(timer2Duration + 50));
     ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::C}));
 
     // elapsed 250ms. at this point timer1 should have 350ms left if it hasn't been restarted. let's wait for 400ms to check
     // that
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration - timer2Duration));
+    waitTimers(std::chrono::milliseconds(timer1Duration - timer2Duration));
     ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::C}));
 
     // wait for remaining time
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer2Duration + 50));
+    waitTimers(std::chrono::milliseconds(timer2Duration + 50));
 
     //-------------------------------------------
     // VALIDATION
@@ -496,7 +496,7 @@ TEST_F(ABCHsm, timers_delete_running) {
 
     //-------------------------------------------
     // ACTIONS
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration + 20));
+    waitTimers(std::chrono::milliseconds(timer1Duration + 20));
 
     //-------------------------------------------
     // VALIDATION
@@ -523,7 +523,7 @@ TEST_F(ABCHsm, timers_start_from_code) {
     //-------------------------------------------
     // ACTIONS
     startTimer(timer1, timer1Duration, true);
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration + 50));
+    waitTimers(std::chrono::milliseconds(timer1Duration + 50));
 
     //-------------------------------------------
     // VALIDATION
@@ -531,6 +531,142 @@ TEST_F(ABCHsm, timers_start_from_code) {
     EXPECT_EQ(mStateCounterB, 1);
 }
 
+TEST_F(ABCHsm, timers_same_id_shared_dispatcher) {
+    TEST_DESCRIPTION("HSMs which share a dispatcher must be able to use the same timer IDs");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const TimerID_t timer1 = 0;
+    const int timer1Duration = 100;
+    HierarchicalStateMachine otherHsm(AbcState::A);
+
+    registerState<ABCHsm>(AbcState::A);
+    registerState<ABCHsm>(AbcState::B, this, &ABCHsm::onB);
+    registerTransition<ABCHsm>(AbcState::A, AbcState::B, AbcEvent::E1);
+    registerTimer(timer1, AbcEvent::E1);
+    initializeHsm();
+
+    otherHsm.registerState(AbcState::A);
+    otherHsm.registerState(AbcState::B);
+    otherHsm.registerTransition(AbcState::A, AbcState::B, AbcEvent::E1);
+    otherHsm.registerTimer(timer1, AbcEvent::E1);
+    ASSERT_TRUE(executeOnMainThread([&]() { return otherHsm.initialize(gDispatcher); }));
+
+    //-------------------------------------------
+    // ACTIONS
+    startTimer(timer1, timer1Duration, true);
+    otherHsm.startTimer(timer1, timer1Duration, true);
+    ASSERT_TRUE(otherHsm.isTimerRunning(timer1));
+
+    // stopping timer of one HSM must not affect timer with the same ID of another HSM
+    otherHsm.stopTimer(timer1);
+    EXPECT_FALSE(otherHsm.isTimerRunning(timer1));
+    EXPECT_TRUE(isTimerRunning(timer1));
+
+    waitTimers(std::chrono::milliseconds(timer1Duration + 50));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::B}));
+    EXPECT_EQ(mStateCounterB, 1);
+    EXPECT_TRUE(compareStateLists(otherHsm.getActiveStates(), {AbcState::A}));
+
+    otherHsm.release();
+}
+
+TEST_F(ABCHsm, timers_start_chrono_interval) {
+    TEST_DESCRIPTION("Validate support for starting timers with std::chrono durations");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const TimerID_t timer1 = 12;
+    const auto timer1Duration = std::chrono::microseconds(100500);
+
+    registerState<ABCHsm>(AbcState::A);
+    registerState<ABCHsm>(AbcState::B, this, &ABCHsm::onB);
+
+    registerTransition<ABCHsm>(AbcState::A, AbcState::B, AbcEvent::E1);
+
+    registerTimer(timer1, AbcEvent::E1);
+    initializeHsm();
+    ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::A}));
+
+    //-------------------------------------------
+    // ACTIONS
+    startTimer(timer1, timer1Duration, true);
+    waitTimers(std::chrono::milliseconds(60));
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::A}));
+    waitTimers(timer1Duration);
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::B}));
+    EXPECT_EQ(mStateCounterB, 1);
+}
+
+TEST_F(ABCHsm, timers_start_with_slack) {
+    TEST_DESCRIPTION("Coarse timer must not expire earlier than requested and not later than allowed by its slack");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const TimerID_t timer1 = 12;
+    const int timer1Duration = 100;
+    const int timer1Slack = 50;
+
+    registerState<ABCHsm>(AbcState::A);
+    registerState<ABCHsm>(AbcState::B, this, &ABCHsm::onB);
+
+    registerTransition<ABCHsm>(AbcState::A, AbcState::B, AbcEvent::E1);
+
+    registerTimer(timer1, AbcEvent::E1);
+    initializeHsm();
+    ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::A}));
+
+    //-------------------------------------------
+    // ACTIONS
+    startTimerWithSlack(timer1, timer1Duration, timer1Slack, true);
+    waitTimers(std::chrono::milliseconds(timer1Duration - 40));
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::A}));
+    waitTimers(std::chrono::milliseconds(40 + timer1Slack + 50));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(compareStateLists(getActiveStates(), {AbcState::B}));
+    EXPECT_EQ(mStateCounterB, 1);
+}
+
+TEST_F(ABCHsm, timers_start_with_slack_full_second) {
+    TEST_DESCRIPTION("Coarse timer with slack equal to its interval must never expire earlier than its interval");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const TimerID_t timer1 = 13;
+    const int timer1Duration = 1000;
+    const int timer1Slack = 1000;
+    std::chrono::steady_clock::time_point expiredAt;
+
+    registerState<ABCHsm>(AbcState::A);
+    registerState(AbcState::B, [&](const VariantVector_t&) { expiredAt = timersNow(); });
+
+    registerTransition<ABCHsm>(AbcState::A, AbcState::B, AbcEvent::E1);
+
+    registerTimer(timer1, AbcEvent::E1);
+    initializeHsm();
+    ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::A}));
+
+    //-------------------------------------------
+    // ACTIONS
+    const auto startedAt = timersNow();
+
+    startTimerWithSlack(timer1, timer1Duration, timer1Slack, true);
+
+    //-------------------------------------------
+    // VALIDATION
+    waitTimers(std::chrono::milliseconds(timer1Duration + timer1Slack));
+    ASSERT_TRUE(waitForState(AbcState::B, 500));
+    EXPECT_GE(expiredAt - startedAt, std::chrono::milliseconds(timer1Duration));
+}
+
 TEST_F(ABCHsm, timers_start_higher_priority) {
     TEST_DESCRIPTION("If during a running timer a new timer with a shorter elapse period is started HSM should "
                      "correctly schedule it");
@@ -586,9 +722,9 @@ TEST_F(ABCHsm, timers_start_higher_priority) {
     // ACTIONS
     startTimer(timerLong, timerLongDuration, true);
     // wait a bit
-    std::this_thread::sleep_for(std::chrono::milliseconds(timerShortDuration));
+    waitTimers(std::chrono::milliseconds(timerShortDuration));
     startTimer(timerShort, timerShortDuration, true);
-    std::this_thread::sleep_for(std::chrono::milliseconds(timerLongDuration + 50));
+    waitTimers(std::chrono::milliseconds(timerLongDuration + 50));
 
     //-------------------------------------------
     // VALIDATION
@@ -618,9 +754,9 @@ TEST_F(ABCHsm, timers_stop_from_code) {
     //-------------------------------------------
     // ACTIONS
     startTimer(timer1, timer1Duration, true);
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration / 2));
+    waitTimers(std::chrono::milliseconds(timer1Duration / 2));
     stopTimer(timer1);
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration));
+    waitTimers(std::chrono::milliseconds(timer1Duration));
 
     //-------------------------------------------
     // VALIDATION
@@ -648,11 +784,11 @@ TEST_F(ABCHsm, timers_restart_from_code) {
     //-------------------------------------------
     // ACTIONS
     startTimer(timer1, timer1Duration, true);
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration / 2));
+    waitTimers(std::chrono::milliseconds(timer1Duration / 2));
     restartTimer(timer1);
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration / 2 + 10));
+    waitTimers(std::chrono::milliseconds(timer1Duration / 2 + 10));
     ASSERT_TRUE(compareStateLists(getActiveStates(), {AbcState::A}));
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration / 2));
+    waitTimers(std::chrono::milliseconds(timer1Duration / 2));
 
     //-------------------------------------------
     // VALIDATION
@@ -713,7 +849,7 @@ TEST_F(ABCHsm, timers_singleshot_is_running) {
     // ACTIONS
     startTimer(timer1, timer1Duration1, true);
     ASSERT_TRUE(isTimerRunning(timer1));
-    std::this_thread::sleep_for(std::chrono::milliseconds(timer1Duration1 * 2));
+    waitTimers(std::chrono::milliseconds(timer1Duration1 * 2));
     ASSERT_FALSE(isTimerRunning(timer1));
 
     //-------------------------------------------
@@ -139,3 +139,24 @@ TEST_F(ABCHsm, state_actions_args) {
     ASSERT_EQ(mArgsC[0].toInt64(), 123);
     ASSERT_EQ(mArgsC[1].toString(), "string arg");
 }
+
+TEST_F(ABCHsm, state_actions_invalid_args) {
+    TEST_DESCRIPTION("state actions with invalid arguments must be rejected during registration");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    registerState<ABCHsm>(AbcState::A);
+
+    //-------------------------------------------
+    // ACTIONS / VALIDATION
+    EXPECT_FALSE(registerStateAction(AbcState::A, StateActionTrigger::ON_STATE_ENTRY, StateAction::START_TIMER, 1, 100));
+    EXPECT_FALSE(registerStateAction(AbcState::A, StateActionTrigger::ON_STATE_ENTRY, StateAction::START_TIMER, 1, 100, 7));
+    EXPECT_FALSE(registerStateAction(AbcState::A, StateActionTrigger::ON_STATE_ENTRY, StateAction::STOP_TIMER, "timer"));
+    EXPECT_FALSE(registerStateAction(AbcState::A, StateActionTrigger::ON_STATE_EXIT, StateAction::RESTART_TIMER));
+    EXPECT_FALSE(registerStateAction(AbcState::A, StateActionTrigger::ON_STATE_EXIT, StateAction::TRANSITION, "event"));
+
+    EXPECT_TRUE(registerStateAction(AbcState::A, StateActionTrigger::ON_STATE_ENTRY, StateAction::START_TIMER, 1, 100, true));
+    EXPECT_TRUE(registerStateAction(AbcState::A, StateActionTrigger::ON_STATE_EXIT, StateAction::STOP_TIMER, 1));
+    EXPECT_TRUE(registerStateAction(AbcState::A, StateActionTrigger::ON_STATE_EXIT, StateAction::RESTART_TIMER, 1));
+    EXPECT_TRUE(registerStateAction(AbcState::A, StateActionTrigger::ON_STATE_EXIT, StateAction::TRANSITION, 1, "arg"));
+}
@@ -0,0 +1,216 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#include "TestsCommon.hpp"
+#include "hsm/ABCHsm.hpp"
+#include "hsmcpp/hsm.hpp"
+
+class SessionHsm : public HierarchicalStateMachine {
+public:
+    SessionHsm()
+        : HierarchicalStateMachine(AbcState::A) {
+        setUserContext(this);
+
+        registerState<SessionHsm>(AbcState::A, this, &SessionHsm::onA);
+        registerState<SessionHsm>(AbcState::B, this, &SessionHsm::onB, &SessionHsm::onEnteringB);
+        registerState(AbcState::C);
+        registerState(AbcState::D);
+        registerState(AbcState::F);
+        registerSubstateEntryPoint(AbcState::C, AbcState::D);
+        registerSubstate(AbcState::C, AbcState::F);
+        registerHistory(AbcState::C, AbcState::E);
+
+        registerTransition<SessionHsm>(AbcState::A, AbcState::B, AbcEvent::E1, this, &SessionHsm::onTransitionAB);
+        registerTransition<SessionHsm>(AbcState::B,
+                                       AbcState::C,
+                                       AbcEvent::E1,
+                                       this,
+                                       nullptr,
+                                       &SessionHsm::checkCondition);
+        registerTransition(AbcState::C, AbcState::A, AbcEvent::E2);
+        registerTransition(AbcState::D, AbcState::F, AbcEvent::E4);
+        registerTransition(AbcState::A, AbcState::E, AbcEvent::E3);
+    }
+
+    explicit SessionHsm(const std::shared_ptr<const HsmDefinition>& definition)
+        : HierarchicalStateMachine(definition) {
+        setUserContext(this);
+    }
+
+    virtual ~SessionHsm() = default;
+
+    void onA(const VariantVector_t& args) {
+        ++mCounterA;
+    }
+
+    void onB(const VariantVector_t& args) {
+        ++mCounterB;
+    }
+
+    bool onEnteringB(const VariantVector_t& args) {
+        ++mCounterEnteringB;
+        return true;
+    }
+
+    void onTransitionAB(const VariantVector_t& args) {
+        ++mCounterTransitionAB;
+    }
+
+    bool checkCondition(const VariantVector_t& args) {
+        ++mCounterCondition;
+        return mConditionValue;
+    }
+
+    bool initializeHsm() {
+        return executeOnMainThread([&]() {
+            if (!gDispatcher) {
+                gDispatcher = std::static_pointer_cast<hsmcpp::IHsmEventDispatcher>(CREATE_DISPATCHER());
+            }
+
+            return initialize(gDispatcher);
+        });
+    }
+
+public:
+    int mCounterA = 0;
+    int mCounterB = 0;
+    int mCounterEnteringB = 0;
+    int mCounterTransitionAB = 0;
+    int mCounterCondition = 0;
+    bool mConditionValue = true;
+};
+
+TEST(shared_definition, callbacks_use_context) {
+    TEST_DESCRIPTION("HSM instances created from the same definition must execute callbacks for their own context");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    SessionHsm prototype;
+    SessionHsm instance1(prototype.getDefinition());
+    SessionHsm instance2(prototype.getDefinition());
+
+    instance2.mConditionValue = false;
+
+    ASSERT_TRUE(instance1.initializeHsm());
+    ASSERT_TRUE(instance2.initializeHsm());
+
+    //-------------------------------------------
+    // ACTIONS
+    ASSERT_TRUE(instance1.transitionSync(AbcEvent::E1, TIMEOUT_SYNC_TRANSITION));
+    ASSERT_TRUE(instance1.transitionSync(AbcEvent::E1, TIMEOUT_SYNC_TRANSITION));
+    ASSERT_TRUE(instance2.transitionSync(AbcEvent::E1, TIMEOUT_SYNC_TRANSITION));
+    ASSERT_FALSE(instance2.transitionSync(AbcEvent::E1, TIMEOUT_SYNC_TRANSITION));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(prototype.getDefinition(), instance1.getDefinition());
+    EXPECT_EQ(instance1.getUserContext(), &instance1);
+
+    EXPECT_TRUE(compareStateLists(instance1.getActiveStates(), {AbcState::C, AbcState::D}));
+    EXPECT_TRUE(compareStateLists(instance2.getActiveStates(), {AbcState::B}));
+
+    EXPECT_EQ(prototype.mCounterA, 0);
+    EXPECT_EQ(prototype.mCounterB, 0);
+    EXPECT_EQ(prototype.mCounterTransitionAB, 0);
+    EXPECT_EQ(prototype.mCounterCondition, 0);
+
+    EXPECT_EQ(instance1.mCounterA, 1);
+    EXPECT_EQ(instance1.mCounterEnteringB, 1);
+    EXPECT_EQ(instance1.mCounterB, 1);
+    EXPECT_EQ(instance1.mCounterTransitionAB, 1);
+    EXPECT_EQ(instance1.mCounterCondition, 1);
+
+    EXPECT_EQ(instance2.mCounterA, 1);
+    EXPECT_EQ(instance2.mCounterEnteringB, 1);
+    EXPECT_EQ(instance2.mCounterB, 1);
+    EXPECT_EQ(instance2.mCounterTransitionAB, 1);
+    EXPECT_EQ(instance2.mCounterCondition, 1);
+}
+
+TEST(shared_definition, history_per_instance) {
+    TEST_DESCRIPTION("history of HSM instances which share definition must be independent");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    SessionHsm prototype;
+    SessionHsm instance1(prototype.getDefinition());
+    SessionHsm instance2(prototype.getDefinition());
+
+    ASSERT_TRUE(instance1.initializeHsm());
+    ASSERT_TRUE(instance2.initializeHsm());
+
+    //-------------------------------------------
+    // ACTIONS
+    // instance1: A -> B -> C/D -> C/F -> A, history of C contains F
+    ASSERT_TRUE(instance1.transitionSync(AbcEvent::E1, TIMEOUT_SYNC_TRANSITION));
+    ASSERT_TRUE(instance1.transitionSync(AbcEvent::E1, TIMEOUT_SYNC_TRANSITION));
+    ASSERT_TRUE(instance1.transitionSync(AbcEvent::E4, TIMEOUT_SYNC_TRANSITION));
+    ASSERT_TRUE(instance1.transitionSync(AbcEvent::E2, TIMEOUT_SYNC_TRANSITION));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(compareStateLists(instance1.getActiveStates(), {AbcState::A}));
+    EXPECT_TRUE(compareStateLists(instance2.getActiveStates(), {AbcState::A}));
+
+    // instance2 has empty history and should use parent entry point
+    ASSERT_TRUE(instance2.transitionSync(AbcEvent::E3, TIMEOUT_SYNC_TRANSITION));
+    EXPECT_TRUE(compareStateLists(instance2.getActiveStates(), {AbcState::C, AbcState::D}));
+
+    ASSERT_TRUE(instance1.transitionSync(AbcEvent::E3, TIMEOUT_SYNC_TRANSITION));
+    EXPECT_TRUE(compareStateLists(instance1.getActiveStates(), {AbcState::C, AbcState::F}));
+}
+
+TEST(shared_definition, copy_on_write) {
+    TEST_DESCRIPTION("modifying structure of HSM instance must not affect other instances which share the definition");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    SessionHsm prototype;
+    SessionHsm instance1(prototype.getDefinition());
+    SessionHsm instance2(prototype.getDefinition());
+
+    //-------------------------------------------
+    // ACTIONS
+    instance2.registerTransition(AbcState::A, AbcState::H, AbcEvent::E2);
+    instance2.registerState(AbcState::H);
+
+    ASSERT_TRUE(instance1.initializeHsm());
+    ASSERT_TRUE(instance2.initializeHsm());
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(prototype.getDefinition(), instance1.getDefinition());
+    EXPECT_NE(prototype.getDefinition(), instance2.getDefinition());
+
+    EXPECT_FALSE(instance1.transitionSync(AbcEvent::E2, TIMEOUT_SYNC_TRANSITION));
+    EXPECT_TRUE(instance2.transitionSync(AbcEvent::E2, TIMEOUT_SYNC_TRANSITION));
+
+    EXPECT_TRUE(compareStateLists(instance1.getActiveStates(), {AbcState::A}));
+    EXPECT_TRUE(compareStateLists(instance2.getActiveStates(), {AbcState::H}));
+}
+
+TEST(shared_definition, reset_context) {
+    TEST_DESCRIPTION("callbacks must be executed for the original handler after user context was reset");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    SessionHsm prototype;
+    SessionHsm instance(prototype.getDefinition());
+
+    //-------------------------------------------
+    // ACTIONS
+    instance.setUserContext(nullptr);
+
+    ASSERT_TRUE(instance.initializeHsm());
+    ASSERT_TRUE(instance.transitionSync(AbcEvent::E1, TIMEOUT_SYNC_TRANSITION));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(instance.getUserContext(), nullptr);
+    EXPECT_TRUE(compareStateLists(instance.getActiveStates(), {AbcState::B}));
+
+    EXPECT_EQ(prototype.mCounterTransitionAB, 1);
+    EXPECT_EQ(prototype.mCounterEnteringB, 1);
+    EXPECT_EQ(prototype.mCounterB, 1);
+    EXPECT_EQ(instance.mCounterTransitionAB, 0);
+    EXPECT_EQ(instance.mCounterB, 0);
+}
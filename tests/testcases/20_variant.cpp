@@ -3,6 +3,7 @@
 #include "TestsCommon.hpp"
 #include "hsmcpp/variant.hpp"
 #include <inttypes.h>
+#include <sstream>
 
 constexpr int gIndexValue = 0;
 constexpr int gIndexValueLess = 1;
@@ -1069,6 +1070,174 @@ TEST(variant, compare_self) {
     ASSERT_EQ(v, v);
 }
 
+TEST(variant, compare_three_way) {
+    TEST_DESCRIPTION("validate that compare() returns consistent results for same and different types");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+
+    //-------------------------------------------
+    // ACTIONS
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(Variant(int8_t(7)).compare(Variant(uint32_t(7))), 0);
+    EXPECT_EQ(Variant(double(7.0)).compare(Variant(int64_t(7))), 0);
+    EXPECT_EQ(Variant(int16_t(3)).compare(Variant(double(3.5))), -1);
+    EXPECT_EQ(Variant(double(3.5)).compare(Variant(int16_t(3))), 1);
+    EXPECT_EQ(Variant("abc").compare(Variant("abd")), -1);
+    EXPECT_EQ(Variant("abd").compare(Variant("abc")), 1);
+    EXPECT_EQ(Variant().compare(Variant()), 0);
+    EXPECT_EQ(Variant().compare(Variant(1)), -1);
+    EXPECT_EQ(Variant(1).compare(Variant()), 1);
+
+    // different non-numeric types must have a strict ordering
+    Variant vString("7");
+    Variant vBool(true);
+
+    EXPECT_NE(vString.compare(vBool), 0);
+    EXPECT_EQ(vString.compare(vBool), -vBool.compare(vString));
+    EXPECT_NE(vString < vBool, vBool < vString);
+}
+
+TEST(variant, hash) {
+    TEST_DESCRIPTION("validate that equal variants have the same hash");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::hash<Variant> hasher;
+
+    //-------------------------------------------
+    // ACTIONS
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(hasher(Variant(int8_t(7))), hasher(Variant(uint64_t(7))));
+    EXPECT_EQ(hasher(Variant(int32_t(7))), hasher(Variant(double(7.0))));
+    EXPECT_EQ(hasher(Variant(int32_t(-5))), hasher(Variant(double(-5.0))));
+    EXPECT_EQ(hasher(Variant("abc")), hasher(Variant(std::string("abc"))));
+    EXPECT_EQ(hasher(Variant(listInt)), hasher(Variant(listInt)));
+    EXPECT_EQ(hasher(Variant(mapIntStr)), hasher(Variant(mapIntStr)));
+    EXPECT_EQ(hasher(Variant()), hasher(Variant()));
+
+    EXPECT_NE(hasher(Variant("abc")), hasher(Variant("abd")));
+    EXPECT_NE(hasher(Variant(int32_t(7))), hasher(Variant(int32_t(8))));
+}
+
+TEST(variant, unordered_map) {
+    TEST_DESCRIPTION("validate that Variant can be used as a key in unordered containers");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    VariantHashMap_t table;
+
+    //-------------------------------------------
+    // ACTIONS
+    table[Variant(int32_t(1))] = Variant("one");
+    table[Variant("two")] = Variant(int32_t(2));
+    table[Variant(double(3.0))] = Variant("three");
+    table[Variant(uint8_t(1))] = Variant("ONE");
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(table.size(), 3);
+    EXPECT_EQ(table[Variant(int64_t(1))], Variant("ONE"));
+    EXPECT_EQ(table[Variant("two")], Variant(int32_t(2)));
+    EXPECT_EQ(table[Variant(uint16_t(3))], Variant("three"));
+    EXPECT_EQ(table.count(Variant("four")), 0);
+}
+
+TEST(variant, format) {
+    TEST_DESCRIPTION("validate that format() produces the same output as toString()");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    VariantVector_t values;
+    char buffer[256];
+
+    makeVariantList(values, i8, i16, i32, i64, ui8, ui16, ui32, ui64, d, b, s1, s2, listInt, vectorBool, mapIntStr);
+    values.push_back(Variant::make(s1, i32));
+
+    for (const Variant& v : values) {
+        //-------------------------------------------
+        // ACTIONS
+        std::ostringstream stream;
+        const size_t bufferLen = v.format(buffer, sizeof(buffer));
+        const size_t streamLen = v.format(stream);
+
+        //-------------------------------------------
+        // VALIDATION
+        EXPECT_STREQ(buffer, v.toString().c_str());
+        EXPECT_EQ(bufferLen, v.toString().size());
+        EXPECT_EQ(stream.str(), v.toString());
+        EXPECT_EQ(streamLen, v.toString().size());
+    }
+}
+
+TEST(variant, format_truncate) {
+    TEST_DESCRIPTION("validate that format() truncates output which doesn't fit into the limit");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::vector<int> bigVector(100000, 7);
+    Variant v(Variant::make(bigVector));
+    char buffer[11];
+    std::ostringstream stream;
+    std::ostringstream streamExact;
+
+    //-------------------------------------------
+    // ACTIONS
+    const size_t bufferLen = v.format(buffer, sizeof(buffer));
+    const size_t streamLen = v.format(stream, 10);
+    const size_t streamExactLen = Variant("1234567890").format(streamExact, 10);
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_STREQ(buffer, "7, 7, 7...");
+    EXPECT_EQ(bufferLen, 10);
+    EXPECT_EQ(stream.str(), "7, 7, 7...");
+    EXPECT_EQ(streamLen, 10);
+    EXPECT_EQ(streamExact.str(), "1234567890");
+    EXPECT_EQ(streamExactLen, 10);
+
+    EXPECT_EQ(Variant("abc").format(buffer, 1), 0);
+    EXPECT_STREQ(buffer, "");
+    EXPECT_EQ(Variant("abc").format(buffer, 3), 2);
+    EXPECT_STREQ(buffer, "..");
+}
+
+TEST(variant, format_large_double) {
+    TEST_DESCRIPTION("validate that format() doesn't truncate doubles with long string representation");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const std::vector<double> values = {1e40, -1.7976931348623157e308};
+    char buffer[512];
+
+    for (const double value : values) {
+        const Variant v(value);
+        std::ostringstream stream;
+
+        //-------------------------------------------
+        // ACTIONS
+        const size_t bufferLen = v.format(buffer, sizeof(buffer));
+        const size_t streamLen = v.format(stream);
+
+        //-------------------------------------------
+        // VALIDATION
+        EXPECT_EQ(v.toString(), std::to_string(value));
+        EXPECT_STREQ(buffer, std::to_string(value).c_str());
+        EXPECT_EQ(bufferLen, std::to_string(value).size());
+        EXPECT_EQ(stream.str(), std::to_string(value));
+        EXPECT_EQ(streamLen, std::to_string(value).size());
+    }
+
+    std::ostringstream limitedStream;
+
+    EXPECT_EQ(Variant(1e40).format(limitedStream, 10), 10);
+    EXPECT_EQ(limitedStream.str(), "1000000...");
+}
+
 TEST_P(FixtureVariantTypeConversion, convert) {
     TEST_DESCRIPTION("Variant should support type conversions");
 
@@ -0,0 +1,405 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#include "TestsCommon.hpp"
+#include "hsmcpp/HsmTimerQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST(timer_queue, order) {
+    TEST_DESCRIPTION("timers must be returned in order of their deadlines");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    HsmTimerQueue queue;
+    const auto now = HsmTimerQueue::Clock_t::now();
+
+    //-------------------------------------------
+    // ACTIONS
+    queue.schedule(1, now + std::chrono::milliseconds(30));
+    queue.schedule(2, now + std::chrono::milliseconds(10));
+    queue.schedule(3, now + std::chrono::milliseconds(20));
+    queue.schedule(4, now + std::chrono::milliseconds(10));
+
+    //-------------------------------------------
+    // VALIDATION
+    ASSERT_EQ(queue.size(), 4U);
+    EXPECT_EQ(queue.topDeadline(), now + std::chrono::milliseconds(10));
+
+    // timers with equal deadlines are returned in order they were scheduled
+    EXPECT_EQ(queue.top(), 2);
+    queue.pop();
+    EXPECT_EQ(queue.top(), 4);
+    queue.pop();
+    EXPECT_EQ(queue.top(), 3);
+    queue.pop();
+    EXPECT_EQ(queue.top(), 1);
+    queue.pop();
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.top(), INVALID_HSM_TIMER_ID);
+    EXPECT_EQ(queue.topDeadline(), HsmTimerQueue::TimePoint_t::max());
+}
+
+TEST(timer_queue, reschedule_and_remove) {
+    TEST_DESCRIPTION("rescheduling and removing timers must keep the queue ordered");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    HsmTimerQueue queue;
+    const auto now = HsmTimerQueue::Clock_t::now();
+
+    queue.schedule(1, now + std::chrono::milliseconds(10));
+    queue.schedule(2, now + std::chrono::milliseconds(20));
+    queue.schedule(3, now + std::chrono::milliseconds(30));
+
+    //-------------------------------------------
+    // ACTIONS
+    queue.schedule(1, now + std::chrono::milliseconds(40));
+    EXPECT_TRUE(queue.remove(2));
+    EXPECT_FALSE(queue.remove(2));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(queue.size(), 2U);
+    EXPECT_FALSE(queue.contains(2));
+    EXPECT_TRUE(queue.contains(1));
+    EXPECT_EQ(queue.top(), 3);
+    queue.pop();
+    EXPECT_EQ(queue.top(), 1);
+    EXPECT_EQ(queue.topDeadline(), now + std::chrono::milliseconds(40));
+}
+
+TEST(timer_queue, postpone) {
+    TEST_DESCRIPTION("postponed timer must keep its position until the old deadline and expire at the new one");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    HsmTimerQueue queue;
+    HsmTimerQueue::Expiration_t expiration;
+    const auto now = HsmTimerQueue::Clock_t::now();
+
+    queue.schedule(1, now + std::chrono::milliseconds(10));
+    queue.schedule(2, now + std::chrono::milliseconds(20));
+
+    //-------------------------------------------
+    // ACTIONS
+    EXPECT_TRUE(queue.postpone(1, now + std::chrono::milliseconds(30)));
+    EXPECT_FALSE(queue.postpone(1, now + std::chrono::milliseconds(5)));
+    EXPECT_FALSE(queue.postpone(3, now + std::chrono::milliseconds(30)));
+
+    //-------------------------------------------
+    // VALIDATION
+    // heap is not modified until the old deadline is reached
+    EXPECT_EQ(queue.top(), 1);
+    EXPECT_EQ(queue.topDeadline(), now + std::chrono::milliseconds(10));
+    EXPECT_FALSE(queue.popExpired(now + std::chrono::milliseconds(15), expiration));
+    EXPECT_EQ(queue.top(), 2);
+    EXPECT_EQ(queue.size(), 2U);
+
+    ASSERT_TRUE(queue.popExpired(now + std::chrono::milliseconds(30), expiration));
+    EXPECT_EQ(expiration, HsmTimerQueue::Expiration_t(2, now + std::chrono::milliseconds(20)));
+    ASSERT_TRUE(queue.popExpired(now + std::chrono::milliseconds(30), expiration));
+    EXPECT_EQ(expiration, HsmTimerQueue::Expiration_t(1, now + std::chrono::milliseconds(30)));
+    EXPECT_TRUE(queue.empty());
+
+    // rescheduling discards postponed deadline
+    queue.schedule(1, now + std::chrono::milliseconds(10));
+    EXPECT_TRUE(queue.postpone(1, now + std::chrono::milliseconds(30)));
+    queue.schedule(1, now + std::chrono::milliseconds(20));
+    ASSERT_TRUE(queue.popExpired(now + std::chrono::milliseconds(20), expiration));
+    EXPECT_EQ(expiration.second, now + std::chrono::milliseconds(20));
+}
+
+TEST(timer_queue, align_deadline) {
+    TEST_DESCRIPTION("coarse timers with nearby deadlines must be aligned to the same deadline within their slack");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const auto deadline = HsmTimerQueue::Clock_t::now() + std::chrono::milliseconds(100);
+    const unsigned int slackMs = 100;
+
+    //-------------------------------------------
+    // ACTIONS
+    const auto aligned = HsmTimerQueue::alignDeadline(deadline, slackMs);
+    const auto alignedNext = HsmTimerQueue::alignDeadline(aligned - std::chrono::milliseconds(10), slackMs);
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(HsmTimerQueue::alignDeadline(deadline, 0), deadline);
+    EXPECT_GE(aligned, deadline);
+    EXPECT_LT(aligned, deadline + std::chrono::milliseconds(slackMs));
+    // grid step is the largest power of two which fits into slack
+    EXPECT_EQ(aligned.time_since_epoch() % std::chrono::milliseconds(64), HsmTimerQueue::TimePoint_t::duration(0));
+    EXPECT_EQ(alignedNext, aligned);
+    EXPECT_EQ(HsmTimerQueue::alignDeadline(aligned, slackMs), aligned);
+}
+
+TEST(timer_queue, next_deadline) {
+    TEST_DESCRIPTION("next deadline of repeating timer must be based on the previous one and follow missed ticks policy");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const auto deadline = HsmTimerQueue::Clock_t::now();
+    const uint64_t periodUs = 10000;
+    const auto period = std::chrono::microseconds(periodUs);
+    const auto onTime = deadline + std::chrono::milliseconds(3);
+    // timer was processed when 3 more periods already passed
+    const auto late = deadline + std::chrono::milliseconds(35);
+
+    //-------------------------------------------
+    // ACTIONS & VALIDATION
+    EXPECT_EQ(HsmTimerQueue::getNextDeadline(deadline, periodUs, onTime, MissedTicksPolicy::FIRE_ALL), deadline + period);
+    EXPECT_EQ(HsmTimerQueue::getNextDeadline(deadline, periodUs, onTime, MissedTicksPolicy::FIRE_ONCE), deadline + period);
+    EXPECT_EQ(HsmTimerQueue::getNextDeadline(deadline, periodUs, onTime, MissedTicksPolicy::SKIP), deadline + period);
+
+    EXPECT_EQ(HsmTimerQueue::getNextDeadline(deadline, periodUs, late, MissedTicksPolicy::FIRE_ALL), deadline + period);
+    EXPECT_EQ(HsmTimerQueue::getNextDeadline(deadline, periodUs, late, MissedTicksPolicy::FIRE_ONCE), late + period);
+    EXPECT_EQ(HsmTimerQueue::getNextDeadline(deadline, periodUs, late, MissedTicksPolicy::SKIP), deadline + period * 4);
+}
+
+TEST(timer_queue, random_operations) {
+    TEST_DESCRIPTION("queue must stay consistent after many random operations");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const int timersCount = 1000;
+    HsmTimerQueue queue;
+    const auto now = HsmTimerQueue::Clock_t::now();
+    std::mt19937 generator(12345);
+    std::uniform_int_distribution<int> randomDelay(0, 100000);
+    std::map<TimerID_t, HsmTimerQueue::TimePoint_t> expectedDeadlines;
+
+    //-------------------------------------------
+    // ACTIONS
+    for (int i = 0; i < timersCount * 3; ++i) {
+        const TimerID_t id = static_cast<TimerID_t>(i % timersCount);
+        const auto deadline = now + std::chrono::microseconds(randomDelay(generator));
+
+        queue.schedule(id, deadline);
+        expectedDeadlines[id] = deadline;
+    }
+
+    for (TimerID_t id = 0; id < timersCount; id += 3) {
+        EXPECT_TRUE(queue.remove(id));
+        expectedDeadlines.erase(id);
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    ASSERT_EQ(queue.size(), expectedDeadlines.size());
+    HsmTimerQueue::TimePoint_t prevDeadline = HsmTimerQueue::TimePoint_t::min();
+
+    while (false == queue.empty()) {
+        const TimerID_t id = queue.top();
+
+        ASSERT_EQ(expectedDeadlines.count(id), 1U);
+        EXPECT_EQ(queue.topDeadline(), expectedDeadlines[id]);
+        EXPECT_LE(prevDeadline, queue.topDeadline());
+
+        prevDeadline = queue.topDeadline();
+        expectedDeadlines.erase(id);
+        queue.pop();
+    }
+
+    EXPECT_TRUE(expectedDeadlines.empty());
+}
+
+TEST(std_dispatcher, timers_repeating_without_drift) {
+    TEST_DESCRIPTION("repeating timers must be rescheduled from the previous deadline and support sub-millisecond intervals");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int expirationsCount = 200;
+    const auto period = std::chrono::microseconds(2500);
+    auto dispatcher = CREATE_DISPATCHER();
+    std::vector<HsmTimerQueue::TimePoint_t> expirations;
+    std::atomic<int> expirationsCounter(0);
+
+    expirations.reserve(expirationsCount);
+    // missed ticks (caused by a busy test machine) must not shift the expirations
+    dispatcher->setMissedTicksPolicy(MissedTicksPolicy::FIRE_ALL);
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerTimerHandler([&](const TimerID_t) {
+        if (expirationsCounter < expirationsCount) {
+            expirations.push_back(HsmTimerQueue::Clock_t::now());
+            ++expirationsCounter;
+        }
+
+        return true;
+    });
+
+    //-------------------------------------------
+    // ACTIONS
+    const auto startedAt = HsmTimerQueue::Clock_t::now();
+
+    dispatcher->startTimer(handlerID, 1, period, false);
+
+    for (int i = 0; (i < 200) && (expirationsCounter < expirationsCount); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    dispatcher->stopTimer(handlerID, 1);
+
+    //-------------------------------------------
+    // VALIDATION
+    ASSERT_EQ(expirationsCounter, expirationsCount);
+
+    // with drift every period would be longer by processing time, so the last expirations would be late by the sum
+    // of all these delays. Minimal lateness of the last few expirations is used to ignore random scheduling delays
+    auto minLateness = HsmTimerQueue::TimePoint_t::duration::max();
+
+    for (int i = expirationsCount - 10; i < expirationsCount; ++i) {
+        const auto expectedDeadline = startedAt + period * (i + 1);
+
+        EXPECT_GE(expirations[i], expectedDeadline);
+        minLateness = std::min(minLateness, expirations[i] - expectedDeadline);
+    }
+
+    EXPECT_LT(minLateness, std::chrono::milliseconds(5));
+
+    dispatcher->stop();
+    dispatcher->join();
+}
+
+TEST(std_dispatcher, timers_restart_postpones_deadline) {
+    TEST_DESCRIPTION("frequently restarted timer must expire only after its interval passes since the last restart");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = CREATE_DISPATCHER();
+    std::atomic<int> expirationsCounter(0);
+    HsmTimerQueue::TimePoint_t expiredAt;
+
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerTimerHandler([&](const TimerID_t) {
+        expiredAt = HsmTimerQueue::Clock_t::now();
+        ++expirationsCounter;
+        return true;
+    });
+
+    dispatcher->startTimer(handlerID, 1, 50, true);
+
+    //-------------------------------------------
+    // ACTIONS
+    // watchdog which is fed every 10 ms must not expire
+    for (int i = 0; i < 15; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        dispatcher->restartTimer(handlerID, 1);
+    }
+
+    const auto lastRestart = HsmTimerQueue::Clock_t::now();
+    const int expirationsBeforeTimeout = expirationsCounter;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(expirationsBeforeTimeout, 0);
+    ASSERT_EQ(expirationsCounter, 1);
+    EXPECT_GE(expiredAt, lastRestart + std::chrono::milliseconds(49));
+    EXPECT_FALSE(dispatcher->isTimerRunning(handlerID, 1));
+
+    dispatcher->stop();
+    dispatcher->join();
+}
+
+TEST(std_dispatcher, timers_missed_ticks_policy) {
+    TEST_DESCRIPTION("missed expirations of repeating timers must be handled according to the policy");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const int periodMs = 20;
+    auto countExpirations = [&](const MissedTicksPolicy policy) {
+        auto dispatcher = CREATE_DISPATCHER();
+        std::atomic<int> expirationsCounter(0);
+
+        dispatcher->setMissedTicksPolicy(policy);
+        EXPECT_TRUE(dispatcher->start());
+
+        const HandlerID_t handlerID = dispatcher->registerTimerHandler([&](const TimerID_t) {
+            // simulate a busy dispatcher: first expiration blocks it for 3.5 periods
+            if (0 == expirationsCounter) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(periodMs * 7 / 2));
+            }
+
+            ++expirationsCounter;
+            return true;
+        });
+
+        dispatcher->startTimer(handlerID, 1, periodMs, false);
+        std::this_thread::sleep_for(std::chrono::milliseconds(periodMs * 8 + periodMs / 2));
+        dispatcher->unregisterTimerHandler(handlerID);
+        dispatcher->stop();
+        dispatcher->join();
+
+        return expirationsCounter.load();
+    };
+
+    //-------------------------------------------
+    // ACTIONS
+    const int fireAllCount = countExpirations(MissedTicksPolicy::FIRE_ALL);
+    const int skipCount = countExpirations(MissedTicksPolicy::SKIP);
+
+    //-------------------------------------------
+    // VALIDATION
+    // FIRE_ALL: all 8 expirations are delivered. SKIP: 3 missed expirations are delivered as one
+    EXPECT_GE(fireAllCount, 7);
+    EXPECT_LE(skipCount, fireAllCount - 2);
+}
+
+TEST(std_dispatcher, idle_spin) {
+    TEST_DESCRIPTION("dispatcher which spins before blocking must process events and timers");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = CREATE_DISPATCHER();
+    std::atomic<int> handledEvents(0);
+    std::atomic<int> expirationsCounter(0);
+
+    dispatcher->setIdleSpinDuration(std::chrono::microseconds(200));
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t eventHandlerID = dispatcher->registerEventHandler([&]() {
+        ++handledEvents;
+        return true;
+    });
+    const HandlerID_t timerHandlerID = dispatcher->registerTimerHandler([&](const TimerID_t) {
+        ++expirationsCounter;
+        return true;
+    });
+
+    //-------------------------------------------
+    // ACTIONS
+    // events are emitted both while dispatcher is spinning and after it blocked
+    for (int i = 0; i < 200; ++i) {
+        const int expected = handledEvents + 1;
+
+        dispatcher->emitEvent(eventHandlerID);
+
+        for (int j = 0; (j < 1000) && (handledEvents < expected); ++j) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        if (0 == (i % 50)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+
+    dispatcher->startTimer(timerHandlerID, 1, 20, true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(handledEvents, 200);
+    EXPECT_EQ(expirationsCounter, 1);
+
+    dispatcher->unregisterEventHandler(eventHandlerID);
+    dispatcher->stop();
+    dispatcher->join();
+}
@@ -0,0 +1,313 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#include <poll.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "TestsCommon.hpp"
+#include "hsmcpp/HsmEventDispatcherEpoll.hpp"
+#include "hsmcpp/hsm.hpp"
+
+namespace {
+// waits until dispatcher fd becomes readable and processes its events. returns false on timeout
+bool runExternalLoopOnce(const std::shared_ptr<HsmEventDispatcherEpoll>& dispatcher, const int timeoutMs) {
+    pollfd pfd = {};
+
+    pfd.fd = dispatcher->getFd();
+    pfd.events = POLLIN;
+
+    const bool isReadable = (poll(&pfd, 1, timeoutMs) > 0);
+
+    if (true == isReadable) {
+        dispatcher->dispatch();
+    }
+
+    return isReadable;
+}
+}  // namespace
+
+TEST(epoll_dispatcher, external_loop_events) {
+    TEST_DESCRIPTION("in EXTERNAL_LOOP mode events must be dispatched only when application calls dispatch()");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher =
+        HsmEventDispatcherEpoll::create(DISPATCHER_DEFAULT_EVENTS_CACHESIZE, HsmEventDispatcherEpoll::RunMode::EXTERNAL_LOOP);
+    int handlerCalls = 0;
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_GE(dispatcher->getFd(), 0);
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerEventHandler([&]() {
+        ++handlerCalls;
+        return true;
+    });
+
+    //-------------------------------------------
+    // ACTIONS
+    // multiple emits must result in a single wakeup and a single handler call
+    dispatcher->emitEvent(handlerID);
+    dispatcher->emitEvent(handlerID);
+    dispatcher->emitEvent(handlerID);
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(handlerCalls, 0);
+    ASSERT_TRUE(runExternalLoopOnce(dispatcher, 1000));
+    EXPECT_EQ(handlerCalls, 1);
+
+    // all events were processed so fd must not be readable anymore
+    EXPECT_FALSE(runExternalLoopOnce(dispatcher, 0));
+
+    dispatcher->stop();
+}
+
+TEST(epoll_dispatcher, external_loop_timers) {
+    TEST_DESCRIPTION("in EXTERNAL_LOOP mode timers must be processed when dispatcher fd becomes readable");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher =
+        HsmEventDispatcherEpoll::create(DISPATCHER_DEFAULT_EVENTS_CACHESIZE, HsmEventDispatcherEpoll::RunMode::EXTERNAL_LOOP);
+    std::list<TimerID_t> firedTimers;
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerTimerHandler([&](const TimerID_t timerID) {
+        firedTimers.push_back(timerID);
+        return true;
+    });
+
+    //-------------------------------------------
+    // ACTIONS
+    const auto startedAt = std::chrono::steady_clock::now();
+
+    dispatcher->startTimer(handlerID, 2, 100, true);
+    dispatcher->startTimer(handlerID, 1, 50, true);
+    dispatcher->startTimer(handlerID, 3, 150, true);
+    dispatcher->stopTimer(handlerID, 3);
+
+    while ((firedTimers.size() < 2U) && (true == runExternalLoopOnce(dispatcher, 1000))) {
+    }
+
+    const auto elapsedMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startedAt).count();
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(firedTimers, (std::list<TimerID_t>{1, 2}));
+    EXPECT_GE(elapsedMs, 100);
+
+    // stopped timer must not wake up the loop
+    EXPECT_FALSE(runExternalLoopOnce(dispatcher, 200));
+    EXPECT_EQ(firedTimers.size(), 2U);
+
+    dispatcher->stop();
+}
+
+TEST(epoll_dispatcher, watch_fd) {
+    TEST_DESCRIPTION("fd readiness must be reported on dispatcher thread until handler stops watching it");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher =
+        HsmEventDispatcherEpoll::create(DISPATCHER_DEFAULT_EVENTS_CACHESIZE, HsmEventDispatcherEpoll::RunMode::EXTERNAL_LOOP);
+    int pipeFd[2] = {-1, -1};
+    int handlerCalls = 0;
+    FdEvents_t lastEvents = 0;
+    char buffer = 0;
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_TRUE(dispatcher->start());
+    ASSERT_EQ(pipe(pipeFd), 0);
+
+    const HandlerID_t watchID = dispatcher->watchFd(pipeFd[0], HSM_FD_READABLE, [&](const int fd, const FdEvents_t events) {
+        ++handlerCalls;
+        lastEvents = events;
+        EXPECT_EQ(fd, pipeFd[0]);
+
+        // stop watching after the second notification
+        return (handlerCalls < 2);
+    });
+
+    ASSERT_NE(watchID, INVALID_HSM_DISPATCHER_HANDLER_ID);
+    EXPECT_EQ(dispatcher->watchFd(pipeFd[0], 0, [](const int, const FdEvents_t) { return true; }),
+              INVALID_HSM_DISPATCHER_HANDLER_ID);
+
+    //-------------------------------------------
+    // ACTIONS & VALIDATION
+    EXPECT_FALSE(runExternalLoopOnce(dispatcher, 50));
+
+    ASSERT_EQ(write(pipeFd[1], "x", 1), 1);
+    ASSERT_TRUE(runExternalLoopOnce(dispatcher, 1000));
+    EXPECT_EQ(handlerCalls, 1);
+    EXPECT_EQ(lastEvents, HSM_FD_READABLE);
+
+    // data wasn't read so fd is still ready (level-triggered)
+    ASSERT_TRUE(runExternalLoopOnce(dispatcher, 1000));
+    EXPECT_EQ(handlerCalls, 2);
+
+    // handler returned false. fd must not be watched anymore
+    EXPECT_FALSE(runExternalLoopOnce(dispatcher, 50));
+    EXPECT_EQ(handlerCalls, 2);
+    EXPECT_EQ(read(pipeFd[0], &buffer, 1), 1);
+
+    dispatcher->stop();
+    close(pipeFd[0]);
+    close(pipeFd[1]);
+}
+
+TEST(epoll_dispatcher, unwatch_fd) {
+    TEST_DESCRIPTION("unwatched fd must not be reported");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher =
+        HsmEventDispatcherEpoll::create(DISPATCHER_DEFAULT_EVENTS_CACHESIZE, HsmEventDispatcherEpoll::RunMode::EXTERNAL_LOOP);
+    int pipeFd[2] = {-1, -1};
+    int handlerCalls = 0;
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_TRUE(dispatcher->start());
+    ASSERT_EQ(pipe(pipeFd), 0);
+
+    const HandlerID_t watchID = dispatcher->watchFd(pipeFd[1], HSM_FD_WRITABLE, [&](const int, const FdEvents_t events) {
+        ++handlerCalls;
+        EXPECT_EQ(events, HSM_FD_WRITABLE);
+        return true;
+    });
+
+    ASSERT_NE(watchID, INVALID_HSM_DISPATCHER_HANDLER_ID);
+    ASSERT_TRUE(runExternalLoopOnce(dispatcher, 1000));
+    EXPECT_EQ(handlerCalls, 1);
+
+    //-------------------------------------------
+    // ACTIONS
+    dispatcher->unwatchFd(watchID);
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_FALSE(runExternalLoopOnce(dispatcher, 50));
+    EXPECT_EQ(handlerCalls, 1);
+
+    dispatcher->stop();
+    close(pipeFd[0]);
+    close(pipeFd[1]);
+}
+
+TEST(epoll_dispatcher, hsm_watch_fd) {
+    TEST_DESCRIPTION("fd readiness must be delivered to HSM as a transition with fd and ready events as arguments");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const StateID_t stateIdle = 0;
+    const StateID_t stateReceived = 1;
+    const EventID_t eventDataAvailable = 0;
+    auto dispatcher = HsmEventDispatcherEpoll::create();
+    HierarchicalStateMachine hsm(stateIdle);
+    int pipeFd[2] = {-1, -1};
+    std::atomic<int> receivedCount(0);
+    std::thread::id callbackThread;
+    VariantVector_t receivedArgs;
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_EQ(pipe(pipeFd), 0);
+
+    hsm.registerState(stateIdle);
+    hsm.registerState(stateReceived, [&](const VariantVector_t& args) {
+        char buffer = 0;
+
+        // consume data so that fd is not reported again
+        EXPECT_EQ(read(pipeFd[0], &buffer, 1), 1);
+        callbackThread = std::this_thread::get_id();
+        receivedArgs = args;
+        ++receivedCount;
+    });
+    hsm.registerTransition(stateIdle, stateReceived, eventDataAvailable);
+    hsm.registerTransition(stateReceived, stateReceived, eventDataAvailable);
+    ASSERT_TRUE(hsm.initialize(dispatcher));
+
+    const HandlerID_t watchID = hsm.watchFd(pipeFd[0], HSM_FD_READABLE, eventDataAvailable);
+
+    ASSERT_NE(watchID, INVALID_HSM_DISPATCHER_HANDLER_ID);
+
+    //-------------------------------------------
+    // ACTIONS
+    ASSERT_EQ(write(pipeFd[1], "x", 1), 1);
+
+    for (int i = 0; (i < 100) && (0 == receivedCount); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // give dispatcher a chance to report fd again if data wasn't consumed
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(receivedCount, 1);
+    EXPECT_TRUE(compareStateLists(hsm.getActiveStates(), {stateReceived}));
+    EXPECT_NE(callbackThread, std::this_thread::get_id());
+    ASSERT_EQ(receivedArgs.size(), 2U);
+    EXPECT_EQ(receivedArgs[0].toInt64(), pipeFd[0]);
+    EXPECT_EQ(receivedArgs[1].toInt64(), HSM_FD_READABLE);
+
+    // unwatched fd must not trigger transitions
+    hsm.unwatchFd(watchID);
+    ASSERT_EQ(write(pipeFd[1], "x", 1), 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(receivedCount, 1);
+
+    hsm.release();
+    dispatcher->stop();
+    dispatcher->join();
+    close(pipeFd[0]);
+    close(pipeFd[1]);
+}
+
+TEST(epoll_dispatcher, delete_from_dispatcher_thread) {
+    TEST_DESCRIPTION("dispatcher must be safely deleted when its last reference is released by a handler");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::shared_ptr<HsmEventDispatcherEpoll> dispatcher = HsmEventDispatcherEpoll::create();
+    std::shared_ptr<int> sentinel = std::make_shared<int>(0);
+    std::weak_ptr<int> sentinelRef = sentinel;
+    std::atomic<bool> canRelease(false);
+    std::atomic<bool> wasReleased(false);
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerEventHandler([&, sentinel]() {
+        while (false == canRelease.load()) {
+            std::this_thread::yield();
+        }
+
+        dispatcher.reset();
+        wasReleased = true;
+        return true;
+    });
+
+    sentinel.reset();
+
+    //-------------------------------------------
+    // ACTIONS
+    dispatcher->emitEvent(handlerID);
+    canRelease = true;
+
+    for (int i = 0; (i < 100) && (false == sentinelRef.expired()); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(wasReleased.load());
+    // handler is destroyed only when dispatcher instance is deleted
+    EXPECT_TRUE(sentinelRef.expired());
+}
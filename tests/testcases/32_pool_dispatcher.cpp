@@ -0,0 +1,241 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "TestsCommon.hpp"
+#include "hsmcpp/HsmEventDispatcherPool.hpp"
+#include "hsmcpp/hsm.hpp"
+
+namespace {
+// waits until condition becomes true. returns false on timeout
+template <typename Condition>
+bool waitFor(const Condition& condition, const int timeoutMs) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while ((false == condition()) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return condition();
+}
+}  // namespace
+
+TEST(pool_dispatcher, strand_is_serial) {
+    TEST_DESCRIPTION("events of the same handler must never be processed concurrently or out of order");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int handlersCount = 8;
+    constexpr int emitThreadsCount = 4;
+    constexpr int eventsPerThread = 2000;
+    struct HandlerState {
+        std::atomic<bool> isRunning{false};
+        std::atomic<int> calls{0};
+        std::atomic<int> overlaps{0};
+    };
+    auto dispatcher = HsmEventDispatcherPool::create(4);
+    std::vector<std::unique_ptr<HandlerState>> states;
+    std::vector<HandlerID_t> handlers;
+
+    ASSERT_TRUE(dispatcher->start());
+
+    for (int i = 0; i < handlersCount; ++i) {
+        HandlerState* state = new HandlerState();
+
+        states.emplace_back(state);
+        handlers.push_back(dispatcher->registerEventHandler([state]() {
+            if (true == state->isRunning.exchange(true)) {
+                ++state->overlaps;
+            }
+
+            std::this_thread::yield();
+            ++state->calls;
+            state->isRunning = false;
+            return true;
+        }));
+    }
+
+    //-------------------------------------------
+    // ACTIONS
+    std::vector<std::thread> emitters;
+
+    for (int t = 0; t < emitThreadsCount; ++t) {
+        emitters.emplace_back([&]() {
+            for (int i = 0; i < eventsPerThread; ++i) {
+                dispatcher->emitEvent(handlers[i % handlersCount]);
+            }
+        });
+    }
+
+    for (std::thread& emitter : emitters) {
+        emitter.join();
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    const int expectedCalls = (emitThreadsCount * eventsPerThread) / handlersCount;
+
+    for (const std::unique_ptr<HandlerState>& state : states) {
+        EXPECT_TRUE(waitFor([&]() { return (state->calls == expectedCalls); }, 5000));
+        EXPECT_EQ(state->overlaps, 0);
+    }
+
+    dispatcher->stop();
+    dispatcher->join();
+}
+
+TEST(pool_dispatcher, strands_run_in_parallel) {
+    TEST_DESCRIPTION("different handlers must be processed by different workers at the same time");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = HsmEventDispatcherPool::create(2);
+    std::atomic<int> runningHandlers(0);
+    std::atomic<bool> metInParallel(false);
+    // both handlers wait for each other. This can succeed only if they are executed by different workers
+    auto handler = [&]() {
+        ++runningHandlers;
+        metInParallel = waitFor([&]() { return (runningHandlers >= 2); }, 2000);
+        return true;
+    };
+
+    ASSERT_EQ(dispatcher->getWorkersCount(), 2U);
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handler1 = dispatcher->registerEventHandler(handler);
+    const HandlerID_t handler2 = dispatcher->registerEventHandler(handler);
+
+    //-------------------------------------------
+    // ACTIONS
+    dispatcher->emitEvent(handler1);
+    dispatcher->emitEvent(handler2);
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(waitFor([&]() { return (true == metInParallel); }, 3000));
+
+    dispatcher->stop();
+    dispatcher->join();
+}
+
+TEST(pool_dispatcher, unregister_handler) {
+    TEST_DESCRIPTION("handler must not be called after it was unregistered or returned false");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = HsmEventDispatcherPool::create(2);
+    std::atomic<int> calls(0);
+
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerEventHandler([&]() {
+        ++calls;
+        return false;
+    });
+
+    //-------------------------------------------
+    // ACTIONS
+    dispatcher->emitEvent(handlerID);
+    ASSERT_TRUE(waitFor([&]() { return (calls > 0); }, 1000));
+    dispatcher->emitEvent(handlerID);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(calls, 1);
+
+    dispatcher->stop();
+    dispatcher->join();
+}
+
+TEST(pool_dispatcher, delete_from_worker) {
+    TEST_DESCRIPTION("dispatcher must be safely deleted when its last reference is released by a handler");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::shared_ptr<HsmEventDispatcherPool> dispatcher = HsmEventDispatcherPool::create(2);
+    std::shared_ptr<int> sentinel = std::make_shared<int>(0);
+    std::weak_ptr<int> sentinelRef = sentinel;
+    std::atomic<bool> canRelease(false);
+    std::atomic<bool> wasReleased(false);
+
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerEventHandler([&, sentinel]() {
+        while (false == canRelease.load()) {
+            std::this_thread::yield();
+        }
+
+        dispatcher.reset();
+        wasReleased = true;
+        return true;
+    });
+
+    sentinel.reset();
+
+    //-------------------------------------------
+    // ACTIONS
+    dispatcher->emitEvent(handlerID);
+    canRelease = true;
+
+    //-------------------------------------------
+    // VALIDATION
+    ASSERT_TRUE(waitFor([&]() { return wasReleased.load(); }, 1000));
+    // handler is destroyed only when dispatcher instance is deleted
+    EXPECT_TRUE(waitFor([&]() { return sentinelRef.expired(); }, 1000));
+}
+
+TEST(pool_dispatcher, multiple_hsm_instances) {
+    TEST_DESCRIPTION("multiple HSM instances sharing the same pool must process all their transitions");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int hsmCount = 16;
+    constexpr int transitionsCount = 200;
+    const StateID_t stateA = 0;
+    const StateID_t stateB = 1;
+    const EventID_t eventNext = 0;
+    auto dispatcher = HsmEventDispatcherPool::create(4);
+    std::vector<std::unique_ptr<HierarchicalStateMachine>> machines;
+    std::atomic<int> enteredStates(0);
+
+    for (int i = 0; i < hsmCount; ++i) {
+        HierarchicalStateMachine* hsm = new HierarchicalStateMachine(stateA);
+
+        machines.emplace_back(hsm);
+        hsm->registerState(stateA, [&](const VariantVector_t&) { ++enteredStates; });
+        hsm->registerState(stateB, [&](const VariantVector_t&) { ++enteredStates; });
+        hsm->registerTransition(stateA, stateB, eventNext);
+        hsm->registerTransition(stateB, stateA, eventNext);
+        ASSERT_TRUE(hsm->initialize(dispatcher));
+    }
+
+    //-------------------------------------------
+    // ACTIONS
+    for (int i = 0; i < transitionsCount; ++i) {
+        for (const std::unique_ptr<HierarchicalStateMachine>& hsm : machines) {
+            hsm->transition(eventNext);
+        }
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    // NOTE: initial state is also entered once during initialization
+    constexpr int expectedStates = hsmCount * (transitionsCount + 1);
+
+    EXPECT_TRUE(waitFor([&]() { return (enteredStates >= expectedStates); }, 5000));
+    EXPECT_EQ(enteredStates, expectedStates);
+
+    for (const std::unique_ptr<HierarchicalStateMachine>& hsm : machines) {
+        // even number of transitions must bring HSM back to the initial state
+        EXPECT_TRUE(compareStateLists(hsm->getActiveStates(), {stateA}));
+        hsm->release();
+    }
+
+    dispatcher->stop();
+    dispatcher->join();
+}
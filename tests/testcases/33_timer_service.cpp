@@ -0,0 +1,181 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+  #include <dirent.h>
+#endif
+
+#include "TestsCommon.hpp"
+#include "hsmcpp/HsmEventDispatcherSTD.hpp"
+#include "hsmcpp/HsmTimerService.hpp"
+
+namespace {
+using TimerEvent_t = std::pair<HandlerID_t, TimerID_t>;
+
+#ifdef __linux__
+int getThreadsCount() {
+    int count = 0;
+    DIR* dir = opendir("/proc/self/task");
+
+    if (nullptr != dir) {
+        for (dirent* entry = readdir(dir); nullptr != entry; entry = readdir(dir)) {
+            if ('.' != entry->d_name[0]) {
+                ++count;
+            }
+        }
+
+        closedir(dir);
+    }
+
+    return count;
+}
+#endif
+}  // namespace
+
+TEST(timer_service, clients_use_same_timer_ids) {
+    TEST_DESCRIPTION("timer IDs must be unique only within a client");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto service = HsmTimerService::create();
+    std::mutex sync;
+    std::vector<TimerEvent_t> expiredTimers;
+    HandlerID_t client1 = INVALID_HSM_DISPATCHER_HANDLER_ID;
+    HandlerID_t client2 = INVALID_HSM_DISPATCHER_HANDLER_ID;
+
+    client1 = service->registerClient([&](const TimerID_t timerID, const HsmTimerService::TimePoint_t&) {
+        std::lock_guard<std::mutex> lck(sync);
+        expiredTimers.emplace_back(client1, timerID);
+    });
+    client2 = service->registerClient([&](const TimerID_t timerID, const HsmTimerService::TimePoint_t&) {
+        std::lock_guard<std::mutex> lck(sync);
+        expiredTimers.emplace_back(client2, timerID);
+    });
+
+    //-------------------------------------------
+    // ACTIONS
+    const auto now = HsmTimerService::TimePoint_t::clock::now();
+
+    service->schedule(client1, 1, now + std::chrono::milliseconds(60));
+    service->schedule(client2, 1, now + std::chrono::milliseconds(20));
+    service->schedule(client2, 2, now + std::chrono::milliseconds(40));
+    EXPECT_EQ(service->getTimersCount(), 3U);
+    EXPECT_TRUE(service->isScheduled(client1, 1));
+    EXPECT_FALSE(service->isScheduled(client1, 2));
+
+    // canceling timer of one client must not affect timer with the same ID of another client
+    EXPECT_TRUE(service->cancel(client2, 2));
+    EXPECT_FALSE(service->cancel(client2, 2));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    //-------------------------------------------
+    // VALIDATION
+    std::lock_guard<std::mutex> lck(sync);
+
+    EXPECT_EQ(expiredTimers, (std::vector<TimerEvent_t>{{client2, 1}, {client1, 1}}));
+    EXPECT_EQ(service->getTimersCount(), 0U);
+    EXPECT_FALSE(service->isScheduled(client1, 1));
+}
+
+TEST(timer_service, unregister_client) {
+    TEST_DESCRIPTION("timers of unregistered client must be canceled");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto service = HsmTimerService::create();
+    std::atomic<int> expiredCount(0);
+    auto handler = [&](const TimerID_t, const HsmTimerService::TimePoint_t&) { ++expiredCount; };
+    const HandlerID_t client1 = service->registerClient(handler);
+    const HandlerID_t client2 = service->registerClient(handler);
+    const auto now = HsmTimerService::TimePoint_t::clock::now();
+
+    service->schedule(client1, 1, now + std::chrono::milliseconds(20));
+    service->schedule(client1, 2, now + std::chrono::milliseconds(20));
+    service->schedule(client2, 1, now + std::chrono::milliseconds(20));
+
+    //-------------------------------------------
+    // ACTIONS
+    service->unregisterClient(client1);
+
+    // unregistered client can't schedule timers
+    service->schedule(client1, 3, now + std::chrono::milliseconds(20));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(service->getTimersCount(), 1U);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(expiredCount, 1);
+}
+
+TEST(timer_service, shared_by_dispatchers) {
+    TEST_DESCRIPTION("timers of multiple dispatchers must be processed by a single thread of the shared service");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int dispatchersCount = 50;
+    std::vector<std::shared_ptr<HsmEventDispatcherSTD>> dispatchers;
+    std::atomic<int> expiredCount(0);
+    std::mutex sync;
+    std::vector<std::thread::id> handlerThreads;
+
+#ifdef __linux__
+    const int threadsBefore = getThreadsCount();
+#endif
+
+    for (int i = 0; i < dispatchersCount; ++i) {
+        auto dispatcher =
+            HsmEventDispatcherSTD::create(DISPATCHER_DEFAULT_EVENTS_CACHESIZE, HsmEventDispatcherSTD::TimersMode::SHARED_SERVICE);
+
+        ASSERT_TRUE(dispatcher->start());
+        dispatchers.push_back(dispatcher);
+    }
+
+    //-------------------------------------------
+    // ACTIONS
+    for (int i = 0; i < dispatchersCount; ++i) {
+        const HandlerID_t handlerID = dispatchers[i]->registerTimerHandler([&](const TimerID_t) {
+            std::lock_guard<std::mutex> lck(sync);
+
+            handlerThreads.push_back(std::this_thread::get_id());
+            ++expiredCount;
+            return true;
+        });
+
+        // all dispatchers use the same timer ID
+        dispatchers[i]->startTimer(handlerID, 1, 10 + (i % 5) * 10, true);
+    }
+
+#ifdef __linux__
+    // one thread per dispatcher and a single thread for all timers (could be already running if service is used by
+    // dispatchers created outside of this test)
+    EXPECT_LE(getThreadsCount() - threadsBefore, dispatchersCount + 1);
+#endif
+
+    for (int i = 0; (i < 100) && (expiredCount < dispatchersCount); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(expiredCount, dispatchersCount);
+
+    {
+        std::lock_guard<std::mutex> lck(sync);
+
+        // timer handlers must be called from dispatchers threads
+        std::sort(handlerThreads.begin(), handlerThreads.end());
+        EXPECT_EQ(std::unique(handlerThreads.begin(), handlerThreads.end()) - handlerThreads.begin(), dispatchersCount);
+    }
+
+    for (const auto& dispatcher : dispatchers) {
+        dispatcher->stop();
+        dispatcher->join();
+    }
+}
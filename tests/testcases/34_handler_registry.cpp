@@ -0,0 +1,322 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#include "TestsCommon.hpp"
+#include "hsmcpp/HsmEventDispatcherSTD.hpp"
+#include "hsmcpp/HsmHandlerRegistry.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+using TestHandler_t = std::function<int()>;
+using TestRegistry_t = HsmHandlerRegistry<TestHandler_t>;
+
+// increments counter when handler object is destroyed
+struct DestructionTracker {
+    explicit DestructionTracker(std::atomic<int>& counter)
+        : destroyedCount(counter) {}
+
+    ~DestructionTracker() {
+        ++destroyedCount;
+    }
+
+    std::atomic<int>& destroyedCount;
+};
+
+int callHandler(const TestRegistry_t& registry, const HandlerID_t id) {
+    int result = -1;
+    TestRegistry_t::ReadGuard readGuard(registry);
+    const TestHandler_t* handler = registry.find(id);
+
+    if (nullptr != handler) {
+        result = (*handler)();
+    }
+
+    return result;
+}
+}  // namespace
+
+TEST(handler_registry, add_find_remove) {
+    TEST_DESCRIPTION("handlers must be accessible by their IDs until they are removed");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    TestRegistry_t registry;
+    std::vector<HandlerID_t> ids;
+
+    //-------------------------------------------
+    // ACTIONS
+    // add more handlers than initial capacity of the registry to force it to grow
+    for (int i = 0; i < 100; ++i) {
+        ids.push_back(registry.add([i]() { return i; }));
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_NE(ids[i], INVALID_HSM_DISPATCHER_HANDLER_ID);
+        EXPECT_EQ(callHandler(registry, ids[i]), i);
+    }
+
+    EXPECT_EQ(callHandler(registry, INVALID_HSM_DISPATCHER_HANDLER_ID), -1);
+
+    EXPECT_TRUE(registry.remove(ids[10]));
+    EXPECT_FALSE(registry.remove(ids[10]));
+    EXPECT_EQ(callHandler(registry, ids[10]), -1);
+    EXPECT_EQ(callHandler(registry, ids[11]), 11);
+
+    registry.clear();
+
+    for (const HandlerID_t id : ids) {
+        EXPECT_EQ(callHandler(registry, id), -1);
+    }
+}
+
+TEST(handler_registry, stale_id) {
+    TEST_DESCRIPTION("ID of a removed handler must not match a new handler which reuses the same slot");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    TestRegistry_t registry;
+    const HandlerID_t oldID = registry.add([]() { return 1; });
+
+    //-------------------------------------------
+    // ACTIONS
+    ASSERT_TRUE(registry.remove(oldID));
+    const HandlerID_t newID = registry.add([]() { return 2; });
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_NE(oldID, newID);
+    EXPECT_EQ(callHandler(registry, oldID), -1);
+    EXPECT_EQ(callHandler(registry, newID), 2);
+    EXPECT_FALSE(registry.remove(oldID));
+    EXPECT_EQ(callHandler(registry, newID), 2);
+}
+
+TEST(handler_registry, schedule) {
+    TEST_DESCRIPTION("handler must be scheduled only once until it's taken for execution");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    TestRegistry_t registry;
+    const HandlerID_t id = registry.add([]() { return 1; });
+
+    //-------------------------------------------
+    // ACTIONS
+    EXPECT_TRUE(registry.trySchedule(id));
+    EXPECT_FALSE(registry.trySchedule(id));
+
+    {
+        TestRegistry_t::ReadGuard readGuard(registry);
+        const TestHandler_t* handler = registry.takeScheduled(id);
+
+        ASSERT_NE(handler, nullptr);
+        EXPECT_EQ((*handler)(), 1);
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(registry.trySchedule(id));
+    ASSERT_TRUE(registry.remove(id));
+    EXPECT_FALSE(registry.trySchedule(id));
+
+    // new handler in the same slot must not inherit scheduled state
+    const HandlerID_t newID = registry.add([]() { return 2; });
+
+    EXPECT_TRUE(registry.trySchedule(newID));
+}
+
+TEST(handler_registry, deferred_destruction) {
+    TEST_DESCRIPTION("handler removed while it's used by a reader must be destroyed only after reader is done");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    TestRegistry_t registry;
+    std::atomic<int> destroyedCount(0);
+    auto tracker = std::make_shared<DestructionTracker>(destroyedCount);
+    const HandlerID_t id = registry.add([tracker]() { return 1; });
+
+    tracker.reset();
+
+    //-------------------------------------------
+    // ACTIONS
+    {
+        TestRegistry_t::ReadGuard readGuard(registry);
+        const TestHandler_t* handler = registry.find(id);
+
+        ASSERT_NE(handler, nullptr);
+        EXPECT_TRUE(registry.remove(id));
+        registry.collect();
+
+        //-------------------------------------------
+        // VALIDATION
+        EXPECT_EQ(registry.find(id), nullptr);
+        EXPECT_EQ(destroyedCount, 0);
+        EXPECT_EQ((*handler)(), 1);
+    }
+
+    registry.collect();
+    EXPECT_EQ(destroyedCount, 1);
+}
+
+TEST(handler_registry, concurrent_access) {
+    TEST_DESCRIPTION("readers must be able to call handlers while other threads add and remove them");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    TestRegistry_t registry;
+    std::atomic<bool> stopReaders(false);
+    std::atomic<int> invalidResults(0);
+    std::vector<HandlerID_t> stableIDs;
+    std::vector<std::thread> readers;
+
+    for (int i = 0; i < 8; ++i) {
+        stableIDs.push_back(registry.add([i]() { return i; }));
+    }
+
+    //-------------------------------------------
+    // ACTIONS
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&]() {
+            while (false == stopReaders) {
+                for (size_t i = 0; i < stableIDs.size(); ++i) {
+                    if (static_cast<int>(i) != callHandler(registry, stableIDs[i])) {
+                        ++invalidResults;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 5000; ++i) {
+        const HandlerID_t id = registry.add([i]() { return i; });
+
+        EXPECT_EQ(callHandler(registry, id), i);
+        EXPECT_TRUE(registry.remove(id));
+    }
+
+    stopReaders = true;
+
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(invalidResults, 0);
+}
+
+TEST(std_dispatcher, unregister_handlers_from_handler) {
+    TEST_DESCRIPTION("event handler must be able to unregister itself and register new handlers while it's executed");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::shared_ptr<HsmEventDispatcherSTD> dispatcher = HsmEventDispatcherSTD::create();
+    std::atomic<int> firstCalls(0);
+    std::atomic<int> secondCalls(0);
+    std::atomic<HandlerID_t> firstID(INVALID_HSM_DISPATCHER_HANDLER_ID);
+    std::atomic<HandlerID_t> secondID(INVALID_HSM_DISPATCHER_HANDLER_ID);
+
+    ASSERT_TRUE(dispatcher->start());
+
+    //-------------------------------------------
+    // ACTIONS
+    firstID = dispatcher->registerEventHandler([&]() {
+        ++firstCalls;
+        dispatcher->unregisterEventHandler(firstID);
+        secondID = dispatcher->registerEventHandler([&]() {
+            ++secondCalls;
+            return true;
+        });
+        dispatcher->emitEvent(secondID);
+        return true;
+    });
+
+    dispatcher->emitEvent(firstID);
+
+    for (int i = 0; (i < 100) && (0 == secondCalls); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // handler was already unregistered, event must be ignored
+    dispatcher->emitEvent(firstID);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(firstCalls, 1);
+    EXPECT_EQ(secondCalls, 1);
+
+    dispatcher->unregisterEventHandler(secondID);
+    dispatcher->stop();
+    dispatcher->join();
+}
+
+TEST(std_dispatcher, emits_are_coalesced) {
+    TEST_DESCRIPTION("events emitted for a handler which is already queued must not add more handler calls");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::shared_ptr<HsmEventDispatcherSTD> dispatcher = HsmEventDispatcherSTD::create();
+    std::mutex sync;
+    std::condition_variable cv;
+    bool handlerStarted = false;
+    bool handlerReleased = false;
+    std::atomic<int> handlerCalls(0);
+
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerEventHandler([&]() {
+        if (1 == ++handlerCalls) {
+            std::unique_lock<std::mutex> lck(sync);
+
+            handlerStarted = true;
+            cv.notify_all();
+            cv.wait(lck, [&]() { return handlerReleased; });
+        }
+
+        return true;
+    });
+
+    //-------------------------------------------
+    // ACTIONS
+    dispatcher->emitEvent(handlerID);
+
+    {
+        std::unique_lock<std::mutex> lck(sync);
+
+        ASSERT_TRUE(cv.wait_for(lck, std::chrono::seconds(5), [&]() { return handlerStarted; }));
+    }
+
+    // handler is being executed, so only the first of these emits schedules it again
+    for (int i = 0; i < 100; ++i) {
+        dispatcher->emitEvent(handlerID);
+    }
+
+    {
+        std::lock_guard<std::mutex> lck(sync);
+
+        handlerReleased = true;
+        cv.notify_all();
+    }
+
+    for (int i = 0; (i < 100) && (handlerCalls < 2); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(handlerCalls, 2);
+
+    dispatcher->unregisterEventHandler(handlerID);
+    dispatcher->stop();
+    dispatcher->join();
+}
@@ -0,0 +1,415 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#include "TestsCommon.hpp"
+#include "hsmcpp/HsmEventDispatcherBusyPoll.hpp"
+#include "hsmcpp/HsmMpscLinkedQueue.hpp"
+#include "hsmcpp/HsmMpscQueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+using Clock_t = std::chrono::steady_clock;
+
+// NOTE: tests can run on a single CPU, so dispatcher must not spin forever while test thread waits for it
+constexpr HsmEventDispatcherBusyPoll::IdleMode TEST_IDLE_MODE = HsmEventDispatcherBusyPoll::IdleMode::YIELD;
+
+// waits until condition becomes true. returns false on timeout
+template <typename Predicate>
+bool waitUntil(const Predicate& condition, const std::chrono::milliseconds& timeout) {
+    const auto deadline = Clock_t::now() + timeout;
+
+    while ((false == condition()) && (Clock_t::now() < deadline)) {
+        std::this_thread::yield();
+    }
+
+    return condition();
+}
+}  // namespace
+
+TEST(mpsc_queue, push_pop) {
+    TEST_DESCRIPTION("queue must keep FIFO order and reject new elements when it's full");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    HsmMpscQueue<int> queue(3);
+    int value = 0;
+
+    //-------------------------------------------
+    // ACTIONS
+    // VALIDATION
+    ASSERT_EQ(queue.capacity(), 4u);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(value));
+
+    // run several laps over the ring
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_TRUE(queue.push((lap * 10) + i));
+        }
+
+        EXPECT_FALSE(queue.push(100));
+        EXPECT_FALSE(queue.empty());
+
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(queue.pop(value));
+            EXPECT_EQ(value, (lap * 10) + i);
+        }
+
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(mpsc_queue, concurrent_producers) {
+    TEST_DESCRIPTION("elements pushed concurrently by multiple producers must be received exactly once");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int PRODUCERS_COUNT = 4;
+    constexpr int ELEMENTS_PER_PRODUCER = 20000;
+    HsmMpscQueue<int> queue(64);
+    std::vector<std::thread> producers;
+    std::vector<int> lastReceived(PRODUCERS_COUNT, -1);
+    int receivedCount = 0;
+    bool isOrdered = true;
+
+    //-------------------------------------------
+    // ACTIONS
+    for (int producer = 0; producer < PRODUCERS_COUNT; ++producer) {
+        producers.emplace_back([producer, &queue]() {
+            for (int i = 0; i < ELEMENTS_PER_PRODUCER; ++i) {
+                while (false == queue.push((producer * ELEMENTS_PER_PRODUCER) + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    while (receivedCount < (PRODUCERS_COUNT * ELEMENTS_PER_PRODUCER)) {
+        int value = 0;
+
+        if (true == queue.pop(value)) {
+            const int producer = value / ELEMENTS_PER_PRODUCER;
+
+            // elements of each producer must arrive in the same order they were pushed
+            isOrdered = isOrdered && (lastReceived[producer] + 1 == value % ELEMENTS_PER_PRODUCER);
+            lastReceived[producer] = value % ELEMENTS_PER_PRODUCER;
+            ++receivedCount;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(isOrdered);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(mpsc_linked_queue, push_pop) {
+    TEST_DESCRIPTION("unbounded queue must keep FIFO order and destroy elements which were not consumed");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::shared_ptr<int> tracker = std::make_shared<int>(0);
+    std::shared_ptr<int> value;
+
+    //-------------------------------------------
+    // ACTIONS
+    // VALIDATION
+    {
+        HsmMpscLinkedQueue<std::shared_ptr<int>> queue;
+
+        EXPECT_TRUE(queue.empty());
+        EXPECT_FALSE(queue.pop(value));
+
+        for (int i = 0; i < 100; ++i) {
+            queue.push(std::make_shared<int>(i));
+        }
+
+        EXPECT_FALSE(queue.empty());
+
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(queue.pop(value));
+            EXPECT_EQ(*value, i);
+        }
+
+        EXPECT_TRUE(queue.empty());
+
+        queue.push(tracker);
+        queue.push(tracker);
+        EXPECT_EQ(tracker.use_count(), 3);
+    }
+
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(mpsc_linked_queue, concurrent_producers) {
+    TEST_DESCRIPTION("elements pushed concurrently by multiple producers must be received exactly once");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int PRODUCERS_COUNT = 4;
+    constexpr int ELEMENTS_PER_PRODUCER = 20000;
+    HsmMpscLinkedQueue<int> queue;
+    std::vector<std::thread> producers;
+    std::vector<int> lastReceived(PRODUCERS_COUNT, -1);
+    int receivedCount = 0;
+    bool isOrdered = true;
+
+    //-------------------------------------------
+    // ACTIONS
+    for (int producer = 0; producer < PRODUCERS_COUNT; ++producer) {
+        producers.emplace_back([producer, &queue]() {
+            for (int i = 0; i < ELEMENTS_PER_PRODUCER; ++i) {
+                queue.push((producer * ELEMENTS_PER_PRODUCER) + i);
+            }
+        });
+    }
+
+    while (receivedCount < (PRODUCERS_COUNT * ELEMENTS_PER_PRODUCER)) {
+        int value = 0;
+
+        if (true == queue.pop(value)) {
+            const int producer = value / ELEMENTS_PER_PRODUCER;
+
+            isOrdered = isOrdered && (lastReceived[producer] + 1 == value % ELEMENTS_PER_PRODUCER);
+            lastReceived[producer] = value % ELEMENTS_PER_PRODUCER;
+            ++receivedCount;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(isOrdered);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(busypoll_dispatcher, events) {
+    TEST_DESCRIPTION("events emitted from different threads must be dispatched without blocking dispatcher thread");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int EVENTS_PER_THREAD = 1000;
+    auto dispatcher = HsmEventDispatcherBusyPoll::create(TEST_IDLE_MODE);
+    std::atomic<int> emittedEvents(0);
+    std::atomic<int> handledEvents(0);
+    std::vector<std::thread> producers;
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerEventHandler([&]() {
+        // NOTE: emits are coalesced, so handler processes everything that was emitted before it was called
+        handledEvents = emittedEvents.load();
+        return true;
+    });
+
+    //-------------------------------------------
+    // ACTIONS
+    for (int i = 0; i < 2; ++i) {
+        producers.emplace_back([&]() {
+            for (int j = 0; j < EVENTS_PER_THREAD; ++j) {
+                ++emittedEvents;
+                dispatcher->emitEvent(handlerID);
+            }
+        });
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(waitUntil([&]() { return (2 * EVENTS_PER_THREAD) == handledEvents.load(); }, std::chrono::seconds(5)));
+
+    dispatcher->stop();
+    dispatcher->join();
+}
+
+TEST(busypoll_dispatcher, delete_from_dispatcher_thread) {
+    TEST_DESCRIPTION("dispatcher must be safely deleted when its last reference is released by a handler");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::shared_ptr<HsmEventDispatcherBusyPoll> dispatcher = HsmEventDispatcherBusyPoll::create(TEST_IDLE_MODE);
+    std::shared_ptr<int> sentinel = std::make_shared<int>(0);
+    std::weak_ptr<int> sentinelRef = sentinel;
+    std::atomic<bool> canRelease(false);
+    std::atomic<bool> wasReleased(false);
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerEventHandler([&, sentinel]() {
+        while (false == canRelease.load()) {
+            std::this_thread::yield();
+        }
+
+        dispatcher.reset();
+        wasReleased = true;
+        return true;
+    });
+
+    sentinel.reset();
+
+    //-------------------------------------------
+    // ACTIONS
+    dispatcher->emitEvent(handlerID);
+    canRelease = true;
+
+    //-------------------------------------------
+    // VALIDATION
+    ASSERT_TRUE(waitUntil([&]() { return wasReleased.load(); }, std::chrono::seconds(1)));
+    // handler is destroyed only when dispatcher instance is deleted
+    EXPECT_TRUE(waitUntil([&]() { return sentinelRef.expired(); }, std::chrono::seconds(1)));
+}
+
+TEST(busypoll_dispatcher, invalid_cpu) {
+    TEST_DESCRIPTION("dispatcher must ignore invalid CPU index and keep dispatching events");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    std::atomic<int> handledEvents(0);
+
+    for (const int cpu : {-5, 1000000}) {
+        auto dispatcher = HsmEventDispatcherBusyPoll::create(TEST_IDLE_MODE, cpu);
+
+        ASSERT_TRUE(dispatcher);
+        ASSERT_TRUE(dispatcher->start());
+
+        const HandlerID_t handlerID = dispatcher->registerEventHandler([&]() {
+            ++handledEvents;
+            return true;
+        });
+
+        //-------------------------------------------
+        // ACTIONS
+        handledEvents = 0;
+        dispatcher->emitEvent(handlerID);
+
+        //-------------------------------------------
+        // VALIDATION
+        EXPECT_TRUE(waitUntil([&]() { return 1 == handledEvents.load(); }, std::chrono::seconds(5)));
+
+        dispatcher->stop();
+        dispatcher->join();
+    }
+}
+
+TEST(busypoll_dispatcher, queue_overflow) {
+    TEST_DESCRIPTION("handlers which don't fit into lock-free queue must still be dispatched");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int HANDLERS_COUNT = 16;
+    auto dispatcher = HsmEventDispatcherBusyPoll::create(TEST_IDLE_MODE, DISPATCHER_ANY_CPU, 2);
+    std::atomic<bool> isBlocked(false);
+    std::atomic<bool> canContinue(false);
+    std::atomic<int> handlerCalls(0);
+    std::vector<HandlerID_t> handlers;
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t blockingHandlerID = dispatcher->registerEventHandler([&]() {
+        isBlocked = true;
+
+        while (false == canContinue.load()) {
+            std::this_thread::yield();
+        }
+
+        return true;
+    });
+
+    for (int i = 0; i < HANDLERS_COUNT; ++i) {
+        handlers.push_back(dispatcher->registerEventHandler([&]() {
+            ++handlerCalls;
+            return true;
+        }));
+    }
+
+    //-------------------------------------------
+    // ACTIONS
+    // keep dispatcher busy while queue is being filled
+    dispatcher->emitEvent(blockingHandlerID);
+    ASSERT_TRUE(waitUntil([&]() { return isBlocked.load(); }, std::chrono::seconds(5)));
+
+    for (const HandlerID_t id : handlers) {
+        dispatcher->emitEvent(id);
+    }
+
+    canContinue = true;
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(waitUntil([&]() { return HANDLERS_COUNT == handlerCalls.load(); }, std::chrono::seconds(5)));
+
+    dispatcher->stop();
+    dispatcher->join();
+}
+
+TEST(busypoll_dispatcher, timers) {
+    TEST_DESCRIPTION("timers must expire while dispatcher thread is polling for events");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = HsmEventDispatcherBusyPoll::create(HsmEventDispatcherBusyPoll::IdleMode::SLEEP);
+    std::atomic<int> singleShotCalls(0);
+    std::atomic<int> repeatingCalls(0);
+    const TimerID_t singleShotTimer = 1;
+    const TimerID_t repeatingTimer = 2;
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerTimerHandler([&](const TimerID_t timerID) {
+        if (singleShotTimer == timerID) {
+            ++singleShotCalls;
+        } else if (repeatingTimer == timerID) {
+            ++repeatingCalls;
+        } else {
+            // unexpected timer
+        }
+
+        return true;
+    });
+
+    //-------------------------------------------
+    // ACTIONS
+    const auto startedAt = Clock_t::now();
+
+    dispatcher->startTimer(handlerID, singleShotTimer, 20, true);
+    dispatcher->startTimer(handlerID, repeatingTimer, 10, false);
+
+    //-------------------------------------------
+    // VALIDATION
+    ASSERT_TRUE(waitUntil([&]() { return repeatingCalls.load() >= 5; }, std::chrono::seconds(5)));
+    EXPECT_GE(Clock_t::now() - startedAt, std::chrono::milliseconds(50));
+    EXPECT_EQ(singleShotCalls.load(), 1);
+    EXPECT_FALSE(dispatcher->isTimerRunning(handlerID, singleShotTimer));
+    EXPECT_TRUE(dispatcher->isTimerRunning(handlerID, repeatingTimer));
+
+    dispatcher->stopTimer(handlerID, repeatingTimer);
+    const int callsAfterStop = repeatingCalls.load();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_LE(repeatingCalls.load(), callsAfterStop + 1);
+
+    dispatcher->stop();
+    dispatcher->join();
+}
@@ -0,0 +1,179 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#include "TestsCommon.hpp"
+#include "hsmcpp/HsmEventDispatcherManual.hpp"
+#include "hsmcpp/hsm.hpp"
+
+#include <chrono>
+#include <vector>
+
+TEST(manual_dispatcher, events) {
+    TEST_DESCRIPTION("events must be dispatched only when application asks for it");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = HsmEventDispatcherManual::create();
+    std::vector<int> calls;
+
+    ASSERT_TRUE(dispatcher);
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handler2 = dispatcher->registerEventHandler([&]() {
+        calls.push_back(2);
+        return true;
+    });
+    const HandlerID_t handler1 = dispatcher->registerEventHandler([&]() {
+        calls.push_back(1);
+        // events emitted by handlers must be processed during the same runUntilIdle() call
+        dispatcher->emitEvent(handler2);
+        return true;
+    });
+
+    //-------------------------------------------
+    // ACTIONS
+    dispatcher->emitEvent(handler1);
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(calls.empty());
+    EXPECT_TRUE(dispatcher->runUntilIdle());
+    EXPECT_EQ(calls, std::vector<int>({1, 2}));
+    EXPECT_FALSE(dispatcher->runUntilIdle());
+
+    dispatcher->stop();
+    dispatcher->emitEvent(handler1);
+    EXPECT_FALSE(dispatcher->runUntilIdle());
+    EXPECT_EQ(calls.size(), 2u);
+}
+
+TEST(manual_dispatcher, timers_order) {
+    TEST_DESCRIPTION("timers must expire in order of their deadlines and in start order if deadlines are equal");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = HsmEventDispatcherManual::create();
+    std::vector<TimerID_t> expiredTimers;
+
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerTimerHandler([&](const TimerID_t timerID) {
+        expiredTimers.push_back(timerID);
+        return true;
+    });
+
+    dispatcher->startTimer(handlerID, 1, 20, true);
+    dispatcher->startTimer(handlerID, 2, 10, true);
+    dispatcher->startTimer(handlerID, 3, 20, true);
+    dispatcher->startTimer(handlerID, 4, 10, true);
+    dispatcher->startTimerUs(handlerID, 5, 10000, true);
+
+    //-------------------------------------------
+    // ACTIONS
+    // VALIDATION
+    EXPECT_EQ(dispatcher->getNextTimerDeadline(), HsmEventDispatcherManual::TimePoint_t(std::chrono::milliseconds(10)));
+    EXPECT_EQ(dispatcher->advance(std::chrono::milliseconds(9)), 0u);
+    EXPECT_TRUE(expiredTimers.empty());
+
+    EXPECT_EQ(dispatcher->advance(std::chrono::milliseconds(6)), 3u);
+    EXPECT_EQ(expiredTimers, std::vector<TimerID_t>({2, 4, 5}));
+    EXPECT_EQ(dispatcher->now(), HsmEventDispatcherManual::TimePoint_t(std::chrono::milliseconds(15)));
+
+    EXPECT_EQ(dispatcher->advanceToNextTimer(), 2u);
+    EXPECT_EQ(expiredTimers, std::vector<TimerID_t>({2, 4, 5, 1, 3}));
+    EXPECT_EQ(dispatcher->now(), HsmEventDispatcherManual::TimePoint_t(std::chrono::milliseconds(20)));
+
+    EXPECT_EQ(dispatcher->advanceToNextTimer(), 0u);
+    EXPECT_EQ(dispatcher->getNextTimerDeadline(), HsmEventDispatcherManual::TimePoint_t::max());
+}
+
+TEST(manual_dispatcher, repeating_timers) {
+    TEST_DESCRIPTION("repeating and restarted timers must follow virtual clock without drift");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const TimerID_t repeatingTimer = 1;
+    const TimerID_t restartedTimer = 2;
+    auto dispatcher = HsmEventDispatcherManual::create();
+    int repeatingCalls = 0;
+    int restartedCalls = 0;
+
+    ASSERT_TRUE(dispatcher->start());
+
+    const HandlerID_t handlerID = dispatcher->registerTimerHandler([&](const TimerID_t timerID) {
+        if (repeatingTimer == timerID) {
+            ++repeatingCalls;
+        } else {
+            ++restartedCalls;
+        }
+
+        return true;
+    });
+
+    dispatcher->startTimer(handlerID, repeatingTimer, 100, false);
+    dispatcher->startTimer(handlerID, restartedTimer, 1000, true);
+
+    //-------------------------------------------
+    // ACTIONS
+    (void)dispatcher->advance(std::chrono::milliseconds(900));
+    dispatcher->restartTimer(handlerID, restartedTimer);
+    (void)dispatcher->advance(std::chrono::milliseconds(999));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(restartedCalls, 0);
+    EXPECT_EQ(dispatcher->advance(std::chrono::milliseconds(1)), 2u);
+    EXPECT_EQ(restartedCalls, 1);
+    EXPECT_EQ(repeatingCalls, 19);
+
+    // 1 hour of virtual time
+    EXPECT_EQ(dispatcher->advance(std::chrono::hours(1)), 36000u);
+    EXPECT_EQ(repeatingCalls, 36019);
+    EXPECT_TRUE(dispatcher->isTimerRunning(handlerID, repeatingTimer));
+    EXPECT_FALSE(dispatcher->isTimerRunning(handlerID, restartedTimer));
+}
+
+TEST(manual_dispatcher, hsm_simulation) {
+    TEST_DESCRIPTION("HSM driven by timers must be simulated without waiting for real time");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    const StateID_t stateOff = 0;
+    const StateID_t stateOn = 1;
+    const EventID_t eventToggle = 0;
+    const TimerID_t toggleTimer = 1;
+    auto dispatcher = HsmEventDispatcherManual::create();
+    HierarchicalStateMachine hsm(stateOff);
+    int switchedOn = 0;
+
+    hsm.registerState(stateOff);
+    hsm.registerState(stateOn, [&](const VariantVector_t&) { ++switchedOn; });
+    hsm.registerTransition(stateOff, stateOn, eventToggle);
+    hsm.registerTransition(stateOn, stateOff, eventToggle);
+    hsm.registerTimer(toggleTimer, eventToggle);
+
+    ASSERT_TRUE(hsm.initialize(dispatcher));
+    hsm.startTimer(toggleTimer, 1000, false);
+
+    //-------------------------------------------
+    // ACTIONS
+    hsm.transition(eventToggle);
+    (void)dispatcher->runUntilIdle();
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(compareStateLists(hsm.getActiveStates(), {stateOn}));
+    EXPECT_EQ(switchedOn, 1);
+
+    // one hour with toggling every second
+    EXPECT_EQ(dispatcher->advance(std::chrono::hours(1)), 3600u);
+    EXPECT_TRUE(compareStateLists(hsm.getActiveStates(), {stateOn}));
+    EXPECT_EQ(switchedOn, 1801);
+
+    (void)dispatcher->advance(std::chrono::milliseconds(999));
+    EXPECT_TRUE(compareStateLists(hsm.getActiveStates(), {stateOn}));
+    (void)dispatcher->advance(std::chrono::milliseconds(1));
+    EXPECT_TRUE(compareStateLists(hsm.getActiveStates(), {stateOff}));
+
+    hsm.release();
+    dispatcher->stop();
+}
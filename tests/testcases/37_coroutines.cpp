@@ -0,0 +1,354 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#include "TestsCommon.hpp"
+#include "hsmcpp/HsmEventDispatcherManual.hpp"
+#include "hsmcpp/HsmEventDispatcherSTD.hpp"
+#include "hsmcpp/hsm.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace {
+namespace States {
+const StateID_t A = 0;
+const StateID_t B = 1;
+const StateID_t C = 2;
+}  // namespace States
+
+namespace Events {
+const EventID_t E1 = 0;
+const EventID_t E2 = 1;
+const EventID_t SELF = 2;
+}  // namespace Events
+
+// minimal fire-and-forget coroutine type
+struct Task {
+    struct promise_type {
+        Task get_return_object() {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() {
+            std::terminate();
+        }
+    };
+};
+
+void registerStructure(HierarchicalStateMachine& hsm) {
+    hsm.registerState(States::A);
+    hsm.registerState(States::B);
+    hsm.registerState(States::C);
+    hsm.registerTransition(States::A, States::B, Events::E1);
+    hsm.registerTransition(States::B, States::C, Events::E2);
+    hsm.registerSelfTransition(States::A, Events::SELF, TransitionType::INTERNAL_TRANSITION);
+}
+
+// waits until condition becomes true. returns false on timeout
+template <typename Predicate>
+bool waitUntil(const Predicate& condition, const std::chrono::milliseconds& timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while ((false == condition()) && (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return condition();
+}
+}  // namespace
+
+TEST(coroutines, transition_async) {
+    TEST_DESCRIPTION("coroutine must be resumed on dispatcher thread with the result of the transition");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = HsmEventDispatcherSTD::create();
+    HierarchicalStateMachine hsm(States::A);
+    std::atomic<bool> isDone(false);
+    std::atomic<std::thread::id> dispatcherThread;
+    HsmEventStatus status1 = HsmEventStatus::PENDING;
+    HsmEventStatus status2 = HsmEventStatus::PENDING;
+    std::thread::id resumedOnThread;
+    VariantVector_t receivedArgs;
+
+    registerStructure(hsm);
+    hsm.registerState(States::B, [&](const VariantVector_t& args) { receivedArgs = args; });
+    ASSERT_TRUE(dispatcher->start());
+    ASSERT_TRUE(hsm.initialize(dispatcher));
+    dispatcher->enqueueAction([&]() { dispatcherThread = std::this_thread::get_id(); });
+
+    //-------------------------------------------
+    // ACTIONS
+    auto coroutine = [&]() -> Task {
+        status1 = co_await hsm.transitionAsync(Events::E1, 7);
+        resumedOnThread = std::this_thread::get_id();
+        // there is no transition from B for E1
+        status2 = co_await hsm.transitionAsync(Events::E1);
+        isDone = true;
+    };
+
+    coroutine();
+
+    //-------------------------------------------
+    // VALIDATION
+    ASSERT_TRUE(waitUntil([&]() { return isDone.load(); }, std::chrono::seconds(5)));
+    EXPECT_EQ(status1, HsmEventStatus::DONE_OK);
+    EXPECT_EQ(status2, HsmEventStatus::DONE_FAILED);
+    EXPECT_EQ(resumedOnThread, dispatcherThread.load());
+    ASSERT_EQ(receivedArgs.size(), 1u);
+    EXPECT_EQ(receivedArgs[0].toInt64(), 7);
+    EXPECT_TRUE(compareStateLists(hsm.getActiveStates(), {States::B}));
+
+    hsm.release();
+    dispatcher->stop();
+    dispatcher->join();
+}
+
+TEST(coroutines, wait_for_state) {
+    TEST_DESCRIPTION("coroutine must be resumed only when requested state becomes active");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = HsmEventDispatcherManual::create();
+    HierarchicalStateMachine hsm(States::A);
+    std::vector<int> steps;
+
+    registerStructure(hsm);
+    ASSERT_TRUE(dispatcher->start());
+    ASSERT_TRUE(hsm.initialize(dispatcher));
+    (void)dispatcher->runUntilIdle();
+
+    auto coroutine = [&]() -> Task {
+        // state is already active. coroutine must not be suspended
+        steps.push_back((true == co_await hsm.waitForState(States::A)) ? 1 : -1);
+        steps.push_back((true == co_await hsm.waitForState(States::C)) ? 2 : -2);
+    };
+
+    //-------------------------------------------
+    // ACTIONS
+    coroutine();
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(steps, std::vector<int>({1}));
+
+    hsm.transition(Events::E1);
+    (void)dispatcher->runUntilIdle();
+    EXPECT_EQ(steps, std::vector<int>({1}));
+
+    hsm.transition(Events::E2);
+    (void)dispatcher->runUntilIdle();
+    EXPECT_EQ(steps, std::vector<int>({1, 2}));
+
+    hsm.release();
+    dispatcher->stop();
+}
+
+TEST(coroutines, wait_for_state_released) {
+    TEST_DESCRIPTION("waiting coroutine must be resumed with false if HSM is released");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = HsmEventDispatcherManual::create();
+    HierarchicalStateMachine hsm(States::A);
+    std::vector<int> steps;
+
+    registerStructure(hsm);
+    ASSERT_TRUE(dispatcher->start());
+    ASSERT_TRUE(hsm.initialize(dispatcher));
+    (void)dispatcher->runUntilIdle();
+
+    auto coroutine = [&]() -> Task {
+        steps.push_back((true == co_await hsm.waitForState(States::C)) ? 1 : -1);
+        // HSM is released. coroutine must not be suspended
+        steps.push_back((true == co_await hsm.waitForState(States::C)) ? 2 : -2);
+    };
+
+    //-------------------------------------------
+    // ACTIONS
+    coroutine();
+    hsm.release();
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_TRUE(steps.empty());
+    (void)dispatcher->runUntilIdle();
+    EXPECT_EQ(steps, std::vector<int>({-1, -2}));
+
+    dispatcher->stop();
+}
+
+TEST(coroutines, wait_for_state_concurrent_transitions) {
+    TEST_DESCRIPTION("waiting coroutines and threads must not miss states which are activated by other threads");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int WAITS_COUNT = 200;
+    auto dispatcher = HsmEventDispatcherSTD::create();
+    HierarchicalStateMachine hsm(States::A);
+    std::atomic<int> completedCoroutines(0);
+    std::atomic<bool> isWaiterDone(false);
+    std::atomic<int> failedWaits(0);
+
+    hsm.registerState(States::A);
+    hsm.registerState(States::B);
+    hsm.registerTransition(States::A, States::B, Events::E1);
+    hsm.registerTransition(States::B, States::A, Events::E2);
+    ASSERT_TRUE(dispatcher->start());
+    ASSERT_TRUE(hsm.initialize(dispatcher));
+
+    auto coroutine = [&]() -> Task {
+        if ((false == co_await hsm.waitForState(States::A)) || (false == co_await hsm.waitForState(States::B))) {
+            ++failedWaits;
+        }
+
+        ++completedCoroutines;
+    };
+
+    //-------------------------------------------
+    // ACTIONS
+    std::thread sender([&]() {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+        while (((completedCoroutines.load() < WAITS_COUNT) || (false == isWaiterDone.load())) &&
+               (std::chrono::steady_clock::now() < deadline)) {
+            (void)hsm.transitionSync(Events::E1, TIMEOUT_SYNC_TRANSITION);
+            (void)hsm.transitionSync(Events::E2, TIMEOUT_SYNC_TRANSITION);
+        }
+    });
+    std::thread waiter([&]() {
+        for (int i = 0; i < WAITS_COUNT; ++i) {
+            if ((false == hsm.waitForState(States::A, TIMEOUT_SYNC_TRANSITION)) ||
+                (false == hsm.waitForState(States::B, TIMEOUT_SYNC_TRANSITION))) {
+                ++failedWaits;
+            }
+        }
+
+        isWaiterDone = true;
+    });
+
+    // coroutines start waiting on this thread while states are being changed by dispatcher
+    for (int i = 0; i < WAITS_COUNT; ++i) {
+        coroutine();
+    }
+
+    sender.join();
+    waiter.join();
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(completedCoroutines.load(), WAITS_COUNT);
+    EXPECT_TRUE(isWaiterDone.load());
+    EXPECT_EQ(failedWaits.load(), 0);
+
+    hsm.release();
+    dispatcher->stop();
+    dispatcher->join();
+}
+
+TEST(coroutines, many_exchanges) {
+    TEST_DESCRIPTION("single thread must be able to drive many suspended coroutines at the same time");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int COROUTINES_COUNT = 1000;
+    auto dispatcher = HsmEventDispatcherManual::create();
+    HierarchicalStateMachine hsm(States::A);
+    int completed = 0;
+    int succeeded = 0;
+
+    registerStructure(hsm);
+    ASSERT_TRUE(dispatcher->start());
+    ASSERT_TRUE(hsm.initialize(dispatcher));
+
+    auto coroutine = [&]() -> Task {
+        const HsmEventStatus status = co_await hsm.transitionAsync(Events::SELF);
+
+        ++completed;
+
+        if (HsmEventStatus::DONE_OK == status) {
+            ++succeeded;
+        }
+    };
+
+    //-------------------------------------------
+    // ACTIONS
+    for (int i = 0; i < COROUTINES_COUNT; ++i) {
+        coroutine();
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(completed, 0);
+    (void)dispatcher->runUntilIdle();
+    EXPECT_EQ(completed, COROUTINES_COUNT);
+    EXPECT_EQ(succeeded, COROUTINES_COUNT);
+
+    hsm.release();
+    dispatcher->stop();
+}
+
+TEST(coroutines, custom_executor) {
+    TEST_DESCRIPTION("coroutine must be resumed using executor provided by the caller");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    auto dispatcher = HsmEventDispatcherManual::create();
+    HierarchicalStateMachine hsm(States::A);
+    std::vector<std::function<void()>> executorQueue;
+    HierarchicalStateMachine::CoroutineExecutor_t executor = [&](std::function<void()> resume) {
+        executorQueue.push_back(std::move(resume));
+    };
+    // resumes coroutines scheduled on executor. returns number of resumed coroutines
+    auto runExecutor = [&]() {
+        std::vector<std::function<void()>> resumeQueue;
+
+        resumeQueue.swap(executorQueue);
+
+        for (const std::function<void()>& resume : resumeQueue) {
+            resume();
+        }
+
+        return resumeQueue.size();
+    };
+    HsmEventStatus status = HsmEventStatus::PENDING;
+    bool isActive = false;
+
+    registerStructure(hsm);
+    ASSERT_TRUE(dispatcher->start());
+    ASSERT_TRUE(hsm.initialize(dispatcher));
+
+    auto coroutine = [&]() -> Task {
+        status = co_await hsm.transitionAsync(Events::E1).via(executor);
+        isActive = co_await hsm.waitForState(States::C).via(executor);
+    };
+
+    //-------------------------------------------
+    // ACTIONS
+    coroutine();
+    (void)dispatcher->runUntilIdle();
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(status, HsmEventStatus::PENDING);
+    EXPECT_EQ(runExecutor(), 1u);
+    EXPECT_EQ(status, HsmEventStatus::DONE_OK);
+
+    hsm.transition(Events::E2);
+    (void)dispatcher->runUntilIdle();
+    EXPECT_FALSE(isActive);
+    EXPECT_EQ(runExecutor(), 1u);
+    EXPECT_TRUE(isActive);
+
+    hsm.release();
+    dispatcher->stop();
+}
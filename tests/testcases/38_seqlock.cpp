@@ -0,0 +1,120 @@
+// Copyright (C) 2026 Igor Krechetov
+// Distributed under MIT license. See file LICENSE for details
+#include "TestsCommon.hpp"
+#include "hsmcpp/HsmSeqLock.hpp"
+
+#include <atomic>
+#include <list>
+#include <thread>
+#include <vector>
+
+TEST(seqlock, publish_and_read) {
+    TEST_DESCRIPTION("published content must be readable and version must change only when content changes");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    HsmSeqLockArray<int, 4> array;
+    int values[4] = {};
+    size_t count = 100;
+
+    //-------------------------------------------
+    // ACTIONS
+    // VALIDATION
+    EXPECT_EQ(array.version(), 0u);
+    EXPECT_EQ(array.read(values, count), 0u);
+    EXPECT_EQ(count, 0u);
+
+    const std::list<int> states = {1, 2, 3};
+
+    EXPECT_TRUE(array.publish(states.begin(), states.end()));
+    EXPECT_EQ(array.read(values, count), 1u);
+    ASSERT_EQ(count, 3u);
+    EXPECT_EQ(std::vector<int>(values, values + count), std::vector<int>({1, 2, 3}));
+
+    // same content
+    EXPECT_FALSE(array.publish(states.begin(), states.end()));
+    EXPECT_EQ(array.version(), 1u);
+
+    const std::list<int> shorterStates = {1, 2};
+
+    EXPECT_TRUE(array.publish(shorterStates.begin(), shorterStates.end()));
+    EXPECT_EQ(array.read(values, count), 2u);
+    ASSERT_EQ(count, 2u);
+    EXPECT_EQ(std::vector<int>(values, values + count), std::vector<int>({1, 2}));
+}
+
+TEST(seqlock, overflow) {
+    TEST_DESCRIPTION("array must keep real number of elements and store only elements which fit into it");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    HsmSeqLockArray<int, 2> array;
+    const std::vector<int> states = {5, 6, 7};
+    int values[2] = {};
+    size_t count = 0;
+
+    //-------------------------------------------
+    // ACTIONS
+    EXPECT_TRUE(array.publish(states.begin(), states.end()));
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(array.read(values, count), 1u);
+    EXPECT_EQ(count, 3u);
+    EXPECT_EQ(values[0], 5);
+    EXPECT_EQ(values[1], 6);
+    // elements which were not stored can't be compared
+    EXPECT_TRUE(array.publish(states.begin(), states.end()));
+    EXPECT_EQ(array.version(), 2u);
+}
+
+TEST(seqlock, concurrent_readers) {
+    TEST_DESCRIPTION("readers must never see partially published content");
+
+    //-------------------------------------------
+    // PRECONDITIONS
+    constexpr int PUBLICATIONS_COUNT = 100000;
+    constexpr size_t READERS_COUNT = 4;
+    HsmSeqLockArray<int, 8> array;
+    std::atomic<bool> isDone(false);
+    std::atomic<int> inconsistentReads(0);
+    std::vector<std::thread> readers;
+
+    //-------------------------------------------
+    // ACTIONS
+    for (size_t i = 0; i < READERS_COUNT; ++i) {
+        readers.emplace_back([&]() {
+            int values[8] = {};
+            size_t count = 0;
+
+            while (false == isDone.load()) {
+                (void)array.read(values, count);
+
+                // writer always publishes arrays where all elements have the same value
+                for (size_t j = 1; j < count; ++j) {
+                    if (values[j] != values[0]) {
+                        ++inconsistentReads;
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i <= PUBLICATIONS_COUNT; ++i) {
+        const std::vector<int> states(1 + (i % 8), i);
+
+        (void)array.publish(states.begin(), states.end());
+    }
+
+    isDone = true;
+
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    //-------------------------------------------
+    // VALIDATION
+    EXPECT_EQ(inconsistentReads.load(), 0);
+    EXPECT_EQ(array.version(), static_cast<uint32_t>(PUBLICATIONS_COUNT));
+}